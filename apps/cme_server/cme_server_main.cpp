@@ -1,14 +1,25 @@
 #include "../../core/include/instrument.h"
 #include "../../core/include/market_data_generator.h"
 #include "../../core/include/order_book_manager.h"
-#include "../../protocols/cme/include/cme_event_listener.h"
+#include "../../core/include/parallel_market_data_generator.h"
+#include "../../core/include/rate_scheduler.h"
+#include "../../protocols/cme/include/cme_channel_publisher.h"
 #include "../../protocols/cme/include/cme_protocol_adapter.h"
+#include "../../protocols/cme/include/cme_snapshot_cycle.h"
+#include "../../protocols/common/include/ab_feed_transport.h"
+#include "../../protocols/common/include/async_transport.h"
+#include "../../protocols/common/include/io_uring_transport.h"
+#include "../../protocols/common/include/replay_server.h"
 #include "../../protocols/common/include/udp_transport.h"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <getopt.h>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <random>
 #include <signal.h>
 #include <thread>
 #include <vector>
@@ -30,10 +41,35 @@ void print_usage(const char* program_name)
               << "Options:\n"
               << "  -i, --incremental-ip IP    Incremental feed IP (default: 224.0.28.64)\n"
               << "  -p, --incremental-port P   Incremental feed port (default: 14310)\n"
+              << "  -I, --incremental-ip-b IP  Incremental feed B IP; enables A/B publishing\n"
+              << "  -P, --incremental-port-b P Incremental feed B port (default: feed A port + 1)\n"
+              << "  -d, --b-delay-us N        Delay feed B behind feed A by N us (default: 0)\n"
               << "  -s, --snapshot-ip IP       Snapshot feed IP (default: 224.0.28.69)\n"
               << "  -q, --snapshot-port P      Snapshot feed port (default: 14320)\n"
+              << "  -S, --snapshot-rate N     Snapshot cycle rate in snapshots/sec (default: 100)\n"
+              << "  -R, --replay-port P       Serve TCP replay of recent incremental packets on port P\n"
+              << "  -c, --channel SPEC        Add a channel ID:GROUP[,GROUP...]:IP:PORT[:CPU] for the listed\n"
+              << "                            product groups; repeatable. Its snapshots go to the snapshot\n"
+              << "                            port + its position (1, 2, ...). Channel 310 keeps the rest.\n"
+              << "  -f, --config FILE         Load channels from a server config (e.g. config/server_config.json).\n"
+              << "                            The first listed replaces channel 310 on the feed options above;\n"
+              << "                            the others need an incremental_feed. -c channels follow them.\n"
+              << "  -C, --cpu N               Pin channel 310's publishing thread to CPU N\n"
+              << "  -A, --async-send N        Send incremental packets from a sender thread per channel. The\n"
+              << "                            thread of channel k (0, 1, ...) busy-polls on CPU N+k; N = -1\n"
+              << "                            leaves the threads floating\n"
+              << "  -U, --io-uring            Send single-feed incremental packets through io_uring with\n"
+              << "                            registered buffers (falls back to sendmmsg if unavailable)\n"
               << "  -m, --mode MODE           Market mode: normal, fast, volatile, thin (default: normal)\n"
-              << "  -r, --rate N              Updates per second (default: 10)\n"
+              << "  -r, --rate N              Updates per second across all instruments (default: 10)\n"
+              << "  -a, --arrival TYPE        Update arrivals: fixed, poisson (default: fixed)\n"
+              << "  -G, --generator-threads N Generate fixed arrivals on N threads, each with its own share of\n"
+              << "                            the instruments (default: 1)\n"
+              << "  -e, --seed N              Seed the generators with N to repeat a run (default: random,\n"
+              << "                            printed at startup)\n"
+              << "  -l, --max-latency-us N    Pack updates into MTU packets held at most N us (default: 0, off)\n"
+              << "  -b, --book-storage TYPE   Order book storage: map, ladder (default: map)\n"
+              << "  -o, --mbo                 Generate market-by-order data (templates 47/53)\n"
               << "  -v, --verbose             Enable verbose logging\n"
               << "  -h, --help                Show this help message\n\n"
               << "Examples:\n"
@@ -41,6 +77,49 @@ void print_usage(const char* program_name)
               << "  " << program_name << " --incremental-ip 127.0.0.1 --incremental-port 20001\n";
 }
 
+// Channel added with --channel, beyond the default channel 310
+struct ChannelOption {
+    cme_protocol::CMEChannelConfig config;
+    std::string ip;
+    uint16_t port = 0;
+};
+
+// ID:GROUP[,GROUP...]:IP:PORT[:CPU]
+bool parse_channel(const std::string& spec, ChannelOption& channel)
+{
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t colon = spec.find(':', start);
+        fields.push_back(spec.substr(start, colon - start));
+        if (colon == std::string::npos) {
+            break;
+        }
+        start = colon + 1;
+    }
+    if (fields.size() < 4 || fields.size() > 5) {
+        return false;
+    }
+
+    try {
+        channel.config.channel_id = static_cast<uint16_t>(std::stoi(fields[0]));
+        size_t group_start = 0;
+        while (group_start <= fields[1].size()) {
+            size_t comma = std::min(fields[1].find(',', group_start), fields[1].size());
+            channel.config.product_groups.push_back(fields[1].substr(group_start, comma - group_start));
+            group_start = comma + 1;
+        }
+        channel.ip = fields[2];
+        channel.port = static_cast<uint16_t>(std::stoi(fields[3]));
+        if (fields.size() == 5) {
+            channel.config.cpu = std::stoi(fields[4]);
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
 // Create sample futures instruments
 std::vector<std::shared_ptr<market_core::Instrument>> create_sample_instruments()
 {
@@ -62,6 +141,7 @@ std::vector<std::shared_ptr<market_core::Instrument>> create_sample_instruments(
         es->set_property("initial_price", 4500.0);
         es->set_property("price_decimals", int64_t(2));
         es->set_property("currency", std::string("USD"));
+        es->set_property("product_group", std::string("Equity"));
         es->external_ids["CME_SECURITY_ID"] = "1";
 
         instruments.push_back(es);
@@ -82,6 +162,7 @@ std::vector<std::shared_ptr<market_core::Instrument>> create_sample_instruments(
         mes->set_property("initial_price", 4500.0);
         mes->set_property("price_decimals", int64_t(2));
         mes->set_property("currency", std::string("USD"));
+        mes->set_property("product_group", std::string("Equity"));
         mes->external_ids["CME_SECURITY_ID"] = "2";
 
         instruments.push_back(mes);
@@ -102,11 +183,33 @@ std::vector<std::shared_ptr<market_core::Instrument>> create_sample_instruments(
         nq->set_property("initial_price", 15000.0);
         nq->set_property("price_decimals", int64_t(2));
         nq->set_property("currency", std::string("USD"));
+        nq->set_property("product_group", std::string("Equity"));
         nq->external_ids["CME_SECURITY_ID"] = "3";
 
         instruments.push_back(nq);
     }
 
+    // Euro FX
+    {
+        auto euro = std::make_shared<market_core::FuturesInstrument>(4, "6EZ4");
+        euro->description = "Euro FX Dec 2024";
+        euro->tick_size = 0.00005;
+        euro->multiplier = 125000.0;
+        euro->underlying = "EUR";
+        euro->maturity_date = "2024-12-16";
+        euro->contract_size = 125000.0;
+        euro->initial_margin = 2600.0;
+        euro->maintenance_margin = 2400.0;
+
+        euro->set_property("initial_price", 1.0850);
+        euro->set_property("price_decimals", int64_t(5));
+        euro->set_property("currency", std::string("USD"));
+        euro->set_property("product_group", std::string("FX"));
+        euro->external_ids["CME_SECURITY_ID"] = "4";
+
+        instruments.push_back(euro);
+    }
+
     return instruments;
 }
 
@@ -119,27 +222,60 @@ int main(int argc, char* argv[])
     // Default configuration
     std::string incremental_ip = "224.0.28.64";
     uint16_t incremental_port = 14310;
+    std::string incremental_ip_b;
+    uint16_t incremental_port_b = 0;
+    std::chrono::microseconds b_delay { 0 };
     std::string snapshot_ip = "224.0.28.69";
     uint16_t snapshot_port = 14320;
+    double snapshot_rate = 100.0;
+    uint16_t replay_port = 0;
+    std::vector<ChannelOption> extra_channels;
+    std::string config_file;
+    int primary_cpu = -1;
+    bool async_send = false;
+    int async_send_cpu = -1;
+    bool io_uring = false;
     market_core::MarketMode market_mode = market_core::MarketMode::NORMAL;
     int updates_per_second = 10;
+    bool poisson_arrivals = false;
+    int generator_threads = 1;
+    uint64_t seed = 0;
+    bool seed_given = false;
+    std::chrono::microseconds max_latency { 0 };
     bool verbose = false;
+    market_core::OrderBook::Config book_config;
 
     // Parse command line arguments
     static struct option long_options[] = {
         { "incremental-ip", required_argument, 0, 'i' },
         { "incremental-port", required_argument, 0, 'p' },
+        { "incremental-ip-b", required_argument, 0, 'I' },
+        { "incremental-port-b", required_argument, 0, 'P' },
+        { "b-delay-us", required_argument, 0, 'd' },
         { "snapshot-ip", required_argument, 0, 's' },
         { "snapshot-port", required_argument, 0, 'q' },
+        { "snapshot-rate", required_argument, 0, 'S' },
+        { "replay-port", required_argument, 0, 'R' },
+        { "channel", required_argument, 0, 'c' },
+        { "config", required_argument, 0, 'f' },
+        { "cpu", required_argument, 0, 'C' },
+        { "async-send", required_argument, 0, 'A' },
+        { "io-uring", no_argument, 0, 'U' },
         { "mode", required_argument, 0, 'm' },
         { "rate", required_argument, 0, 'r' },
+        { "arrival", required_argument, 0, 'a' },
+        { "generator-threads", required_argument, 0, 'G' },
+        { "seed", required_argument, 0, 'e' },
+        { "max-latency-us", required_argument, 0, 'l' },
+        { "book-storage", required_argument, 0, 'b' },
+        { "mbo", no_argument, 0, 'o' },
         { "verbose", no_argument, 0, 'v' },
         { "help", no_argument, 0, 'h' },
         { 0, 0, 0, 0 }
     };
 
     int opt;
-    while ((opt = getopt_long(argc, argv, "i:p:s:q:m:r:vh", long_options, nullptr)) != -1) {
+    while ((opt = getopt_long(argc, argv, "i:p:I:P:d:s:q:S:R:c:f:C:A:Um:r:a:G:e:l:b:ovh", long_options, nullptr)) != -1) {
         switch (opt) {
         case 'i':
             incremental_ip = optarg;
@@ -147,12 +283,53 @@ int main(int argc, char* argv[])
         case 'p':
             incremental_port = static_cast<uint16_t>(std::stoi(optarg));
             break;
+        case 'I':
+            incremental_ip_b = optarg;
+            break;
+        case 'P':
+            incremental_port_b = static_cast<uint16_t>(std::stoi(optarg));
+            break;
+        case 'd':
+            b_delay = std::chrono::microseconds(std::max(0, std::stoi(optarg)));
+            break;
         case 's':
             snapshot_ip = optarg;
             break;
         case 'q':
             snapshot_port = static_cast<uint16_t>(std::stoi(optarg));
             break;
+        case 'S':
+            snapshot_rate = std::stod(optarg);
+            if (!(snapshot_rate > 0.0)) {
+                std::cerr << "Invalid snapshot rate: " << optarg << " (must be positive)\n";
+                return 1;
+            }
+            break;
+        case 'R':
+            replay_port = static_cast<uint16_t>(std::stoi(optarg));
+            break;
+        case 'c': {
+            ChannelOption channel;
+            if (!parse_channel(optarg, channel)) {
+                std::cerr << "Invalid channel spec: " << optarg << "\n";
+                return 1;
+            }
+            extra_channels.push_back(channel);
+            break;
+        }
+        case 'f':
+            config_file = optarg;
+            break;
+        case 'C':
+            primary_cpu = std::stoi(optarg);
+            break;
+        case 'A':
+            async_send = true;
+            async_send_cpu = std::stoi(optarg);
+            break;
+        case 'U':
+            io_uring = true;
+            break;
         case 'm': {
             std::string mode_str = optarg;
             if (mode_str == "fast")
@@ -168,7 +345,35 @@ int main(int argc, char* argv[])
             break;
         }
         case 'r':
-            updates_per_second = std::stoi(optarg);
+            updates_per_second = std::max(1, std::stoi(optarg));
+            break;
+        case 'a':
+            poisson_arrivals = std::string(optarg) == "poisson";
+            break;
+        case 'G':
+            generator_threads = std::max(1, std::stoi(optarg));
+            break;
+        case 'e':
+            seed = std::stoull(optarg);
+            seed_given = true;
+            break;
+        case 'l':
+            max_latency = std::chrono::microseconds(std::max(0, std::stoi(optarg)));
+            break;
+        case 'b': {
+            std::string storage_str = optarg;
+            if (storage_str == "ladder")
+                book_config.storage = market_core::OrderBook::Storage::TICK_LADDER;
+            else if (storage_str == "map")
+                book_config.storage = market_core::OrderBook::Storage::PRICE_MAP;
+            else {
+                std::cerr << "Invalid book storage: " << storage_str << " (must be map or ladder)\n";
+                return 1;
+            }
+            break;
+        }
+        case 'o':
+            book_config.aggregate_by_price = false;
             break;
         case 'v':
             verbose = true;
@@ -182,10 +387,59 @@ int main(int argc, char* argv[])
         }
     }
 
+    // Channel 310 uses the incremental feed options and takes every
+    // instrument no other channel claims; a config file may replace it
+    cme_protocol::CMEChannelConfig primary;
+    primary.channel_id = 310; // CME Equity Futures
+    primary.name = "CME Globex Equity Futures";
+    if (!config_file.empty()) {
+        std::vector<cme_protocol::CMEChannelConfig> configured;
+        if (!cme_protocol::CMEChannelRegistry::load_channels(config_file, configured)) {
+            std::cerr << "No channels loaded from " << config_file << "\n";
+            return 1;
+        }
+        primary = configured.front();
+        std::vector<ChannelOption> channels;
+        for (size_t i = 1; i < configured.size(); ++i) {
+            if (configured[i].incremental_ip.empty() || configured[i].incremental_port == 0) {
+                std::cerr << "Channel " << configured[i].channel_id << " in " << config_file
+                          << " has no incremental_feed\n";
+                return 1;
+            }
+            channels.push_back({ configured[i], configured[i].incremental_ip, configured[i].incremental_port });
+        }
+        extra_channels.insert(extra_channels.begin(), channels.begin(), channels.end());
+    }
+    if (primary_cpu >= 0) {
+        primary.cpu = primary_cpu;
+    }
+    // Poisson arrivals pick the instrument, which the shards own
+    if (generator_threads > 1 && poisson_arrivals) {
+        std::cerr << "--generator-threads needs fixed arrivals\n";
+        return 1;
+    }
+
     std::cout << "CME Mock MDP Server (New Architecture)\n";
     std::cout << "=====================================\n";
-    std::cout << "Incremental Feed: " << incremental_ip << ":" << incremental_port << "\n";
-    std::cout << "Snapshot Feed:    " << snapshot_ip << ":" << snapshot_port << "\n";
+    if (incremental_port_b == 0) {
+        incremental_port_b = static_cast<uint16_t>(incremental_port + 1);
+    }
+    std::cout << "Incremental Feed: " << incremental_ip << ":" << incremental_port << " (channel "
+              << primary.channel_id << ")\n";
+    if (!incremental_ip_b.empty()) {
+        std::cout << "Incremental B:    " << incremental_ip_b << ":" << incremental_port_b;
+        if (b_delay.count() > 0) {
+            std::cout << " (+" << b_delay.count() << "us)";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "Snapshot Feed:    " << snapshot_ip << ":" << snapshot_port
+              << " (" << snapshot_rate << " snapshots/sec)\n";
+    for (size_t i = 0; i < extra_channels.size(); ++i) {
+        std::cout << "Channel " << extra_channels[i].config.channel_id << ":      "
+                  << extra_channels[i].ip << ":" << extra_channels[i].port << ", snapshots on port "
+                  << snapshot_port + i + 1 << "\n";
+    }
     std::cout << "Market Mode:      ";
     switch (market_mode) {
     case market_core::MarketMode::NORMAL:
@@ -208,18 +462,31 @@ int main(int argc, char* argv[])
         break;
     }
     std::cout << "\n";
-    std::cout << "Update Rate:      " << updates_per_second << " Hz\n\n";
+    // A random seed is printed so the run can be repeated with --seed
+    if (!seed_given) {
+        seed = std::random_device {}();
+    }
+    std::cout << "Seed:             " << seed << (seed_given ? "" : " (random)") << "\n";
+    std::cout << "Update Rate:      " << updates_per_second << " Hz ("
+              << (poisson_arrivals ? "poisson" : "fixed") << " arrivals";
+    if (generator_threads > 1) {
+        std::cout << ", " << generator_threads << " generator threads";
+    }
+    std::cout << ")\n\n";
 
     try {
         // 1. Create core components
         auto book_manager = std::make_shared<market_core::OrderBookManager>();
-        auto market_generator = std::make_shared<market_core::MarketDataGenerator>(book_manager);
+        auto market_generator = std::make_shared<market_core::MarketDataGenerator>(book_manager, seed);
+
+        // Sharded generation: each worker thread owns a share of the books
+        std::unique_ptr<market_core::ParallelMarketDataGenerator> parallel_generator;
 
         // 2. Create and configure instruments
         auto instruments = create_sample_instruments();
         for (auto& instrument : instruments) {
             book_manager->add_instrument(instrument);
-            book_manager->create_order_book(instrument->instrument_id);
+            book_manager->create_order_book(instrument->instrument_id, book_config);
             std::cout << "Added instrument: " << instrument->primary_symbol
                       << " (ID: " << instrument->instrument_id << ")\n";
         }
@@ -229,108 +496,258 @@ int main(int argc, char* argv[])
         auto config = market_generator->get_config();
         config.updates_per_second = updates_per_second;
         market_generator->set_config(config);
+        if (generator_threads > 1) {
+            parallel_generator = std::make_unique<market_core::ParallelMarketDataGenerator>(
+                book_manager, static_cast<size_t>(generator_threads), seed);
+            parallel_generator->set_config(config);
+        }
 
-        // 4. Create CME protocol adapters and transports
-        auto incremental_adapter = std::make_shared<cme_protocol::CMEProtocolAdapter>();
-        auto snapshot_adapter = std::make_shared<cme_protocol::CMEProtocolAdapter>();
-
-        auto inc_transport = std::make_shared<market_protocols::UDPTransport>(
-            incremental_ip, incremental_port);
-        auto snap_transport = std::make_shared<market_protocols::UDPTransport>(
-            snapshot_ip, snapshot_port);
-
-        if (!inc_transport->initialize() || !snap_transport->initialize()) {
-            std::cerr << "Failed to initialize UDP transports\n";
-            return 1;
+        // 4. One publishing thread per channel
+        auto publisher = std::make_shared<cme_protocol::CMEMultiChannelPublisher>(book_manager);
+        publisher->add_channel(primary);
+        for (const auto& channel : extra_channels) {
+            publisher->add_channel(channel.config);
+        }
+        publisher->assign_instruments();
+
+        // Recent incremental packets of every channel are journaled for TCP replay
+        std::unique_ptr<market_protocols::ReplayServer> replay_server;
+        if (replay_port != 0) {
+            market_protocols::ReplayServer::Config replay_config;
+            replay_config.port = replay_port;
+            replay_server = std::make_unique<market_protocols::ReplayServer>(replay_config);
         }
 
-        incremental_adapter->set_transport(inc_transport);
-        incremental_adapter->set_channel_id(310); // CME Equity Futures
-        incremental_adapter->set_batch_size(5);
+        // 5. Transports, snapshot cycles and definitions per channel
+        std::vector<std::unique_ptr<cme_protocol::CMESnapshotCycle>> snapshot_cycles;
+        std::vector<std::shared_ptr<market_protocols::AsyncTransport>> async_transports;
+        for (size_t index = 0; index < publisher->channel_count(); ++index) {
+            auto& channel = publisher->channel_at(index);
+            const auto& incremental_adapter = channel.adapter();
+
+            // A/B publishing sends each encoded packet to both groups
+            std::shared_ptr<market_protocols::IMessageTransport> inc_transport;
+            bool inc_ready = false;
+            if (index == 0 && !incremental_ip_b.empty()) {
+                auto ab_transport = std::make_shared<market_protocols::ABFeedTransport>(
+                    incremental_ip, incremental_port, incremental_ip_b, incremental_port_b);
+                ab_transport->set_b_delay(b_delay);
+                inc_ready = ab_transport->initialize();
+                inc_transport = ab_transport;
+            } else {
+                const std::string& ip = index > 0 ? extra_channels[index - 1].ip : incremental_ip;
+                uint16_t port = index > 0 ? extra_channels[index - 1].port : incremental_port;
+                if (io_uring) {
+                    auto uring_transport = std::make_shared<market_protocols::IoUringTransport>(ip, port);
+                    if (uring_transport->initialize()) {
+                        inc_ready = true;
+                        inc_transport = uring_transport;
+                    } else {
+                        std::cerr << "io_uring unavailable for channel " << channel.channel_id()
+                                  << ", using sendmmsg\n";
+                    }
+                }
+                if (!inc_transport) {
+                    auto udp_transport = std::make_shared<market_protocols::UDPTransport>(ip, port);
+                    inc_ready = udp_transport->initialize();
+                    inc_transport = udp_transport;
+                }
+            }
+            auto snap_transport = std::make_shared<market_protocols::UDPTransport>(
+                snapshot_ip, static_cast<uint16_t>(snapshot_port + index));
 
-        snapshot_adapter->set_transport(snap_transport);
-        snapshot_adapter->set_channel_id(310);
-        snapshot_adapter->set_batch_size(1);
+            if (!inc_ready || !snap_transport->initialize()) {
+                std::cerr << "Failed to initialize UDP transports for channel " << channel.channel_id() << "\n";
+                return 1;
+            }
 
-        // 5. Create event listeners to connect core to protocols
-        auto inc_listener = std::make_shared<cme_protocol::CMEEventListener>(
-            book_manager, incremental_adapter);
-        auto snap_listener = std::make_shared<cme_protocol::CMEEventListener>(
-            book_manager, snapshot_adapter);
+            // Syscalls move to a sender thread so kernel stalls stay off
+            // the channel thread
+            if (async_send) {
+                market_protocols::AsyncTransport::Config async_config;
+                if (async_send_cpu >= 0) {
+                    async_config.cpu = async_send_cpu + static_cast<int>(index);
+                } else {
+                    async_config.idle_sleep = std::chrono::microseconds(50);
+                }
+                auto async_transport = std::make_shared<market_protocols::AsyncTransport>(inc_transport, async_config);
+                async_transport->start();
+                async_transports.push_back(async_transport);
+                inc_transport = async_transport;
+            }
 
-        // 6. Register listeners with market generator
-        market_generator->add_listener(inc_listener);
-        market_generator->add_listener(snap_listener);
+            incremental_adapter->set_transport(inc_transport);
+            incremental_adapter->set_coalesce_updates(true); // Multi-entry 46s, like the real feed
+            if (max_latency.count() > 0) {
+                // Packets close on the MTU, the deadline or an event boundary
+                incremental_adapter->set_batch_size(1000);
+                incremental_adapter->set_max_latency(max_latency);
+            } else {
+                incremental_adapter->set_batch_size(5);
+            }
 
-        // 7. Send instrument definitions
-        std::cout << "\nSending instrument definitions...\n";
-        for (auto& instrument : instruments) {
-            incremental_adapter->send_instrument_definition(*instrument);
-            if (verbose) {
-                std::cout << "Sent definition for " << instrument->primary_symbol << "\n";
+            if (replay_server) {
+                auto journal = std::make_shared<market_protocols::PacketJournal>(
+                    16384, incremental_adapter->max_message_size());
+                incremental_adapter->set_journal(journal);
+                replay_server->add_channel(channel.channel_id(), journal);
             }
+
+            // Definitions go out before the channel thread takes the adapter
+            for (uint32_t instrument_id : publisher->registry().instruments(index)) {
+                auto instrument = book_manager->get_instrument(instrument_id);
+                incremental_adapter->send_instrument_definition(*instrument);
+                if (verbose) {
+                    std::cout << "Sent definition for " << instrument->primary_symbol
+                              << " on channel " << channel.channel_id() << "\n";
+                }
+            }
+
+            // Snapshots of the channel's books on their own thread, stamped
+            // against the channel's incremental feed
+            auto snapshot_adapter = std::make_shared<cme_protocol::CMEProtocolAdapter>();
+            snapshot_adapter->set_transport(snap_transport);
+            snapshot_adapter->set_channel_id(channel.channel_id());
+            snapshot_adapter->set_batch_size(1);
+
+            cme_protocol::CMESnapshotCycle::Config cycle_config;
+            cycle_config.snapshots_per_second = snapshot_rate;
+            cycle_config.max_depth = snapshot_adapter->max_depth_levels();
+            auto* registry = &publisher->registry();
+            cycle_config.instrument_filter = [registry, index](uint32_t instrument_id) {
+                return registry->channel_index(instrument_id) == index;
+            };
+            snapshot_cycles.push_back(std::make_unique<cme_protocol::CMESnapshotCycle>(
+                book_manager, snapshot_adapter, incremental_adapter, cycle_config));
+
+            std::cout << "Channel " << channel.channel_id() << ": "
+                      << publisher->registry().instruments(index).size() << " instruments\n";
         }
 
-        // 8. Generate initial snapshots
-        std::cout << "Generating initial snapshots...\n";
-        for (auto& instrument : instruments) {
-            auto snapshot = market_generator->generate_snapshot(instrument->instrument_id);
-            if (snapshot && verbose) {
-                std::cout << "Generated snapshot for " << instrument->primary_symbol << "\n";
+        if (replay_server) {
+            if (!replay_server->start()) {
+                std::cerr << "Failed to start replay server on port " << replay_port << "\n";
+                return 1;
             }
+            std::cout << "Replay Server:    TCP port " << replay_port << "\n";
+        }
+
+        // 6. Route generated events to the channel threads
+        if (parallel_generator) {
+            parallel_generator->add_record_listener(publisher);
+        } else {
+            market_generator->add_record_listener(publisher);
+        }
+        publisher->start();
+        for (auto& cycle : snapshot_cycles) {
+            cycle->start();
         }
 
         std::cout << "\nStarting market data generation...\n";
         std::cout << "Press Ctrl+C to stop\n\n";
 
-        // 9. Main market data generation loop
-        auto last_snapshot = std::chrono::steady_clock::now();
-        const auto snapshot_interval = std::chrono::seconds(30);
-        const auto update_interval = std::chrono::milliseconds(1000 / updates_per_second);
+        // 7. Main market data generation loop
+        // Channel threads meet packing deadlines themselves, so this loop
+        // only paces the generator.
+        // Fixed arrivals come from a token bucket in batches; poisson
+        // arrivals give each instrument its own stream at an equal share
+        // of the rate
+        market_core::RateScheduler::Config rate_config;
+        rate_config.target_rate = updates_per_second;
+        market_core::RateScheduler scheduler(rate_config);
+
+        market_core::ArrivalScheduler arrivals;
+        if (poisson_arrivals) {
+            double per_instrument = static_cast<double>(updates_per_second) / instruments.size();
+            for (auto& instrument : instruments) {
+                arrivals.add_instrument(instrument->instrument_id, market_core::ArrivalProcess::poisson(per_instrument));
+            }
+        }
+        std::vector<uint32_t> due;
+        size_t unsent = 0; // Fixed arrivals not yet dealt to the shards
+        const size_t max_batch = config.max_batch_events;
 
         auto stats_timer = std::chrono::steady_clock::now();
         const auto stats_interval = std::chrono::seconds(10);
 
         while (g_running) {
-            auto loop_start = std::chrono::steady_clock::now();
-
             // Generate market updates
-            market_generator->generate_all_instruments();
-
-            // Periodic snapshots
-            if (loop_start - last_snapshot >= snapshot_interval) {
-                for (auto& instrument : instruments) {
-                    market_generator->generate_snapshot(instrument->instrument_id);
+            if (poisson_arrivals) {
+                due.clear();
+                scheduler.acquire(arrivals, due, max_batch);
+                for (uint32_t instrument_id : due) {
+                    market_generator->generate_update(instrument_id);
                 }
-                last_snapshot = loop_start;
-                if (verbose) {
-                    std::cout << "Generated periodic snapshots\n";
+            } else if (parallel_generator) {
+                // Shards generate equal counts; the remainder waits for the
+                // next batch
+                unsent += scheduler.acquire(max_batch);
+                size_t per_thread = unsent / parallel_generator->thread_count();
+                if (per_thread > 0) {
+                    parallel_generator->generate_batch(static_cast<int>(per_thread));
+                    unsent -= per_thread * parallel_generator->thread_count();
                 }
+            } else {
+                size_t count = scheduler.acquire(max_batch);
+                market_generator->generate_batch(static_cast<int>(count));
             }
+            auto loop_start = std::chrono::steady_clock::now();
 
             // Print statistics
             if (loop_start - stats_timer >= stats_interval) {
-                const auto& stats = market_generator->get_statistics();
-                auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
-                    loop_start - stats.start_time)
-                                   .count();
+                auto stats = parallel_generator ? parallel_generator->get_statistics()
+                                                : market_generator->get_statistics();
+                auto rate = scheduler.get_statistics();
 
                 std::cout << "Stats: " << stats.updates_generated << " updates, "
                           << stats.trades_generated << " trades, "
-                          << stats.quotes_generated << " quotes, "
-                          << stats.snapshots_generated << " snapshots "
-                          << "(" << (elapsed > 0 ? stats.updates_generated / elapsed : 0)
-                          << " updates/sec)\n";
+                          << stats.quotes_generated << " quotes "
+                          << "(" << std::fixed << std::setprecision(1) << rate.achieved_rate
+                          << " of " << rate.target_rate << " updates/sec, jitter "
+                          << std::setprecision(0) << rate.jitter_ns / 1000.0 << "us, max late "
+                          << rate.max_lateness_ns / 1000 << "us)\n";
+
+                for (size_t index = 0; index < publisher->channel_count(); ++index) {
+                    auto& channel = publisher->channel_at(index);
+                    uint64_t packets = channel.adapter()->packets_sent();
+                    auto cycle = snapshot_cycles[index]->get_statistics();
+                    std::cout << "Channel " << channel.channel_id() << ": " << channel.events_published()
+                              << " events, " << packets << " packets";
+                    if (packets > 0) {
+                        std::cout << " (" << std::setprecision(1)
+                                  << static_cast<double>(channel.adapter()->messages_sent()) / packets
+                                  << " messages/packet)";
+                    }
+                    std::cout << ", backlog " << channel.backlog() << "; snapshots: " << cycle.snapshots
+                              << " in " << cycle.cycles << " cycles, last "
+                              << cycle.last_cycle_ns / 1000000 << "ms\n";
+
+                    if (async_send) {
+                        const auto& sender = *async_transports[index];
+                        const auto& latency = sender.send_latency();
+                        std::cout << "  Sender: depth " << sender.queue_depth() << " (max "
+                                  << sender.max_queue_depth() << "), " << sender.backpressure_waits()
+                                  << " back-pressure waits, " << sender.drops() + sender.oversize_drops()
+                                  << " dropped, " << sender.send_failures() << " failed; enqueue-to-send p50 < "
+                                  << latency.percentile(0.5) / 1000 << "us, p99 < "
+                                  << latency.percentile(0.99) / 1000 << "us\n";
+                    }
+                }
 
+                scheduler.reset_statistics();
                 stats_timer = loop_start;
             }
+        }
 
-            // Sleep to maintain update rate
-            auto loop_end = std::chrono::steady_clock::now();
-            auto elapsed = loop_end - loop_start;
-            if (elapsed < update_interval) {
-                std::this_thread::sleep_for(update_interval - elapsed);
-            }
+        for (auto& cycle : snapshot_cycles) {
+            cycle->stop();
+        }
+        publisher->stop();
+        for (auto& sender : async_transports) {
+            sender->stop();
+        }
+        if (replay_server) {
+            replay_server->stop();
         }
 
     } catch (const std::exception& e) {
@@ -1,11 +1,11 @@
 #include "../../core/include/market_data_generator.h"
 #include "../../core/include/order_book_manager.h"
 #include "../../protocols/reuters/include/reuters_protocol_adapter.h"
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <iostream>
 #include <signal.h>
-#include <thread>
 
 std::atomic<bool> running(true);
 
@@ -64,23 +64,46 @@ int main(int argc, char* argv[])
 
         // Initialize Reuters protocol adapter
         uint16_t port = 11501; // Same as sample client
-        if (argc > 1 && std::string(argv[1]) != "--help") {
-            try {
-                port = static_cast<uint16_t>(std::stoi(argv[1]));
-            } catch (const std::exception&) {
-                std::cerr << "Invalid port number: " << argv[1] << std::endl;
-                std::cout << "Usage: " << argv[0] << " [port]" << std::endl;
-                std::cout << "Default port: 11501" << std::endl;
-                return 1;
+        bool io_uring = false;
+        reuters_protocol::SessionOutputQueue::Config output_config;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--help") {
+                std::cout << "Usage: " << argv[0] << " [--io-uring] [--slow-consumer POLICY] [port]" << std::endl;
+                std::cout << "  port: TCP port to listen on (default: 11501)" << std::endl;
+                std::cout << "  --io-uring: send session traffic through io_uring" << std::endl;
+                std::cout << "  --slow-consumer: conflate, drop or disconnect a client whose" << std::endl;
+                std::cout << "                   1MB output queue fills (default: conflate)" << std::endl;
+                std::cout << "  Implements LSEG FX Market Data API over TCP with SBE encoding" << std::endl;
+                return 0;
+            } else if (arg == "--io-uring") {
+                io_uring = true;
+            } else if (arg == "--slow-consumer" && i + 1 < argc) {
+                std::string policy = argv[++i];
+                if (policy == "drop") {
+                    output_config.policy = reuters_protocol::SlowConsumerPolicy::DROP;
+                } else if (policy == "disconnect") {
+                    output_config.policy = reuters_protocol::SlowConsumerPolicy::DISCONNECT;
+                } else if (policy == "conflate") {
+                    output_config.policy = reuters_protocol::SlowConsumerPolicy::CONFLATE;
+                } else {
+                    std::cerr << "Invalid slow-consumer policy: " << policy << std::endl;
+                    return 1;
+                }
+            } else {
+                try {
+                    port = static_cast<uint16_t>(std::stoi(arg));
+                } catch (const std::exception&) {
+                    std::cerr << "Invalid port number: " << arg << std::endl;
+                    std::cout << "Usage: " << argv[0] << " [--io-uring] [port]" << std::endl;
+                    std::cout << "Default port: 11501" << std::endl;
+                    return 1;
+                }
             }
-        } else if (argc > 1 && std::string(argv[1]) == "--help") {
-            std::cout << "Usage: " << argv[0] << " [port]" << std::endl;
-            std::cout << "  port: TCP port to listen on (default: 11501)" << std::endl;
-            std::cout << "  Implements LSEG FX Market Data API over TCP with SBE encoding" << std::endl;
-            return 0;
         }
 
         auto reuters_adapter = std::make_unique<reuters_protocol::ReutersProtocolAdapter>(port);
+        reuters_adapter->set_output_config(output_config);
 
         // Connect market data generator to Reuters adapter
         // Convert raw pointer to shared_ptr for listener management
@@ -92,10 +115,14 @@ int main(int argc, char* argv[])
             std::cerr << "Failed to initialize Reuters server on port " << port << std::endl;
             return 1;
         }
+        if (io_uring && !reuters_shared->enable_io_uring()) {
+            std::cerr << "io_uring unavailable, sending with send()" << std::endl;
+        }
 
         std::cout << "Reuters server listening on port " << port << std::endl;
         std::cout << "Protocol: TCP with LSEG FX Market Data API (SBE)" << std::endl;
         std::cout << "Market data: Real-time FX quotes and trades" << std::endl;
+        std::cout << "Session I/O: " << (reuters_shared->io_uring_enabled() ? "io_uring" : "send()") << std::endl;
         std::cout << "Press Ctrl+C to shutdown" << std::endl;
         std::cout << std::endl;
 
@@ -106,8 +133,9 @@ int main(int argc, char* argv[])
         while (running) {
             auto now = std::chrono::steady_clock::now();
 
-            // Process Reuters protocol (TCP connections, sessions, messages)
-            reuters_shared->run_once();
+            // Process Reuters protocol (TCP connections, sessions, messages),
+            // waiting up to 1ms for socket events instead of sleeping
+            reuters_shared->run_once(1);
 
             // Generate market data updates every 100ms
             if (std::chrono::duration_cast<std::chrono::milliseconds>(now - last_market_update).count() >= 100) {
@@ -127,11 +155,22 @@ int main(int argc, char* argv[])
                           << ", Events=" << stats.market_events_processed
                           << std::endl;
 
+                // Slowest clients by output backlog
+                size_t backlogged = 0;
+                size_t deepest = 0;
+                for (const auto& queue : reuters_shared->get_session_queue_stats()) {
+                    backlogged += queue.depth > 0;
+                    deepest = std::max(deepest, queue.queued_bytes);
+                }
+                if (backlogged > 0 || stats.messages_dropped > 0 || stats.slow_consumer_disconnects > 0) {
+                    std::cout << "  Slow consumers: " << backlogged << " backlogged (deepest " << deepest
+                              << " bytes), " << stats.messages_conflated << " conflated, "
+                              << stats.messages_dropped << " dropped, " << stats.slow_consumer_disconnects
+                              << " disconnected" << std::endl;
+                }
+
                 last_stats_print = now;
             }
-
-            // Small sleep to prevent busy waiting
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
 
         std::cout << "\nShutting down Reuters server..." << std::endl;
@@ -1,9 +1,11 @@
 #include "../../core/include/market_data_generator.h"
 #include "../../core/include/order_book_manager.h"
+#include "../../core/include/rate_scheduler.h"
 #include "../../protocols/reuters/include/reuters_protocol_adapter.h"
 #include <atomic>
 #include <chrono>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <signal.h>
 #include <thread>
@@ -192,6 +194,11 @@ int main(int argc, char* argv[])
             tcp_port = static_cast<uint16_t>(std::stoi(argv[2]));
         }
 
+        // Optional conflation interval in milliseconds (0 = every update)
+        if (argc > 3) {
+            multicast_config.conflation_interval_ms = static_cast<uint32_t>(std::stoul(argv[3]));
+        }
+
         auto reuters_adapter = std::make_unique<reuters_protocol::ReutersProtocolAdapter>(tcp_port, multicast_config);
 
         // Convert to shared_ptr for listener management
@@ -215,6 +222,9 @@ int main(int argc, char* argv[])
                   << ":" << multicast_config.security_definition_feed.port << std::endl;
         std::cout << "  Snapshots:     " << multicast_config.snapshot_feed.multicast_ip
                   << ":" << multicast_config.snapshot_feed.port << std::endl;
+        if (multicast_config.conflation_interval_ms > 0) {
+            std::cout << "  Conflation:    " << multicast_config.conflation_interval_ms << "ms" << std::endl;
+        }
         std::cout << "\nChannel-specific feeds:" << std::endl;
         std::cout << "  Channel 1 (Major): 239.100.2.1-2:15101-15102" << std::endl;
         std::cout << "  Channel 2 (Commodity): 239.100.3.1-2:15201-15202" << std::endl;
@@ -223,33 +233,31 @@ int main(int argc, char* argv[])
                   << std::endl;
 
         // Main server loop
-        auto last_market_update = std::chrono::steady_clock::now();
         auto last_stats_print = std::chrono::steady_clock::now();
         auto last_snapshot = std::chrono::steady_clock::now();
 
-        while (running) {
-            auto now = std::chrono::steady_clock::now();
+        // Two instrument updates per incremental interval, paced by the
+        // scheduler instead of a fixed 1ms sleep
+        market_core::RateScheduler::Config rate_config;
+        rate_config.target_rate = 2000.0 / std::max<uint32_t>(multicast_config.incremental_interval_ms, 1);
+        market_core::RateScheduler scheduler(rate_config);
+
+        auto instrument_ids = book_manager->get_all_instrument_ids();
+        std::mt19937 instrument_rng(std::random_device {}());
+        std::uniform_int_distribution<size_t> instrument_dist(0, instrument_ids.empty() ? 0 : instrument_ids.size() - 1);
 
+        while (running) {
             // Process Reuters protocol (TCP connections, sessions)
             reuters_shared->run_once();
 
-            // Generate market data updates (reduced frequency)
-            if (std::chrono::duration_cast<std::chrono::milliseconds>(now - last_market_update).count() >= multicast_config.incremental_interval_ms) {
-                // Generate updates for only 1-2 instruments at a time instead of all 7
-                auto instrument_ids = book_manager->get_all_instrument_ids();
-                if (!instrument_ids.empty()) {
-                    // Pick 2 random instruments per update cycle
-                    auto time_seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-                    std::default_random_engine generator(time_seed);
-                    std::shuffle(instrument_ids.begin(), instrument_ids.end(), generator);
-                    
-                    for (size_t i = 0; i < std::min(size_t(2), instrument_ids.size()); ++i) {
-                        data_generator->generate_update(instrument_ids[i]);
-                    }
-                }
-                last_market_update = now;
+            // Generate the market data updates that are due
+            size_t due = scheduler.poll();
+            for (size_t i = 0; i < due && !instrument_ids.empty(); ++i) {
+                data_generator->generate_update(instrument_ids[instrument_dist(instrument_rng)]);
             }
 
+            auto now = std::chrono::steady_clock::now();
+
             // Generate snapshots periodically
             if (std::chrono::duration_cast<std::chrono::seconds>(now - last_snapshot).count() >= multicast_config.snapshot_interval_seconds) {
                 // Trigger snapshot generation for all instruments
@@ -292,18 +300,31 @@ int main(int argc, char* argv[])
                 const auto& stats = reuters_shared->get_statistics();
                 auto uptime = std::chrono::duration_cast<std::chrono::seconds>(now - stats.start_time).count();
 
+                auto rate = scheduler.get_statistics();
+
                 std::cout << "Stats [" << uptime << "s]: "
                           << "Sessions=" << stats.sessions_created
                           << ", Sent=" << stats.messages_sent
                           << ", Recv=" << stats.messages_received
                           << ", Events=" << stats.market_events_processed
+                          << ", Rate=" << std::fixed << std::setprecision(1) << rate.achieved_rate
+                          << "/" << rate.target_rate << " per sec"
                           << std::endl;
 
+                if (multicast_config.conflation_interval_ms > 0 && reuters_shared->multicast_publisher()) {
+                    const auto& publisher = reuters_shared->multicast_publisher()->get_statistics();
+                    std::cout << "  Conflation: intervals=" << publisher.conflation_intervals
+                              << ", conflated=" << publisher.quotes_conflated
+                              << ", packets=" << publisher.messages_sent_a << std::endl;
+                }
+
+                scheduler.reset_statistics();
                 last_stats_print = now;
             }
 
-            // Small sleep to prevent busy waiting
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            // Sleep until the next update is due, still polling sessions
+            // at least every millisecond
+            scheduler.wait_next(std::chrono::milliseconds(1));
         }
 
         std::cout << "\nShutting down Reuters multicast server..." << std::endl;
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace market_core {
+
+// Counter-based random bit generator.
+//
+// Output n of stream (seed, stream_id) is a pure function of the key and n
+// (SplitMix64 finalizer over key + n * gamma), so streams are independent,
+// reproducible, and can be skipped ahead in O(1). Satisfies
+// UniformRandomBitGenerator for use with <random> distributions.
+class CounterRng {
+public:
+    using result_type = uint64_t;
+
+    explicit CounterRng(uint64_t seed = 0, uint64_t stream_id = 0)
+        : key_(derive_key(seed, stream_id))
+    {
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() { return mix(key_ + GAMMA * ++counter_); }
+
+    void discard(uint64_t n) { counter_ += n; }
+    uint64_t counter() const { return counter_; }
+    uint64_t key() const { return key_; }
+
+    // Derive an independent key for a (seed, stream) pair
+    static uint64_t derive_key(uint64_t seed, uint64_t stream_id)
+    {
+        return mix(mix(seed) ^ mix(stream_id + GAMMA));
+    }
+
+private:
+    static constexpr uint64_t GAMMA = 0x9e3779b97f4a7c15ULL;
+
+    uint64_t key_;
+    uint64_t counter_ = 0;
+
+    static uint64_t mix(uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+};
+
+} // namespace market_core
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "market_events.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace market_core {
+
+// Handle to an interned string; 0 means "not set"
+using InternId = uint32_t;
+
+// Process-wide string table so event records can carry market maker IDs,
+// trade IDs and halt reasons as fixed-size handles. Interning takes a lock
+// and is expected on the cold path only (first sighting of a string).
+class StringInterner {
+public:
+    static StringInterner& instance();
+
+    InternId intern(const std::string& value);
+    std::string lookup(InternId id) const; // Empty for 0 or unknown IDs
+    size_t size() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, InternId> ids_;
+    std::vector<std::string> values_ { std::string() }; // Slot 0 reserved
+};
+
+// Per-type payloads of an EventRecord
+
+struct QuoteRecord {
+    double price;
+    uint64_t quantity;
+    uint64_t implied_quantity; // Valid when HAS_IMPLIED_QUANTITY
+    uint32_t order_count;
+    InternId market_maker_id;
+    Side side;
+    UpdateAction action;
+    uint8_t price_level; // Valid when HAS_PRICE_LEVEL
+};
+
+struct TradeRecord {
+    double price;
+    uint64_t quantity;
+    InternId trade_id;
+    Side aggressor_side; // Valid when HAS_AGGRESSOR_SIDE
+};
+
+struct OrderRecord {
+    uint64_t order_id;
+    uint64_t priority;
+    double price;
+    uint64_t quantity;
+    Side side;
+    UpdateAction action;
+};
+
+struct StatisticsRecord {
+    double value;
+    uint64_t volume; // Valid when HAS_VOLUME
+    StatisticsEvent::StatType stat_type;
+};
+
+struct StatusRecord {
+    StatusEvent::Status status;
+    InternId halt_reason;
+};
+
+// Compact, trivially-copyable market event.
+//
+// A tagged union over the incremental event types, sized to one cache line,
+// so the generator -> book -> listener path can pass events by reference or
+// in contiguous batches without touching the heap. Optional fields of the
+// MarketEvent classes become presence flags; strings become InternIds.
+// Snapshots stay on the MarketEvent path since they are variable-sized.
+struct EventRecord {
+    enum Flags : uint8_t {
+        HAS_PRICE_LEVEL = 1 << 0,
+        HAS_RPT_SEQ = 1 << 1,
+        HAS_IMPLIED_QUANTITY = 1 << 2,
+        HAS_AGGRESSOR_SIDE = 1 << 3,
+        HAS_VOLUME = 1 << 4
+    };
+
+    MarketEvent::EventType type;
+    uint8_t flags;
+    uint32_t instrument_id;
+    uint64_t timestamp_ns;
+    uint32_t sequence_number;
+    uint32_t rpt_seq; // Valid when HAS_RPT_SEQ
+
+    union {
+        QuoteRecord quote;
+        TradeRecord trade;
+        OrderRecord order;
+        StatisticsRecord statistics;
+        StatusRecord status;
+    };
+
+    bool has(Flags flag) const { return (flags & flag) != 0; }
+    void set(Flags flag) { flags |= flag; }
+
+    // Zero-initialized record of the given type
+    static EventRecord make(MarketEvent::EventType type, uint32_t instrument_id)
+    {
+        EventRecord record {};
+        record.type = type;
+        record.instrument_id = instrument_id;
+        return record;
+    }
+};
+
+static_assert(std::is_trivially_copyable<EventRecord>::value, "EventRecord must be trivially copyable");
+static_assert(sizeof(EventRecord) <= 64, "EventRecord must fit in a cache line");
+
+// Non-owning view over contiguous records (stand-in for std::span)
+class EventRecordSpan {
+public:
+    EventRecordSpan() = default;
+    EventRecordSpan(const EventRecord* data, size_t size)
+        : data_(data)
+        , size_(size)
+    {
+    }
+
+    const EventRecord* begin() const { return data_; }
+    const EventRecord* end() const { return data_ + size_; }
+    const EventRecord& operator[](size_t i) const { return data_[i]; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    const EventRecord* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Conversion to and from the MarketEvent hierarchy. to_record returns false
+// for event types without a record form (SNAPSHOT, IMBALANCE); strings are
+// interned. to_market_event allocates and is meant for legacy consumers.
+bool to_record(const MarketEvent& event, EventRecord& record);
+std::shared_ptr<MarketEvent> to_market_event(const EventRecord& record);
+
+// Stack-constructible views for code that takes the class types by reference
+QuoteEvent to_quote_event(const EventRecord& record);
+TradeEvent to_trade_event(const EventRecord& record);
+OrderEvent to_order_event(const EventRecord& record);
+StatisticsEvent to_statistics_event(const EventRecord& record);
+StatusEvent to_status_event(const EventRecord& record);
+
+} // namespace market_core
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "counter_rng.h"
+#include "event_record.h"
 #include "instrument.h"
 #include "market_events.h"
 #include "order_book_manager.h"
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <memory>
@@ -33,6 +36,9 @@ struct MarketConfig {
     double book_depth_target = 5; // Target number of levels per side
     bool generate_implied = false; // Generate implied prices (CME)
     bool generate_statistics = true; // Generate OHLC stats
+    size_t max_batch_events = 256; // Events per listener batch in generate_batch
+    uint64_t simulated_clock_start_ns = 0; // First simulated timestamp
+    uint64_t simulated_clock_step_ns = 0; // Non-zero replaces wall-clock timestamps
 };
 
 // Event listener interface
@@ -42,10 +48,56 @@ public:
     virtual void on_market_event(const std::shared_ptr<MarketEvent>& event) = 0;
 };
 
+// Allocation-free listener interface. The record is only valid for the
+// duration of the call.
+class IEventRecordListener {
+public:
+    virtual ~IEventRecordListener() = default;
+    virtual void on_event_record(const EventRecord& record) = 0;
+
+    // Batch delivery from generate_batch/generate_all_instruments. Records
+    // are already applied to the books, in generation order.
+    virtual void on_market_events(EventRecordSpan records)
+    {
+        for (const auto& record : records) {
+            on_event_record(record);
+        }
+    }
+};
+
+// Bridges records to an IMarketEventListener that has not migrated yet by
+// materializing a MarketEvent per record (one allocation per event)
+class MarketEventListenerAdapter : public IEventRecordListener {
+public:
+    explicit MarketEventListenerAdapter(std::weak_ptr<IMarketEventListener> target)
+        : target_(std::move(target))
+    {
+    }
+
+    void on_event_record(const EventRecord& record) override
+    {
+        if (auto target = target_.lock()) {
+            if (auto event = to_market_event(record)) {
+                target->on_market_event(event);
+            }
+        }
+    }
+
+    bool expired() const { return target_.expired(); }
+    bool wraps(const std::shared_ptr<IMarketEventListener>& listener) const { return target_.lock() == listener; }
+
+private:
+    std::weak_ptr<IMarketEventListener> target_;
+};
+
 // Market data generator - protocol agnostic
 class MarketDataGenerator {
 public:
     MarketDataGenerator(std::shared_ptr<OrderBookManager> book_manager);
+
+    // Reproducible generation: the same seed and stream yield the same
+    // event sequence (given a simulated clock for timestamps)
+    MarketDataGenerator(std::shared_ptr<OrderBookManager> book_manager, uint64_t seed, uint64_t stream_id = 0);
     ~MarketDataGenerator() = default;
 
     // Configuration
@@ -55,6 +107,15 @@ public:
     // Set market mode presets
     void set_market_mode(MarketMode mode);
 
+    // Restrict generate_batch/generate_all_instruments to a subset of
+    // instruments (empty = every instrument in the manager)
+    void set_instruments(std::vector<uint32_t> instrument_ids) { instrument_ids_ = std::move(instrument_ids); }
+    const std::vector<uint32_t>& get_instruments() const { return instrument_ids_; }
+
+    // First order id handed out by MBO generation; generators sharing a
+    // manager need disjoint ranges
+    void set_order_id_base(uint64_t base) { next_order_id_ = base; }
+
     // Event generation
     void generate_update(uint32_t instrument_id);
     void generate_batch(int count);
@@ -63,12 +124,17 @@ public:
     // Specific event generation
     std::shared_ptr<QuoteEvent> generate_quote(uint32_t instrument_id);
     std::shared_ptr<TradeEvent> generate_trade(uint32_t instrument_id);
+    std::shared_ptr<OrderEvent> generate_order(uint32_t instrument_id); // MBO books only
     std::shared_ptr<StatisticsEvent> generate_statistics(uint32_t instrument_id);
     std::shared_ptr<SnapshotEvent> generate_snapshot(uint32_t instrument_id);
 
-    // Event listeners (protocols register here)
+    // Event listeners (protocols register here). Listeners that also
+    // implement IEventRecordListener receive records directly; others are
+    // wrapped in a MarketEventListenerAdapter.
     void add_listener(std::weak_ptr<IMarketEventListener> listener);
+    void add_record_listener(std::weak_ptr<IEventRecordListener> listener);
     void remove_listener(std::shared_ptr<IMarketEventListener> listener);
+    void remove_record_listener(std::shared_ptr<IEventRecordListener> listener);
     void clear_listeners();
 
     // Statistics
@@ -76,6 +142,7 @@ public:
         uint64_t updates_generated = 0;
         uint64_t trades_generated = 0;
         uint64_t quotes_generated = 0;
+        uint64_t orders_generated = 0;
         uint64_t snapshots_generated = 0;
         std::chrono::steady_clock::time_point start_time;
     };
@@ -87,12 +154,31 @@ private:
     MarketConfig config_;
     Statistics stats_;
 
-    // Event listeners
-    std::vector<std::weak_ptr<IMarketEventListener>> listeners_;
-    std::mutex listeners_mutex_;
+    // Event listeners; adapter is set (and keeps the wrapper alive) for
+    // legacy listeners
+    struct ListenerEntry {
+        std::weak_ptr<IEventRecordListener> listener;
+        std::shared_ptr<MarketEventListenerAdapter> adapter;
+    };
+
+    // Copy-on-write listener list: dispatch reads the current version
+    // without locking, registration publishes a new one. Old versions are
+    // kept alive since a dispatch may still be walking them.
+    struct ListenerList {
+        std::vector<ListenerEntry> entries;
+    };
+    std::atomic<const ListenerList*> listeners_ { nullptr };
+    std::vector<std::unique_ptr<const ListenerList>> listener_lists_;
+    std::mutex listeners_mutex_; // Serializes registration only
+
+    // Reused between batches
+    std::vector<EventRecord> batch_buffer_;
+
+    // Instrument subset, empty for all
+    std::vector<uint32_t> instrument_ids_;
 
     // Random number generation
-    std::mt19937 rng_;
+    CounterRng rng_;
     std::uniform_real_distribution<> uniform_dist_ { 0.0, 1.0 };
     std::normal_distribution<> normal_dist_ { 0.0, 1.0 };
     std::poisson_distribution<> poisson_dist_ { 3 };
@@ -100,8 +186,27 @@ private:
     // Sequence tracking
     std::unordered_map<uint32_t, uint32_t> instrument_sequences_;
 
+    // Order-level generation state (shared across instruments)
+    uint64_t next_order_id_ = 1;
+    uint64_t next_order_priority_ = 1;
+
+    // Simulated clock ticks handed out so far
+    uint64_t clock_ticks_ = 0;
+
+    // Record builders; return false when the book can't support the event
+    bool build_quote(const Instrument& instrument, const OrderBook& book, EventRecord& record);
+    bool build_trade(const Instrument& instrument, const OrderBook& book, EventRecord& record);
+    bool build_order(const Instrument& instrument, const OrderBook& book, EventRecord& record);
+    void build_statistics(const OrderBook& book, EventRecord& record);
+
+    // Generate one event for the instrument and apply it to its book
+    bool next_record(uint32_t instrument_id, EventRecord& record);
+
     // Helper methods
-    void notify_listeners(const std::shared_ptr<MarketEvent>& event);
+    std::vector<uint32_t> target_instruments() const;
+    uint64_t next_timestamp();
+    void dispatch(EventRecordSpan records);
+    void publish_listeners(std::vector<ListenerEntry> entries); // Caller holds listeners_mutex_
     double calculate_price_movement(double current_price, const Instrument& instrument);
     uint64_t calculate_quantity(const Instrument& instrument);
     bool should_generate_trade();
@@ -13,13 +13,13 @@ class Instrument;
 class OrderBook;
 
 // Common types across all protocols
-enum class Side {
+enum class Side : uint8_t {
     BID,
     ASK,
     NONE
 };
 
-enum class UpdateAction {
+enum class UpdateAction : uint8_t {
     ADD,
     CHANGE,
     DELETE,
@@ -40,14 +40,15 @@ enum class InstrumentType {
 // Base market event
 class MarketEvent {
 public:
-    enum EventType {
+    enum EventType : uint8_t {
         QUOTE_UPDATE,
         TRADE,
         BOOK_CLEAR,
         STATISTICS,
         STATUS_CHANGE,
         SNAPSHOT,
-        IMBALANCE
+        IMBALANCE,
+        ORDER_UPDATE
     };
 
     EventType type;
@@ -109,6 +110,30 @@ public:
     }
 };
 
+// Order-level (market-by-order) update event
+class OrderEvent : public MarketEvent {
+public:
+    uint64_t order_id;
+    Side side;
+    double price;
+    uint64_t quantity; // Remaining displayed quantity
+    UpdateAction action; // ADD, CHANGE or DELETE
+    uint64_t priority; // Queue priority, lower is earlier
+
+    std::optional<uint32_t> rpt_seq;
+
+    OrderEvent(uint32_t instrument_id)
+        : MarketEvent(EventType::ORDER_UPDATE, instrument_id)
+        , order_id(0)
+        , side(Side::BID)
+        , price(0.0)
+        , quantity(0)
+        , action(UpdateAction::ADD)
+        , priority(0)
+    {
+    }
+};
+
 // Statistics event (OHLC, settlement, etc.)
 class StatisticsEvent : public MarketEvent {
 public:
@@ -143,6 +168,10 @@ public:
     std::optional<uint64_t> total_volume;
     std::optional<uint32_t> rpt_seq;
 
+    // Resting orders, best level first and FIFO within a level.
+    // Only populated for books that keep order-level detail.
+    std::vector<OrderEvent> orders;
+
     SnapshotEvent(uint32_t instrument_id)
         : MarketEvent(EventType::SNAPSHOT, instrument_id)
     {
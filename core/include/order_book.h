@@ -1,6 +1,9 @@
 #pragma once
 
+#include "event_record.h"
 #include "market_events.h"
+#include "order_level_book.h"
+#include "price_ladder.h"
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -55,9 +58,11 @@ public:
     OrderBook(uint32_t instrument_id, const std::string& symbol);
     ~OrderBook() = default;
 
-    // Core order book operations
-    void add_level(Side side, const PriceLevel& level);
-    void update_level(Side side, const PriceLevel& level);
+    // Core order book operations. Adds and updates return false, leaving
+    // the book unchanged, when tick ladder storage refuses the price (more
+    // than PriceLadder::MAX_CAPACITY ticks from the rest of its side).
+    bool add_level(Side side, const PriceLevel& level);
+    bool update_level(Side side, const PriceLevel& level);
     void remove_level(Side side, double price);
     void clear_side(Side side);
     void clear();
@@ -86,26 +91,54 @@ public:
 
     // State queries
     bool is_crossed() const;
-    size_t bid_depth() const { return bids_.size(); }
-    size_t ask_depth() const { return asks_.size(); }
-    bool is_empty() const { return bids_.empty() && asks_.empty(); }
+    size_t bid_depth() const;
+    size_t ask_depth() const;
+    bool is_empty() const { return bid_depth() == 0 && ask_depth() == 0; }
+
+    // Level storage backing the book
+    enum class Storage {
+        PRICE_MAP, // std::map keyed on price
+        TICK_LADDER // Flat array indexed by tick offset (see PriceLadder)
+    };
 
     // Configuration for different protocols
     struct Config {
         size_t max_visible_levels = 10; // How many levels to maintain
         bool maintain_implied_prices = false; // For CME
         bool track_market_makers = false; // For Reuters
-        bool aggregate_by_price = true; // Aggregate orders at same price
+        bool aggregate_by_price = true; // false = keep order-level (MBO) detail
+
+        Storage storage = Storage::PRICE_MAP;
+        double tick_size = 0.0; // Ladder tick; 0 = use Instrument::tick_size
+        size_t ladder_capacity = PriceLadder::DEFAULT_CAPACITY; // Initial ticks per side
     };
 
-    void set_config(const Config& config) { config_ = config; }
+    // Switching storage migrates any existing levels.
+    // The tick ladder does not retain market_maker_id. Returns false,
+    // keeping the old configuration, if the ladder cannot hold every level.
+    // Turning off aggregate_by_price adds an empty order-level book whose
+    // aggregated levels then drive the price levels.
+    bool set_config(const Config& config);
+
+    // Order-level view; null when the book only aggregates by price
+    const OrderLevelBook* get_order_level_book() const { return orders_.get(); }
+    std::vector<OrderEntry> get_orders(Side side, size_t max_levels = SIZE_MAX) const;
     const Config& get_config() const { return config_; }
 
     // Generate snapshot event from current state
     std::shared_ptr<SnapshotEvent> create_snapshot_event(size_t max_levels = SIZE_MAX) const;
 
-    // Apply an event to the book
-    void apply_event(const std::shared_ptr<MarketEvent>& event);
+    // Same, into a caller-owned event whose vectors are reused
+    void fill_snapshot_event(SnapshotEvent& snapshot, size_t max_levels = SIZE_MAX) const;
+
+    // Per-instrument sequence (rpt_seq, else sequence_number) of the last
+    // applied event; snapshots carry it as their rpt_seq
+    uint32_t last_sequence() const { return last_sequence_; }
+
+    // Apply an event to the book; false if the book refused it (see
+    // add_level and OrderLevelBook::add_order)
+    bool apply_event(const std::shared_ptr<MarketEvent>& event);
+    bool apply_record(const EventRecord& record);
 
 private:
     uint32_t instrument_id_;
@@ -116,13 +149,24 @@ private:
     std::map<double, PriceLevel, std::greater<double>> bids_; // Descending
     std::map<double, PriceLevel> asks_; // Ascending
 
+    // Tick-indexed storage, allocated when config_.storage == TICK_LADDER
+    std::unique_ptr<PriceLadder> bid_ladder_;
+    std::unique_ptr<PriceLadder> ask_ladder_;
+
+    // Market-by-order detail, allocated when !config_.aggregate_by_price
+    std::unique_ptr<OrderLevelBook> orders_;
+
     std::vector<Trade> recent_trades_;
     MarketStats stats_;
+    uint32_t last_sequence_ = 0;
 
     // Helper methods
     void update_stats_on_trade(const Trade& trade);
-    void apply_quote_event(const QuoteEvent& quote);
+    bool apply_quote_event(const QuoteEvent& quote);
     void apply_trade_event(const TradeEvent& trade);
+    bool apply_level_update(Side side, const PriceLevel& level, UpdateAction action);
+    bool apply_order_update(const OrderRecord& order, uint64_t timestamp_ns);
+    bool sync_level_from_orders(Side side, double price, uint64_t timestamp_ns);
 };
 
 } // namespace market_core
\ No newline at end of file
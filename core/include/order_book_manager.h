@@ -2,18 +2,29 @@
 
 #include "instrument.h"
 #include "order_book.h"
+#include <atomic>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 #include <vector>
 
 namespace market_core {
 
-// Manages multiple order books and instruments
+// Manages multiple order books and instruments.
+//
+// Books are hashed to lock-striped shards, so applying an event or taking a
+// snapshot only serializes against other instruments in the same shard. The
+// instrument/book registry is copy-on-write behind an atomic pointer: lookups
+// never take a lock, and writers (add_instrument, create_order_book, resets)
+// serialize on a separate registry mutex.
 class OrderBookManager {
 public:
-    OrderBookManager() = default;
-    ~OrderBookManager() = default;
+    static constexpr size_t DEFAULT_SHARD_COUNT = 64;
+
+    explicit OrderBookManager(size_t shard_count = DEFAULT_SHARD_COUNT);
+    ~OrderBookManager();
+
+    OrderBookManager(const OrderBookManager&) = delete;
+    OrderBookManager& operator=(const OrderBookManager&) = delete;
 
     // Instrument management
     bool add_instrument(std::shared_ptr<Instrument> instrument);
@@ -35,27 +46,77 @@ public:
     // Bulk operations
     void clear_all_books();
     void reset_all_books();
-    size_t instrument_count() const { return instruments_.size(); }
-    size_t book_count() const { return order_books_.size(); }
+    size_t instrument_count() const { return instrument_count_.load(std::memory_order_relaxed); }
+    size_t book_count() const { return book_count_.load(std::memory_order_relaxed); }
+    size_t shard_count() const { return shard_count_; }
 
-    // Thread-safe event application
-    void apply_event(const std::shared_ptr<MarketEvent>& event);
+    // Thread-safe event application; locks only the instrument's shard.
+    // False if the book refused the event; events without a book are ignored.
+    bool apply_event(const std::shared_ptr<MarketEvent>& event);
+    bool apply_record(const EventRecord& record);
 
     // Generate events
     std::shared_ptr<SnapshotEvent> create_snapshot(
         uint32_t instrument_id,
         size_t max_levels = SIZE_MAX) const;
 
+    // Copy a book's top max_levels into a reused event. The shard lock is
+    // held only for the copy, so encoding the snapshot never blocks
+    // apply_record. False when the instrument has no book.
+    bool capture_snapshot(
+        uint32_t instrument_id,
+        SnapshotEvent& snapshot,
+        size_t max_levels = SIZE_MAX) const;
+
 private:
-    // Thread safety
-    mutable std::mutex mutex_;
+    // Immutable once published; replaced wholesale when its book changes
+    struct Entry {
+        uint32_t instrument_id;
+        uint32_t shard;
+        std::shared_ptr<Instrument> instrument;
+        std::shared_ptr<OrderBook> book;
+    };
+
+    // Open-addressed table of entry pointers. Slots are only ever filled or
+    // swapped for a newer entry for the same ID, so readers can probe without
+    // locking. Grows by publishing a new table.
+    struct Registry {
+        std::unique_ptr<std::atomic<const Entry*>[]> slots;
+        size_t mask;
+        size_t size = 0;
+
+        explicit Registry(size_t capacity);
+        const Entry* find(uint32_t instrument_id) const;
+        std::atomic<const Entry*>* slot_for(uint32_t instrument_id);
+    };
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+    };
+
+    size_t shard_count_;
+    std::unique_ptr<Shard[]> shards_;
+
+    std::atomic<Registry*> registry_;
+    std::mutex registry_mutex_;
+
+    // Superseded tables and entries; readers may still hold pointers to
+    // them, so they are kept until destruction. Growth is bounded by
+    // table doubling and one entry per book change.
+    std::vector<std::unique_ptr<Registry>> retired_registries_;
+    std::vector<std::unique_ptr<const Entry>> entries_;
+
+    std::atomic<size_t> instrument_count_ { 0 };
+    std::atomic<size_t> book_count_ { 0 };
 
-    // Instrument and order book storage
-    std::unordered_map<uint32_t, std::shared_ptr<Instrument>> instruments_;
-    std::unordered_map<uint32_t, std::shared_ptr<OrderBook>> order_books_;
+    static size_t hash(uint32_t instrument_id);
+    const Entry* find_entry(uint32_t instrument_id) const;
+    Shard& shard_for(const Entry& entry) const { return shards_[entry.shard]; }
 
-    // Helper to ensure instrument exists before creating book
-    bool validate_instrument(uint32_t instrument_id) const;
+    // Caller holds registry_mutex_
+    void publish_entry(Entry entry);
+    template <typename Fn>
+    void for_each_entry(Fn&& fn) const;
 };
 
-} // namespace market_core
\ No newline at end of file
+} // namespace market_core
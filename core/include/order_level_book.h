@@ -0,0 +1,165 @@
+#pragma once
+
+#include "market_events.h"
+#include "price_ladder.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace market_core {
+
+struct PriceLevel;
+
+// Open-addressing hash from a 64-bit key to a 32-bit slot index.
+// Linear probing with backward-shift deletion, so there are no tombstones
+// and lookups stay short under heavy add/cancel churn.
+class FlatIndex {
+public:
+    static constexpr uint32_t NPOS = UINT32_MAX;
+
+    explicit FlatIndex(size_t capacity = 1024);
+
+    uint32_t find(uint64_t key) const;
+    void insert(uint64_t key, uint32_t value); // key must not be present
+    bool erase(uint64_t key);
+    void clear();
+    size_t size() const { return size_; }
+
+private:
+    struct Entry {
+        uint64_t key;
+        uint32_t value; // NPOS marks an empty bucket
+    };
+
+    std::vector<Entry> table_;
+    size_t mask_;
+    size_t size_ = 0;
+
+    static size_t hash(uint64_t key)
+    {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return static_cast<size_t>(key);
+    }
+
+    void grow();
+};
+
+// Resting order as exposed to callers
+struct OrderEntry {
+    uint64_t order_id;
+    Side side;
+    double price;
+    uint64_t quantity;
+    uint64_t priority;
+    uint64_t timestamp_ns;
+};
+
+// Market-by-order book.
+//
+// Orders live in a pooled node array and are found by ID through a FlatIndex.
+// Each price level is an intrusive doubly-linked FIFO through the nodes, so
+// add, modify and cancel are O(1) and allocate nothing once the pools have
+// grown to the working set. An aggregated PriceLadder per side provides the
+// sorted price view and best prices.
+class OrderLevelBook {
+public:
+    OrderLevelBook(double tick_size, size_t expected_orders = 4096);
+
+    // Returns false if the order ID already exists, or if its level could
+    // not be stored (see PriceLadder::MAX_CAPACITY); the book is then unchanged
+    bool add_order(uint64_t order_id, Side side, double price, uint64_t quantity,
+        uint64_t priority, uint64_t timestamp_ns);
+
+    // Price change or quantity increase moves the order to the back of the queue
+    // with the new priority; a quantity decrease keeps its place. A new price
+    // whose level could not be stored is refused, leaving the order as it was.
+    bool modify_order(uint64_t order_id, double price, uint64_t quantity,
+        uint64_t priority, uint64_t timestamp_ns);
+
+    bool cancel_order(uint64_t order_id);
+
+    // Reduce quantity by a fill; removes the order when fully filled
+    bool fill_order(uint64_t order_id, uint64_t quantity);
+
+    void clear();
+
+    std::optional<OrderEntry> find_order(uint64_t order_id) const;
+    size_t order_count() const { return live_orders_.size(); }
+    size_t level_count(Side side) const;
+
+    // ID of the n-th live order (modulo count) for random selection
+    uint64_t order_id_at(size_t n) const { return nodes_[live_orders_[n % live_orders_.size()]].order_id; }
+
+    std::optional<double> best_price(Side side) const;
+
+    // Aggregated levels, best first
+    std::vector<PriceLevel> get_levels(Side side, size_t max_levels = SIZE_MAX) const;
+    std::optional<PriceLevel> get_level(Side side, double price) const;
+
+    // Orders best level first, FIFO within a level
+    std::vector<OrderEntry> get_orders(Side side, size_t max_levels = SIZE_MAX) const;
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct OrderNode {
+        uint64_t order_id;
+        uint64_t quantity;
+        uint64_t priority;
+        uint64_t timestamp_ns;
+        double price;
+        uint32_t prev;
+        uint32_t next; // Doubles as free-list link when not live
+        uint32_t level;
+        uint32_t live_pos; // Position in live_orders_
+        Side side;
+    };
+
+    struct LevelQueue {
+        double price;
+        int64_t tick;
+        uint64_t total_quantity;
+        uint32_t order_count;
+        uint32_t head;
+        uint32_t tail; // Doubles as free-list link when not in use
+        Side side;
+    };
+
+    double tick_size_;
+
+    std::vector<OrderNode> nodes_;
+    uint32_t free_node_ = NIL;
+    std::vector<uint32_t> live_orders_;
+    FlatIndex order_index_;
+
+    std::vector<LevelQueue> levels_;
+    uint32_t free_level_ = NIL;
+    FlatIndex bid_level_index_;
+    FlatIndex ask_level_index_;
+
+    PriceLadder bid_ladder_;
+    PriceLadder ask_ladder_;
+
+    // False for prices whose tick does not fit an int64_t exactly
+    bool to_tick(double price, int64_t& tick) const;
+    FlatIndex& level_index(Side side) { return side == Side::BID ? bid_level_index_ : ask_level_index_; }
+    const FlatIndex& level_index(Side side) const { return side == Side::BID ? bid_level_index_ : ask_level_index_; }
+    PriceLadder& ladder(Side side) { return side == Side::BID ? bid_ladder_ : ask_ladder_; }
+    const PriceLadder& ladder(Side side) const { return side == Side::BID ? bid_ladder_ : ask_ladder_; }
+
+    uint32_t allocate_node();
+    void release_node(uint32_t idx);
+    uint32_t find_or_create_level(Side side, double price);
+    void release_level(uint32_t idx);
+
+    void link_back(uint32_t level_idx, uint32_t node_idx);
+    void unlink(uint32_t node_idx);
+    void publish_level(uint32_t level_idx);
+
+    OrderEntry to_entry(const OrderNode& node) const;
+};
+
+} // namespace market_core
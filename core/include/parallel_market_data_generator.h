@@ -0,0 +1,77 @@
+#pragma once
+
+#include "market_data_generator.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace market_core {
+
+// Multi-threaded market data generation.
+//
+// Instruments are sorted by ID and dealt round-robin to one
+// MarketDataGenerator shard per worker thread. Each shard draws from its own
+// CounterRng stream derived from (seed, shard index), owns a disjoint order
+// ID range and only touches its own books, so for a given seed and thread
+// count every shard produces the same events on every run (use the
+// simulated clock in MarketConfig for identical timestamps too). The
+// interleaving of events across shards is not deterministic.
+class ParallelMarketDataGenerator {
+public:
+    ParallelMarketDataGenerator(
+        std::shared_ptr<OrderBookManager> book_manager,
+        size_t thread_count,
+        uint64_t seed);
+    ~ParallelMarketDataGenerator();
+
+    ParallelMarketDataGenerator(const ParallelMarketDataGenerator&) = delete;
+    ParallelMarketDataGenerator& operator=(const ParallelMarketDataGenerator&) = delete;
+
+    // Configuration, applied to every shard
+    void set_config(const MarketConfig& config);
+    void set_market_mode(MarketMode mode);
+    const MarketConfig& get_config() const { return shards_.front()->get_config(); }
+
+    // Re-deal instruments after the manager's instrument set changed
+    void repartition();
+
+    // Event generation; blocks until every shard is done
+    void generate_batch(int updates_per_thread);
+    void generate_all_instruments();
+
+    // Listeners registered here are called from every worker thread, one
+    // shard at a time. Attach to shard(i) directly for per-shard listeners
+    // that need no serialization.
+    void add_record_listener(std::weak_ptr<IEventRecordListener> listener);
+    void clear_listeners();
+
+    size_t thread_count() const { return shards_.size(); }
+    MarketDataGenerator& shard(size_t index) { return *shards_[index]; }
+
+    // Totals across shards; call between generation calls
+    MarketDataGenerator::Statistics get_statistics() const;
+    void reset_statistics();
+
+private:
+    std::shared_ptr<OrderBookManager> book_manager_;
+    std::vector<std::unique_ptr<MarketDataGenerator>> shards_;
+    std::vector<std::shared_ptr<IEventRecordListener>> forwarders_;
+
+    // Worker pool: run() publishes a task under a new generation number and
+    // waits until every worker has run it against its shard
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable work_done_;
+    std::function<void(MarketDataGenerator&)> task_;
+    uint64_t generation_ = 0;
+    size_t pending_ = 0;
+    bool stopping_ = false;
+
+    void run(std::function<void(MarketDataGenerator&)> task);
+    void worker_loop(size_t index);
+};
+
+} // namespace market_core
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "market_events.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace market_core {
+
+struct PriceLevel;
+
+// One side of a book stored as a flat array of levels indexed by integer
+// tick offset from a moving anchor. Prices are converted to ticks once on
+// entry, so level lookup never compares doubles.
+//
+// Add/change/delete are O(1); best price is cached and, when the best level
+// is removed, the next one is found with a word-at-a-time scan of the
+// occupancy bitmap. When a price falls outside the window the ladder is
+// re-anchored around the occupied range, growing if the range no longer
+// fits, up to MAX_CAPACITY ticks.
+class PriceLadder {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024; // Ticks, rounded up to a multiple of 64
+    static constexpr size_t MAX_CAPACITY = 65536; // Ticks; a wider occupied range is refused
+
+    PriceLadder(Side side, double tick_size, size_t capacity = DEFAULT_CAPACITY);
+
+    // Insert or overwrite the level at level.price. False, leaving the
+    // ladder untouched, if the price would stretch the occupied range past
+    // MAX_CAPACITY ticks.
+    bool set(const PriceLevel& level);
+    // Whether set() would take a level at price
+    bool accepts(double price) const;
+    // Returns false if no level exists at price
+    bool erase(double price);
+    void clear();
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    std::optional<double> best_price() const;
+
+    // Levels from best to worst
+    std::vector<PriceLevel> levels(size_t max_levels = SIZE_MAX) const;
+
+    // Introspection for tests and diagnostics
+    double tick_size() const { return tick_size_; }
+    size_t capacity() const { return capacity_; }
+    int64_t anchor_tick() const { return anchor_tick_; }
+    uint64_t recenter_count() const { return recenter_count_; }
+
+private:
+    // Hot per-level state; price is kept so callers get back exactly what they stored
+    struct Slot {
+        double price;
+        uint64_t quantity;
+        uint64_t last_update_time;
+        uint64_t implied_quantity;
+        uint32_t order_count;
+        uint8_t level_number;
+        uint8_t flags;
+    };
+
+    static constexpr uint8_t HAS_IMPLIED = 0x01;
+    static constexpr uint8_t HAS_LEVEL_NUMBER = 0x02;
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct AlignedDelete {
+        void operator()(Slot* p) const;
+    };
+    using SlotArray = std::unique_ptr<Slot[], AlignedDelete>;
+
+    Side side_;
+    double tick_size_;
+    size_t capacity_;
+    int64_t anchor_tick_ = 0; // Absolute tick stored at slot 0
+    int64_t best_idx_ = -1; // Slot index of best level, -1 if empty
+    size_t count_ = 0;
+    uint64_t recenter_count_ = 0;
+
+    SlotArray slots_;
+    std::vector<uint64_t> occupied_; // One bit per slot
+
+    static SlotArray allocate_slots(size_t capacity);
+
+    // False for prices whose tick does not fit an int64_t exactly
+    bool to_tick(double price, int64_t& tick) const;
+    bool is_occupied(size_t idx) const { return (occupied_[idx >> 6] >> (idx & 63)) & 1U; }
+    bool better(int64_t a, int64_t b) const { return side_ == Side::BID ? a > b : a < b; }
+
+    // Nearest occupied slot strictly worse than idx, or -1
+    int64_t next_worse(int64_t idx) const;
+    int64_t highest_below(int64_t idx) const;
+    int64_t lowest_above(int64_t idx) const;
+
+    // Lowest and highest occupied ticks widened to include tick
+    void occupied_range(int64_t tick, int64_t& lo, int64_t& hi) const;
+    bool recenter(int64_t tick);
+    PriceLevel to_level(size_t idx) const;
+};
+
+} // namespace market_core
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "counter_rng.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace market_core {
+
+// Hybrid sleep/busy-spin timer. Sleeps until spin_threshold before the
+// deadline (OS wake-up latency is tens of microseconds), then spins on the
+// steady clock for the remainder.
+class PacingTimer {
+public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::nanoseconds DEFAULT_SPIN_THRESHOLD { 100000 };
+
+    explicit PacingTimer(std::chrono::nanoseconds spin_threshold = DEFAULT_SPIN_THRESHOLD)
+        : spin_threshold_(spin_threshold)
+    {
+    }
+
+    // Returns the time the wait actually ended
+    clock::time_point wait_until(clock::time_point deadline) const;
+
+    std::chrono::nanoseconds spin_threshold() const { return spin_threshold_; }
+
+private:
+    std::chrono::nanoseconds spin_threshold_;
+};
+
+// Token bucket: tokens accrue continuously at `rate` per second up to
+// `burst`. Fractional tokens are kept so low rates stay exact.
+class TokenBucket {
+public:
+    using clock = std::chrono::steady_clock;
+
+    TokenBucket(double rate, double burst, clock::time_point start = clock::now());
+
+    void refill(clock::time_point now);
+    bool try_acquire(double tokens = 1.0);
+    size_t acquire_up_to(size_t max_tokens); // Whole tokens taken
+
+    // Time at which `tokens` will be available, assuming no other takers
+    clock::time_point available_at(double tokens = 1.0) const;
+
+    double tokens() const { return tokens_; }
+    double rate() const { return rate_; }
+    double burst() const { return burst_; }
+
+private:
+    double rate_;
+    double burst_;
+    double tokens_;
+    clock::time_point last_refill_;
+};
+
+// Inter-arrival time distribution for one event source
+class ArrivalProcess {
+public:
+    // Custom sampler returning the next gap in seconds
+    using Sampler = std::function<double(CounterRng&)>;
+
+    static ArrivalProcess fixed(double rate);
+    static ArrivalProcess poisson(double rate);
+    static ArrivalProcess custom(Sampler sampler);
+
+    uint64_t next_interval_ns(CounterRng& rng) const;
+
+private:
+    enum class Kind : uint8_t {
+        FIXED,
+        POISSON,
+        CUSTOM
+    };
+
+    Kind kind_ = Kind::FIXED;
+    double rate_ = 1.0;
+    Sampler sampler_;
+};
+
+// Per-instrument arrival streams merged on one timeline. Times are
+// nanoseconds since start; the caller paces against them.
+class ArrivalScheduler {
+public:
+    explicit ArrivalScheduler(uint64_t seed = 0)
+        : rng_(seed)
+    {
+    }
+
+    void add_instrument(uint32_t instrument_id, ArrivalProcess process);
+    bool empty() const { return heap_.empty(); }
+
+    // Time of the earliest pending arrival
+    uint64_t next_time_ns() const { return heap_.top().time_ns; }
+
+    // Append up to max_events instruments due at or before now_ns to out;
+    // returns how many were appended
+    size_t pop_due(uint64_t now_ns, std::vector<uint32_t>& out, size_t max_events = SIZE_MAX);
+
+private:
+    struct Arrival {
+        uint64_t time_ns;
+        uint32_t index;
+
+        bool operator>(const Arrival& other) const
+        {
+            return time_ns != other.time_ns ? time_ns > other.time_ns : index > other.index;
+        }
+    };
+
+    struct Source {
+        uint32_t instrument_id;
+        ArrivalProcess process;
+    };
+
+    CounterRng rng_;
+    std::vector<Source> sources_;
+    std::priority_queue<Arrival, std::vector<Arrival>, std::greater<Arrival>> heap_;
+};
+
+// Paces a loop to a target event rate: acquire() blocks until at least one
+// event is due and returns how many may be emitted now. Rates above the
+// loop's iteration rate come back as batches, so one thread can hold
+// millions of events per second.
+class RateScheduler {
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct Config {
+        double target_rate = 1000.0; // Events per second
+        double burst = 0.0; // Catch-up cap in events; 0 = 1ms worth (at least 1)
+        std::chrono::nanoseconds spin_threshold = PacingTimer::DEFAULT_SPIN_THRESHOLD;
+    };
+
+    // Pacing accuracy since start/reset_statistics
+    struct Statistics {
+        double target_rate = 0.0;
+        double achieved_rate = 0.0;
+        uint64_t events = 0;
+        uint64_t waits = 0;
+        double mean_lateness_ns = 0.0; // Wake-up time past the scheduled deadline
+        double jitter_ns = 0.0; // Standard deviation of lateness
+        uint64_t max_lateness_ns = 0;
+    };
+
+    explicit RateScheduler(const Config& config);
+
+    // Wait until an event is due, then take up to max_events
+    size_t acquire(size_t max_events = SIZE_MAX);
+
+    // Take whatever is due without waiting
+    size_t poll(size_t max_events = SIZE_MAX);
+
+    // Arrival-driven pacing: wait for the scheduler's next arrival (its
+    // timeline starts at construction of this RateScheduler) and append
+    // the due instruments to out. target_rate only feeds the statistics.
+    size_t acquire(ArrivalScheduler& arrivals, std::vector<uint32_t>& out, size_t max_events = SIZE_MAX);
+
+    // Wait for the next event but no longer than max_wait; for loops that
+    // have other work to service
+    void wait_next(std::chrono::nanoseconds max_wait);
+
+    Statistics get_statistics() const;
+    void reset_statistics();
+
+    const Config& get_config() const { return config_; }
+
+private:
+    Config config_;
+    PacingTimer timer_;
+    TokenBucket bucket_;
+
+    clock::time_point epoch_; // Arrival timeline origin
+    clock::time_point start_; // Statistics window
+    uint64_t events_ = 0;
+    uint64_t waits_ = 0;
+    double lateness_sum_ = 0.0;
+    double lateness_sum_sq_ = 0.0;
+    uint64_t max_lateness_ = 0;
+
+    void record_wait(clock::time_point deadline, clock::time_point woke);
+};
+
+} // namespace market_core
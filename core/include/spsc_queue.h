@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace market_core {
+
+// Bounded single-producer/single-consumer ring of trivially-copyable items.
+//
+// try_push and try_pop never block or allocate; capacity is rounded up to
+// a power of two. The producer and consumer indices sit on separate cache
+// lines and each side keeps a cached copy of the other's index, so a push
+// or pop only touches the shared line when its cached view runs out.
+// Producer calls may come from different threads as long as they are
+// serialized by something that orders them (a mutex, a join); the same
+// holds for the consumer.
+template <typename T>
+class SpscQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscQueue items are copied with memcpy");
+
+public:
+    explicit SpscQueue(size_t capacity)
+        : mask_(round_up(capacity) - 1)
+        , items_(new T[mask_ + 1])
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side; false when full
+    bool try_push(const T& item)
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return false;
+            }
+        }
+        items_[tail & mask_] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; pops up to max_items into out, returns the count
+    size_t try_pop(T* out, size_t max_items)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (cached_tail_ == head) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (cached_tail_ == head) {
+                return 0;
+            }
+        }
+
+        size_t count = cached_tail_ - head;
+        if (count > max_items) {
+            count = max_items;
+        }
+
+        // At most two contiguous runs around the wrap
+        size_t begin = head & mask_;
+        size_t first = count < mask_ + 1 - begin ? count : mask_ + 1 - begin;
+        std::memcpy(out, &items_[begin], first * sizeof(T));
+        std::memcpy(out + first, &items_[0], (count - first) * sizeof(T));
+
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // Approximate when read by a thread other than producer or consumer
+    size_t size() const
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    static size_t round_up(size_t value)
+    {
+        size_t power = 1;
+        while (power < value) {
+            power <<= 1;
+        }
+        return power;
+    }
+
+    const size_t mask_;
+    std::unique_ptr<T[]> items_;
+
+    alignas(64) std::atomic<size_t> head_ { 0 }; // Consumer
+    size_t cached_tail_ = 0;
+
+    alignas(64) std::atomic<size_t> tail_ { 0 }; // Producer
+    size_t cached_head_ = 0;
+};
+
+} // namespace market_core
@@ -0,0 +1,252 @@
+#include "../include/event_record.h"
+
+namespace market_core {
+
+// ===========================
+// StringInterner
+// ===========================
+
+StringInterner& StringInterner::instance()
+{
+    static StringInterner interner;
+    return interner;
+}
+
+InternId StringInterner::intern(const std::string& value)
+{
+    if (value.empty()) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = ids_.find(value);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+
+    InternId id = static_cast<InternId>(values_.size());
+    values_.push_back(value);
+    ids_.emplace(value, id);
+    return id;
+}
+
+std::string StringInterner::lookup(InternId id) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return id < values_.size() ? values_[id] : std::string();
+}
+
+size_t StringInterner::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return values_.size() - 1;
+}
+
+// ===========================
+// MarketEvent -> EventRecord
+// ===========================
+
+static InternId intern_optional(const std::optional<std::string>& value)
+{
+    return value ? StringInterner::instance().intern(*value) : 0;
+}
+
+static std::optional<std::string> lookup_optional(InternId id)
+{
+    if (id == 0) {
+        return std::nullopt;
+    }
+    return StringInterner::instance().lookup(id);
+}
+
+bool to_record(const MarketEvent& event, EventRecord& record)
+{
+    record = EventRecord::make(event.type, event.instrument_id);
+    record.timestamp_ns = event.timestamp_ns;
+    record.sequence_number = event.sequence_number;
+
+    switch (event.type) {
+    case MarketEvent::QUOTE_UPDATE: {
+        const auto& quote = static_cast<const QuoteEvent&>(event);
+        record.quote.price = quote.price;
+        record.quote.quantity = quote.quantity;
+        record.quote.order_count = quote.order_count;
+        record.quote.side = quote.side;
+        record.quote.action = quote.action;
+        record.quote.market_maker_id = intern_optional(quote.market_maker_id);
+        if (quote.price_level) {
+            record.quote.price_level = *quote.price_level;
+            record.set(EventRecord::HAS_PRICE_LEVEL);
+        }
+        if (quote.implied_quantity) {
+            record.quote.implied_quantity = *quote.implied_quantity;
+            record.set(EventRecord::HAS_IMPLIED_QUANTITY);
+        }
+        if (quote.rpt_seq) {
+            record.rpt_seq = *quote.rpt_seq;
+            record.set(EventRecord::HAS_RPT_SEQ);
+        }
+        return true;
+    }
+    case MarketEvent::TRADE: {
+        const auto& trade = static_cast<const TradeEvent&>(event);
+        record.trade.price = trade.price;
+        record.trade.quantity = trade.quantity;
+        record.trade.trade_id = intern_optional(trade.trade_id);
+        if (trade.aggressor_side) {
+            record.trade.aggressor_side = *trade.aggressor_side;
+            record.set(EventRecord::HAS_AGGRESSOR_SIDE);
+        }
+        if (trade.rpt_seq) {
+            record.rpt_seq = *trade.rpt_seq;
+            record.set(EventRecord::HAS_RPT_SEQ);
+        }
+        return true;
+    }
+    case MarketEvent::ORDER_UPDATE: {
+        const auto& order = static_cast<const OrderEvent&>(event);
+        record.order.order_id = order.order_id;
+        record.order.priority = order.priority;
+        record.order.price = order.price;
+        record.order.quantity = order.quantity;
+        record.order.side = order.side;
+        record.order.action = order.action;
+        if (order.rpt_seq) {
+            record.rpt_seq = *order.rpt_seq;
+            record.set(EventRecord::HAS_RPT_SEQ);
+        }
+        return true;
+    }
+    case MarketEvent::STATISTICS: {
+        const auto& stats = static_cast<const StatisticsEvent&>(event);
+        record.statistics.stat_type = stats.stat_type;
+        record.statistics.value = stats.value;
+        if (stats.volume) {
+            record.statistics.volume = *stats.volume;
+            record.set(EventRecord::HAS_VOLUME);
+        }
+        return true;
+    }
+    case MarketEvent::STATUS_CHANGE: {
+        const auto& status = static_cast<const StatusEvent&>(event);
+        record.status.status = status.status;
+        record.status.halt_reason = intern_optional(status.halt_reason);
+        return true;
+    }
+    case MarketEvent::BOOK_CLEAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// ===========================
+// EventRecord -> MarketEvent
+// ===========================
+
+static void copy_header(const EventRecord& record, MarketEvent& event)
+{
+    event.timestamp_ns = record.timestamp_ns;
+    event.sequence_number = record.sequence_number;
+}
+
+QuoteEvent to_quote_event(const EventRecord& record)
+{
+    QuoteEvent quote(record.instrument_id);
+    copy_header(record, quote);
+    quote.side = record.quote.side;
+    quote.price = record.quote.price;
+    quote.quantity = record.quote.quantity;
+    quote.action = record.quote.action;
+    quote.order_count = record.quote.order_count;
+    quote.market_maker_id = lookup_optional(record.quote.market_maker_id);
+    if (record.has(EventRecord::HAS_PRICE_LEVEL)) {
+        quote.price_level = record.quote.price_level;
+    }
+    if (record.has(EventRecord::HAS_IMPLIED_QUANTITY)) {
+        quote.implied_quantity = record.quote.implied_quantity;
+    }
+    if (record.has(EventRecord::HAS_RPT_SEQ)) {
+        quote.rpt_seq = record.rpt_seq;
+    }
+    return quote;
+}
+
+TradeEvent to_trade_event(const EventRecord& record)
+{
+    TradeEvent trade(record.instrument_id);
+    copy_header(record, trade);
+    trade.price = record.trade.price;
+    trade.quantity = record.trade.quantity;
+    trade.trade_id = lookup_optional(record.trade.trade_id);
+    if (record.has(EventRecord::HAS_AGGRESSOR_SIDE)) {
+        trade.aggressor_side = record.trade.aggressor_side;
+    }
+    if (record.has(EventRecord::HAS_RPT_SEQ)) {
+        trade.rpt_seq = record.rpt_seq;
+    }
+    return trade;
+}
+
+OrderEvent to_order_event(const EventRecord& record)
+{
+    OrderEvent order(record.instrument_id);
+    copy_header(record, order);
+    order.order_id = record.order.order_id;
+    order.side = record.order.side;
+    order.price = record.order.price;
+    order.quantity = record.order.quantity;
+    order.action = record.order.action;
+    order.priority = record.order.priority;
+    if (record.has(EventRecord::HAS_RPT_SEQ)) {
+        order.rpt_seq = record.rpt_seq;
+    }
+    return order;
+}
+
+StatisticsEvent to_statistics_event(const EventRecord& record)
+{
+    StatisticsEvent stats(record.instrument_id);
+    copy_header(record, stats);
+    stats.stat_type = record.statistics.stat_type;
+    stats.value = record.statistics.value;
+    if (record.has(EventRecord::HAS_VOLUME)) {
+        stats.volume = record.statistics.volume;
+    }
+    return stats;
+}
+
+StatusEvent to_status_event(const EventRecord& record)
+{
+    StatusEvent status(record.instrument_id);
+    copy_header(record, status);
+    status.status = record.status.status;
+    status.halt_reason = lookup_optional(record.status.halt_reason);
+    return status;
+}
+
+std::shared_ptr<MarketEvent> to_market_event(const EventRecord& record)
+{
+    switch (record.type) {
+    case MarketEvent::QUOTE_UPDATE:
+        return std::make_shared<QuoteEvent>(to_quote_event(record));
+    case MarketEvent::TRADE:
+        return std::make_shared<TradeEvent>(to_trade_event(record));
+    case MarketEvent::ORDER_UPDATE:
+        return std::make_shared<OrderEvent>(to_order_event(record));
+    case MarketEvent::STATISTICS:
+        return std::make_shared<StatisticsEvent>(to_statistics_event(record));
+    case MarketEvent::STATUS_CHANGE:
+        return std::make_shared<StatusEvent>(to_status_event(record));
+    case MarketEvent::BOOK_CLEAR: {
+        auto event = std::make_shared<MarketEvent>(MarketEvent::BOOK_CLEAR, record.instrument_id);
+        copy_header(record, *event);
+        return event;
+    }
+    default:
+        return nullptr;
+    }
+}
+
+} // namespace market_core
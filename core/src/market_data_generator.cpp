@@ -1,9 +1,17 @@
 #include "../include/market_data_generator.h"
 #include <chrono>
+#include <cmath>
 #include <random>
 
 namespace market_core {
 
+static uint64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
 MarketDataGenerator::MarketDataGenerator(std::shared_ptr<OrderBookManager> book_manager)
     : book_manager_(book_manager)
     , config_()
@@ -12,6 +20,14 @@ MarketDataGenerator::MarketDataGenerator(std::shared_ptr<OrderBookManager> book_
     stats_.start_time = std::chrono::steady_clock::now();
 }
 
+MarketDataGenerator::MarketDataGenerator(std::shared_ptr<OrderBookManager> book_manager, uint64_t seed, uint64_t stream_id)
+    : book_manager_(book_manager)
+    , config_()
+    , rng_(seed, stream_id)
+{
+    stats_.start_time = std::chrono::steady_clock::now();
+}
+
 void MarketDataGenerator::set_market_mode(MarketMode mode)
 {
     config_.mode = mode;
@@ -56,75 +72,164 @@ void MarketDataGenerator::set_market_mode(MarketMode mode)
 }
 
 void MarketDataGenerator::generate_update(uint32_t instrument_id)
+{
+    EventRecord record;
+    if (next_record(instrument_id, record)) {
+        dispatch(EventRecordSpan(&record, 1));
+    }
+}
+
+bool MarketDataGenerator::next_record(uint32_t instrument_id, EventRecord& record)
 {
     auto [instrument, book] = book_manager_->get_instrument_and_book(instrument_id);
     if (!instrument || !book) {
-        return;
+        return false;
     }
 
+    stats_.updates_generated++;
+
     // Decide what type of update to generate
     if (should_generate_trade()) {
-        auto trade_event = generate_trade(instrument_id);
-        if (trade_event) {
-            notify_listeners(trade_event);
-            stats_.trades_generated++;
+        if (!build_trade(*instrument, *book, record)) {
+            return false;
+        }
+        stats_.trades_generated++;
+    } else if (book->get_order_level_book()) {
+        if (!build_order(*instrument, *book, record)) {
+            return false;
         }
+        stats_.orders_generated++;
     } else {
-        auto quote_event = generate_quote(instrument_id);
-        if (quote_event) {
-            notify_listeners(quote_event);
-            stats_.quotes_generated++;
+        if (!build_quote(*instrument, *book, record)) {
+            return false;
         }
+        stats_.quotes_generated++;
     }
 
-    stats_.updates_generated++;
+    // Apply to local books before the next event is derived from them. An
+    // event the book refuses is not published either, so the feed and
+    // snapshots agree.
+    return book_manager_->apply_record(record);
+}
+
+std::vector<uint32_t> MarketDataGenerator::target_instruments() const
+{
+    return instrument_ids_.empty() ? book_manager_->get_all_instrument_ids() : instrument_ids_;
+}
+
+uint64_t MarketDataGenerator::next_timestamp()
+{
+    if (config_.simulated_clock_step_ns == 0) {
+        return now_ns();
+    }
+    return config_.simulated_clock_start_ns + config_.simulated_clock_step_ns * clock_ticks_++;
 }
 
 void MarketDataGenerator::generate_batch(int count)
 {
-    auto instrument_ids = book_manager_->get_all_instrument_ids();
-    if (instrument_ids.empty()) {
+    auto instrument_ids = target_instruments();
+    if (instrument_ids.empty() || count <= 0) {
         return;
     }
 
+    size_t max_batch = std::max<size_t>(config_.max_batch_events, 1);
+    batch_buffer_.resize(max_batch);
+    size_t pending = 0;
+
+    std::uniform_int_distribution<size_t> inst_dist(0, instrument_ids.size() - 1);
     for (int i = 0; i < count; ++i) {
         // Pick random instrument
-        std::uniform_int_distribution<> inst_dist(0, instrument_ids.size() - 1);
         uint32_t instrument_id = instrument_ids[inst_dist(rng_)];
-        generate_update(instrument_id);
+        if (next_record(instrument_id, batch_buffer_[pending]) && ++pending == max_batch) {
+            dispatch(EventRecordSpan(batch_buffer_.data(), pending));
+            pending = 0;
+        }
+    }
+
+    if (pending > 0) {
+        dispatch(EventRecordSpan(batch_buffer_.data(), pending));
     }
 }
 
 void MarketDataGenerator::generate_all_instruments()
 {
-    auto instrument_ids = book_manager_->get_all_instrument_ids();
+    auto instrument_ids = target_instruments();
+
+    size_t max_batch = std::max<size_t>(config_.max_batch_events, 1);
+    batch_buffer_.resize(max_batch);
+    size_t pending = 0;
+
     for (uint32_t instrument_id : instrument_ids) {
-        generate_update(instrument_id);
+        if (next_record(instrument_id, batch_buffer_[pending]) && ++pending == max_batch) {
+            dispatch(EventRecordSpan(batch_buffer_.data(), pending));
+            pending = 0;
+        }
+    }
+
+    if (pending > 0) {
+        dispatch(EventRecordSpan(batch_buffer_.data(), pending));
     }
 }
 
 std::shared_ptr<QuoteEvent> MarketDataGenerator::generate_quote(uint32_t instrument_id)
+{
+    auto [instrument, book] = book_manager_->get_instrument_and_book(instrument_id);
+    EventRecord record;
+    if (!instrument || !book || !build_quote(*instrument, *book, record)) {
+        return nullptr;
+    }
+    return std::make_shared<QuoteEvent>(to_quote_event(record));
+}
+
+std::shared_ptr<TradeEvent> MarketDataGenerator::generate_trade(uint32_t instrument_id)
+{
+    auto [instrument, book] = book_manager_->get_instrument_and_book(instrument_id);
+    EventRecord record;
+    if (!instrument || !book || !build_trade(*instrument, *book, record)) {
+        return nullptr;
+    }
+    return std::make_shared<TradeEvent>(to_trade_event(record));
+}
+
+std::shared_ptr<OrderEvent> MarketDataGenerator::generate_order(uint32_t instrument_id)
+{
+    auto [instrument, book] = book_manager_->get_instrument_and_book(instrument_id);
+    EventRecord record;
+    if (!instrument || !book || !build_order(*instrument, *book, record)) {
+        return nullptr;
+    }
+    return std::make_shared<OrderEvent>(to_order_event(record));
+}
+
+std::shared_ptr<StatisticsEvent> MarketDataGenerator::generate_statistics(uint32_t instrument_id)
 {
     auto [instrument, book] = book_manager_->get_instrument_and_book(instrument_id);
     if (!instrument || !book) {
         return nullptr;
     }
 
-    auto quote = std::make_shared<QuoteEvent>(instrument_id);
-    quote->timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::system_clock::now().time_since_epoch())
-                              .count();
-    quote->sequence_number = get_next_sequence(instrument_id);
+    EventRecord record;
+    build_statistics(*book, record);
+    return std::make_shared<StatisticsEvent>(to_statistics_event(record));
+}
+
+bool MarketDataGenerator::build_quote(const Instrument& instrument, const OrderBook& book, EventRecord& record)
+{
+    record = EventRecord::make(MarketEvent::QUOTE_UPDATE, book.get_instrument_id());
+    record.timestamp_ns = next_timestamp();
+    record.sequence_number = get_next_sequence(record.instrument_id);
+
+    QuoteRecord& quote = record.quote;
 
     // Choose side
-    quote->side = (uniform_dist_(rng_) < 0.5) ? Side::BID : Side::ASK;
+    quote.side = (uniform_dist_(rng_) < 0.5) ? Side::BID : Side::ASK;
 
     // Choose action
-    quote->action = choose_update_action();
+    quote.action = choose_update_action();
 
     // Get current best prices
-    auto best_bid = book->get_best_bid();
-    auto best_ask = book->get_best_ask();
+    auto best_bid = book.get_best_bid();
+    auto best_ask = book.get_best_ask();
 
     // Generate price based on current market
     double reference_price = 0.0;
@@ -132,93 +237,150 @@ std::shared_ptr<QuoteEvent> MarketDataGenerator::generate_quote(uint32_t instrum
         reference_price = (*best_bid + *best_ask) / 2.0;
     } else {
         // Use instrument's initial price if no market exists
-        auto initial_price = instrument->get_property<double>("initial_price");
+        auto initial_price = instrument.get_property<double>("initial_price");
         reference_price = initial_price.value_or(100.0);
     }
 
     // Apply price movement
-    double price_move = calculate_price_movement(reference_price, *instrument);
+    double price_move = calculate_price_movement(reference_price, instrument);
     double new_price = reference_price + price_move;
 
     // Round to tick size
-    quote->price = apply_tick_rounding(new_price, instrument->tick_size);
+    quote.price = apply_tick_rounding(new_price, instrument.tick_size);
 
     // Adjust price based on side and action
-    if (quote->side == Side::BID && best_bid) {
-        if (quote->action == UpdateAction::ADD) {
-            quote->price = std::min(quote->price, *best_bid - instrument->tick_size);
+    if (quote.side == Side::BID && best_bid) {
+        if (quote.action == UpdateAction::ADD) {
+            quote.price = std::min(quote.price, *best_bid - instrument.tick_size);
         }
-    } else if (quote->side == Side::ASK && best_ask) {
-        if (quote->action == UpdateAction::ADD) {
-            quote->price = std::max(quote->price, *best_ask + instrument->tick_size);
+    } else if (quote.side == Side::ASK && best_ask) {
+        if (quote.action == UpdateAction::ADD) {
+            quote.price = std::max(quote.price, *best_ask + instrument.tick_size);
         }
     }
 
-    quote->quantity = calculate_quantity(*instrument);
-    quote->order_count = std::max(1U, static_cast<uint32_t>(quote->quantity / 1000));
+    quote.quantity = calculate_quantity(instrument);
+    quote.order_count = std::max(1U, static_cast<uint32_t>(quote.quantity / 1000));
 
     // Set price level (1-based)
-    if (quote->side == Side::BID) {
-        auto bids = book->get_bids();
-        quote->price_level = static_cast<uint8_t>(bids.size() + 1);
-    } else {
-        auto asks = book->get_asks();
-        quote->price_level = static_cast<uint8_t>(asks.size() + 1);
-    }
+    size_t depth = (quote.side == Side::BID) ? book.bid_depth() : book.ask_depth();
+    quote.price_level = static_cast<uint8_t>(depth + 1);
+    record.set(EventRecord::HAS_PRICE_LEVEL);
 
-    return quote;
+    return true;
 }
 
-std::shared_ptr<TradeEvent> MarketDataGenerator::generate_trade(uint32_t instrument_id)
+bool MarketDataGenerator::build_trade(const Instrument& instrument, const OrderBook& book, EventRecord& record)
 {
-    auto [instrument, book] = book_manager_->get_instrument_and_book(instrument_id);
-    if (!instrument || !book) {
-        return nullptr;
-    }
-
-    auto best_bid = book->get_best_bid();
-    auto best_ask = book->get_best_ask();
+    auto best_bid = book.get_best_bid();
+    auto best_ask = book.get_best_ask();
 
     if (!best_bid || !best_ask) {
-        return nullptr; // No market to trade against
+        return false; // No market to trade against
     }
 
-    auto trade = std::make_shared<TradeEvent>(instrument_id);
-    trade->timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::system_clock::now().time_since_epoch())
-                              .count();
-    trade->sequence_number = get_next_sequence(instrument_id);
+    record = EventRecord::make(MarketEvent::TRADE, book.get_instrument_id());
+    record.timestamp_ns = next_timestamp();
+    record.sequence_number = get_next_sequence(record.instrument_id);
 
     // Choose aggressor side
     Side aggressor = choose_aggressor_side();
-    trade->aggressor_side = aggressor;
+    record.trade.aggressor_side = aggressor;
+    record.set(EventRecord::HAS_AGGRESSOR_SIDE);
 
     // Trade at best price of opposite side
     if (aggressor == Side::BID) {
-        trade->price = *best_ask; // Buy at offer
+        record.trade.price = *best_ask; // Buy at offer
     } else {
-        trade->price = *best_bid; // Sell at bid
+        record.trade.price = *best_bid; // Sell at bid
     }
 
-    trade->quantity = calculate_quantity(*instrument) / 2; // Trades typically smaller
+    record.trade.quantity = calculate_quantity(instrument) / 2; // Trades typically smaller
 
-    return trade;
+    return true;
 }
 
-std::shared_ptr<StatisticsEvent> MarketDataGenerator::generate_statistics(uint32_t instrument_id)
+bool MarketDataGenerator::build_order(const Instrument& instrument, const OrderBook& book, EventRecord& record)
 {
-    auto [instrument, book] = book_manager_->get_instrument_and_book(instrument_id);
-    if (!instrument || !book) {
-        return nullptr;
+    const OrderLevelBook* orders = book.get_order_level_book();
+    if (!orders) {
+        return false;
     }
 
-    auto stats_event = std::make_shared<StatisticsEvent>(instrument_id);
-    stats_event->timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::system_clock::now().time_since_epoch())
-                                    .count();
-    stats_event->sequence_number = get_next_sequence(instrument_id);
+    record = EventRecord::make(MarketEvent::ORDER_UPDATE, book.get_instrument_id());
+    record.timestamp_ns = next_timestamp();
+    record.sequence_number = get_next_sequence(record.instrument_id);
+
+    OrderRecord& order = record.order;
 
-    const auto& book_stats = book->get_stats();
+    // Grow the book towards the depth target, then churn resting orders
+    size_t target_orders = static_cast<size_t>(config_.book_depth_target) * 2 * 4;
+    UpdateAction action = choose_update_action();
+    if (orders->order_count() == 0 || (orders->order_count() < target_orders && action != UpdateAction::DELETE)) {
+        action = UpdateAction::ADD;
+    }
+
+    if (action != UpdateAction::ADD) {
+        std::uniform_int_distribution<size_t> pick(0, orders->order_count() - 1);
+        auto resting = orders->find_order(orders->order_id_at(pick(rng_)));
+
+        order.order_id = resting->order_id;
+        order.side = resting->side;
+        order.price = resting->price;
+        order.action = action;
+
+        if (action == UpdateAction::CHANGE) {
+            // Mostly partial reductions (keep priority), sometimes a size increase
+            if (uniform_dist_(rng_) < 0.7 && resting->quantity > 100) {
+                order.quantity = resting->quantity - 100;
+                order.priority = resting->priority;
+            } else {
+                order.quantity = resting->quantity + calculate_quantity(instrument);
+                order.priority = next_order_priority_++;
+            }
+        } else {
+            order.quantity = 0;
+            order.priority = resting->priority;
+        }
+        return true;
+    }
+
+    // New order around the current market, never crossing the opposite side
+    auto best_bid = orders->best_price(Side::BID);
+    auto best_ask = orders->best_price(Side::ASK);
+    double reference_price = (best_bid && best_ask)
+        ? (*best_bid + *best_ask) / 2.0
+        : instrument.get_property<double>("initial_price").value_or(100.0);
+
+    order.side = (uniform_dist_(rng_) < 0.5) ? Side::BID : Side::ASK;
+    double offset_ticks = std::abs(normal_dist_(rng_)) * config_.book_depth_target + 1.0;
+    double price = (order.side == Side::BID)
+        ? reference_price - offset_ticks * instrument.tick_size
+        : reference_price + offset_ticks * instrument.tick_size;
+    price = apply_tick_rounding(price, instrument.tick_size);
+
+    if (order.side == Side::BID && best_ask) {
+        price = std::min(price, *best_ask - instrument.tick_size);
+    } else if (order.side == Side::ASK && best_bid) {
+        price = std::max(price, *best_bid + instrument.tick_size);
+    }
+
+    order.order_id = next_order_id_++;
+    order.price = price;
+    order.quantity = calculate_quantity(instrument);
+    order.priority = next_order_priority_++;
+    order.action = UpdateAction::ADD;
+    return true;
+}
+
+void MarketDataGenerator::build_statistics(const OrderBook& book, EventRecord& record)
+{
+    record = EventRecord::make(MarketEvent::STATISTICS, book.get_instrument_id());
+    record.timestamp_ns = next_timestamp();
+    record.sequence_number = get_next_sequence(record.instrument_id);
+
+    StatisticsRecord& stats = record.statistics;
+    const auto& book_stats = book.get_stats();
 
     // Generate different types of statistics
     std::uniform_int_distribution<> stat_dist(0, 6);
@@ -226,44 +388,45 @@ std::shared_ptr<StatisticsEvent> MarketDataGenerator::generate_statistics(uint32
 
     switch (stat_choice) {
     case 0:
-        stats_event->stat_type = StatisticsEvent::OPEN;
-        stats_event->value = book_stats.open_price;
+        stats.stat_type = StatisticsEvent::OPEN;
+        stats.value = book_stats.open_price;
         break;
     case 1:
-        stats_event->stat_type = StatisticsEvent::HIGH;
-        stats_event->value = book_stats.high_price;
+        stats.stat_type = StatisticsEvent::HIGH;
+        stats.value = book_stats.high_price;
         break;
     case 2:
-        stats_event->stat_type = StatisticsEvent::LOW;
-        stats_event->value = book_stats.low_price;
+        stats.stat_type = StatisticsEvent::LOW;
+        stats.value = book_stats.low_price;
         break;
     case 3:
-        stats_event->stat_type = StatisticsEvent::CLOSE;
-        stats_event->value = book_stats.last_price;
+        stats.stat_type = StatisticsEvent::CLOSE;
+        stats.value = book_stats.last_price;
         break;
     case 4:
-        stats_event->stat_type = StatisticsEvent::SETTLEMENT;
-        stats_event->value = book_stats.settlement_price;
+        stats.stat_type = StatisticsEvent::SETTLEMENT;
+        stats.value = book_stats.settlement_price;
         break;
     case 5:
-        stats_event->stat_type = StatisticsEvent::VWAP;
-        stats_event->value = book_stats.vwap;
+        stats.stat_type = StatisticsEvent::VWAP;
+        stats.value = book_stats.vwap;
         break;
     case 6:
-        stats_event->stat_type = StatisticsEvent::TRADE_VOLUME;
-        stats_event->value = static_cast<double>(book_stats.total_volume);
-        stats_event->volume = book_stats.total_volume;
+        stats.stat_type = StatisticsEvent::TRADE_VOLUME;
+        stats.value = static_cast<double>(book_stats.total_volume);
+        stats.volume = book_stats.total_volume;
+        record.set(EventRecord::HAS_VOLUME);
         break;
     }
-
-    return stats_event;
 }
 
 std::shared_ptr<SnapshotEvent> MarketDataGenerator::generate_snapshot(uint32_t instrument_id)
 {
     auto snapshot = book_manager_->create_snapshot(instrument_id, config_.book_depth_target);
     if (snapshot) {
-        snapshot->sequence_number = get_next_sequence(instrument_id);
+        // Tag with the book's last sequence; consuming a new one would
+        // leave a gap in the instrument's incremental rpt_seq
+        snapshot->sequence_number = snapshot->rpt_seq.value_or(0);
         stats_.snapshots_generated++;
     }
     return snapshot;
@@ -271,27 +434,89 @@ std::shared_ptr<SnapshotEvent> MarketDataGenerator::generate_snapshot(uint32_t i
 
 void MarketDataGenerator::add_listener(std::weak_ptr<IMarketEventListener> listener)
 {
+    // Listeners that already speak records skip the adapter
+    auto record_listener = std::dynamic_pointer_cast<IEventRecordListener>(listener.lock());
+    if (record_listener) {
+        add_record_listener(record_listener);
+        return;
+    }
+
+    auto adapter = std::make_shared<MarketEventListenerAdapter>(listener);
     std::lock_guard<std::mutex> lock(listeners_mutex_);
-    listeners_.push_back(listener);
+    const ListenerList* current = listeners_.load(std::memory_order_relaxed);
+    std::vector<ListenerEntry> entries = current ? current->entries : std::vector<ListenerEntry> {};
+    entries.push_back(ListenerEntry { adapter, adapter });
+    publish_listeners(std::move(entries));
+}
+
+void MarketDataGenerator::add_record_listener(std::weak_ptr<IEventRecordListener> listener)
+{
+    std::lock_guard<std::mutex> lock(listeners_mutex_);
+    const ListenerList* current = listeners_.load(std::memory_order_relaxed);
+    std::vector<ListenerEntry> entries = current ? current->entries : std::vector<ListenerEntry> {};
+    entries.push_back(ListenerEntry { listener, nullptr });
+    publish_listeners(std::move(entries));
 }
 
 void MarketDataGenerator::remove_listener(std::shared_ptr<IMarketEventListener> listener)
 {
+    auto record_listener = std::dynamic_pointer_cast<IEventRecordListener>(listener);
+    if (record_listener) {
+        remove_record_listener(record_listener);
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(listeners_mutex_);
-    // Remove by comparing the locked weak_ptr
-    listeners_.erase(
-        std::remove_if(listeners_.begin(), listeners_.end(),
-            [&listener](const std::weak_ptr<IMarketEventListener>& wp) {
-                auto sp = wp.lock();
-                return !sp || sp == listener;
-            }),
-        listeners_.end());
+    const ListenerList* current = listeners_.load(std::memory_order_relaxed);
+    if (!current) {
+        return;
+    }
+
+    std::vector<ListenerEntry> entries;
+    for (const auto& entry : current->entries) {
+        if (!entry.adapter || !entry.adapter->wraps(listener)) {
+            entries.push_back(entry);
+        }
+    }
+    publish_listeners(std::move(entries));
+}
+
+void MarketDataGenerator::remove_record_listener(std::shared_ptr<IEventRecordListener> listener)
+{
+    std::lock_guard<std::mutex> lock(listeners_mutex_);
+    const ListenerList* current = listeners_.load(std::memory_order_relaxed);
+    if (!current) {
+        return;
+    }
+
+    std::vector<ListenerEntry> entries;
+    for (const auto& entry : current->entries) {
+        if (entry.listener.lock() != listener) {
+            entries.push_back(entry);
+        }
+    }
+    publish_listeners(std::move(entries));
 }
 
 void MarketDataGenerator::clear_listeners()
 {
     std::lock_guard<std::mutex> lock(listeners_mutex_);
-    listeners_.clear();
+    publish_listeners({});
+}
+
+void MarketDataGenerator::publish_listeners(std::vector<ListenerEntry> entries)
+{
+    // Registration is rare, so expired listeners are pruned here rather
+    // than on the dispatch path
+    entries.erase(
+        std::remove_if(entries.begin(), entries.end(),
+            [](const ListenerEntry& entry) {
+                return entry.listener.expired() || (entry.adapter && entry.adapter->expired());
+            }),
+        entries.end());
+
+    listener_lists_.push_back(std::make_unique<const ListenerList>(ListenerList { std::move(entries) }));
+    listeners_.store(listener_lists_.back().get(), std::memory_order_release);
 }
 
 void MarketDataGenerator::reset_statistics()
@@ -299,28 +524,22 @@ void MarketDataGenerator::reset_statistics()
     stats_ = Statistics {};
     stats_.start_time = std::chrono::steady_clock::now();
     instrument_sequences_.clear();
+    clock_ticks_ = 0;
 }
 
-void MarketDataGenerator::notify_listeners(const std::shared_ptr<MarketEvent>& event)
+void MarketDataGenerator::dispatch(EventRecordSpan records)
 {
-    // Apply to local books first
-    book_manager_->apply_event(event);
+    const ListenerList* listeners = listeners_.load(std::memory_order_acquire);
+    if (!listeners) {
+        return;
+    }
 
     // Notify protocol adapters
-    std::lock_guard<std::mutex> lock(listeners_mutex_);
-    for (auto& listener : listeners_) {
-        if (auto shared_listener = listener.lock()) {
-            shared_listener->on_market_event(event);
+    for (const auto& entry : listeners->entries) {
+        if (auto listener = entry.listener.lock()) {
+            listener->on_market_events(records);
         }
     }
-
-    // Remove expired weak pointers
-    listeners_.erase(
-        std::remove_if(listeners_.begin(), listeners_.end(),
-            [](const std::weak_ptr<IMarketEventListener>& wp) {
-                return wp.expired();
-            }),
-        listeners_.end());
 }
 
 double MarketDataGenerator::calculate_price_movement(double current_price, const Instrument& instrument)
@@ -12,20 +12,61 @@ OrderBook::OrderBook(uint32_t instrument_id, const std::string& symbol)
 {
 }
 
-void OrderBook::add_level(Side side, const PriceLevel& level)
+bool OrderBook::set_config(const Config& config)
 {
-    if (side == Side::BID) {
-        bids_[level.price] = level;
-    } else if (side == Side::ASK) {
-        asks_[level.price] = level;
+    bool was_ladder = static_cast<bool>(bid_ladder_);
+    bool use_ladder = config.storage == Storage::TICK_LADDER;
+
+    if (use_ladder && (!was_ladder || config.tick_size != config_.tick_size)) {
+        // Fill the new ladders before replacing the storage
+        auto bid_ladder = std::make_unique<PriceLadder>(Side::BID, config.tick_size, config.ladder_capacity);
+        auto ask_ladder = std::make_unique<PriceLadder>(Side::ASK, config.tick_size, config.ladder_capacity);
+        for (const auto& level : get_bids()) {
+            if (!bid_ladder->set(level)) {
+                return false;
+            }
+        }
+        for (const auto& level : get_asks()) {
+            if (!ask_ladder->set(level)) {
+                return false;
+            }
+        }
+
+        bid_ladder_ = std::move(bid_ladder);
+        ask_ladder_ = std::move(ask_ladder);
+        bids_.clear();
+        asks_.clear();
+    } else if (!use_ladder && was_ladder) {
+        for (const auto& level : bid_ladder_->levels()) {
+            bids_[level.price] = level;
+        }
+        for (const auto& level : ask_ladder_->levels()) {
+            asks_[level.price] = level;
+        }
+        bid_ladder_.reset();
+        ask_ladder_.reset();
     }
+
+    if (!config.aggregate_by_price && !orders_) {
+        double tick_size = config.tick_size > 0.0 ? config.tick_size : 0.01;
+        orders_ = std::make_unique<OrderLevelBook>(tick_size);
+    } else if (config.aggregate_by_price) {
+        orders_.reset();
+    }
+
+    config_ = config;
+    return true;
 }
 
-void OrderBook::update_level(Side side, const PriceLevel& level)
+bool OrderBook::add_level(Side side, const PriceLevel& level)
 {
-    if (level.quantity == 0) {
-        remove_level(side, level.price);
-        return;
+    if (bid_ladder_) {
+        if (side == Side::BID) {
+            return bid_ladder_->set(level);
+        } else if (side == Side::ASK) {
+            return ask_ladder_->set(level);
+        }
+        return true;
     }
 
     if (side == Side::BID) {
@@ -33,10 +74,29 @@ void OrderBook::update_level(Side side, const PriceLevel& level)
     } else if (side == Side::ASK) {
         asks_[level.price] = level;
     }
+    return true;
+}
+
+bool OrderBook::update_level(Side side, const PriceLevel& level)
+{
+    if (level.quantity == 0) {
+        remove_level(side, level.price);
+        return true;
+    }
+    return add_level(side, level);
 }
 
 void OrderBook::remove_level(Side side, double price)
 {
+    if (bid_ladder_) {
+        if (side == Side::BID) {
+            bid_ladder_->erase(price);
+        } else if (side == Side::ASK) {
+            ask_ladder_->erase(price);
+        }
+        return;
+    }
+
     if (side == Side::BID) {
         bids_.erase(price);
     } else if (side == Side::ASK) {
@@ -48,15 +108,32 @@ void OrderBook::clear_side(Side side)
 {
     if (side == Side::BID) {
         bids_.clear();
+        if (bid_ladder_) {
+            bid_ladder_->clear();
+        }
     } else if (side == Side::ASK) {
         asks_.clear();
+        if (ask_ladder_) {
+            ask_ladder_->clear();
+        }
     }
 }
 
+std::vector<OrderEntry> OrderBook::get_orders(Side side, size_t max_levels) const
+{
+    if (!orders_) {
+        return {};
+    }
+    return orders_->get_orders(side, max_levels);
+}
+
 void OrderBook::clear()
 {
-    bids_.clear();
-    asks_.clear();
+    clear_side(Side::BID);
+    clear_side(Side::ASK);
+    if (orders_) {
+        orders_->clear();
+    }
     recent_trades_.clear();
     stats_ = MarketStats {};
 }
@@ -73,8 +150,22 @@ void OrderBook::add_trade(const Trade& trade)
     update_stats_on_trade(trade);
 }
 
+size_t OrderBook::bid_depth() const
+{
+    return bid_ladder_ ? bid_ladder_->size() : bids_.size();
+}
+
+size_t OrderBook::ask_depth() const
+{
+    return ask_ladder_ ? ask_ladder_->size() : asks_.size();
+}
+
 std::vector<PriceLevel> OrderBook::get_bids(size_t max_levels) const
 {
+    if (bid_ladder_) {
+        return bid_ladder_->levels(max_levels);
+    }
+
     std::vector<PriceLevel> result;
     result.reserve(std::min(max_levels, bids_.size()));
 
@@ -91,6 +182,10 @@ std::vector<PriceLevel> OrderBook::get_bids(size_t max_levels) const
 
 std::vector<PriceLevel> OrderBook::get_asks(size_t max_levels) const
 {
+    if (ask_ladder_) {
+        return ask_ladder_->levels(max_levels);
+    }
+
     std::vector<PriceLevel> result;
     result.reserve(std::min(max_levels, asks_.size()));
 
@@ -118,6 +213,9 @@ std::vector<Trade> OrderBook::get_recent_trades(size_t count) const
 
 std::optional<double> OrderBook::get_best_bid() const
 {
+    if (bid_ladder_) {
+        return bid_ladder_->best_price();
+    }
     if (bids_.empty()) {
         return std::nullopt;
     }
@@ -126,6 +224,9 @@ std::optional<double> OrderBook::get_best_bid() const
 
 std::optional<double> OrderBook::get_best_ask() const
 {
+    if (ask_ladder_) {
+        return ask_ladder_->best_price();
+    }
     if (asks_.empty()) {
         return std::nullopt;
     }
@@ -168,19 +269,27 @@ bool OrderBook::is_crossed() const
 std::shared_ptr<SnapshotEvent> OrderBook::create_snapshot_event(size_t max_levels) const
 {
     auto snapshot = std::make_shared<SnapshotEvent>(instrument_id_);
+    fill_snapshot_event(*snapshot, max_levels);
+    return snapshot;
+}
+
+void OrderBook::fill_snapshot_event(SnapshotEvent& snapshot, size_t max_levels) const
+{
+    snapshot.instrument_id = instrument_id_;
+    snapshot.bid_levels.clear();
+    snapshot.ask_levels.clear();
+    snapshot.orders.clear();
+    snapshot.rpt_seq = last_sequence_;
 
     // Get current timestamp
     auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
         std::chrono::system_clock::now().time_since_epoch())
                    .count();
-    snapshot->timestamp_ns = now;
+    snapshot.timestamp_ns = now;
 
     // Add bid levels
     size_t bid_count = 0;
-    for (const auto& [price, level] : bids_) {
-        if (bid_count >= max_levels)
-            break;
-
+    for (const auto& level : get_bids(max_levels)) {
         QuoteEvent bid_quote(instrument_id_);
         bid_quote.side = Side::BID;
         bid_quote.price = level.price;
@@ -192,16 +301,13 @@ std::shared_ptr<SnapshotEvent> OrderBook::create_snapshot_event(size_t max_level
             bid_quote.price_level = static_cast<uint8_t>(bid_count + 1);
         }
 
-        snapshot->bid_levels.push_back(bid_quote);
+        snapshot.bid_levels.push_back(bid_quote);
         ++bid_count;
     }
 
     // Add ask levels
     size_t ask_count = 0;
-    for (const auto& [price, level] : asks_) {
-        if (ask_count >= max_levels)
-            break;
-
+    for (const auto& level : get_asks(max_levels)) {
         QuoteEvent ask_quote(instrument_id_);
         ask_quote.side = Side::ASK;
         ask_quote.price = level.price;
@@ -213,30 +319,53 @@ std::shared_ptr<SnapshotEvent> OrderBook::create_snapshot_event(size_t max_level
             ask_quote.price_level = static_cast<uint8_t>(ask_count + 1);
         }
 
-        snapshot->ask_levels.push_back(ask_quote);
+        snapshot.ask_levels.push_back(ask_quote);
         ++ask_count;
     }
 
-    // Add statistics
-    snapshot->last_trade_price = (stats_.last_price > 0) ? std::optional<double>(stats_.last_price) : std::nullopt;
-    snapshot->total_volume = stats_.total_volume;
+    // Add resting orders for MBO books
+    if (orders_) {
+        for (Side side : { Side::BID, Side::ASK }) {
+            for (const auto& entry : orders_->get_orders(side, max_levels)) {
+                OrderEvent order(instrument_id_);
+                order.timestamp_ns = entry.timestamp_ns;
+                order.order_id = entry.order_id;
+                order.side = entry.side;
+                order.price = entry.price;
+                order.quantity = entry.quantity;
+                order.priority = entry.priority;
+                order.action = UpdateAction::ADD;
+                snapshot.orders.push_back(order);
+            }
+        }
+    }
 
-    return snapshot;
+    // Add statistics
+    snapshot.last_trade_price = (stats_.last_price > 0) ? std::optional<double>(stats_.last_price) : std::nullopt;
+    snapshot.total_volume = stats_.total_volume;
 }
 
-void OrderBook::apply_event(const std::shared_ptr<MarketEvent>& event)
+bool OrderBook::apply_event(const std::shared_ptr<MarketEvent>& event)
 {
     switch (event->type) {
     case MarketEvent::EventType::QUOTE_UPDATE: {
         auto quote = std::static_pointer_cast<QuoteEvent>(event);
-        apply_quote_event(*quote);
-        break;
+        last_sequence_ = quote->rpt_seq.value_or(quote->sequence_number);
+        return apply_quote_event(*quote);
     }
     case MarketEvent::EventType::TRADE: {
         auto trade = std::static_pointer_cast<TradeEvent>(event);
+        last_sequence_ = trade->rpt_seq.value_or(trade->sequence_number);
         apply_trade_event(*trade);
         break;
     }
+    case MarketEvent::EventType::ORDER_UPDATE: {
+        auto order = std::static_pointer_cast<OrderEvent>(event);
+        last_sequence_ = order->rpt_seq.value_or(order->sequence_number);
+        OrderRecord record { order->order_id, order->priority, order->price, order->quantity,
+            order->side, order->action };
+        return apply_order_update(record, order->timestamp_ns);
+    }
     case MarketEvent::EventType::BOOK_CLEAR: {
         clear();
         break;
@@ -245,6 +374,53 @@ void OrderBook::apply_event(const std::shared_ptr<MarketEvent>& event)
         // Ignore other event types for now
         break;
     }
+    return true;
+}
+
+bool OrderBook::apply_record(const EventRecord& record)
+{
+    if (record.type != MarketEvent::EventType::BOOK_CLEAR) {
+        last_sequence_ = record.has(EventRecord::HAS_RPT_SEQ) ? record.rpt_seq : record.sequence_number;
+    }
+
+    switch (record.type) {
+    case MarketEvent::EventType::QUOTE_UPDATE: {
+        PriceLevel level;
+        level.price = record.quote.price;
+        level.quantity = record.quote.quantity;
+        level.order_count = record.quote.order_count;
+        level.last_update_time = record.timestamp_ns;
+        if (record.has(EventRecord::HAS_PRICE_LEVEL)) {
+            level.level_number = record.quote.price_level;
+        }
+        if (record.quote.market_maker_id) {
+            level.market_maker_id = StringInterner::instance().lookup(record.quote.market_maker_id);
+        }
+        return apply_level_update(record.quote.side, level, record.quote.action);
+    }
+    case MarketEvent::EventType::TRADE: {
+        Trade trade;
+        trade.price = record.trade.price;
+        trade.quantity = record.trade.quantity;
+        trade.timestamp_ns = record.timestamp_ns;
+        if (record.has(EventRecord::HAS_AGGRESSOR_SIDE)) {
+            trade.aggressor_side = record.trade.aggressor_side;
+        }
+        if (record.trade.trade_id) {
+            trade.trade_id = StringInterner::instance().lookup(record.trade.trade_id);
+        }
+        add_trade(trade);
+        break;
+    }
+    case MarketEvent::EventType::ORDER_UPDATE:
+        return apply_order_update(record.order, record.timestamp_ns);
+    case MarketEvent::EventType::BOOK_CLEAR:
+        clear();
+        break;
+    default:
+        break;
+    }
+    return true;
 }
 
 void OrderBook::update_stats_on_trade(const Trade& trade)
@@ -275,7 +451,7 @@ void OrderBook::update_stats_on_trade(const Trade& trade)
     }
 }
 
-void OrderBook::apply_quote_event(const QuoteEvent& quote)
+bool OrderBook::apply_quote_event(const QuoteEvent& quote)
 {
     PriceLevel level;
     level.price = quote.price;
@@ -284,19 +460,24 @@ void OrderBook::apply_quote_event(const QuoteEvent& quote)
     level.last_update_time = quote.timestamp_ns;
     level.level_number = quote.price_level;
 
-    switch (quote.action) {
+    return apply_level_update(quote.side, level, quote.action);
+}
+
+bool OrderBook::apply_level_update(Side side, const PriceLevel& level, UpdateAction action)
+{
+    switch (action) {
     case UpdateAction::ADD:
     case UpdateAction::CHANGE:
     case UpdateAction::OVERLAY:
-        update_level(quote.side, level);
-        break;
+        return update_level(side, level);
     case UpdateAction::DELETE:
-        remove_level(quote.side, quote.price);
+        remove_level(side, level.price);
         break;
     case UpdateAction::CLEAR:
-        clear_side(quote.side);
+        clear_side(side);
         break;
     }
+    return true;
 }
 
 void OrderBook::apply_trade_event(const TradeEvent& trade_event)
@@ -311,4 +492,63 @@ void OrderBook::apply_trade_event(const TradeEvent& trade_event)
     add_trade(trade);
 }
 
-} // namespace market_core
\ No newline at end of file
+bool OrderBook::apply_order_update(const OrderRecord& order, uint64_t timestamp_ns)
+{
+    if (!orders_) {
+        return true; // Price-aggregated book ignores order detail
+    }
+
+    // Modifies and cancels act on the resting order's side
+    auto existing = orders_->find_order(order.order_id);
+    Side side = existing ? existing->side : order.side;
+
+    // An order whose level the book cannot store is refused. Duplicate
+    // adds and changes to unknown orders stay no-ops, as before.
+    switch (order.action) {
+    case UpdateAction::ADD:
+        if (!orders_->add_order(order.order_id, order.side, order.price, order.quantity,
+                order.priority, timestamp_ns)
+            && !existing) {
+            return false;
+        }
+        break;
+    case UpdateAction::CHANGE:
+    case UpdateAction::OVERLAY:
+        if (!orders_->modify_order(order.order_id, order.price, order.quantity,
+                order.priority, timestamp_ns)
+            && existing) {
+            return false;
+        }
+        break;
+    case UpdateAction::DELETE:
+        orders_->cancel_order(order.order_id);
+        break;
+    case UpdateAction::CLEAR:
+        orders_->clear();
+        clear_side(Side::BID);
+        clear_side(Side::ASK);
+        return true;
+    }
+
+    // Re-derive the aggregated levels touched by this order
+    bool synced = true;
+    if (existing && existing->price != order.price) {
+        synced &= sync_level_from_orders(side, existing->price, timestamp_ns);
+    }
+    synced &= sync_level_from_orders(side, order.price, timestamp_ns);
+    return synced;
+}
+
+bool OrderBook::sync_level_from_orders(Side side, double price, uint64_t timestamp_ns)
+{
+    auto level = orders_->get_level(side, price);
+    if (!level) {
+        remove_level(side, price);
+        return true;
+    }
+
+    level->last_update_time = timestamp_ns;
+    return update_level(side, *level);
+}
+
+} // namespace market_core
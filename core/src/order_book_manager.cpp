@@ -3,58 +3,159 @@
 
 namespace market_core {
 
-bool OrderBookManager::add_instrument(std::shared_ptr<Instrument> instrument)
+static constexpr size_t INITIAL_REGISTRY_CAPACITY = 256;
+
+// ===========================
+// Registry
+// ===========================
+
+OrderBookManager::Registry::Registry(size_t capacity)
+    : slots(new std::atomic<const Entry*>[capacity])
+    , mask(capacity - 1)
+{
+    for (size_t i = 0; i < capacity; ++i) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+const OrderBookManager::Entry* OrderBookManager::Registry::find(uint32_t instrument_id) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t pos = OrderBookManager::hash(instrument_id) & mask;; pos = (pos + 1) & mask) {
+        const Entry* entry = slots[pos].load(std::memory_order_acquire);
+        if (!entry || entry->instrument_id == instrument_id) {
+            return entry;
+        }
+    }
+}
 
+std::atomic<const OrderBookManager::Entry*>* OrderBookManager::Registry::slot_for(uint32_t instrument_id)
+{
+    for (size_t pos = OrderBookManager::hash(instrument_id) & mask;; pos = (pos + 1) & mask) {
+        const Entry* entry = slots[pos].load(std::memory_order_relaxed);
+        if (!entry || entry->instrument_id == instrument_id) {
+            return &slots[pos];
+        }
+    }
+}
+
+// ===========================
+// OrderBookManager
+// ===========================
+
+OrderBookManager::OrderBookManager(size_t shard_count)
+    : shard_count_(std::max<size_t>(shard_count, 1))
+    , shards_(new Shard[shard_count_])
+    , registry_(new Registry(INITIAL_REGISTRY_CAPACITY))
+{
+}
+
+OrderBookManager::~OrderBookManager()
+{
+    delete registry_.load(std::memory_order_relaxed);
+}
+
+size_t OrderBookManager::hash(uint32_t instrument_id)
+{
+    uint64_t key = instrument_id;
+    key ^= key >> 16;
+    key *= 0x9e3779b97f4a7c15ULL;
+    key ^= key >> 32;
+    return static_cast<size_t>(key);
+}
+
+const OrderBookManager::Entry* OrderBookManager::find_entry(uint32_t instrument_id) const
+{
+    return registry_.load(std::memory_order_acquire)->find(instrument_id);
+}
+
+void OrderBookManager::publish_entry(Entry entry)
+{
+    Registry* registry = registry_.load(std::memory_order_relaxed);
+    std::atomic<const Entry*>* slot = registry->slot_for(entry.instrument_id);
+    bool is_new = slot->load(std::memory_order_relaxed) == nullptr;
+
+    // Keep load factor at or below 1/2; readers on the old table still see
+    // every entry it held
+    if (is_new && (registry->size + 1) * 2 > registry->mask + 1) {
+        auto grown = std::make_unique<Registry>((registry->mask + 1) * 2);
+        for (size_t i = 0; i <= registry->mask; ++i) {
+            const Entry* existing = registry->slots[i].load(std::memory_order_relaxed);
+            if (existing) {
+                grown->slot_for(existing->instrument_id)->store(existing, std::memory_order_relaxed);
+                grown->size++;
+            }
+        }
+
+        Registry* next = grown.release();
+        registry_.store(next, std::memory_order_release);
+        retired_registries_.emplace_back(registry);
+        registry = next;
+        slot = registry->slot_for(entry.instrument_id);
+    }
+
+    entries_.push_back(std::make_unique<const Entry>(std::move(entry)));
+    slot->store(entries_.back().get(), std::memory_order_release);
+    if (is_new) {
+        registry->size++;
+    }
+}
+
+template <typename Fn>
+void OrderBookManager::for_each_entry(Fn&& fn) const
+{
+    const Registry* registry = registry_.load(std::memory_order_acquire);
+    for (size_t i = 0; i <= registry->mask; ++i) {
+        const Entry* entry = registry->slots[i].load(std::memory_order_acquire);
+        if (entry) {
+            fn(*entry);
+        }
+    }
+}
+
+bool OrderBookManager::add_instrument(std::shared_ptr<Instrument> instrument)
+{
     if (!instrument) {
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+
     uint32_t id = instrument->instrument_id;
-    if (instruments_.find(id) != instruments_.end()) {
+    if (find_entry(id)) {
         return false; // Already exists
     }
 
-    instruments_[id] = instrument;
+    publish_entry(Entry { id, static_cast<uint32_t>(hash(id) % shard_count_), instrument, nullptr });
+    instrument_count_.fetch_add(1, std::memory_order_relaxed);
     return true;
 }
 
 std::shared_ptr<Instrument> OrderBookManager::get_instrument(uint32_t instrument_id) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = instruments_.find(instrument_id);
-    if (it != instruments_.end()) {
-        return it->second;
-    }
-    return nullptr;
+    const Entry* entry = find_entry(instrument_id);
+    return entry ? entry->instrument : nullptr;
 }
 
 std::vector<std::shared_ptr<Instrument>> OrderBookManager::get_all_instruments() const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
     std::vector<std::shared_ptr<Instrument>> result;
-    result.reserve(instruments_.size());
+    result.reserve(instrument_count());
 
-    for (const auto& [id, instrument] : instruments_) {
-        result.push_back(instrument);
-    }
+    for_each_entry([&](const Entry& entry) {
+        result.push_back(entry.instrument);
+    });
 
     return result;
 }
 
 std::vector<uint32_t> OrderBookManager::get_all_instrument_ids() const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
     std::vector<uint32_t> result;
-    result.reserve(instruments_.size());
+    result.reserve(instrument_count());
 
-    for (const auto& [id, instrument] : instruments_) {
-        result.push_back(id);
-    }
+    for_each_entry([&](const Entry& entry) {
+        result.push_back(entry.instrument_id);
+    });
 
     return result;
 }
@@ -63,45 +164,50 @@ bool OrderBookManager::create_order_book(
     uint32_t instrument_id,
     const OrderBook::Config& config)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::mutex> lock(registry_mutex_);
 
-    if (!validate_instrument(instrument_id)) {
+    const Entry* entry = find_entry(instrument_id);
+    if (!entry) {
         return false; // Instrument doesn't exist
     }
 
-    if (order_books_.find(instrument_id) != order_books_.end()) {
+    if (entry->book) {
         return false; // Order book already exists
     }
 
-    auto instrument = instruments_[instrument_id];
+    const auto& instrument = entry->instrument;
     auto book = std::make_shared<OrderBook>(instrument_id, instrument->primary_symbol);
-    book->set_config(config);
 
-    order_books_[instrument_id] = book;
+    // Tick ladder and order-level books index prices by the instrument's tick
+    // unless overridden
+    OrderBook::Config book_config = config;
+    bool tick_indexed = book_config.storage == OrderBook::Storage::TICK_LADDER || !book_config.aggregate_by_price;
+    if (tick_indexed && book_config.tick_size <= 0.0) {
+        book_config.tick_size = instrument->tick_size;
+    }
+    book->set_config(book_config);
+
+    publish_entry(Entry { instrument_id, entry->shard, instrument, book });
+    book_count_.fetch_add(1, std::memory_order_relaxed);
     return true;
 }
 
 std::shared_ptr<OrderBook> OrderBookManager::get_order_book(uint32_t instrument_id) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto it = order_books_.find(instrument_id);
-    if (it != order_books_.end()) {
-        return it->second;
-    }
-    return nullptr;
+    const Entry* entry = find_entry(instrument_id);
+    return entry ? entry->book : nullptr;
 }
 
 std::vector<std::shared_ptr<OrderBook>> OrderBookManager::get_all_order_books() const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
     std::vector<std::shared_ptr<OrderBook>> result;
-    result.reserve(order_books_.size());
+    result.reserve(book_count());
 
-    for (const auto& [id, book] : order_books_) {
-        result.push_back(book);
-    }
+    for_each_entry([&](const Entry& entry) {
+        if (entry.book) {
+            result.push_back(entry.book);
+        }
+    });
 
     return result;
 }
@@ -109,63 +215,88 @@ std::vector<std::shared_ptr<OrderBook>> OrderBookManager::get_all_order_books()
 std::pair<std::shared_ptr<Instrument>, std::shared_ptr<OrderBook>>
 OrderBookManager::get_instrument_and_book(uint32_t instrument_id) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto instrument_it = instruments_.find(instrument_id);
-    auto book_it = order_books_.find(instrument_id);
-
-    std::shared_ptr<Instrument> instrument = (instrument_it != instruments_.end()) ? instrument_it->second : nullptr;
-
-    std::shared_ptr<OrderBook> book = (book_it != order_books_.end()) ? book_it->second : nullptr;
-
-    return { instrument, book };
+    const Entry* entry = find_entry(instrument_id);
+    if (!entry) {
+        return { nullptr, nullptr };
+    }
+    return { entry->instrument, entry->book };
 }
 
 void OrderBookManager::clear_all_books()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    for (auto& [id, book] : order_books_) {
-        book->clear();
-    }
+    for_each_entry([&](const Entry& entry) {
+        if (entry.book) {
+            std::lock_guard<std::mutex> lock(shard_for(entry).mutex);
+            entry.book->clear();
+        }
+    });
 }
 
 void OrderBookManager::reset_all_books()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    order_books_.clear();
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+
+    std::vector<const Entry*> with_books;
+    for_each_entry([&](const Entry& entry) {
+        if (entry.book) {
+            with_books.push_back(&entry);
+        }
+    });
+
+    for (const Entry* entry : with_books) {
+        publish_entry(Entry { entry->instrument_id, entry->shard, entry->instrument, nullptr });
+    }
+    book_count_.store(0, std::memory_order_relaxed);
 }
 
-void OrderBookManager::apply_event(const std::shared_ptr<MarketEvent>& event)
+bool OrderBookManager::apply_event(const std::shared_ptr<MarketEvent>& event)
 {
     if (!event) {
-        return;
+        return true;
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
+    const Entry* entry = find_entry(event->instrument_id);
+    if (entry && entry->book) {
+        std::lock_guard<std::mutex> lock(shard_for(*entry).mutex);
+        return entry->book->apply_event(event);
+    }
+    return true;
+}
 
-    auto book_it = order_books_.find(event->instrument_id);
-    if (book_it != order_books_.end()) {
-        book_it->second->apply_event(event);
+bool OrderBookManager::apply_record(const EventRecord& record)
+{
+    const Entry* entry = find_entry(record.instrument_id);
+    if (entry && entry->book) {
+        std::lock_guard<std::mutex> lock(shard_for(*entry).mutex);
+        return entry->book->apply_record(record);
     }
+    return true;
 }
 
 std::shared_ptr<SnapshotEvent> OrderBookManager::create_snapshot(
     uint32_t instrument_id,
     size_t max_levels) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    auto book_it = order_books_.find(instrument_id);
-    if (book_it != order_books_.end()) {
-        return book_it->second->create_snapshot_event(max_levels);
+    const Entry* entry = find_entry(instrument_id);
+    if (entry && entry->book) {
+        std::lock_guard<std::mutex> lock(shard_for(*entry).mutex);
+        return entry->book->create_snapshot_event(max_levels);
     }
     return nullptr;
 }
 
-bool OrderBookManager::validate_instrument(uint32_t instrument_id) const
+bool OrderBookManager::capture_snapshot(
+    uint32_t instrument_id,
+    SnapshotEvent& snapshot,
+    size_t max_levels) const
 {
-    return instruments_.find(instrument_id) != instruments_.end();
+    const Entry* entry = find_entry(instrument_id);
+    if (!entry || !entry->book) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(shard_for(*entry).mutex);
+    entry->book->fill_snapshot_event(snapshot, max_levels);
+    return true;
 }
 
-} // namespace market_core
\ No newline at end of file
+} // namespace market_core
@@ -0,0 +1,458 @@
+#include "../include/order_level_book.h"
+#include "../include/order_book.h"
+#include <algorithm>
+#include <cmath>
+
+namespace market_core {
+
+// ===========================
+// FlatIndex
+// ===========================
+
+static size_t next_power_of_two(size_t n)
+{
+    size_t p = 16;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+FlatIndex::FlatIndex(size_t capacity)
+    : table_(next_power_of_two(capacity * 2), Entry { 0, NPOS })
+    , mask_(table_.size() - 1)
+{
+}
+
+uint32_t FlatIndex::find(uint64_t key) const
+{
+    for (size_t pos = hash(key) & mask_;; pos = (pos + 1) & mask_) {
+        const Entry& entry = table_[pos];
+        if (entry.value == NPOS) {
+            return NPOS;
+        }
+        if (entry.key == key) {
+            return entry.value;
+        }
+    }
+}
+
+void FlatIndex::insert(uint64_t key, uint32_t value)
+{
+    // Keep load factor at or below 1/2
+    if ((size_ + 1) * 2 > table_.size()) {
+        grow();
+    }
+
+    size_t pos = hash(key) & mask_;
+    while (table_[pos].value != NPOS) {
+        pos = (pos + 1) & mask_;
+    }
+    table_[pos] = Entry { key, value };
+    ++size_;
+}
+
+bool FlatIndex::erase(uint64_t key)
+{
+    size_t pos = hash(key) & mask_;
+    while (true) {
+        if (table_[pos].value == NPOS) {
+            return false;
+        }
+        if (table_[pos].key == key) {
+            break;
+        }
+        pos = (pos + 1) & mask_;
+    }
+
+    // Backward-shift: pull later entries of the probe run into the hole
+    size_t hole = pos;
+    for (size_t next = (hole + 1) & mask_; table_[next].value != NPOS; next = (next + 1) & mask_) {
+        size_t home = hash(table_[next].key) & mask_;
+        bool movable = (hole <= next) ? (home <= hole || home > next) : (home <= hole && home > next);
+        if (movable) {
+            table_[hole] = table_[next];
+            hole = next;
+        }
+    }
+    table_[hole].value = NPOS;
+    --size_;
+    return true;
+}
+
+void FlatIndex::clear()
+{
+    std::fill(table_.begin(), table_.end(), Entry { 0, NPOS });
+    size_ = 0;
+}
+
+void FlatIndex::grow()
+{
+    std::vector<Entry> old;
+    old.swap(table_);
+    table_.assign(old.size() * 2, Entry { 0, NPOS });
+    mask_ = table_.size() - 1;
+    size_ = 0;
+
+    for (const auto& entry : old) {
+        if (entry.value != NPOS) {
+            insert(entry.key, entry.value);
+        }
+    }
+}
+
+// ===========================
+// OrderLevelBook
+// ===========================
+
+OrderLevelBook::OrderLevelBook(double tick_size, size_t expected_orders)
+    : tick_size_(tick_size > 0.0 ? tick_size : 0.01)
+    , order_index_(expected_orders)
+    , bid_level_index_(256)
+    , ask_level_index_(256)
+    , bid_ladder_(Side::BID, tick_size_)
+    , ask_ladder_(Side::ASK, tick_size_)
+{
+    nodes_.reserve(expected_orders);
+    live_orders_.reserve(expected_orders);
+    levels_.reserve(512);
+}
+
+bool OrderLevelBook::to_tick(double price, int64_t& tick) const
+{
+    // Doubles are exact integers up to 2^53
+    double ticks = price / tick_size_;
+    if (!(std::fabs(ticks) < 0x1p53)) {
+        return false;
+    }
+    tick = std::llround(ticks);
+    return true;
+}
+
+bool OrderLevelBook::add_order(uint64_t order_id, Side side, double price, uint64_t quantity,
+    uint64_t priority, uint64_t timestamp_ns)
+{
+    if (side != Side::BID && side != Side::ASK) {
+        return false;
+    }
+    if (order_index_.find(order_id) != FlatIndex::NPOS) {
+        return false;
+    }
+    // Every live order has its level on the ladder
+    if (!ladder(side).accepts(price)) {
+        return false;
+    }
+
+    uint32_t idx = allocate_node();
+    OrderNode& node = nodes_[idx];
+    node.order_id = order_id;
+    node.quantity = quantity;
+    node.priority = priority;
+    node.timestamp_ns = timestamp_ns;
+    node.price = price;
+    node.side = side;
+    node.live_pos = static_cast<uint32_t>(live_orders_.size());
+    live_orders_.push_back(idx);
+    order_index_.insert(order_id, idx);
+
+    uint32_t level_idx = find_or_create_level(side, price);
+    link_back(level_idx, idx);
+    publish_level(level_idx);
+    return true;
+}
+
+bool OrderLevelBook::modify_order(uint64_t order_id, double price, uint64_t quantity,
+    uint64_t priority, uint64_t timestamp_ns)
+{
+    uint32_t idx = order_index_.find(order_id);
+    if (idx == FlatIndex::NPOS) {
+        return false;
+    }
+
+    if (quantity == 0) {
+        return cancel_order(order_id);
+    }
+
+    OrderNode& node = nodes_[idx];
+    int64_t tick;
+    if (!to_tick(price, tick)) {
+        return false;
+    }
+    bool same_level = tick == levels_[node.level].tick;
+    // An order that is alone on its side leaves nothing to span
+    bool alone = levels_[node.level].order_count == 1 && ladder(node.side).size() == 1;
+    if (!same_level && !alone && !ladder(node.side).accepts(price)) {
+        return false;
+    }
+    node.timestamp_ns = timestamp_ns;
+
+    if (same_level && quantity <= node.quantity) {
+        // Size reduction keeps queue position
+        levels_[node.level].total_quantity -= node.quantity - quantity;
+        node.quantity = quantity;
+        publish_level(node.level);
+        return true;
+    }
+
+    // Loses priority: requeue at the back of the (possibly new) level
+    uint32_t old_level = node.level;
+    unlink(idx);
+    if (levels_[old_level].order_count == 0) {
+        release_level(old_level);
+    } else {
+        publish_level(old_level);
+    }
+
+    nodes_[idx].price = price;
+    nodes_[idx].quantity = quantity;
+    nodes_[idx].priority = priority;
+
+    uint32_t new_level = find_or_create_level(nodes_[idx].side, price);
+    link_back(new_level, idx);
+    publish_level(new_level);
+    return true;
+}
+
+bool OrderLevelBook::cancel_order(uint64_t order_id)
+{
+    uint32_t idx = order_index_.find(order_id);
+    if (idx == FlatIndex::NPOS) {
+        return false;
+    }
+
+    uint32_t level_idx = nodes_[idx].level;
+    unlink(idx);
+    if (levels_[level_idx].order_count == 0) {
+        release_level(level_idx);
+    } else {
+        publish_level(level_idx);
+    }
+
+    order_index_.erase(order_id);
+    release_node(idx);
+    return true;
+}
+
+bool OrderLevelBook::fill_order(uint64_t order_id, uint64_t quantity)
+{
+    uint32_t idx = order_index_.find(order_id);
+    if (idx == FlatIndex::NPOS) {
+        return false;
+    }
+
+    OrderNode& node = nodes_[idx];
+    if (quantity >= node.quantity) {
+        return cancel_order(order_id);
+    }
+
+    node.quantity -= quantity;
+    levels_[node.level].total_quantity -= quantity;
+    publish_level(node.level);
+    return true;
+}
+
+void OrderLevelBook::clear()
+{
+    nodes_.clear();
+    free_node_ = NIL;
+    live_orders_.clear();
+    order_index_.clear();
+
+    levels_.clear();
+    free_level_ = NIL;
+    bid_level_index_.clear();
+    ask_level_index_.clear();
+
+    bid_ladder_.clear();
+    ask_ladder_.clear();
+}
+
+std::optional<OrderEntry> OrderLevelBook::find_order(uint64_t order_id) const
+{
+    uint32_t idx = order_index_.find(order_id);
+    if (idx == FlatIndex::NPOS) {
+        return std::nullopt;
+    }
+    return to_entry(nodes_[idx]);
+}
+
+size_t OrderLevelBook::level_count(Side side) const
+{
+    return ladder(side).size();
+}
+
+std::optional<double> OrderLevelBook::best_price(Side side) const
+{
+    return ladder(side).best_price();
+}
+
+std::vector<PriceLevel> OrderLevelBook::get_levels(Side side, size_t max_levels) const
+{
+    return ladder(side).levels(max_levels);
+}
+
+std::optional<PriceLevel> OrderLevelBook::get_level(Side side, double price) const
+{
+    int64_t tick;
+    if (!to_tick(price, tick)) {
+        return std::nullopt;
+    }
+    uint32_t level_idx = level_index(side).find(static_cast<uint64_t>(tick));
+    if (level_idx == FlatIndex::NPOS) {
+        return std::nullopt;
+    }
+
+    const LevelQueue& level = levels_[level_idx];
+    PriceLevel result {};
+    result.price = level.price;
+    result.quantity = level.total_quantity;
+    result.order_count = level.order_count;
+    return result;
+}
+
+std::vector<OrderEntry> OrderLevelBook::get_orders(Side side, size_t max_levels) const
+{
+    std::vector<OrderEntry> result;
+
+    for (const auto& price_level : ladder(side).levels(max_levels)) {
+        int64_t tick;
+        uint32_t level_idx = to_tick(price_level.price, tick)
+            ? level_index(side).find(static_cast<uint64_t>(tick))
+            : FlatIndex::NPOS;
+        if (level_idx == FlatIndex::NPOS) {
+            continue;
+        }
+        for (uint32_t idx = levels_[level_idx].head; idx != NIL; idx = nodes_[idx].next) {
+            result.push_back(to_entry(nodes_[idx]));
+        }
+    }
+
+    return result;
+}
+
+uint32_t OrderLevelBook::allocate_node()
+{
+    if (free_node_ != NIL) {
+        uint32_t idx = free_node_;
+        free_node_ = nodes_[idx].next;
+        return idx;
+    }
+
+    nodes_.emplace_back();
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+void OrderLevelBook::release_node(uint32_t idx)
+{
+    // Swap-remove from the dense live list
+    uint32_t pos = nodes_[idx].live_pos;
+    uint32_t last = live_orders_.back();
+    live_orders_[pos] = last;
+    nodes_[last].live_pos = pos;
+    live_orders_.pop_back();
+
+    nodes_[idx].next = free_node_;
+    free_node_ = idx;
+}
+
+uint32_t OrderLevelBook::find_or_create_level(Side side, double price)
+{
+    int64_t tick = 0;
+    to_tick(price, tick); // Callers checked the price
+    FlatIndex& index = level_index(side);
+
+    uint32_t idx = index.find(static_cast<uint64_t>(tick));
+    if (idx != FlatIndex::NPOS) {
+        return idx;
+    }
+
+    if (free_level_ != NIL) {
+        idx = free_level_;
+        free_level_ = levels_[idx].tail;
+    } else {
+        levels_.emplace_back();
+        idx = static_cast<uint32_t>(levels_.size() - 1);
+    }
+
+    LevelQueue& level = levels_[idx];
+    level.price = price;
+    level.tick = tick;
+    level.total_quantity = 0;
+    level.order_count = 0;
+    level.head = NIL;
+    level.tail = NIL;
+    level.side = side;
+
+    index.insert(static_cast<uint64_t>(tick), idx);
+    return idx;
+}
+
+void OrderLevelBook::release_level(uint32_t idx)
+{
+    LevelQueue& level = levels_[idx];
+    level_index(level.side).erase(static_cast<uint64_t>(level.tick));
+    ladder(level.side).erase(level.price);
+
+    level.tail = free_level_;
+    free_level_ = idx;
+}
+
+void OrderLevelBook::link_back(uint32_t level_idx, uint32_t node_idx)
+{
+    LevelQueue& level = levels_[level_idx];
+    OrderNode& node = nodes_[node_idx];
+
+    node.level = level_idx;
+    node.prev = level.tail;
+    node.next = NIL;
+
+    if (level.tail != NIL) {
+        nodes_[level.tail].next = node_idx;
+    } else {
+        level.head = node_idx;
+    }
+    level.tail = node_idx;
+
+    level.order_count++;
+    level.total_quantity += node.quantity;
+}
+
+void OrderLevelBook::unlink(uint32_t node_idx)
+{
+    OrderNode& node = nodes_[node_idx];
+    LevelQueue& level = levels_[node.level];
+
+    if (node.prev != NIL) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        level.head = node.next;
+    }
+    if (node.next != NIL) {
+        nodes_[node.next].prev = node.prev;
+    } else {
+        level.tail = node.prev;
+    }
+
+    level.order_count--;
+    level.total_quantity -= node.quantity;
+}
+
+void OrderLevelBook::publish_level(uint32_t level_idx)
+{
+    const LevelQueue& level = levels_[level_idx];
+
+    PriceLevel aggregated {};
+    aggregated.price = level.price;
+    aggregated.quantity = level.total_quantity;
+    aggregated.order_count = level.order_count;
+    aggregated.last_update_time = level.tail != NIL ? nodes_[level.tail].timestamp_ns : 0;
+    // add_order and modify_order checked that the ladder takes the price
+    ladder(level.side).set(aggregated);
+}
+
+OrderEntry OrderLevelBook::to_entry(const OrderNode& node) const
+{
+    return OrderEntry { node.order_id, node.side, node.price, node.quantity, node.priority, node.timestamp_ns };
+}
+
+} // namespace market_core
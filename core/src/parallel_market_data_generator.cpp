@@ -0,0 +1,191 @@
+#include "../include/parallel_market_data_generator.h"
+#include <algorithm>
+
+namespace market_core {
+
+// Shared by every shard so a listener only ever sees one batch at a time
+class SerializedRecordListener : public IEventRecordListener {
+public:
+    explicit SerializedRecordListener(std::weak_ptr<IEventRecordListener> target)
+        : target_(std::move(target))
+    {
+    }
+
+    void on_event_record(const EventRecord& record) override
+    {
+        if (auto target = target_.lock()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            target->on_event_record(record);
+        }
+    }
+
+    void on_market_events(EventRecordSpan records) override
+    {
+        if (auto target = target_.lock()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            target->on_market_events(records);
+        }
+    }
+
+private:
+    std::weak_ptr<IEventRecordListener> target_;
+    std::mutex mutex_;
+};
+
+ParallelMarketDataGenerator::ParallelMarketDataGenerator(
+    std::shared_ptr<OrderBookManager> book_manager,
+    size_t thread_count,
+    uint64_t seed)
+    : book_manager_(book_manager)
+{
+    thread_count = std::max<size_t>(thread_count, 1);
+    for (size_t i = 0; i < thread_count; ++i) {
+        shards_.push_back(std::make_unique<MarketDataGenerator>(book_manager_, seed, i));
+        // Top 16 bits of the order ID identify the shard
+        shards_.back()->set_order_id_base((static_cast<uint64_t>(i) << 48) + 1);
+    }
+    repartition();
+
+    for (size_t i = 0; i < thread_count; ++i) {
+        workers_.emplace_back(&ParallelMarketDataGenerator::worker_loop, this, i);
+    }
+}
+
+ParallelMarketDataGenerator::~ParallelMarketDataGenerator()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_ready_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ParallelMarketDataGenerator::set_config(const MarketConfig& config)
+{
+    for (auto& shard : shards_) {
+        shard->set_config(config);
+    }
+}
+
+void ParallelMarketDataGenerator::set_market_mode(MarketMode mode)
+{
+    for (auto& shard : shards_) {
+        shard->set_market_mode(mode);
+    }
+}
+
+void ParallelMarketDataGenerator::repartition()
+{
+    // Registry order depends on hashing, so sort for a stable assignment
+    auto instrument_ids = book_manager_->get_all_instrument_ids();
+    std::sort(instrument_ids.begin(), instrument_ids.end());
+
+    std::vector<std::vector<uint32_t>> partitions(shards_.size());
+    for (size_t i = 0; i < instrument_ids.size(); ++i) {
+        partitions[i % shards_.size()].push_back(instrument_ids[i]);
+    }
+
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        shards_[i]->set_instruments(std::move(partitions[i]));
+    }
+}
+
+void ParallelMarketDataGenerator::generate_batch(int updates_per_thread)
+{
+    run([updates_per_thread](MarketDataGenerator& shard) {
+        // Shards left without instruments (more threads than instruments)
+        // would otherwise fall back to every instrument
+        if (!shard.get_instruments().empty()) {
+            shard.generate_batch(updates_per_thread);
+        }
+    });
+}
+
+void ParallelMarketDataGenerator::generate_all_instruments()
+{
+    run([](MarketDataGenerator& shard) {
+        if (!shard.get_instruments().empty()) {
+            shard.generate_all_instruments();
+        }
+    });
+}
+
+void ParallelMarketDataGenerator::add_record_listener(std::weak_ptr<IEventRecordListener> listener)
+{
+    auto forwarder = std::make_shared<SerializedRecordListener>(std::move(listener));
+    for (auto& shard : shards_) {
+        shard->add_record_listener(forwarder);
+    }
+    forwarders_.push_back(forwarder);
+}
+
+void ParallelMarketDataGenerator::clear_listeners()
+{
+    for (auto& shard : shards_) {
+        shard->clear_listeners();
+    }
+    forwarders_.clear();
+}
+
+MarketDataGenerator::Statistics ParallelMarketDataGenerator::get_statistics() const
+{
+    MarketDataGenerator::Statistics total;
+    total.start_time = shards_.front()->get_statistics().start_time;
+    for (const auto& shard : shards_) {
+        const auto& stats = shard->get_statistics();
+        total.updates_generated += stats.updates_generated;
+        total.trades_generated += stats.trades_generated;
+        total.quotes_generated += stats.quotes_generated;
+        total.orders_generated += stats.orders_generated;
+        total.snapshots_generated += stats.snapshots_generated;
+        total.start_time = std::min(total.start_time, stats.start_time);
+    }
+    return total;
+}
+
+void ParallelMarketDataGenerator::reset_statistics()
+{
+    for (auto& shard : shards_) {
+        shard->reset_statistics();
+    }
+}
+
+void ParallelMarketDataGenerator::run(std::function<void(MarketDataGenerator&)> task)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    task_ = std::move(task);
+    pending_ = workers_.size();
+    ++generation_;
+    work_ready_.notify_all();
+    work_done_.wait(lock, [this] { return pending_ == 0; });
+    task_ = nullptr;
+}
+
+void ParallelMarketDataGenerator::worker_loop(size_t index)
+{
+    uint64_t seen = 0;
+    while (true) {
+        std::function<void(MarketDataGenerator&)> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_ready_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+            task = task_;
+        }
+
+        task(*shards_[index]);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0) {
+            work_done_.notify_one();
+        }
+    }
+}
+
+} // namespace market_core
@@ -0,0 +1,288 @@
+#include "../include/price_ladder.h"
+#include "../include/order_book.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+namespace market_core {
+
+static size_t round_capacity(size_t capacity)
+{
+    return std::max<size_t>(64, (capacity + 63) & ~size_t(63));
+}
+
+static int highest_bit(uint64_t word) { return 63 - __builtin_clzll(word); }
+static int lowest_bit(uint64_t word) { return __builtin_ctzll(word); }
+
+void PriceLadder::AlignedDelete::operator()(Slot* p) const
+{
+    ::operator delete[](p, std::align_val_t(CACHE_LINE));
+}
+
+PriceLadder::SlotArray PriceLadder::allocate_slots(size_t capacity)
+{
+    void* raw = ::operator new[](capacity * sizeof(Slot), std::align_val_t(CACHE_LINE));
+    std::memset(raw, 0, capacity * sizeof(Slot));
+    return SlotArray(static_cast<Slot*>(raw));
+}
+
+PriceLadder::PriceLadder(Side side, double tick_size, size_t capacity)
+    : side_(side)
+    , tick_size_(tick_size > 0.0 ? tick_size : 0.01)
+    , capacity_(round_capacity(std::min(capacity, MAX_CAPACITY)))
+    , slots_(allocate_slots(capacity_))
+    , occupied_(capacity_ / 64, 0)
+{
+}
+
+bool PriceLadder::to_tick(double price, int64_t& tick) const
+{
+    // Doubles are exact integers up to 2^53
+    double ticks = price / tick_size_;
+    if (!(std::fabs(ticks) < 0x1p53)) {
+        return false;
+    }
+    tick = std::llround(ticks);
+    return true;
+}
+
+bool PriceLadder::set(const PriceLevel& level)
+{
+    int64_t tick;
+    if (!to_tick(level.price, tick)) {
+        return false;
+    }
+
+    if (count_ == 0) {
+        // Empty ladder: re-anchor for free with the new price in the middle
+        anchor_tick_ = tick - static_cast<int64_t>(capacity_ / 2);
+    } else if (tick < anchor_tick_ || tick >= anchor_tick_ + static_cast<int64_t>(capacity_)) {
+        if (!recenter(tick)) {
+            return false;
+        }
+    }
+
+    size_t idx = static_cast<size_t>(tick - anchor_tick_);
+    Slot& slot = slots_[idx];
+    slot.price = level.price;
+    slot.quantity = level.quantity;
+    slot.last_update_time = level.last_update_time;
+    slot.order_count = level.order_count;
+    slot.implied_quantity = level.implied_quantity.value_or(0);
+    slot.level_number = level.level_number.value_or(0);
+    slot.flags = (level.implied_quantity ? HAS_IMPLIED : 0)
+        | (level.level_number ? HAS_LEVEL_NUMBER : 0);
+
+    if (!is_occupied(idx)) {
+        occupied_[idx >> 6] |= uint64_t(1) << (idx & 63);
+        ++count_;
+        if (best_idx_ < 0 || better(static_cast<int64_t>(idx), best_idx_)) {
+            best_idx_ = static_cast<int64_t>(idx);
+        }
+    }
+    return true;
+}
+
+bool PriceLadder::accepts(double price) const
+{
+    int64_t tick;
+    if (!to_tick(price, tick)) {
+        return false;
+    }
+    if (count_ == 0 || (tick >= anchor_tick_ && tick < anchor_tick_ + static_cast<int64_t>(capacity_))) {
+        return true;
+    }
+    int64_t lo, hi;
+    occupied_range(tick, lo, hi);
+    return static_cast<size_t>(hi - lo + 1) <= MAX_CAPACITY;
+}
+
+bool PriceLadder::erase(double price)
+{
+    if (count_ == 0) {
+        return false;
+    }
+
+    int64_t tick;
+    if (!to_tick(price, tick)) {
+        return false;
+    }
+    int64_t offset = tick - anchor_tick_;
+    if (offset < 0 || offset >= static_cast<int64_t>(capacity_)) {
+        return false;
+    }
+
+    size_t idx = static_cast<size_t>(offset);
+    if (!is_occupied(idx)) {
+        return false;
+    }
+
+    occupied_[idx >> 6] &= ~(uint64_t(1) << (idx & 63));
+    --count_;
+
+    if (offset == best_idx_) {
+        best_idx_ = count_ == 0 ? -1 : next_worse(offset);
+    }
+    return true;
+}
+
+void PriceLadder::clear()
+{
+    std::fill(occupied_.begin(), occupied_.end(), 0);
+    count_ = 0;
+    best_idx_ = -1;
+}
+
+std::optional<double> PriceLadder::best_price() const
+{
+    if (best_idx_ < 0) {
+        return std::nullopt;
+    }
+    return slots_[best_idx_].price;
+}
+
+std::vector<PriceLevel> PriceLadder::levels(size_t max_levels) const
+{
+    std::vector<PriceLevel> result;
+    result.reserve(std::min(max_levels, count_));
+
+    for (int64_t idx = best_idx_; idx >= 0 && result.size() < max_levels; idx = next_worse(idx)) {
+        result.push_back(to_level(static_cast<size_t>(idx)));
+    }
+    return result;
+}
+
+int64_t PriceLadder::next_worse(int64_t idx) const
+{
+    // Bids get worse as price falls, asks as it rises
+    return side_ == Side::BID ? highest_below(idx) : lowest_above(idx);
+}
+
+int64_t PriceLadder::highest_below(int64_t idx) const
+{
+    if (idx <= 0) {
+        return -1;
+    }
+
+    int64_t pos = idx - 1;
+    size_t word = static_cast<size_t>(pos) >> 6;
+    uint64_t bits = occupied_[word] & (~uint64_t(0) >> (63 - (pos & 63)));
+
+    while (true) {
+        if (bits) {
+            return static_cast<int64_t>(word * 64 + highest_bit(bits));
+        }
+        if (word == 0) {
+            return -1;
+        }
+        bits = occupied_[--word];
+    }
+}
+
+int64_t PriceLadder::lowest_above(int64_t idx) const
+{
+    int64_t pos = idx + 1;
+    if (pos >= static_cast<int64_t>(capacity_)) {
+        return -1;
+    }
+
+    size_t word = static_cast<size_t>(pos) >> 6;
+    uint64_t bits = occupied_[word] & (~uint64_t(0) << (pos & 63));
+
+    while (true) {
+        if (bits) {
+            return static_cast<int64_t>(word * 64 + lowest_bit(bits));
+        }
+        if (++word == occupied_.size()) {
+            return -1;
+        }
+        bits = occupied_[word];
+    }
+}
+
+void PriceLadder::occupied_range(int64_t tick, int64_t& lo, int64_t& hi) const
+{
+    lo = tick;
+    hi = tick;
+    for (size_t word = 0; word < occupied_.size(); ++word) {
+        if (occupied_[word]) {
+            lo = std::min(lo, anchor_tick_ + static_cast<int64_t>(word * 64 + lowest_bit(occupied_[word])));
+            break;
+        }
+    }
+    for (size_t word = occupied_.size(); word-- > 0;) {
+        if (occupied_[word]) {
+            hi = std::max(hi, anchor_tick_ + static_cast<int64_t>(word * 64 + highest_bit(occupied_[word])));
+            break;
+        }
+    }
+}
+
+bool PriceLadder::recenter(int64_t tick)
+{
+    // Occupied range in absolute ticks, including the incoming price
+    int64_t lo, hi;
+    occupied_range(tick, lo, hi);
+
+    // An outlier far from the book would otherwise double the ladder
+    // until it spans the gap
+    size_t span = static_cast<size_t>(hi - lo + 1);
+    if (span > MAX_CAPACITY) {
+        return false;
+    }
+
+    // Keep at least as much headroom as the range itself so drift does not
+    // immediately trigger another recenter
+    size_t new_capacity = capacity_;
+    while (span * 2 > new_capacity && new_capacity < MAX_CAPACITY) {
+        new_capacity = std::min(new_capacity * 2, MAX_CAPACITY);
+    }
+
+    int64_t new_anchor = lo - static_cast<int64_t>((new_capacity - span) / 2);
+
+    SlotArray new_slots = allocate_slots(new_capacity);
+    std::vector<uint64_t> new_occupied(new_capacity / 64, 0);
+
+    for (size_t word = 0; word < occupied_.size(); ++word) {
+        uint64_t bits = occupied_[word];
+        while (bits) {
+            size_t old_idx = word * 64 + lowest_bit(bits);
+            bits &= bits - 1;
+            size_t new_idx = static_cast<size_t>(anchor_tick_ + static_cast<int64_t>(old_idx) - new_anchor);
+            new_slots[new_idx] = slots_[old_idx];
+            new_occupied[new_idx >> 6] |= uint64_t(1) << (new_idx & 63);
+        }
+    }
+
+    if (best_idx_ >= 0) {
+        best_idx_ += anchor_tick_ - new_anchor;
+    }
+
+    slots_ = std::move(new_slots);
+    occupied_ = std::move(new_occupied);
+    capacity_ = new_capacity;
+    anchor_tick_ = new_anchor;
+    ++recenter_count_;
+    return true;
+}
+
+PriceLevel PriceLadder::to_level(size_t idx) const
+{
+    const Slot& slot = slots_[idx];
+
+    PriceLevel level;
+    level.price = slot.price;
+    level.quantity = slot.quantity;
+    level.order_count = slot.order_count;
+    level.last_update_time = slot.last_update_time;
+    if (slot.flags & HAS_IMPLIED) {
+        level.implied_quantity = slot.implied_quantity;
+    }
+    if (slot.flags & HAS_LEVEL_NUMBER) {
+        level.level_number = slot.level_number;
+    }
+    return level;
+}
+
+} // namespace market_core
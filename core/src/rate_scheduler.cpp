@@ -0,0 +1,249 @@
+#include "../include/rate_scheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace market_core {
+
+// Guards against a refill at the exact deadline landing a hair under 1.0
+static constexpr double TOKEN_EPSILON = 1e-9;
+
+PacingTimer::clock::time_point PacingTimer::wait_until(clock::time_point deadline) const
+{
+    auto now = clock::now();
+    if (deadline - now > spin_threshold_) {
+        std::this_thread::sleep_until(deadline - spin_threshold_);
+    }
+
+    // Spin out the remainder
+    while ((now = clock::now()) < deadline) {
+    }
+    return now;
+}
+
+TokenBucket::TokenBucket(double rate, double burst, clock::time_point start)
+    : rate_(rate)
+    , burst_(std::max(burst, 1.0))
+    , tokens_(1.0)
+    , last_refill_(start)
+{
+}
+
+void TokenBucket::refill(clock::time_point now)
+{
+    if (now <= last_refill_) {
+        return;
+    }
+    double elapsed = std::chrono::duration<double>(now - last_refill_).count();
+    tokens_ = std::min(burst_, tokens_ + elapsed * rate_);
+    last_refill_ = now;
+}
+
+bool TokenBucket::try_acquire(double tokens)
+{
+    if (tokens_ + TOKEN_EPSILON < tokens) {
+        return false;
+    }
+    tokens_ -= tokens;
+    return true;
+}
+
+size_t TokenBucket::acquire_up_to(size_t max_tokens)
+{
+    double whole = std::floor(tokens_ + TOKEN_EPSILON);
+    if (whole < 1.0) {
+        return 0;
+    }
+    size_t taken = whole < static_cast<double>(max_tokens) ? static_cast<size_t>(whole) : max_tokens;
+    tokens_ -= static_cast<double>(taken);
+    return taken;
+}
+
+TokenBucket::clock::time_point TokenBucket::available_at(double tokens) const
+{
+    if (tokens_ >= tokens) {
+        return last_refill_;
+    }
+    auto wait = std::chrono::duration<double>((tokens - tokens_) / rate_);
+    return last_refill_ + std::chrono::duration_cast<clock::duration>(wait);
+}
+
+ArrivalProcess ArrivalProcess::fixed(double rate)
+{
+    ArrivalProcess process;
+    process.kind_ = Kind::FIXED;
+    process.rate_ = rate;
+    return process;
+}
+
+ArrivalProcess ArrivalProcess::poisson(double rate)
+{
+    ArrivalProcess process;
+    process.kind_ = Kind::POISSON;
+    process.rate_ = rate;
+    return process;
+}
+
+ArrivalProcess ArrivalProcess::custom(Sampler sampler)
+{
+    ArrivalProcess process;
+    process.kind_ = Kind::CUSTOM;
+    process.sampler_ = std::move(sampler);
+    return process;
+}
+
+uint64_t ArrivalProcess::next_interval_ns(CounterRng& rng) const
+{
+    double seconds = 0.0;
+    switch (kind_) {
+    case Kind::FIXED:
+        seconds = 1.0 / rate_;
+        break;
+    case Kind::POISSON: {
+        // Exponential gaps; 53 random bits give a uniform in [0, 1)
+        double u = static_cast<double>(rng() >> 11) * 0x1.0p-53;
+        seconds = -std::log1p(-u) / rate_;
+        break;
+    }
+    case Kind::CUSTOM:
+        seconds = sampler_(rng);
+        break;
+    }
+
+    // At least 1ns so a source can never schedule itself twice at once
+    return std::max<uint64_t>(1, static_cast<uint64_t>(std::llround(std::max(seconds, 0.0) * 1e9)));
+}
+
+void ArrivalScheduler::add_instrument(uint32_t instrument_id, ArrivalProcess process)
+{
+    uint32_t index = static_cast<uint32_t>(sources_.size());
+    sources_.push_back(Source { instrument_id, std::move(process) });
+    heap_.push(Arrival { sources_.back().process.next_interval_ns(rng_), index });
+}
+
+size_t ArrivalScheduler::pop_due(uint64_t now_ns, std::vector<uint32_t>& out, size_t max_events)
+{
+    size_t count = 0;
+    while (count < max_events && !heap_.empty() && heap_.top().time_ns <= now_ns) {
+        Arrival arrival = heap_.top();
+        heap_.pop();
+
+        const Source& source = sources_[arrival.index];
+        out.push_back(source.instrument_id);
+        ++count;
+
+        arrival.time_ns += source.process.next_interval_ns(rng_);
+        heap_.push(arrival);
+    }
+    return count;
+}
+
+RateScheduler::RateScheduler(const Config& config)
+    : config_(config)
+    , timer_(config.spin_threshold)
+    , bucket_(config.target_rate,
+          config.burst > 0.0 ? config.burst : std::max(1.0, config.target_rate / 1000.0))
+    , epoch_(clock::now())
+    , start_(epoch_)
+{
+}
+
+size_t RateScheduler::acquire(size_t max_events)
+{
+    bucket_.refill(clock::now());
+    if (bucket_.tokens() + TOKEN_EPSILON < 1.0) {
+        auto deadline = bucket_.available_at(1.0);
+        auto woke = timer_.wait_until(deadline);
+        record_wait(deadline, woke);
+        bucket_.refill(woke);
+    }
+
+    size_t taken = bucket_.acquire_up_to(max_events);
+    events_ += taken;
+    return taken;
+}
+
+size_t RateScheduler::poll(size_t max_events)
+{
+    bucket_.refill(clock::now());
+    size_t taken = bucket_.acquire_up_to(max_events);
+    events_ += taken;
+    return taken;
+}
+
+size_t RateScheduler::acquire(ArrivalScheduler& arrivals, std::vector<uint32_t>& out, size_t max_events)
+{
+    if (arrivals.empty()) {
+        return 0;
+    }
+
+    auto deadline = epoch_ + std::chrono::nanoseconds(arrivals.next_time_ns());
+    auto now = clock::now();
+    if (now < deadline) {
+        now = timer_.wait_until(deadline);
+        record_wait(deadline, now);
+    }
+
+    auto now_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - epoch_).count());
+    size_t taken = arrivals.pop_due(now_ns, out, max_events);
+    events_ += taken;
+    return taken;
+}
+
+void RateScheduler::wait_next(std::chrono::nanoseconds max_wait)
+{
+    auto now = clock::now();
+    bucket_.refill(now);
+    if (bucket_.tokens() + TOKEN_EPSILON >= 1.0) {
+        return;
+    }
+
+    auto deadline = bucket_.available_at(1.0);
+    if (deadline <= now + max_wait) {
+        record_wait(deadline, timer_.wait_until(deadline));
+    } else {
+        // Not due yet; a plain sleep is accurate enough for the caller's poll
+        std::this_thread::sleep_for(max_wait);
+    }
+}
+
+void RateScheduler::record_wait(clock::time_point deadline, clock::time_point woke)
+{
+    double lateness = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(woke - deadline).count());
+    ++waits_;
+    lateness_sum_ += lateness;
+    lateness_sum_sq_ += lateness * lateness;
+    max_lateness_ = std::max(max_lateness_, static_cast<uint64_t>(lateness));
+}
+
+RateScheduler::Statistics RateScheduler::get_statistics() const
+{
+    Statistics stats;
+    stats.target_rate = config_.target_rate;
+    stats.events = events_;
+    stats.waits = waits_;
+
+    double elapsed = std::chrono::duration<double>(clock::now() - start_).count();
+    if (elapsed > 0.0) {
+        stats.achieved_rate = static_cast<double>(events_) / elapsed;
+    }
+    if (waits_ > 0) {
+        stats.mean_lateness_ns = lateness_sum_ / waits_;
+        double variance = lateness_sum_sq_ / waits_ - stats.mean_lateness_ns * stats.mean_lateness_ns;
+        stats.jitter_ns = std::sqrt(std::max(variance, 0.0));
+    }
+    stats.max_lateness_ns = max_lateness_;
+    return stats;
+}
+
+void RateScheduler::reset_statistics()
+{
+    start_ = clock::now();
+    events_ = 0;
+    waits_ = 0;
+    lateness_sum_ = 0.0;
+    lateness_sum_sq_ = 0.0;
+    max_lateness_ = 0;
+}
+
+} // namespace market_core
@@ -15,7 +15,7 @@ struct NetworkConfig {
     };
 
     FeedConfig incremental_feed_a = { "127.0.0.1", 14310 };
-    FeedConfig incremental_feed_b = { "127.0.0.1", 14311 };
+    FeedConfig incremental_feed_b = { "", 0 }; // Only published with --feed-b
     FeedConfig snapshot_feed = { "127.0.0.1", 14320 };
     FeedConfig definition_feed = { "127.0.0.1", 14330 };
 };
@@ -35,9 +35,6 @@ public:
         const std::vector<std::vector<uint8_t>>& messages);
 
 private:
-    // Helper to determine if instrument is FX (Channel 330)
-    static bool is_fx_instrument(uint32_t security_id);
-
     // Convert our internal structures to SBE format
     static void populate_snapshot_message(
         cme_sbe::SnapshotFullRefresh52& sbe_msg,
@@ -2,49 +2,66 @@
 
 #include "mdp_messages.h"
 #include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <string>
 #include <vector>
 
 namespace cme_mock {
 
-// SBE field decoding helpers
+// Little-endian field at any alignment
+template <typename T>
+inline T load_le(const uint8_t* data)
+{
+    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "SBE fields are little-endian");
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+// SBE field decoding helpers. Reads in place from a buffer it does not
+// own, so the buffer must outlive the decoder.
 class SBEDecoder {
 public:
-    SBEDecoder(const std::vector<uint8_t>& data)
-        : buffer_(data)
+    SBEDecoder(const uint8_t* data, size_t length)
+        : data_(data)
+        , length_(length)
         , offset_(0)
     {
     }
-    SBEDecoder(const uint8_t* data, size_t length)
-        : buffer_(data, data + length)
-        , offset_(0)
+    explicit SBEDecoder(const std::vector<uint8_t>& data)
+        : SBEDecoder(data.data(), data.size())
     {
     }
+    SBEDecoder(std::vector<uint8_t>&&) = delete; // Would dangle
 
     // Reset for reuse
-    void reset(const std::vector<uint8_t>& data)
+    void reset(const uint8_t* data, size_t length)
     {
-        buffer_ = data;
+        data_ = data;
+        length_ = length;
         offset_ = 0;
     }
+    void reset(const std::vector<uint8_t>& data) { reset(data.data(), data.size()); }
 
     // Check if we can read more data
     bool can_read(size_t bytes) const
     {
-        return offset_ + bytes <= buffer_.size();
+        return bytes <= length_ - offset_;
     }
 
     size_t get_offset() const { return offset_; }
-    size_t remaining() const { return buffer_.size() - offset_; }
-
-    // Basic type decoders
-    uint8_t decode_uint8();
-    uint16_t decode_uint16();
-    uint32_t decode_uint32();
-    uint64_t decode_uint64();
-    int32_t decode_int32();
-    int64_t decode_int64();
-    char decode_char();
+    size_t remaining() const { return length_ - offset_; }
+    const uint8_t* position() const { return data_ + offset_; }
+
+    // Basic type decoders; 0 past the end
+    uint8_t decode_uint8() { return read<uint8_t>(); }
+    uint16_t decode_uint16() { return read<uint16_t>(); }
+    uint32_t decode_uint32() { return read<uint32_t>(); }
+    uint64_t decode_uint64() { return read<uint64_t>(); }
+    int32_t decode_int32() { return read<int32_t>(); }
+    int64_t decode_int64() { return read<int64_t>(); }
+    char decode_char() { return read<char>(); }
     std::string decode_string(size_t length);
 
     // MDP specific decoders
@@ -54,8 +71,138 @@ public:
     void skip(size_t bytes);
 
 private:
-    std::vector<uint8_t> buffer_;
+    const uint8_t* data_;
+    size_t length_;
     size_t offset_;
+
+    template <typename T>
+    T read()
+    {
+        if (!can_read(sizeof(T))) {
+            return 0;
+        }
+        T value = load_le<T>(data_ + offset_);
+        offset_ += sizeof(T);
+        return value;
+    }
+};
+
+// One SBE message of an MDP packet
+struct MDPMessage {
+    static constexpr size_t HEADER_SIZE = 8; // SBE message header
+
+    const uint8_t* data; // From the SBE header
+    uint16_t size; // Size field: SBE header and body
+    uint16_t block_length;
+    uint16_t template_id;
+    uint16_t schema_id;
+    uint16_t version;
+
+    // Decoder positioned at the root block
+    SBEDecoder body() const { return SBEDecoder(data + HEADER_SIZE, size - HEADER_SIZE); }
+};
+
+// Non-owning view of an MDP packet: the 12-byte packet header followed by
+// size-prefixed SBE messages. Iteration stops at the end of the packet or
+// at the first size field that is too small for an SBE header or runs past
+// the end; the iterator's offset() then tells which.
+class MDPPacketView {
+public:
+    static constexpr size_t HEADER_SIZE = 12;
+    static constexpr size_t SIZE_FIELD = 2;
+
+    MDPPacketView(const uint8_t* data, size_t length)
+        : data_(data)
+        , length_(length)
+    {
+    }
+    explicit MDPPacketView(const std::vector<uint8_t>& packet)
+        : MDPPacketView(packet.data(), packet.size())
+    {
+    }
+    MDPPacketView(std::vector<uint8_t>&&) = delete; // Would dangle
+
+    bool valid() const { return length_ >= HEADER_SIZE; }
+    uint32_t sequence_number() const { return valid() ? load_le<uint32_t>(data_) : 0; }
+    uint64_t sending_time() const { return valid() ? load_le<uint64_t>(data_ + 4) : 0; }
+    size_t size() const { return length_; }
+
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = MDPMessage;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const MDPMessage*;
+        using reference = const MDPMessage&;
+
+        iterator() = default;
+        iterator(const uint8_t* data, size_t length, size_t offset)
+            : data_(data)
+            , length_(length)
+            , offset_(offset)
+        {
+            parse();
+        }
+
+        reference operator*() const { return message_; }
+        pointer operator->() const { return &message_; }
+        iterator& operator++()
+        {
+            offset_ += SIZE_FIELD + message_.size;
+            parse();
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+        bool operator==(const iterator& other) const
+        {
+            return done_ == other.done_ && (done_ || offset_ == other.offset_);
+        }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+        // Offset of the current message's size field; once done, where
+        // the walk stopped
+        size_t offset() const { return offset_; }
+
+    private:
+        const uint8_t* data_ = nullptr;
+        size_t length_ = 0;
+        size_t offset_ = 0;
+        bool done_ = true;
+        MDPMessage message_ {};
+
+        void parse()
+        {
+            done_ = true;
+            if (length_ - offset_ < SIZE_FIELD) {
+                return;
+            }
+            uint16_t size = load_le<uint16_t>(data_ + offset_);
+            if (size < MDPMessage::HEADER_SIZE || size > length_ - offset_ - SIZE_FIELD) {
+                return;
+            }
+
+            const uint8_t* message = data_ + offset_ + SIZE_FIELD;
+            message_.data = message;
+            message_.size = size;
+            message_.block_length = load_le<uint16_t>(message);
+            message_.template_id = load_le<uint16_t>(message + 2);
+            message_.schema_id = load_le<uint16_t>(message + 4);
+            message_.version = load_le<uint16_t>(message + 6);
+            done_ = false;
+        }
+    };
+
+    iterator begin() const { return valid() ? iterator(data_, length_, HEADER_SIZE) : end(); }
+    iterator end() const { return iterator(); }
+
+private:
+    const uint8_t* data_;
+    size_t length_;
 };
 
 // MDP 3.0 Message Decoder
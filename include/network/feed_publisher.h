@@ -20,6 +20,12 @@ public:
 
     bool initialize();
 
+    // Publish every packet to a B feed as well; encoded once, sent twice
+    bool set_feed_b(const std::string& ip, uint16_t port)
+    {
+        return udp_publisher_->set_secondary_destination(ip, port);
+    }
+
 protected:
     std::shared_ptr<UDPPublisher> udp_publisher_;
     std::shared_ptr<OrderBookManager> book_manager_;
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cstdint>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 #include <string>
 #include <vector>
 
@@ -14,14 +17,22 @@ public:
     // Initialize the socket
     bool initialize();
 
+    // A/B publishing: every send also goes to this second destination,
+    // from the same buffer in the same sendmmsg() call
+    bool set_secondary_destination(const std::string& ip_address, uint16_t port);
+
     // Send data
     bool send(const uint8_t* data, size_t length);
     bool send(const std::vector<uint8_t>& data);
 
-    // Batch sending for efficiency
+    // Batch sending for efficiency: queued messages leave in one
+    // sendmmsg() call per flush
     void queue_message(const std::vector<uint8_t>& message);
     bool flush_queue();
 
+    // Send syscalls made, for measuring batching
+    uint64_t get_syscalls() const { return syscalls_; }
+
     // Statistics
     uint64_t get_messages_sent() const { return messages_sent_; }
     uint64_t get_bytes_sent() const { return bytes_sent_; }
@@ -31,15 +42,24 @@ private:
     std::string ip_address_;
     uint16_t port_;
     int socket_fd_;
+    std::string secondary_ip_;
+    uint16_t secondary_port_ = 0;
+
+    // Destinations resolved once, not on every send
+    struct sockaddr_in dest_addr_;
+    struct sockaddr_in secondary_addr_;
 
     // Message batching
     std::vector<std::vector<uint8_t>> message_queue_;
     size_t max_batch_size_ = 10;
+    std::vector<struct iovec> flush_iovecs_;
+    std::vector<struct mmsghdr> flush_headers_;
 
     // Statistics
     uint64_t messages_sent_ = 0;
     uint64_t bytes_sent_ = 0;
     uint64_t errors_ = 0;
+    uint64_t syscalls_ = 0;
 
     void cleanup();
 };
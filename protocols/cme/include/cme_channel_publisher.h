@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../../core/include/spsc_queue.h"
+#include "cme_channel_registry.h"
+#include "cme_event_listener.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace cme_protocol {
+
+// Publishes one channel from its own thread. The generator side queues
+// event records with publish(); the channel thread pops them in batches
+// and runs them through its own adapter, so sequence numbers, packet
+// building and sends of different channels never share state or a lock.
+class CMEChannelPublisher {
+public:
+    static constexpr size_t MAX_BATCH = 256; // Records per adapter batch
+
+    CMEChannelPublisher(
+        const CMEChannelConfig& config,
+        std::shared_ptr<market_core::OrderBookManager> book_manager);
+    ~CMEChannelPublisher();
+
+    CMEChannelPublisher(const CMEChannelPublisher&) = delete;
+    CMEChannelPublisher& operator=(const CMEChannelPublisher&) = delete;
+
+    const CMEChannelConfig& config() const { return config_; }
+    uint16_t channel_id() const { return config_.channel_id; }
+
+    // Configure (transport, batching, definitions) before start(); from
+    // then until stop() the adapter belongs to the channel thread
+    const std::shared_ptr<CMEProtocolAdapter>& adapter() const { return adapter_; }
+
+    void start();
+    void stop(); // Publishes whatever is still queued first
+    bool is_running() const { return thread_.joinable(); }
+
+    // Producer side. Calls must not overlap; waits while the queue is full.
+    void publish(const market_core::EventRecord& record)
+    {
+        if (!queue_.try_push(record)) {
+            wait_and_push(record);
+        }
+    }
+
+    // Statistics
+    size_t backlog() const { return queue_.size(); }
+    uint64_t events_published() const { return events_published_.load(std::memory_order_relaxed); }
+    uint64_t queue_full_waits() const { return queue_full_waits_.load(std::memory_order_relaxed); }
+
+private:
+    CMEChannelConfig config_;
+    std::shared_ptr<CMEProtocolAdapter> adapter_;
+    std::shared_ptr<CMEEventListener> listener_;
+    market_core::SpscQueue<market_core::EventRecord> queue_;
+
+    std::thread thread_;
+    std::atomic<bool> stopping_ { false };
+    std::atomic<uint64_t> events_published_ { 0 };
+    std::atomic<uint64_t> queue_full_waits_ { 0 };
+
+    void run();
+    void wait_and_push(const market_core::EventRecord& record);
+};
+
+// Generator listener that fans events out to one CMEChannelPublisher per
+// channel, by the instrument's channel in the registry
+class CMEMultiChannelPublisher : public market_core::IEventRecordListener {
+public:
+    explicit CMEMultiChannelPublisher(std::shared_ptr<market_core::OrderBookManager> book_manager);
+    ~CMEMultiChannelPublisher() override;
+
+    // The first channel added also takes unassigned instruments
+    CMEChannelPublisher& add_channel(const CMEChannelConfig& config);
+
+    // Map the manager's instruments to channels; call once instruments are
+    // added, before events flow
+    void assign_instruments();
+
+    void start();
+    void stop();
+
+    size_t channel_count() const { return channels_.size(); }
+    CMEChannelPublisher& channel_at(size_t index) { return *channels_[index]; }
+    CMEChannelPublisher* find_channel(uint16_t channel_id);
+    CMEChannelPublisher& channel_for(uint32_t instrument_id)
+    {
+        return *channels_[registry_.channel_index(instrument_id)];
+    }
+    const CMEChannelRegistry& registry() const { return registry_; }
+
+    // IEventRecordListener interface
+    void on_event_record(const market_core::EventRecord& record) override;
+    void on_market_events(market_core::EventRecordSpan records) override;
+
+private:
+    std::shared_ptr<market_core::OrderBookManager> book_manager_;
+    CMEChannelRegistry registry_;
+    std::vector<std::unique_ptr<CMEChannelPublisher>> channels_;
+};
+
+} // namespace cme_protocol
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../../core/include/order_book_manager.h"
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cme_protocol {
+
+// One CME market data channel: its own incremental sequence space, packet
+// builder, transports and publishing thread
+struct CMEChannelConfig {
+    uint16_t channel_id = 310;
+    std::string name;
+
+    // Instruments listed here, then instruments whose "product_group"
+    // property matches, belong to this channel. The first channel also
+    // takes every instrument no channel claims.
+    std::vector<uint32_t> instrument_ids;
+    std::vector<std::string> product_groups;
+
+    // Incremental feed; empty leaves it to the server
+    std::string incremental_ip;
+    uint16_t incremental_port = 0;
+
+    int cpu = -1; // Pin the publishing thread to this CPU; -1 leaves it floating
+    size_t queue_capacity = 65536; // Events queued from the generator
+    std::chrono::microseconds idle_sleep { 50 }; // 0 busy-polls when idle
+};
+
+// Instrument -> channel mapping, resolved once up front so routing an
+// event is an array lookup
+class CMEChannelRegistry {
+public:
+    static constexpr uint32_t MAX_DENSE_ID = 1u << 20;
+
+    // Channels listed under "channels" in a server config (id, name,
+    // product_groups, instrument_ids, cpu, incremental_feed {ip, port}).
+    // False if the JSON has no channel with an id.
+    static bool parse_channels(const std::string& json, std::vector<CMEChannelConfig>& channels);
+    static bool load_channels(const std::string& filename, std::vector<CMEChannelConfig>& channels);
+
+    // Returns the new channel's index
+    size_t add_channel(const CMEChannelConfig& config);
+
+    // (Re)assign every instrument the manager knows about
+    void assign_instruments(const market_core::OrderBookManager& manager);
+    size_t assign(const market_core::Instrument& instrument);
+
+    // Index of the instrument's channel; unassigned instruments go to the
+    // first channel
+    size_t channel_index(uint32_t instrument_id) const
+    {
+        if (instrument_id < dense_.size()) {
+            return dense_[instrument_id] != UNASSIGNED ? dense_[instrument_id] : 0;
+        }
+        if (instrument_id >= MAX_DENSE_ID) {
+            auto it = sparse_.find(instrument_id);
+            return it != sparse_.end() ? it->second : 0;
+        }
+        return 0;
+    }
+
+    const CMEChannelConfig* find(uint16_t channel_id) const;
+    const std::vector<CMEChannelConfig>& channels() const { return channels_; }
+    size_t channel_count() const { return channels_.size(); }
+
+    // Instruments assigned to a channel, in assignment order
+    const std::vector<uint32_t>& instruments(size_t index) const { return members_[index]; }
+
+private:
+    static constexpr uint16_t UNASSIGNED = 0xFFFF;
+
+    std::vector<CMEChannelConfig> channels_;
+    std::vector<std::vector<uint32_t>> members_;
+    std::vector<uint16_t> dense_; // Channel index by instrument ID
+    std::unordered_map<uint32_t, uint16_t> sparse_; // IDs from MAX_DENSE_ID up
+
+    size_t match(const market_core::Instrument& instrument) const;
+};
+
+} // namespace cme_protocol
@@ -2,12 +2,14 @@
 
 #include "cme_messages.h"
 #include "cme_sbe/MDIncrementalRefreshBook46.h"
+#include "cme_sbe/MDIncrementalRefreshOrderBook47.h"
 #include "cme_sbe/MDIncrementalRefreshSessionStatistics51.h"
 #include "cme_sbe/MDIncrementalRefreshTradeSummary48.h"
 #include "cme_sbe/MDInstrumentDefinitionFuture54.h"
 #include "cme_sbe/MessageHeader.h"
 #include "cme_sbe/SecurityStatus30.h"
 #include "cme_sbe/SnapshotFullRefresh52.h"
+#include "cme_sbe/SnapshotFullRefreshOrderBook53.h"
 #include <cstdint>
 #include <vector>
 
@@ -19,6 +21,7 @@ public:
     // Buffer management
     static constexpr size_t MAX_MESSAGE_SIZE = 1400; // UDP MTU
     static constexpr size_t HEADER_SIZE = 8; // SBE message header
+    static constexpr size_t PACKET_OVERHEAD = 12 + 2; // Packet header + message size field
 
     // Encode incremental refresh book using SBE API
     // This method:
@@ -29,10 +32,69 @@ public:
     static std::vector<uint8_t> encode_incremental_refresh_book(
         const IncrementalRefresh& refresh);
 
+    // In-place encoders used by CMEPacketBuilder: write the message (SBE
+    // header included) straight into buffer and return its length, or 0
+    // when it would not fit in capacity. No allocation.
+    static size_t encode_incremental_refresh_book(
+        uint64_t transact_time,
+        uint8_t match_event_indicator,
+        const MDPriceLevel* entries,
+        size_t entry_count,
+        uint8_t* buffer,
+        size_t capacity);
+
+    static size_t encode_incremental_refresh_order_book(
+        uint64_t transact_time,
+        uint8_t match_event_indicator,
+        const MDOrderEntry* entries,
+        size_t entry_count,
+        uint8_t* buffer,
+        size_t capacity);
+
+    // Encoded sizes, so callers can reserve space before encoding
+    static constexpr size_t incremental_refresh_book_length(size_t entry_count)
+    {
+        return HEADER_SIZE + cme_sbe::MDIncrementalRefreshBook46::sbeBlockLength()
+            + cme_sbe::MDIncrementalRefreshBook46::NoMDEntries::sbeHeaderSize()
+            + entry_count * cme_sbe::MDIncrementalRefreshBook46::NoMDEntries::sbeBlockLength()
+            + cme_sbe::MDIncrementalRefreshBook46::NoOrderIDEntries::sbeHeaderSize();
+    }
+
+    static constexpr size_t incremental_refresh_order_book_length(size_t entry_count)
+    {
+        return HEADER_SIZE + cme_sbe::MDIncrementalRefreshOrderBook47::sbeBlockLength()
+            + cme_sbe::MDIncrementalRefreshOrderBook47::NoMDEntries::sbeHeaderSize()
+            + entry_count * cme_sbe::MDIncrementalRefreshOrderBook47::NoMDEntries::sbeBlockLength();
+    }
+
+    // Most book entries that fit one template 46 message in a packet
+    static constexpr size_t max_incremental_book_entries()
+    {
+        return (MAX_MESSAGE_SIZE - PACKET_OVERHEAD - incremental_refresh_book_length(0))
+            / cme_sbe::MDIncrementalRefreshBook46::NoMDEntries::sbeBlockLength();
+    }
+
     // Encode snapshot using SBE API
     static std::vector<uint8_t> encode_snapshot_full_refresh(
         const SnapshotFullRefresh& snapshot);
 
+    // Encode market-by-order incremental (template 47)
+    static std::vector<uint8_t> encode_incremental_refresh_order_book(
+        const IncrementalRefreshOrderBook& refresh);
+
+    // Encode one chunk of a market-by-order snapshot (template 53)
+    static std::vector<uint8_t> encode_snapshot_full_refresh_order_book(
+        const SnapshotFullRefreshOrderBook& snapshot);
+
+    // Most order entries that fit one template 53 message in a packet
+    static constexpr size_t max_snapshot_order_entries()
+    {
+        return (MAX_MESSAGE_SIZE - PACKET_OVERHEAD - HEADER_SIZE
+                   - cme_sbe::SnapshotFullRefreshOrderBook53::sbeBlockLength()
+                   - cme_sbe::GroupSize::encodedLength())
+            / cme_sbe::SnapshotFullRefreshOrderBook53::NoMDEntries::sbeBlockLength();
+    }
+
     // Encode security definition using SBE API
     static std::vector<uint8_t> encode_security_definition_future(
         const SecurityDefinition& definition);
@@ -7,8 +7,11 @@
 
 namespace cme_protocol {
 
-// Event listener that connects core market events to CME protocol adapter
-class CMEEventListener : public market_core::IMarketEventListener {
+// Event listener that connects core market events to CME protocol adapter.
+// Receives records directly from the generator; on_market_event remains for
+// callers that still publish MarketEvent objects (e.g. snapshots).
+class CMEEventListener : public market_core::IMarketEventListener,
+                         public market_core::IEventRecordListener {
 public:
     CMEEventListener(
         std::shared_ptr<market_core::OrderBookManager> book_manager,
@@ -19,6 +22,12 @@ public:
     // IMarketEventListener interface
     void on_market_event(const std::shared_ptr<market_core::MarketEvent>& event) override;
 
+    // IEventRecordListener interface
+    void on_event_record(const market_core::EventRecord& record) override;
+
+    // Packs the whole batch into as few packets as the MTU allows
+    void on_market_events(market_core::EventRecordSpan records) override;
+
 private:
     std::shared_ptr<market_core::OrderBookManager> book_manager_;
     std::shared_ptr<CMEProtocolAdapter> cme_adapter_;
@@ -29,6 +38,7 @@ private:
     void handle_snapshot_event(const std::shared_ptr<market_core::SnapshotEvent>& event);
     void handle_statistics_event(const std::shared_ptr<market_core::StatisticsEvent>& event);
     void handle_status_event(const std::shared_ptr<market_core::StatusEvent>& event);
+    void handle_order_event(const std::shared_ptr<market_core::OrderEvent>& event);
 };
 
 } // namespace cme_protocol
\ No newline at end of file
@@ -0,0 +1,519 @@
+#pragma once
+
+#include "cme_messages.h"
+#include "cme_sbe/MDIncrementalRefreshBook46.h"
+#include "cme_sbe/MDIncrementalRefreshOrderBook47.h"
+#include "cme_sbe/MDIncrementalRefreshTradeSummary48.h"
+#include "cme_sbe/MessageHeader.h"
+#include "cme_sbe/SnapshotFullRefresh52.h"
+#include "cme_sbe/SnapshotFullRefreshOrderBook53.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace cme_protocol {
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "MDP wire structs are stored in host byte order");
+
+// Wire images of the high-volume MDP templates. Every block is a packed
+// struct checked field by field against the generated flyweights, so
+// encoding is a handful of plain stores at offsets fixed at compile time.
+namespace mdp_wire {
+
+#pragma pack(push, 1)
+
+struct MessageHeader {
+    uint16_t block_length;
+    uint16_t template_id;
+    uint16_t schema_id;
+    uint16_t version;
+};
+
+struct GroupSize {
+    uint16_t block_length;
+    uint8_t num_in_group;
+};
+
+struct GroupSize8Byte {
+    uint16_t block_length;
+    uint8_t padding[5];
+    uint8_t num_in_group;
+};
+
+// Root block of templates 46, 47 and 48
+struct IncrementalRoot {
+    uint64_t transact_time;
+    uint8_t match_event_indicator;
+    uint8_t padding[2];
+};
+
+struct BookEntry46 {
+    int64_t md_entry_px;
+    int32_t md_entry_size;
+    int32_t security_id;
+    uint32_t rpt_seq;
+    int32_t number_of_orders;
+    uint8_t md_price_level;
+    uint8_t md_update_action;
+    char md_entry_type;
+    int32_t tradeable_size;
+    uint8_t padding[1];
+};
+
+struct OrderEntry47 {
+    uint64_t order_id;
+    uint64_t md_order_priority;
+    int64_t md_entry_px;
+    int32_t md_display_qty;
+    int32_t security_id;
+    uint8_t md_update_action;
+    char md_entry_type;
+    uint8_t padding[6];
+};
+
+struct TradeEntry48 {
+    int64_t md_entry_px;
+    int32_t md_entry_size;
+    int32_t security_id;
+    uint32_t rpt_seq;
+    int32_t number_of_orders;
+    uint8_t aggressor_side;
+    uint8_t md_update_action;
+    uint32_t md_trade_entry_id;
+    uint8_t padding[2];
+};
+
+struct SnapshotRoot52 {
+    uint32_t last_msg_seq_num_processed;
+    uint32_t tot_num_reports;
+    int32_t security_id;
+    uint32_t rpt_seq;
+    uint64_t transact_time;
+    uint64_t last_update_time;
+    uint16_t trade_date;
+    uint8_t md_security_trading_status;
+    int64_t high_limit_price;
+    int64_t low_limit_price;
+    int64_t max_price_variation;
+};
+
+struct SnapshotEntry52 {
+    int64_t md_entry_px;
+    int32_t md_entry_size;
+    int32_t number_of_orders;
+    int8_t md_price_level;
+    uint16_t trading_reference_date;
+    uint8_t open_close_settl_flag;
+    uint8_t settl_price_type;
+    char md_entry_type;
+};
+
+struct SnapshotRoot53 {
+    uint32_t last_msg_seq_num_processed;
+    uint32_t tot_num_reports;
+    int32_t security_id;
+    uint32_t no_chunks;
+    uint32_t current_chunk;
+    uint64_t transact_time;
+};
+
+struct OrderEntry53 {
+    uint64_t order_id;
+    uint64_t md_order_priority;
+    int64_t md_entry_px;
+    int32_t md_display_qty;
+    char md_entry_type;
+};
+
+#pragma pack(pop)
+
+#define MDP_WIRE_FIELD(Struct, field, Flyweight, accessor) \
+    static_assert(offsetof(Struct, field) == Flyweight::accessor##EncodingOffset(), #Struct "::" #field)
+
+MDP_WIRE_FIELD(GroupSize, num_in_group, cme_sbe::GroupSize, numInGroup);
+MDP_WIRE_FIELD(GroupSize8Byte, num_in_group, cme_sbe::GroupSize8Byte, numInGroup);
+static_assert(sizeof(MessageHeader) == cme_sbe::MessageHeader::encodedLength(), "MessageHeader");
+static_assert(sizeof(GroupSize) == cme_sbe::GroupSize::encodedLength(), "GroupSize");
+static_assert(sizeof(GroupSize8Byte) == cme_sbe::GroupSize8Byte::encodedLength(), "GroupSize8Byte");
+
+MDP_WIRE_FIELD(IncrementalRoot, match_event_indicator, cme_sbe::MDIncrementalRefreshBook46, matchEventIndicator);
+static_assert(sizeof(IncrementalRoot) == cme_sbe::MDIncrementalRefreshBook46::sbeBlockLength(), "IncrementalRoot 46");
+static_assert(sizeof(IncrementalRoot) == cme_sbe::MDIncrementalRefreshOrderBook47::sbeBlockLength(), "IncrementalRoot 47");
+static_assert(sizeof(IncrementalRoot) == cme_sbe::MDIncrementalRefreshTradeSummary48::sbeBlockLength(), "IncrementalRoot 48");
+
+using Book46 = cme_sbe::MDIncrementalRefreshBook46::NoMDEntries;
+MDP_WIRE_FIELD(BookEntry46, md_entry_size, Book46, mDEntrySize);
+MDP_WIRE_FIELD(BookEntry46, security_id, Book46, securityID);
+MDP_WIRE_FIELD(BookEntry46, rpt_seq, Book46, rptSeq);
+MDP_WIRE_FIELD(BookEntry46, number_of_orders, Book46, numberOfOrders);
+MDP_WIRE_FIELD(BookEntry46, md_price_level, Book46, mDPriceLevel);
+MDP_WIRE_FIELD(BookEntry46, md_update_action, Book46, mDUpdateAction);
+MDP_WIRE_FIELD(BookEntry46, md_entry_type, Book46, mDEntryType);
+MDP_WIRE_FIELD(BookEntry46, tradeable_size, Book46, tradeableSize);
+static_assert(sizeof(BookEntry46) == Book46::sbeBlockLength(), "BookEntry46");
+
+using Order47 = cme_sbe::MDIncrementalRefreshOrderBook47::NoMDEntries;
+MDP_WIRE_FIELD(OrderEntry47, md_order_priority, Order47, mDOrderPriority);
+MDP_WIRE_FIELD(OrderEntry47, md_entry_px, Order47, mDEntryPx);
+MDP_WIRE_FIELD(OrderEntry47, md_display_qty, Order47, mDDisplayQty);
+MDP_WIRE_FIELD(OrderEntry47, security_id, Order47, securityID);
+MDP_WIRE_FIELD(OrderEntry47, md_update_action, Order47, mDUpdateAction);
+MDP_WIRE_FIELD(OrderEntry47, md_entry_type, Order47, mDEntryType);
+static_assert(sizeof(OrderEntry47) == Order47::sbeBlockLength(), "OrderEntry47");
+
+using Trade48 = cme_sbe::MDIncrementalRefreshTradeSummary48::NoMDEntries;
+MDP_WIRE_FIELD(TradeEntry48, md_entry_size, Trade48, mDEntrySize);
+MDP_WIRE_FIELD(TradeEntry48, security_id, Trade48, securityID);
+MDP_WIRE_FIELD(TradeEntry48, rpt_seq, Trade48, rptSeq);
+MDP_WIRE_FIELD(TradeEntry48, number_of_orders, Trade48, numberOfOrders);
+MDP_WIRE_FIELD(TradeEntry48, aggressor_side, Trade48, aggressorSide);
+MDP_WIRE_FIELD(TradeEntry48, md_update_action, Trade48, mDUpdateAction);
+MDP_WIRE_FIELD(TradeEntry48, md_trade_entry_id, Trade48, mDTradeEntryID);
+static_assert(sizeof(TradeEntry48) == Trade48::sbeBlockLength(), "TradeEntry48");
+
+using Snapshot52 = cme_sbe::SnapshotFullRefresh52;
+MDP_WIRE_FIELD(SnapshotRoot52, tot_num_reports, Snapshot52, totNumReports);
+MDP_WIRE_FIELD(SnapshotRoot52, security_id, Snapshot52, securityID);
+MDP_WIRE_FIELD(SnapshotRoot52, rpt_seq, Snapshot52, rptSeq);
+MDP_WIRE_FIELD(SnapshotRoot52, transact_time, Snapshot52, transactTime);
+MDP_WIRE_FIELD(SnapshotRoot52, last_update_time, Snapshot52, lastUpdateTime);
+MDP_WIRE_FIELD(SnapshotRoot52, trade_date, Snapshot52, tradeDate);
+MDP_WIRE_FIELD(SnapshotRoot52, md_security_trading_status, Snapshot52, mDSecurityTradingStatus);
+MDP_WIRE_FIELD(SnapshotRoot52, high_limit_price, Snapshot52, highLimitPrice);
+MDP_WIRE_FIELD(SnapshotRoot52, low_limit_price, Snapshot52, lowLimitPrice);
+MDP_WIRE_FIELD(SnapshotRoot52, max_price_variation, Snapshot52, maxPriceVariation);
+static_assert(sizeof(SnapshotRoot52) == Snapshot52::sbeBlockLength(), "SnapshotRoot52");
+
+MDP_WIRE_FIELD(SnapshotEntry52, md_entry_size, Snapshot52::NoMDEntries, mDEntrySize);
+MDP_WIRE_FIELD(SnapshotEntry52, number_of_orders, Snapshot52::NoMDEntries, numberOfOrders);
+MDP_WIRE_FIELD(SnapshotEntry52, md_price_level, Snapshot52::NoMDEntries, mDPriceLevel);
+MDP_WIRE_FIELD(SnapshotEntry52, trading_reference_date, Snapshot52::NoMDEntries, tradingReferenceDate);
+MDP_WIRE_FIELD(SnapshotEntry52, open_close_settl_flag, Snapshot52::NoMDEntries, openCloseSettlFlag);
+MDP_WIRE_FIELD(SnapshotEntry52, settl_price_type, Snapshot52::NoMDEntries, settlPriceType);
+MDP_WIRE_FIELD(SnapshotEntry52, md_entry_type, Snapshot52::NoMDEntries, mDEntryType);
+static_assert(sizeof(SnapshotEntry52) == Snapshot52::NoMDEntries::sbeBlockLength(), "SnapshotEntry52");
+
+using Snapshot53 = cme_sbe::SnapshotFullRefreshOrderBook53;
+MDP_WIRE_FIELD(SnapshotRoot53, tot_num_reports, Snapshot53, totNumReports);
+MDP_WIRE_FIELD(SnapshotRoot53, security_id, Snapshot53, securityID);
+MDP_WIRE_FIELD(SnapshotRoot53, no_chunks, Snapshot53, noChunks);
+MDP_WIRE_FIELD(SnapshotRoot53, current_chunk, Snapshot53, currentChunk);
+MDP_WIRE_FIELD(SnapshotRoot53, transact_time, Snapshot53, transactTime);
+static_assert(sizeof(SnapshotRoot53) == Snapshot53::sbeBlockLength(), "SnapshotRoot53");
+
+MDP_WIRE_FIELD(OrderEntry53, md_order_priority, Snapshot53::NoMDEntries, mDOrderPriority);
+MDP_WIRE_FIELD(OrderEntry53, md_entry_px, Snapshot53::NoMDEntries, mDEntryPx);
+MDP_WIRE_FIELD(OrderEntry53, md_display_qty, Snapshot53::NoMDEntries, mDDisplayQty);
+MDP_WIRE_FIELD(OrderEntry53, md_entry_type, Snapshot53::NoMDEntries, mDEntryType);
+static_assert(sizeof(OrderEntry53) == Snapshot53::NoMDEntries::sbeBlockLength(), "OrderEntry53");
+
+#undef MDP_WIRE_FIELD
+
+// Compile-time layout of one template: header bytes, where the root block
+// and the entry group start, and the encoded length for n entries. A
+// group holds at most MAX_ENTRIES, the largest numInGroup the schema allows.
+template <typename Message, typename Root, typename EntryGroupHeader, typename Entry, size_t TrailingGroups = 0>
+struct Layout {
+    static constexpr MessageHeader HEADER = {
+        Message::sbeBlockLength(),
+        Message::sbeTemplateId(),
+        Message::sbeSchemaId(),
+        Message::sbeSchemaVersion()
+    };
+    static constexpr size_t MAX_ENTRIES = std::numeric_limits<decltype(EntryGroupHeader::num_in_group)>::max();
+
+    static constexpr EntryGroupHeader group_header(size_t count)
+    {
+        EntryGroupHeader header {};
+        header.block_length = sizeof(Entry);
+        header.num_in_group = static_cast<uint8_t>(count);
+        return header;
+    }
+
+    static constexpr size_t ROOT_OFFSET = sizeof(MessageHeader);
+    static constexpr size_t GROUP_OFFSET = ROOT_OFFSET + sizeof(Root);
+    static constexpr size_t ENTRIES_OFFSET = GROUP_OFFSET + sizeof(EntryGroupHeader);
+    static constexpr size_t TRAILER_SIZE = TrailingGroups * sizeof(GroupSize8Byte);
+
+    static constexpr size_t length(size_t count)
+    {
+        return ENTRIES_OFFSET + count * sizeof(Entry) + TRAILER_SIZE;
+    }
+};
+
+// 46 and 48 end with an empty NoOrderIDEntries group
+using Book46Layout = Layout<cme_sbe::MDIncrementalRefreshBook46, IncrementalRoot, GroupSize, BookEntry46, 1>;
+using OrderBook47Layout = Layout<cme_sbe::MDIncrementalRefreshOrderBook47, IncrementalRoot, GroupSize, OrderEntry47>;
+using TradeSummary48Layout = Layout<cme_sbe::MDIncrementalRefreshTradeSummary48, IncrementalRoot, GroupSize, TradeEntry48, 1>;
+using Snapshot52Layout = Layout<cme_sbe::SnapshotFullRefresh52, SnapshotRoot52, GroupSize, SnapshotEntry52>;
+using Snapshot53Layout = Layout<cme_sbe::SnapshotFullRefreshOrderBook53, SnapshotRoot53, GroupSize, OrderEntry53>;
+
+// Blocks are written in place, one store per field. Packed blocks have
+// alignment 1, so any buffer offset is valid.
+template <typename Block>
+inline Block& block_at(uint8_t* buffer)
+{
+    return *reinterpret_cast<Block*>(buffer);
+}
+
+template <typename Block>
+inline void store(uint8_t* buffer, const Block& value)
+{
+    std::memcpy(buffer, &value, sizeof(Block));
+}
+
+} // namespace mdp_wire
+
+// Encoders for the hot MDP templates. Same wire output as CMEEncoder's
+// flyweight path for every field that one sets, without per-field bounds
+// checks or wrap calls; fields the flyweight path leaves untouched carry
+// their schema null value. Each returns the encoded length, or 0 when the
+// message would not fit in capacity or has more entries than its group
+// can count.
+class CMEFastEncoder {
+public:
+    static constexpr size_t incremental_refresh_book_length(size_t entry_count)
+    {
+        return mdp_wire::Book46Layout::length(entry_count);
+    }
+    static constexpr size_t incremental_refresh_order_book_length(size_t entry_count)
+    {
+        return mdp_wire::OrderBook47Layout::length(entry_count);
+    }
+    static constexpr size_t trade_summary_length(size_t entry_count)
+    {
+        return mdp_wire::TradeSummary48Layout::length(entry_count);
+    }
+    static constexpr size_t snapshot_full_refresh_length(size_t entry_count)
+    {
+        return mdp_wire::Snapshot52Layout::length(entry_count);
+    }
+    static constexpr size_t snapshot_full_refresh_order_book_length(size_t entry_count)
+    {
+        return mdp_wire::Snapshot53Layout::length(entry_count);
+    }
+
+    // Entry prices are already in instrument ticks of 10^-price_decimals;
+    // the MDP mantissa carries two more decimals (see CMEEncoder::to_sbe_price)
+    static constexpr int64_t to_mantissa(int64_t price) { return price * 100; }
+
+    // Template 46
+    static size_t encode_incremental_refresh_book(
+        uint64_t transact_time,
+        uint8_t match_event_indicator,
+        const MDPriceLevel* entries,
+        size_t entry_count,
+        uint8_t* buffer,
+        size_t capacity)
+    {
+        using L = mdp_wire::Book46Layout;
+        size_t length = L::length(entry_count);
+        if (entry_count > L::MAX_ENTRIES || length > capacity) {
+            return 0;
+        }
+
+        encode_incremental_header<L>(transact_time, match_event_indicator, entry_count, buffer);
+        uint8_t* out = buffer + L::ENTRIES_OFFSET;
+        for (size_t i = 0; i < entry_count; ++i, out += sizeof(mdp_wire::BookEntry46)) {
+            const MDPriceLevel& entry = entries[i];
+            auto& wire = mdp_wire::block_at<mdp_wire::BookEntry46>(out);
+            wire.md_entry_px = to_mantissa(entry.price);
+            wire.md_entry_size = entry.quantity;
+            wire.security_id = static_cast<int32_t>(entry.security_id);
+            wire.rpt_seq = entry.rpt_seq;
+            wire.number_of_orders = static_cast<int32_t>(entry.number_of_orders);
+            wire.md_price_level = entry.price_level;
+            wire.md_update_action = static_cast<uint8_t>(entry.update_action);
+            wire.md_entry_type = static_cast<char>(entry.entry_type);
+            wire.tradeable_size = entry.tradeable_size;
+            wire.padding[0] = 0;
+        }
+        mdp_wire::store(out, EMPTY_ORDER_ID_GROUP_46);
+        return length;
+    }
+
+    // Template 47
+    static size_t encode_incremental_refresh_order_book(
+        uint64_t transact_time,
+        uint8_t match_event_indicator,
+        const MDOrderEntry* entries,
+        size_t entry_count,
+        uint8_t* buffer,
+        size_t capacity)
+    {
+        using L = mdp_wire::OrderBook47Layout;
+        size_t length = L::length(entry_count);
+        if (entry_count > L::MAX_ENTRIES || length > capacity) {
+            return 0;
+        }
+
+        encode_incremental_header<L>(transact_time, match_event_indicator, entry_count, buffer);
+        uint8_t* out = buffer + L::ENTRIES_OFFSET;
+        for (size_t i = 0; i < entry_count; ++i, out += sizeof(mdp_wire::OrderEntry47)) {
+            const MDOrderEntry& entry = entries[i];
+            auto& wire = mdp_wire::block_at<mdp_wire::OrderEntry47>(out);
+            wire.order_id = entry.order_id;
+            wire.md_order_priority = entry.order_priority;
+            wire.md_entry_px = to_mantissa(entry.price);
+            wire.md_display_qty = entry.display_qty;
+            wire.security_id = static_cast<int32_t>(entry.security_id);
+            wire.md_update_action = static_cast<uint8_t>(entry.update_action);
+            wire.md_entry_type = static_cast<char>(entry.entry_type);
+            std::memset(wire.padding, 0, sizeof(wire.padding));
+        }
+        return length;
+    }
+
+    // Template 48, without order ID entries
+    static size_t encode_trade_summary(
+        uint64_t transact_time,
+        uint8_t match_event_indicator,
+        const MDTrade* entries,
+        size_t entry_count,
+        uint8_t* buffer,
+        size_t capacity)
+    {
+        using L = mdp_wire::TradeSummary48Layout;
+        size_t length = L::length(entry_count);
+        if (entry_count > L::MAX_ENTRIES || length > capacity) {
+            return 0;
+        }
+
+        encode_incremental_header<L>(transact_time, match_event_indicator, entry_count, buffer);
+        uint8_t* out = buffer + L::ENTRIES_OFFSET;
+        for (size_t i = 0; i < entry_count; ++i, out += sizeof(mdp_wire::TradeEntry48)) {
+            const MDTrade& entry = entries[i];
+            auto& wire = mdp_wire::block_at<mdp_wire::TradeEntry48>(out);
+            wire.md_entry_px = to_mantissa(entry.price);
+            wire.md_entry_size = entry.quantity;
+            wire.security_id = static_cast<int32_t>(entry.security_id);
+            wire.rpt_seq = entry.rpt_seq;
+            wire.number_of_orders = static_cast<int32_t>(entry.number_of_orders);
+            wire.aggressor_side = entry.aggressor_side;
+            wire.md_update_action = static_cast<uint8_t>(MDUpdateAction::New);
+            wire.md_trade_entry_id = entry.trade_entry_id;
+            std::memset(wire.padding, 0, sizeof(wire.padding));
+        }
+        mdp_wire::store(out, EMPTY_ORDER_ID_GROUP_48);
+        return length;
+    }
+
+    // Template 52: bids then offers
+    static size_t encode_snapshot_full_refresh(
+        const SnapshotFullRefresh& snapshot,
+        uint8_t* buffer,
+        size_t capacity)
+    {
+        using L = mdp_wire::Snapshot52Layout;
+        size_t entry_count = snapshot.bid_entries.size() + snapshot.ask_entries.size();
+        size_t length = L::length(entry_count);
+        if (entry_count > L::MAX_ENTRIES || length > capacity) {
+            return 0;
+        }
+
+        mdp_wire::store(buffer, L::HEADER);
+        auto& root = mdp_wire::block_at<mdp_wire::SnapshotRoot52>(buffer + L::ROOT_OFFSET);
+        root.last_msg_seq_num_processed = snapshot.last_msg_seq_num_processed;
+        root.tot_num_reports = snapshot.tot_num_reports;
+        root.security_id = static_cast<int32_t>(snapshot.security_id);
+        root.rpt_seq = snapshot.rpt_seq;
+        root.transact_time = snapshot.transact_time;
+        root.last_update_time = 0;
+        root.trade_date = 0;
+        root.md_security_trading_status = cme_sbe::SecurityTradingStatus::NULL_VALUE;
+        root.high_limit_price = cme_sbe::PRICENULL9::mantissaNullValue();
+        root.low_limit_price = cme_sbe::PRICENULL9::mantissaNullValue();
+        root.max_price_variation = cme_sbe::PRICENULL9::mantissaNullValue();
+
+        mdp_wire::store(buffer + L::GROUP_OFFSET, L::group_header(entry_count));
+
+        uint8_t* out = buffer + L::ENTRIES_OFFSET;
+        out = encode_snapshot_levels(snapshot.bid_entries, MDEntryType::Bid, out);
+        encode_snapshot_levels(snapshot.ask_entries, MDEntryType::Offer, out);
+        return length;
+    }
+
+    // Template 53, one chunk
+    static size_t encode_snapshot_full_refresh_order_book(
+        const SnapshotFullRefreshOrderBook& snapshot,
+        uint8_t* buffer,
+        size_t capacity)
+    {
+        using L = mdp_wire::Snapshot53Layout;
+        size_t length = L::length(snapshot.entries.size());
+        if (snapshot.entries.size() > L::MAX_ENTRIES || length > capacity) {
+            return 0;
+        }
+
+        mdp_wire::store(buffer, L::HEADER);
+        auto& root = mdp_wire::block_at<mdp_wire::SnapshotRoot53>(buffer + L::ROOT_OFFSET);
+        root.last_msg_seq_num_processed = snapshot.last_msg_seq_num_processed;
+        root.tot_num_reports = snapshot.tot_num_reports;
+        root.security_id = static_cast<int32_t>(snapshot.security_id);
+        root.no_chunks = snapshot.no_chunks;
+        root.current_chunk = snapshot.current_chunk;
+        root.transact_time = snapshot.transact_time;
+
+        mdp_wire::store(buffer + L::GROUP_OFFSET, L::group_header(snapshot.entries.size()));
+
+        uint8_t* out = buffer + L::ENTRIES_OFFSET;
+        for (const MDOrderEntry& entry : snapshot.entries) {
+            auto& wire = mdp_wire::block_at<mdp_wire::OrderEntry53>(out);
+            wire.order_id = entry.order_id;
+            wire.md_order_priority = entry.order_priority;
+            wire.md_entry_px = to_mantissa(entry.price);
+            wire.md_display_qty = entry.display_qty;
+            wire.md_entry_type = static_cast<char>(entry.entry_type);
+            out += sizeof(wire);
+        }
+        return length;
+    }
+
+private:
+    static constexpr mdp_wire::GroupSize8Byte EMPTY_ORDER_ID_GROUP_46 = {
+        cme_sbe::MDIncrementalRefreshBook46::NoOrderIDEntries::sbeBlockLength(), {}, 0
+    };
+    static constexpr mdp_wire::GroupSize8Byte EMPTY_ORDER_ID_GROUP_48 = {
+        cme_sbe::MDIncrementalRefreshTradeSummary48::NoOrderIDEntries::sbeBlockLength(), {}, 0
+    };
+
+    // Header, root block and entry group header of templates 46-48
+    template <typename L>
+    static void encode_incremental_header(
+        uint64_t transact_time,
+        uint8_t match_event_indicator,
+        size_t entry_count,
+        uint8_t* buffer)
+    {
+        mdp_wire::store(buffer, L::HEADER);
+        auto& root = mdp_wire::block_at<mdp_wire::IncrementalRoot>(buffer + L::ROOT_OFFSET);
+        root.transact_time = transact_time;
+        root.match_event_indicator = match_event_indicator;
+        root.padding[0] = 0;
+        root.padding[1] = 0;
+        mdp_wire::store(buffer + L::GROUP_OFFSET, L::group_header(entry_count));
+    }
+
+    static uint8_t* encode_snapshot_levels(
+        const std::vector<MDPriceLevel>& levels,
+        MDEntryType entry_type,
+        uint8_t* out)
+    {
+        for (const MDPriceLevel& level : levels) {
+            auto& wire = mdp_wire::block_at<mdp_wire::SnapshotEntry52>(out);
+            wire.md_entry_px = to_mantissa(level.price);
+            wire.md_entry_size = level.quantity;
+            wire.number_of_orders = static_cast<int32_t>(level.number_of_orders);
+            wire.md_price_level = static_cast<int8_t>(level.price_level);
+            wire.trading_reference_date = cme_sbe::SnapshotFullRefresh52::NoMDEntries::tradingReferenceDateNullValue();
+            wire.open_close_settl_flag = cme_sbe::OpenCloseSettlFlag::NULL_VALUE;
+            wire.settl_price_type = 0;
+            wire.md_entry_type = static_cast<char>(entry_type);
+            out += sizeof(wire);
+        }
+        return out;
+    }
+};
+
+} // namespace cme_protocol
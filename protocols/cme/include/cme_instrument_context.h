@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../../core/include/instrument.h"
+#include "cme_messages.h"
+#include <unordered_map>
+#include <vector>
+
+namespace cme_protocol {
+
+// Everything the CME encoders need from an Instrument, resolved once.
+// Instruments carry their CME identity in string-keyed maps
+// (external_ids["CME_SECURITY_ID"], properties["price_decimals"]); these
+// are read when the context is built so the hot path does no string work.
+struct CMEInstrumentContext {
+    uint32_t security_id = 0;
+    double price_scale = 100.0; // 10^price_decimals
+    int64_t tick_mantissa = 0; // tick_size in price units
+    bool resolved = false;
+
+    // Entry templates with the per-instrument fields filled in; hot-path
+    // builders copy one and set the per-event fields
+    MDPriceLevel book_entry {};
+    MDOrderEntry order_entry {};
+
+    int64_t to_price(double price) const { return static_cast<int64_t>(price * price_scale); }
+
+    static CMEInstrumentContext resolve(const market_core::Instrument& instrument);
+};
+
+// Contexts in a dense array indexed by internal instrument ID. IDs past
+// MAX_DENSE_ID (not expected from OrderBookManager) fall back to a hash
+// map so a stray large ID cannot blow up the table. Not thread-safe; one
+// table per adapter.
+class CMEInstrumentContextTable {
+public:
+    static constexpr uint32_t MAX_DENSE_ID = 1u << 20;
+
+    // Resolve (or re-resolve, e.g. after its IDs change) an instrument
+    const CMEInstrumentContext& add(const market_core::Instrument& instrument);
+
+    // Hot-path lookup; resolves on first use of an unregistered instrument
+    const CMEInstrumentContext& get(const market_core::Instrument& instrument)
+    {
+        uint32_t id = instrument.instrument_id;
+        if (id < dense_.size() && dense_[id].resolved) {
+            return dense_[id];
+        }
+        return find_or_add(instrument);
+    }
+
+    void clear();
+
+private:
+    std::vector<CMEInstrumentContext> dense_;
+    std::unordered_map<uint32_t, CMEInstrumentContext> sparse_;
+
+    const CMEInstrumentContext& find_or_add(const market_core::Instrument& instrument);
+};
+
+} // namespace cme_protocol
@@ -17,9 +17,11 @@ enum class MDPMessageType : uint16_t {
     IncrementalRefreshTrade = 48,
     IncrementalRefreshVolume = 37,
     IncrementalRefreshSessionStatistics = 51,
+    IncrementalRefreshOrderBook = 47,
 
     // Snapshot Messages
     SnapshotFullRefresh = 52,
+    SnapshotFullRefreshOrderBook = 53,
 
     // Security Definition
     MDInstrumentDefinitionFuture = 54,
@@ -106,6 +108,17 @@ struct MDPriceLevel {
     int32_t tradeable_size;
 };
 
+// CME Order Entry (market-by-order)
+struct MDOrderEntry {
+    uint64_t order_id;
+    uint64_t order_priority;
+    int64_t price;
+    int32_t display_qty;
+    uint32_t security_id;
+    MDUpdateAction update_action;
+    MDEntryType entry_type; // Bid or Offer
+};
+
 // CME Trade Entry
 struct MDTrade {
     uint32_t security_id;
@@ -113,8 +126,8 @@ struct MDTrade {
     int64_t price;
     int32_t quantity;
     uint32_t number_of_orders;
-    int8_t aggressor_side;
-    std::string trade_id;
+    uint8_t aggressor_side; // 0 none, 1 buy, 2 sell
+    uint32_t trade_entry_id;
 };
 
 // CME Statistics Entry
@@ -139,12 +152,32 @@ struct SnapshotFullRefresh {
     uint32_t security_id;
     uint64_t transact_time;
     uint32_t rpt_seq;
+    uint32_t last_msg_seq_num_processed = 0; // Incremental packet the book reflects
+    uint32_t tot_num_reports = 1; // Snapshots in the cycle
     std::vector<MDPriceLevel> bid_entries;
     std::vector<MDPriceLevel> ask_entries;
     double last_trade_price;
     uint64_t total_volume;
 };
 
+// Incremental Refresh Order Book message (template 47)
+struct IncrementalRefreshOrderBook {
+    uint64_t transact_time;
+    MatchEventIndicator match_event_indicator;
+    std::vector<MDOrderEntry> entries;
+};
+
+// Snapshot Full Refresh Order Book message (template 53), one chunk
+struct SnapshotFullRefreshOrderBook {
+    uint32_t security_id;
+    uint32_t last_msg_seq_num_processed;
+    uint32_t tot_num_reports;
+    uint32_t no_chunks;
+    uint32_t current_chunk;
+    uint64_t transact_time;
+    std::vector<MDOrderEntry> entries;
+};
+
 // Security Definition
 struct SecurityDefinition {
     uint32_t security_id;
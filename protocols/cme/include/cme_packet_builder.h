@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace cme_protocol {
+
+// Builds one MDP packet in a buffer allocated once at construction.
+//
+// Layout: 12-byte packet header (sequence number, sending time), then per
+// message a 2-byte little-endian size followed by the SBE message. Messages
+// are encoded straight into message_buffer() and committed with their
+// length; finish() stamps the header and the packet is read back in place
+// through data()/size().
+class CMEPacketBuilder {
+public:
+    static constexpr size_t PACKET_HEADER_SIZE = 12; // Sequence number + sending time
+    static constexpr size_t MESSAGE_SIZE_FIELD = 2;
+
+    explicit CMEPacketBuilder(size_t capacity);
+
+    CMEPacketBuilder(const CMEPacketBuilder&) = delete;
+    CMEPacketBuilder& operator=(const CMEPacketBuilder&) = delete;
+
+    // Drop any contents and start an empty packet
+    void reset()
+    {
+        size_ = PACKET_HEADER_SIZE;
+        message_count_ = 0;
+    }
+
+    bool empty() const { return message_count_ == 0; }
+    size_t message_count() const { return message_count_; }
+    size_t capacity() const { return capacity_; }
+
+    // Whether a message of this encoded length still fits
+    bool fits(size_t message_length) const
+    {
+        return size_ + MESSAGE_SIZE_FIELD + message_length <= capacity_;
+    }
+
+    // Largest message that fits in an otherwise empty packet
+    size_t max_message_length() const { return capacity_ - PACKET_HEADER_SIZE - MESSAGE_SIZE_FIELD; }
+
+    // Where the next message body goes, and how much room it has
+    uint8_t* message_buffer() { return buffer_.get() + size_ + MESSAGE_SIZE_FIELD; }
+    size_t message_capacity() const { return capacity_ - size_ - MESSAGE_SIZE_FIELD; }
+
+    // Seal the message just encoded into message_buffer()
+    void commit_message(size_t length)
+    {
+        uint16_t size_field = static_cast<uint16_t>(length);
+        std::memcpy(buffer_.get() + size_, &size_field, MESSAGE_SIZE_FIELD);
+        size_ += MESSAGE_SIZE_FIELD + length;
+        ++message_count_;
+    }
+
+    // Copy a pre-encoded message in; false when it does not fit
+    bool append_message(const uint8_t* data, size_t length);
+
+    // Write the packet header; the packet is then ready to send
+    void finish(uint32_t sequence_number, uint64_t sending_time);
+
+    const uint8_t* data() const { return buffer_.get(); }
+    size_t size() const { return size_; }
+
+private:
+    std::unique_ptr<uint8_t[]> buffer_;
+    size_t capacity_;
+    size_t size_ = PACKET_HEADER_SIZE;
+    size_t message_count_ = 0;
+};
+
+} // namespace cme_protocol
@@ -1,8 +1,12 @@
 #pragma once
 
+#include "../../common/include/packet_journal.h"
 #include "../../common/include/protocol_adapter.h"
+#include "cme_instrument_context.h"
 #include "cme_messages.h"
-#include <queue>
+#include "cme_packet_builder.h"
+#include <atomic>
+#include <chrono>
 
 namespace cme_protocol {
 
@@ -37,6 +41,10 @@ public:
         const market_core::Instrument& instrument,
         const market_core::StatusEvent& event) override;
 
+    void process_order_event(
+        const market_core::Instrument& instrument,
+        const market_core::OrderEvent& event) override;
+
     void send_instrument_definition(
         const market_core::Instrument& instrument) override;
 
@@ -54,57 +62,156 @@ public:
         transport_ = transport;
     }
 
+    // Copy every packet sent into a retransmission journal, keyed by its
+    // packet sequence number
+    void set_journal(std::shared_ptr<market_protocols::PacketJournal> journal) { journal_ = journal; }
+
     // CME-specific methods
     void set_channel_id(uint16_t channel_id) { channel_id_ = channel_id; }
     void set_batch_size(size_t size) { batch_size_ = size; }
     void flush_batch(); // Send accumulated messages
 
+    // Between begin_batch() and end_batch() messages share packets, up to
+    // batch_size messages or max_message_size() bytes per packet, instead of
+    // one packet per message
+    void begin_batch() { batching_ = true; }
+    void end_batch();
+
+    // Latency-bounded packing. With a non-zero max latency every message is
+    // packed, inside a batch or not: a packet goes out when the next
+    // message would overflow it, when it holds batch_size messages, or
+    // once its first message has waited max_latency. The size and latency
+    // flushes wait for the current match event to end (MatchEventIndicator
+    // end-of-event); only an overflowing message splits an event. Call
+    // poll() from idle loops so a quiet feed still meets the deadline; it
+    // also polls the transport for deferred sends.
+    void set_max_latency(std::chrono::nanoseconds latency) { max_latency_ = latency; }
+    std::chrono::nanoseconds get_max_latency() const { return max_latency_; }
+    void poll();
+
+    // Update coalescing. When enabled, the quote, trade and statistics
+    // updates of a batch, all template 46 entries here, are merged into one
+    // message with an entry per update, across instruments, instead of one
+    // message each. A run ends at the batch end or at any other message
+    // (order updates, snapshots, status), and splits only when it outgrows
+    // a packet; only the run's last message carries end-of-event and the
+    // last-quote/trade/stats flags in its MatchEventIndicator.
+    void set_coalesce_updates(bool enabled) { coalesce_updates_ = enabled; }
+    bool get_coalesce_updates() const { return coalesce_updates_; }
+
+    // Resolve an instrument's security ID, price scale and entry templates
+    // up front. send_instrument_definition does this too; instruments that
+    // were never registered are resolved on first use.
+    void register_instrument(const market_core::Instrument& instrument) { contexts_.add(instrument); }
+
+    // Publish one instrument's snapshot (template 52, plus template 53 for
+    // MBO books) stamped for a snapshot cycle: lastMsgSeqNumProcessed is
+    // the incremental packet sequence the book reflects, totNumReports the
+    // number of instruments in the cycle. rptSeq comes from the event.
+    void send_snapshot(
+        const market_core::Instrument& instrument,
+        const market_core::SnapshotEvent& event,
+        uint32_t last_msg_seq_num_processed,
+        uint32_t tot_num_reports);
+
+    // Sequence number of the last packet handed to the transport; safe to
+    // read from other threads, e.g. a snapshot cycle correlating with this
+    // incremental feed
+    uint32_t last_sent_sequence() const { return last_sent_sequence_.load(std::memory_order_acquire); }
+
+    // Packing effectiveness; readable from other threads
+    uint64_t packets_sent() const { return packets_sent_.load(std::memory_order_relaxed); }
+    uint64_t messages_sent() const { return messages_sent_.load(std::memory_order_relaxed); }
+
     // Sequence management
     uint32_t get_next_sequence() override { return ++sequence_number_; }
     void reset_sequence() override { sequence_number_ = 0; }
 
 private:
     std::shared_ptr<market_protocols::IMessageTransport> transport_;
+    std::shared_ptr<market_protocols::PacketJournal> journal_;
     uint16_t channel_id_ = 310; // Default CME Equity Futures channel
     uint32_t sequence_number_ = 0;
+    std::atomic<uint32_t> last_sent_sequence_ { 0 };
     size_t batch_size_ = 10;
 
-    // Message batching
-    std::queue<std::vector<uint8_t>> message_queue_;
-    std::vector<std::vector<uint8_t>> current_batch_;
-
-    // Helper methods
-    std::vector<uint8_t> encode_incremental_refresh(
+    CMEInstrumentContextTable contexts_;
+
+    // Message batching: incremental messages are encoded straight into
+    // the packet being built, which is handed to the transport in place
+    CMEPacketBuilder packet_;
+    bool batching_ = false;
+    std::chrono::nanoseconds max_latency_ { 0 };
+    std::chrono::steady_clock::time_point packet_started_; // First message of packet_
+    bool event_open_ = false; // Last packed message did not end its match event
+    std::atomic<uint64_t> packets_sent_ { 0 };
+    std::atomic<uint64_t> messages_sent_ { 0 };
+
+    // Update run being coalesced, up to a full packet's worth of entries
+    bool coalesce_updates_ = false;
+    std::vector<MDPriceLevel> pending_entries_;
+    uint64_t pending_transact_time_ = 0;
+    MatchEventIndicator pending_indicator_ {}; // last_*_msg flags of the run
+
+    // Hot-path entry builders; encoded in place by send_book_entries and
+    // send_order_entries
+    MDPriceLevel quote_entry(
         const market_core::Instrument& instrument,
         const market_core::QuoteEvent& event);
 
-    std::vector<uint8_t> encode_trade_summary(
+    MDPriceLevel trade_entry(
         const market_core::Instrument& instrument,
         const market_core::TradeEvent& event);
 
+    MDPriceLevel statistics_entry(
+        const market_core::Instrument& instrument,
+        const market_core::StatisticsEvent& event);
+
+    MDOrderEntry order_entry(
+        const market_core::Instrument& instrument,
+        const market_core::OrderEvent& event);
+
+    // Helper methods
+
     std::vector<uint8_t> encode_snapshot_full_refresh(
         const market_core::Instrument& instrument,
-        const market_core::SnapshotEvent& event);
+        const market_core::SnapshotEvent& event,
+        uint32_t last_msg_seq_num_processed,
+        uint32_t tot_num_reports);
 
-    std::vector<uint8_t> encode_statistics(
+    // One template 53 message per chunk of resting orders
+    std::vector<std::vector<uint8_t>> encode_order_book_snapshot(
         const market_core::Instrument& instrument,
-        const market_core::StatisticsEvent& event);
+        const market_core::SnapshotEvent& event,
+        uint32_t last_msg_seq_num_processed,
+        uint32_t tot_num_reports);
 
     std::vector<uint8_t> encode_security_status(
         const market_core::Instrument& instrument,
         const market_core::StatusEvent& event);
 
-    std::vector<uint8_t> create_packet_header(uint64_t sending_time);
-    std::vector<uint8_t> encode_message_size(uint16_t size);
+    // Space for a message of `length` bytes in the current packet, flushing
+    // first if it would not fit; commit_message seals it
+    uint8_t* reserve_message(size_t length);
+    void commit_message(size_t length, bool end_of_event);
+    void emit_packet(); // Send packet_ as is, leaving any update run pending
+
+    // Add an entry to the update run; false when not coalescing
+    bool coalesce_entry(const MDPriceLevel& entry, uint64_t transact_time, MatchEventIndicator flags);
+
+    // Emit the pending update run as one message; end_of_event closes it
+    void flush_entries(bool end_of_event = true);
 
-    void send_message(const std::vector<uint8_t>& message);
-    void send_batch(const std::vector<std::vector<uint8_t>>& messages);
+    // The send_* helpers close any pending update run first, keeping wire
+    // order; write_book_entries encodes without touching the run
+    void send_book_entries(uint64_t transact_time, MatchEventIndicator indicator, const MDPriceLevel* entries, size_t count);
+    void write_book_entries(uint64_t transact_time, MatchEventIndicator indicator, const MDPriceLevel* entries, size_t count);
+    void send_order_entries(uint64_t transact_time, MatchEventIndicator indicator, const MDOrderEntry* entries, size_t count);
+    void send_message(const std::vector<uint8_t>& message); // Pre-encoded (snapshots, definitions)
 
     // Convert core types to CME types
     MDUpdateAction to_cme_update_action(market_core::UpdateAction action);
     MDEntryType to_cme_entry_type(market_core::Side side);
-    uint32_t get_cme_security_id(const market_core::Instrument& instrument);
-    int64_t price_to_cme(double price, const market_core::Instrument& instrument);
 };
 
 } // namespace cme_protocol
\ No newline at end of file
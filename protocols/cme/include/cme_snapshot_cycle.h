@@ -0,0 +1,87 @@
+#pragma once
+
+#include "cme_protocol_adapter.h"
+#include "order_book_manager.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace cme_protocol {
+
+// Snapshot channel loop: publishes a full refresh of every instrument with
+// a book, round after round, from its own thread at a fixed snapshot rate.
+//
+// Each book is copied to max_depth levels under its shard lock and encoded
+// off-lock, so the incremental path is only held up for the copy. Every
+// snapshot carries the instrument's rptSeq (the sequence of the last event
+// applied to the book) and, as lastMsgSeqNumProcessed, the incremental
+// feed's last sent packet sequence read just before the copy. Events are
+// applied to books before they are encoded, so a snapshot never misses an
+// update from a packet at or below lastMsgSeqNumProcessed; updates it
+// already includes from later packets are the ones a recovering client
+// skips by rptSeq. totNumReports is the number of instruments in the
+// cycle, and the snapshot channel's packet sequence restarts at 1 with
+// each cycle.
+class CMESnapshotCycle {
+public:
+    struct Config {
+        double snapshots_per_second = 1000.0; // Budget across all instruments
+        size_t max_depth = 10; // Price levels per side
+
+        // Instruments of this channel; empty cycles every instrument
+        std::function<bool(uint32_t)> instrument_filter;
+    };
+
+    struct Statistics {
+        uint64_t cycles = 0; // Completed cycles
+        uint64_t snapshots = 0;
+        uint64_t last_cycle_ns = 0; // Duration of the last completed cycle
+    };
+
+    CMESnapshotCycle(
+        std::shared_ptr<market_core::OrderBookManager> book_manager,
+        std::shared_ptr<CMEProtocolAdapter> snapshot_adapter,
+        std::shared_ptr<const CMEProtocolAdapter> incremental_adapter,
+        const Config& config);
+    ~CMESnapshotCycle();
+
+    CMESnapshotCycle(const CMESnapshotCycle&) = delete;
+    CMESnapshotCycle& operator=(const CMESnapshotCycle&) = delete;
+
+    // Cycle continuously on a background thread at the configured rate.
+    // The snapshot adapter belongs to that thread until stop().
+    void start();
+    void stop();
+    bool is_running() const { return thread_.joinable(); }
+
+    // One unpaced cycle on the caller's thread; returns the snapshots sent
+    size_t run_cycle();
+
+    Statistics get_statistics() const;
+
+private:
+    std::shared_ptr<market_core::OrderBookManager> book_manager_;
+    std::shared_ptr<CMEProtocolAdapter> snapshot_adapter_;
+    std::shared_ptr<const CMEProtocolAdapter> incremental_adapter_;
+    Config config_;
+
+    std::thread thread_;
+    std::atomic<bool> stopping_ { false };
+
+    // Reused across snapshots and cycles
+    market_core::SnapshotEvent event_;
+    std::vector<uint32_t> cycle_ids_;
+
+    std::atomic<uint64_t> cycles_ { 0 };
+    std::atomic<uint64_t> snapshots_ { 0 };
+    std::atomic<uint64_t> last_cycle_ns_ { 0 };
+
+    void run();
+    size_t begin_cycle(); // Instruments of the next cycle, into cycle_ids_
+    bool publish(uint32_t instrument_id, uint32_t tot_num_reports);
+    void end_cycle(std::chrono::steady_clock::time_point started);
+};
+
+} // namespace cme_protocol
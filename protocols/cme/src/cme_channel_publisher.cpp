@@ -0,0 +1,150 @@
+#include "../include/cme_channel_publisher.h"
+#include <pthread.h>
+#include <sched.h>
+
+namespace cme_protocol {
+
+static void pin_current_thread(int cpu)
+{
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+}
+
+CMEChannelPublisher::CMEChannelPublisher(
+    const CMEChannelConfig& config,
+    std::shared_ptr<market_core::OrderBookManager> book_manager)
+    : config_(config)
+    , adapter_(std::make_shared<CMEProtocolAdapter>())
+    , listener_(std::make_shared<CMEEventListener>(std::move(book_manager), adapter_))
+    , queue_(config.queue_capacity)
+{
+    adapter_->set_channel_id(config.channel_id);
+}
+
+CMEChannelPublisher::~CMEChannelPublisher()
+{
+    stop();
+}
+
+void CMEChannelPublisher::start()
+{
+    if (thread_.joinable()) {
+        return;
+    }
+    stopping_ = false;
+    thread_ = std::thread(&CMEChannelPublisher::run, this);
+}
+
+void CMEChannelPublisher::stop()
+{
+    stopping_ = true;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void CMEChannelPublisher::wait_and_push(const market_core::EventRecord& record)
+{
+    // Dropping would leave a sequence gap; back-pressure the generator
+    queue_full_waits_.fetch_add(1, std::memory_order_relaxed);
+    while (!queue_.try_push(record)) {
+        std::this_thread::yield();
+    }
+}
+
+void CMEChannelPublisher::run()
+{
+    if (config_.cpu >= 0) {
+        pin_current_thread(config_.cpu);
+    }
+
+    std::vector<market_core::EventRecord> batch(MAX_BATCH);
+    while (true) {
+        // Read the flag first so records queued before stop() are drained
+        bool stopping = stopping_.load(std::memory_order_acquire);
+        size_t count = queue_.try_pop(batch.data(), batch.size());
+        if (count > 0) {
+            listener_->on_market_events(market_core::EventRecordSpan(batch.data(), count));
+            events_published_.fetch_add(count, std::memory_order_relaxed);
+            continue;
+        }
+        if (stopping) {
+            break;
+        }
+
+        // Idle: meet packing deadlines and deferred sends, then back off
+        adapter_->poll();
+        if (config_.idle_sleep.count() > 0) {
+            std::this_thread::sleep_for(config_.idle_sleep);
+        }
+    }
+    adapter_->flush_batch();
+}
+
+CMEMultiChannelPublisher::CMEMultiChannelPublisher(std::shared_ptr<market_core::OrderBookManager> book_manager)
+    : book_manager_(std::move(book_manager))
+{
+}
+
+CMEMultiChannelPublisher::~CMEMultiChannelPublisher()
+{
+    stop();
+}
+
+CMEChannelPublisher& CMEMultiChannelPublisher::add_channel(const CMEChannelConfig& config)
+{
+    registry_.add_channel(config);
+    channels_.push_back(std::make_unique<CMEChannelPublisher>(config, book_manager_));
+    return *channels_.back();
+}
+
+void CMEMultiChannelPublisher::assign_instruments()
+{
+    registry_.assign_instruments(*book_manager_);
+}
+
+void CMEMultiChannelPublisher::start()
+{
+    for (auto& channel : channels_) {
+        channel->start();
+    }
+}
+
+void CMEMultiChannelPublisher::stop()
+{
+    for (auto& channel : channels_) {
+        channel->stop();
+    }
+}
+
+CMEChannelPublisher* CMEMultiChannelPublisher::find_channel(uint16_t channel_id)
+{
+    for (auto& channel : channels_) {
+        if (channel->channel_id() == channel_id) {
+            return channel.get();
+        }
+    }
+    return nullptr;
+}
+
+void CMEMultiChannelPublisher::on_event_record(const market_core::EventRecord& record)
+{
+    if (channels_.empty()) {
+        return;
+    }
+    channel_for(record.instrument_id).publish(record);
+}
+
+void CMEMultiChannelPublisher::on_market_events(market_core::EventRecordSpan records)
+{
+    if (channels_.empty()) {
+        return;
+    }
+    for (const auto& record : records) {
+        channel_for(record.instrument_id).publish(record);
+    }
+}
+
+} // namespace cme_protocol
@@ -0,0 +1,243 @@
+#include "../include/cme_channel_registry.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace cme_protocol {
+
+// Minimal JSON scanning for the flat objects of a channel list: values
+// are found by key within one object's text
+
+// End of the object or array opening at begin (one past its closing bracket)
+static size_t matching_close(const std::string& json, size_t begin)
+{
+    char open = json[begin];
+    char close = open == '{' ? '}' : ']';
+    int depth = 0;
+    bool in_string = false;
+    for (size_t pos = begin; pos < json.size(); ++pos) {
+        char c = json[pos];
+        if (in_string) {
+            if (c == '\\') {
+                ++pos;
+            } else if (c == '"') {
+                in_string = false;
+            }
+        } else if (c == '"') {
+            in_string = true;
+        } else if (c == open) {
+            ++depth;
+        } else if (c == close && --depth == 0) {
+            return pos + 1;
+        }
+    }
+    return std::string::npos;
+}
+
+// Position just past "key": and any whitespace, or npos
+static size_t value_of(const std::string& object, const std::string& key)
+{
+    size_t pos = object.find("\"" + key + "\"");
+    if (pos == std::string::npos) {
+        return pos;
+    }
+    pos = object.find(':', pos + key.size() + 2);
+    if (pos == std::string::npos) {
+        return pos;
+    }
+    return object.find_first_not_of(" \t\r\n", pos + 1);
+}
+
+static bool string_value(const std::string& object, size_t pos, std::string& value)
+{
+    if (pos == std::string::npos || object[pos] != '"') {
+        return false;
+    }
+    size_t end = object.find('"', pos + 1);
+    if (end == std::string::npos) {
+        return false;
+    }
+    value = object.substr(pos + 1, end - pos - 1);
+    return true;
+}
+
+static bool number_value(const std::string& object, size_t pos, long& value)
+{
+    if (pos == std::string::npos) {
+        return false;
+    }
+    try {
+        value = std::stol(object.substr(pos, 24));
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+// Elements of an array value, each as its own text
+static std::vector<std::string> array_elements(const std::string& object, size_t pos)
+{
+    std::vector<std::string> elements;
+    if (pos == std::string::npos || object[pos] != '[') {
+        return elements;
+    }
+    size_t end = matching_close(object, pos);
+    if (end == std::string::npos) {
+        return elements;
+    }
+    std::string body = object.substr(pos + 1, end - pos - 2);
+    size_t start = 0;
+    while (start < body.size()) {
+        start = body.find_first_not_of(" \t\r\n,", start);
+        if (start == std::string::npos) {
+            break;
+        }
+        size_t next;
+        if (body[start] == '{' || body[start] == '[') {
+            next = matching_close(body, start);
+        } else if (body[start] == '"') {
+            next = body.find('"', start + 1);
+            next = next == std::string::npos ? next : next + 1;
+        } else {
+            next = body.find(',', start);
+        }
+        next = std::min(next, body.size());
+        elements.push_back(body.substr(start, next - start));
+        start = next;
+    }
+    return elements;
+}
+
+bool CMEChannelRegistry::parse_channels(const std::string& json, std::vector<CMEChannelConfig>& channels)
+{
+    size_t before = channels.size();
+    for (const std::string& object : array_elements(json, value_of(json, "channels"))) {
+        CMEChannelConfig config;
+        long number;
+        if (object.empty() || object[0] != '{' || !number_value(object, value_of(object, "id"), number)
+            || number <= 0 || number > 0xFFFF) {
+            continue;
+        }
+        config.channel_id = static_cast<uint16_t>(number);
+        string_value(object, value_of(object, "name"), config.name);
+        for (const std::string& group : array_elements(object, value_of(object, "product_groups"))) {
+            std::string value;
+            if (string_value(group, 0, value)) {
+                config.product_groups.push_back(value);
+            }
+        }
+        for (const std::string& id : array_elements(object, value_of(object, "instrument_ids"))) {
+            if (number_value(id, 0, number) && number >= 0) {
+                config.instrument_ids.push_back(static_cast<uint32_t>(number));
+            }
+        }
+        if (number_value(object, value_of(object, "cpu"), number)) {
+            config.cpu = static_cast<int>(number);
+        }
+
+        size_t feed = value_of(object, "incremental_feed");
+        if (feed != std::string::npos && object[feed] == '{') {
+            std::string feed_object = object.substr(feed, matching_close(object, feed) - feed);
+            string_value(feed_object, value_of(feed_object, "ip"), config.incremental_ip);
+            if (number_value(feed_object, value_of(feed_object, "port"), number) && number > 0 && number <= 0xFFFF) {
+                config.incremental_port = static_cast<uint16_t>(number);
+            }
+        }
+        channels.push_back(config);
+    }
+    return channels.size() > before;
+}
+
+bool CMEChannelRegistry::load_channels(const std::string& filename, std::vector<CMEChannelConfig>& channels)
+{
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return parse_channels(buffer.str(), channels);
+}
+
+size_t CMEChannelRegistry::add_channel(const CMEChannelConfig& config)
+{
+    channels_.push_back(config);
+    members_.emplace_back();
+    return channels_.size() - 1;
+}
+
+void CMEChannelRegistry::assign_instruments(const market_core::OrderBookManager& manager)
+{
+    dense_.clear();
+    sparse_.clear();
+    for (auto& members : members_) {
+        members.clear();
+    }
+
+    for (const auto& instrument : manager.get_all_instruments()) {
+        assign(*instrument);
+    }
+}
+
+size_t CMEChannelRegistry::assign(const market_core::Instrument& instrument)
+{
+    if (channels_.empty()) {
+        return 0;
+    }
+
+    uint32_t id = instrument.instrument_id;
+    size_t index = match(instrument);
+
+    uint16_t* slot;
+    if (id >= MAX_DENSE_ID) {
+        slot = &sparse_.emplace(id, UNASSIGNED).first->second;
+    } else {
+        if (id >= dense_.size()) {
+            dense_.resize(static_cast<size_t>(id) + 1, UNASSIGNED);
+        }
+        slot = &dense_[id];
+    }
+
+    // Re-assignment moves the instrument out of its old channel
+    if (*slot != UNASSIGNED) {
+        auto& members = members_[*slot];
+        members.erase(std::remove(members.begin(), members.end(), id), members.end());
+    }
+    *slot = static_cast<uint16_t>(index);
+    members_[index].push_back(id);
+    return index;
+}
+
+const CMEChannelConfig* CMEChannelRegistry::find(uint16_t channel_id) const
+{
+    for (const auto& channel : channels_) {
+        if (channel.channel_id == channel_id) {
+            return &channel;
+        }
+    }
+    return nullptr;
+}
+
+size_t CMEChannelRegistry::match(const market_core::Instrument& instrument) const
+{
+    // Explicit assignments win over product groups
+    for (size_t i = 0; i < channels_.size(); ++i) {
+        const auto& ids = channels_[i].instrument_ids;
+        if (std::find(ids.begin(), ids.end(), instrument.instrument_id) != ids.end()) {
+            return i;
+        }
+    }
+
+    auto group = instrument.get_property<std::string>("product_group");
+    if (group) {
+        for (size_t i = 0; i < channels_.size(); ++i) {
+            const auto& groups = channels_[i].product_groups;
+            if (std::find(groups.begin(), groups.end(), *group) != groups.end()) {
+                return i;
+            }
+        }
+    }
+    return 0;
+}
+
+} // namespace cme_protocol
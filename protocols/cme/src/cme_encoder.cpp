@@ -11,53 +11,73 @@ std::vector<uint8_t> CMEEncoder::encode_incremental_refresh_book(
     // 1. Allocate buffer for SBE to encode into
     std::vector<uint8_t> buffer(MAX_MESSAGE_SIZE);
 
-    // 2. Create and wrap the message header
+    // 2. Encode in place, then trim to the encoded length
+    size_t encoded_length = encode_incremental_refresh_book(
+        refresh.transact_time,
+        refresh.match_event_indicator.to_byte(),
+        refresh.entries.data(),
+        refresh.entries.size(),
+        buffer.data(),
+        buffer.size());
+
+    buffer.resize(encoded_length);
+    return buffer;
+}
+
+size_t CMEEncoder::encode_incremental_refresh_book(
+    uint64_t transact_time,
+    uint8_t match_event_indicator,
+    const MDPriceLevel* entries,
+    size_t entry_count,
+    uint8_t* buffer,
+    size_t capacity)
+{
+    size_t encoded_length = incremental_refresh_book_length(entry_count);
+    if (encoded_length > capacity) {
+        return 0;
+    }
+
+    // 1. Wrap the message header
     cme_sbe::MessageHeader header;
-    header.wrap(reinterpret_cast<char*>(buffer.data()), 0, 0, buffer.size())
+    header.wrap(reinterpret_cast<char*>(buffer), 0, 0, capacity)
         .blockLength(cme_sbe::MDIncrementalRefreshBook46::sbeBlockLength())
         .templateId(cme_sbe::MDIncrementalRefreshBook46::sbeTemplateId())
         .schemaId(cme_sbe::MDIncrementalRefreshBook46::sbeSchemaId())
         .version(cme_sbe::MDIncrementalRefreshBook46::sbeSchemaVersion());
 
-    // 3. Wrap the actual message for encoding at the correct offset
+    // 2. Wrap the actual message for encoding at the correct offset
     cme_sbe::MDIncrementalRefreshBook46 sbe_msg;
     sbe_msg.wrapForEncode(
-        reinterpret_cast<char*>(buffer.data()),
+        reinterpret_cast<char*>(buffer),
         header.encodedLength(), // Start after header
-        buffer.size());
-
-    // 4. Use SBE's fluent API to set all fields
-    // SBE handles all the binary encoding internally
-    sbe_msg.transactTime(refresh.transact_time);
+        capacity);
 
-    // Set match event indicator
-    sbe_msg.matchEventIndicator().clear();
+    // 3. Use SBE's fluent API to set all fields
+    sbe_msg.transactTime(transact_time);
+    sbe_msg.matchEventIndicator().rawValue(match_event_indicator);
 
-    // 5. Encode repeating groups using SBE's API
-    auto& entries = sbe_msg.noMDEntriesCount(refresh.entries.size());
-    for (const auto& entry : refresh.entries) {
-        auto& group_entry = entries.next();
+    // 4. Encode repeating groups using SBE's API
+    auto& group = sbe_msg.noMDEntriesCount(static_cast<uint8_t>(entry_count));
+    for (size_t i = 0; i < entry_count; ++i) {
+        const MDPriceLevel& entry = entries[i];
+        auto& group_entry = group.next();
         group_entry.securityID(entry.security_id)
             .rptSeq(entry.rpt_seq)
             .mDEntrySize(static_cast<int32_t>(entry.quantity))
             .numberOfOrders(entry.number_of_orders)
             .mDPriceLevel(entry.price_level)
             .mDUpdateAction(static_cast<cme_sbe::MDUpdateAction::Value>(entry.update_action))
-            .mDEntryType(static_cast<cme_sbe::MDEntryTypeBook::Value>(entry.entry_type));
+            .mDEntryType(static_cast<cme_sbe::MDEntryTypeBook::Value>(entry.entry_type))
+            .tradeableSize(entry.tradeable_size);
 
         // Set price separately to avoid chaining issues
         group_entry.mDEntryPx().mantissa(to_sbe_price(entry.price));
     }
 
-    // 6. Second repeating group (usually empty for book updates)
+    // 5. Second repeating group (usually empty for book updates)
     sbe_msg.noOrderIDEntriesCount(0);
 
-    // 7. Get the actual encoded length from SBE
-    size_t encoded_length = header.encodedLength() + sbe_msg.encodedLength();
-
-    // 8. Resize buffer to actual size and return
-    buffer.resize(encoded_length);
-    return buffer;
+    return encoded_length;
 }
 
 std::vector<uint8_t> CMEEncoder::encode_snapshot_full_refresh(
@@ -82,8 +102,9 @@ std::vector<uint8_t> CMEEncoder::encode_snapshot_full_refresh(
 
     // Use SBE API to set fields - SBE does all binary encoding
     sbe_msg.securityID(snapshot.security_id)
-        .lastMsgSeqNumProcessed(snapshot.rpt_seq)
-        .totNumReports(1)
+        .lastMsgSeqNumProcessed(snapshot.last_msg_seq_num_processed)
+        .totNumReports(snapshot.tot_num_reports)
+        .rptSeq(snapshot.rpt_seq)
         .transactTime(snapshot.transact_time)
         .tradeDate(0); // Will be set if needed
 
@@ -121,6 +142,110 @@ std::vector<uint8_t> CMEEncoder::encode_snapshot_full_refresh(
     return buffer;
 }
 
+std::vector<uint8_t> CMEEncoder::encode_incremental_refresh_order_book(
+    const IncrementalRefreshOrderBook& refresh)
+{
+    std::vector<uint8_t> buffer(MAX_MESSAGE_SIZE);
+
+    size_t encoded_length = encode_incremental_refresh_order_book(
+        refresh.transact_time,
+        refresh.match_event_indicator.to_byte(),
+        refresh.entries.data(),
+        refresh.entries.size(),
+        buffer.data(),
+        buffer.size());
+
+    buffer.resize(encoded_length);
+    return buffer;
+}
+
+size_t CMEEncoder::encode_incremental_refresh_order_book(
+    uint64_t transact_time,
+    uint8_t match_event_indicator,
+    const MDOrderEntry* entries,
+    size_t entry_count,
+    uint8_t* buffer,
+    size_t capacity)
+{
+    size_t encoded_length = incremental_refresh_order_book_length(entry_count);
+    if (encoded_length > capacity) {
+        return 0;
+    }
+
+    cme_sbe::MessageHeader header;
+    header.wrap(reinterpret_cast<char*>(buffer), 0, 0, capacity)
+        .blockLength(cme_sbe::MDIncrementalRefreshOrderBook47::sbeBlockLength())
+        .templateId(cme_sbe::MDIncrementalRefreshOrderBook47::sbeTemplateId())
+        .schemaId(cme_sbe::MDIncrementalRefreshOrderBook47::sbeSchemaId())
+        .version(cme_sbe::MDIncrementalRefreshOrderBook47::sbeSchemaVersion());
+
+    cme_sbe::MDIncrementalRefreshOrderBook47 sbe_msg;
+    sbe_msg.wrapForEncode(
+        reinterpret_cast<char*>(buffer),
+        header.encodedLength(),
+        capacity);
+
+    sbe_msg.transactTime(transact_time);
+    sbe_msg.matchEventIndicator().rawValue(match_event_indicator);
+
+    auto& group = sbe_msg.noMDEntriesCount(static_cast<uint8_t>(entry_count));
+    for (size_t i = 0; i < entry_count; ++i) {
+        const MDOrderEntry& entry = entries[i];
+        auto& group_entry = group.next();
+        group_entry.orderID(entry.order_id)
+            .mDOrderPriority(entry.order_priority)
+            .mDDisplayQty(entry.display_qty)
+            .securityID(static_cast<int32_t>(entry.security_id))
+            .mDUpdateAction(static_cast<cme_sbe::MDUpdateAction::Value>(entry.update_action))
+            .mDEntryType(static_cast<cme_sbe::MDEntryTypeBook::Value>(entry.entry_type));
+
+        group_entry.mDEntryPx().mantissa(to_sbe_price(entry.price));
+    }
+
+    return encoded_length;
+}
+
+std::vector<uint8_t> CMEEncoder::encode_snapshot_full_refresh_order_book(
+    const SnapshotFullRefreshOrderBook& snapshot)
+{
+    std::vector<uint8_t> buffer(MAX_MESSAGE_SIZE);
+
+    cme_sbe::MessageHeader header;
+    header.wrap(reinterpret_cast<char*>(buffer.data()), 0, 0, buffer.size())
+        .blockLength(cme_sbe::SnapshotFullRefreshOrderBook53::sbeBlockLength())
+        .templateId(cme_sbe::SnapshotFullRefreshOrderBook53::sbeTemplateId())
+        .schemaId(cme_sbe::SnapshotFullRefreshOrderBook53::sbeSchemaId())
+        .version(cme_sbe::SnapshotFullRefreshOrderBook53::sbeSchemaVersion());
+
+    cme_sbe::SnapshotFullRefreshOrderBook53 sbe_msg;
+    sbe_msg.wrapForEncode(
+        reinterpret_cast<char*>(buffer.data()),
+        header.encodedLength(),
+        buffer.size());
+
+    sbe_msg.lastMsgSeqNumProcessed(snapshot.last_msg_seq_num_processed)
+        .totNumReports(snapshot.tot_num_reports)
+        .securityID(static_cast<int32_t>(snapshot.security_id))
+        .noChunks(snapshot.no_chunks)
+        .currentChunk(snapshot.current_chunk)
+        .transactTime(snapshot.transact_time);
+
+    auto& entries = sbe_msg.noMDEntriesCount(static_cast<uint8_t>(snapshot.entries.size()));
+    for (const auto& entry : snapshot.entries) {
+        auto& group_entry = entries.next();
+        group_entry.orderID(entry.order_id)
+            .mDOrderPriority(entry.order_priority)
+            .mDDisplayQty(entry.display_qty)
+            .mDEntryType(static_cast<cme_sbe::MDEntryTypeBook::Value>(entry.entry_type));
+
+        group_entry.mDEntryPx().mantissa(to_sbe_price(entry.price));
+    }
+
+    size_t encoded_length = header.encodedLength() + sbe_msg.encodedLength();
+    buffer.resize(encoded_length);
+    return buffer;
+}
+
 std::vector<uint8_t> CMEEncoder::encode_security_definition_future(
     const SecurityDefinition& definition)
 {
@@ -43,12 +43,63 @@ void CMEEventListener::on_market_event(const std::shared_ptr<market_core::Market
         handle_status_event(status_event);
         break;
     }
+    case market_core::MarketEvent::ORDER_UPDATE: {
+        auto order_event = std::static_pointer_cast<market_core::OrderEvent>(event);
+        handle_order_event(order_event);
+        break;
+    }
     default:
         // Ignore unknown event types
         break;
     }
 }
 
+void CMEEventListener::on_event_record(const market_core::EventRecord& record)
+{
+    if (!cme_adapter_) {
+        return;
+    }
+
+    auto instrument = book_manager_->get_instrument(record.instrument_id);
+    if (!instrument) {
+        return;
+    }
+
+    // Class views are built on the stack; no per-event allocation
+    switch (record.type) {
+    case market_core::MarketEvent::QUOTE_UPDATE:
+        cme_adapter_->process_quote_event(*instrument, market_core::to_quote_event(record));
+        break;
+    case market_core::MarketEvent::TRADE:
+        cme_adapter_->process_trade_event(*instrument, market_core::to_trade_event(record));
+        break;
+    case market_core::MarketEvent::STATISTICS:
+        cme_adapter_->process_statistics_event(*instrument, market_core::to_statistics_event(record));
+        break;
+    case market_core::MarketEvent::STATUS_CHANGE:
+        cme_adapter_->process_status_event(*instrument, market_core::to_status_event(record));
+        break;
+    case market_core::MarketEvent::ORDER_UPDATE:
+        cme_adapter_->process_order_event(*instrument, market_core::to_order_event(record));
+        break;
+    default:
+        break;
+    }
+}
+
+void CMEEventListener::on_market_events(market_core::EventRecordSpan records)
+{
+    if (!cme_adapter_) {
+        return;
+    }
+
+    cme_adapter_->begin_batch();
+    for (const auto& record : records) {
+        on_event_record(record);
+    }
+    cme_adapter_->end_batch();
+}
+
 void CMEEventListener::handle_quote_event(const std::shared_ptr<market_core::QuoteEvent>& event)
 {
     // Get instrument for this event
@@ -101,4 +152,14 @@ void CMEEventListener::handle_status_event(const std::shared_ptr<market_core::St
     cme_adapter_->process_status_event(*instrument, *event);
 }
 
+void CMEEventListener::handle_order_event(const std::shared_ptr<market_core::OrderEvent>& event)
+{
+    auto instrument = book_manager_->get_instrument(event->instrument_id);
+    if (!instrument) {
+        return;
+    }
+
+    cme_adapter_->process_order_event(*instrument, *event);
+}
+
 } // namespace cme_protocol
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "../include/cme_instrument_context.h"
+
+namespace cme_protocol {
+
+CMEInstrumentContext CMEInstrumentContext::resolve(const market_core::Instrument& instrument)
+{
+    CMEInstrumentContext context;
+
+    // CME-specific security ID, falling back to the internal instrument ID
+    auto cme_id = instrument.get_external_id("CME_SECURITY_ID");
+    context.security_id = cme_id ? static_cast<uint32_t>(std::stoul(*cme_id)) : instrument.instrument_id;
+
+    // Price decimals from instrument properties, default to 2
+    int64_t decimals = instrument.get_property<int64_t>("price_decimals").value_or(2);
+    context.price_scale = 1.0;
+    for (int64_t i = 0; i < decimals; ++i) {
+        context.price_scale *= 10.0;
+    }
+    context.tick_mantissa = context.to_price(instrument.tick_size);
+
+    context.book_entry.security_id = context.security_id;
+    context.book_entry.price_level = 1;
+    context.order_entry.security_id = context.security_id;
+    context.resolved = true;
+    return context;
+}
+
+const CMEInstrumentContext& CMEInstrumentContextTable::add(const market_core::Instrument& instrument)
+{
+    uint32_t id = instrument.instrument_id;
+    if (id >= MAX_DENSE_ID) {
+        return sparse_[id] = CMEInstrumentContext::resolve(instrument);
+    }
+
+    if (id >= dense_.size()) {
+        dense_.resize(static_cast<size_t>(id) + 1);
+    }
+    return dense_[id] = CMEInstrumentContext::resolve(instrument);
+}
+
+const CMEInstrumentContext& CMEInstrumentContextTable::find_or_add(const market_core::Instrument& instrument)
+{
+    if (instrument.instrument_id >= MAX_DENSE_ID) {
+        auto it = sparse_.find(instrument.instrument_id);
+        if (it != sparse_.end()) {
+            return it->second;
+        }
+    }
+    return add(instrument);
+}
+
+void CMEInstrumentContextTable::clear()
+{
+    dense_.clear();
+    sparse_.clear();
+}
+
+} // namespace cme_protocol
@@ -0,0 +1,28 @@
+#include "../include/cme_packet_builder.h"
+
+namespace cme_protocol {
+
+CMEPacketBuilder::CMEPacketBuilder(size_t capacity)
+    : buffer_(new uint8_t[capacity])
+    , capacity_(capacity)
+{
+}
+
+bool CMEPacketBuilder::append_message(const uint8_t* data, size_t length)
+{
+    if (!fits(length)) {
+        return false;
+    }
+    std::memcpy(message_buffer(), data, length);
+    commit_message(length);
+    return true;
+}
+
+void CMEPacketBuilder::finish(uint32_t sequence_number, uint64_t sending_time)
+{
+    // Little-endian encoding for packet header
+    std::memcpy(buffer_.get(), &sequence_number, 4);
+    std::memcpy(buffer_.get() + 4, &sending_time, 8);
+}
+
+} // namespace cme_protocol
@@ -1,69 +1,102 @@
 #include "../include/cme_protocol_adapter.h"
 #include "../include/cme_encoder.h"
+#include "../include/cme_fast_encoder.h"
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 
 namespace cme_protocol {
 
+// Largest coalesced run: one template 46 that still fits an empty packet
+static constexpr size_t MAX_COALESCED_ENTRIES = CMEEncoder::max_incremental_book_entries();
+
+static uint64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
 CMEProtocolAdapter::CMEProtocolAdapter()
     : channel_id_(310)
     , sequence_number_(0)
     , batch_size_(10)
+    , packet_(CMEEncoder::MAX_MESSAGE_SIZE)
 {
+    pending_entries_.reserve(MAX_COALESCED_ENTRIES);
 }
 
 void CMEProtocolAdapter::process_quote_event(
     const market_core::Instrument& instrument,
     const market_core::QuoteEvent& event)
 {
-    // Convert core event to CME incremental refresh
-    IncrementalRefresh refresh;
-    refresh.transact_time = event.timestamp_ns;
-
-    // Set match event indicator
-    refresh.match_event_indicator.end_of_event = true;
-    refresh.match_event_indicator.last_quote_msg = true;
-
-    // Convert quote to CME price level
-    MDPriceLevel level;
-    level.security_id = get_cme_security_id(instrument);
-    level.rpt_seq = event.rpt_seq.value_or(event.sequence_number);
-    level.price = price_to_cme(event.price, instrument);
-    level.quantity = static_cast<int32_t>(event.quantity);
-    level.number_of_orders = event.order_count;
-    level.price_level = event.price_level.value_or(1);
-    level.update_action = to_cme_update_action(event.action);
-    level.entry_type = to_cme_entry_type(event.side);
-    level.tradeable_size = static_cast<int32_t>(event.quantity); // Usually same as quantity
+    MatchEventIndicator indicator {};
+    indicator.end_of_event = true;
+    indicator.last_quote_msg = true;
 
-    refresh.entries.push_back(level);
-
-    // Encode and send
-    auto encoded = encode_incremental_refresh(instrument, event);
-    send_message(encoded);
+    MDPriceLevel level = quote_entry(instrument, event);
+    if (coalesce_entry(level, event.timestamp_ns, indicator)) {
+        return;
+    }
+    send_book_entries(event.timestamp_ns, indicator, &level, 1);
 }
 
 void CMEProtocolAdapter::process_trade_event(
     const market_core::Instrument& instrument,
     const market_core::TradeEvent& event)
 {
-    auto encoded = encode_trade_summary(instrument, event);
-    send_message(encoded);
+    // For now, encode trade as incremental refresh with trade entry type
+    MatchEventIndicator indicator {};
+    indicator.end_of_event = true;
+    indicator.last_trade_msg = true;
+
+    MDPriceLevel trade = trade_entry(instrument, event);
+    if (coalesce_entry(trade, event.timestamp_ns, indicator)) {
+        return;
+    }
+    send_book_entries(event.timestamp_ns, indicator, &trade, 1);
 }
 
 void CMEProtocolAdapter::process_snapshot_event(
     const market_core::Instrument& instrument,
     const market_core::SnapshotEvent& event)
 {
-    auto encoded = encode_snapshot_full_refresh(instrument, event);
-    send_message(encoded);
+    // A standalone snapshot is a cycle of one
+    send_snapshot(instrument, event, event.rpt_seq.value_or(event.sequence_number), 1);
+}
+
+void CMEProtocolAdapter::send_snapshot(
+    const market_core::Instrument& instrument,
+    const market_core::SnapshotEvent& event,
+    uint32_t last_msg_seq_num_processed,
+    uint32_t tot_num_reports)
+{
+    auto encoded = encode_snapshot_full_refresh(instrument, event, last_msg_seq_num_processed, tot_num_reports);
+    if (!encoded.empty()) {
+        send_message(encoded);
+    }
+
+    // MBO books also publish their resting orders
+    if (!event.orders.empty()) {
+        for (const auto& chunk : encode_order_book_snapshot(instrument, event, last_msg_seq_num_processed, tot_num_reports)) {
+            send_message(chunk);
+        }
+    }
 }
 
 void CMEProtocolAdapter::process_statistics_event(
     const market_core::Instrument& instrument,
     const market_core::StatisticsEvent& event)
 {
-    auto encoded = encode_statistics(instrument, event);
-    send_message(encoded);
+    MatchEventIndicator indicator {};
+    indicator.end_of_event = true;
+    indicator.last_stats_msg = true;
+
+    MDPriceLevel stats = statistics_entry(instrument, event);
+    if (coalesce_entry(stats, event.timestamp_ns, indicator)) {
+        return;
+    }
+    send_book_entries(event.timestamp_ns, indicator, &stats, 1);
 }
 
 void CMEProtocolAdapter::process_status_event(
@@ -74,15 +107,30 @@ void CMEProtocolAdapter::process_status_event(
     send_message(encoded);
 }
 
+void CMEProtocolAdapter::process_order_event(
+    const market_core::Instrument& instrument,
+    const market_core::OrderEvent& event)
+{
+    MatchEventIndicator indicator {};
+    indicator.end_of_event = true;
+    indicator.last_quote_msg = true;
+
+    MDOrderEntry order = order_entry(instrument, event);
+    send_order_entries(event.timestamp_ns, indicator, &order, 1);
+}
+
 void CMEProtocolAdapter::send_instrument_definition(
     const market_core::Instrument& instrument)
 {
+    // A definition (re)registers the instrument's encoding context
+    const CMEInstrumentContext& context = contexts_.add(instrument);
+
     // Create security definition based on instrument type
     SecurityDefinition definition;
-    definition.security_id = get_cme_security_id(instrument);
+    definition.security_id = context.security_id;
     definition.symbol = instrument.primary_symbol;
     definition.update_action = SecurityUpdateAction::Add;
-    definition.min_price_increment = price_to_cme(instrument.tick_size, instrument);
+    definition.min_price_increment = context.tick_mantissa;
     definition.display_factor = 1;
     definition.currency = instrument.get_property<std::string>("currency").value_or("USD");
     definition.security_exchange = "CME";
@@ -103,84 +151,117 @@ void CMEProtocolAdapter::send_instrument_definition(
 
 void CMEProtocolAdapter::flush_batch()
 {
-    if (current_batch_.empty()) {
+    flush_entries();
+    emit_packet();
+}
+
+void CMEProtocolAdapter::emit_packet()
+{
+    if (packet_.empty()) {
         return;
     }
 
-    send_batch(current_batch_);
-    current_batch_.clear();
+    // Without a transport the packet is dropped and no sequence consumed
+    if (transport_) {
+        uint32_t sequence = get_next_sequence();
+        packet_.finish(sequence, now_ns());
+        transport_->send_packet(packet_.data(), packet_.size());
+        if (journal_) {
+            journal_->record(sequence, packet_.data(), packet_.size());
+        }
+        last_sent_sequence_.store(sequence, std::memory_order_release);
+        packets_sent_.fetch_add(1, std::memory_order_relaxed);
+        messages_sent_.fetch_add(packet_.message_count(), std::memory_order_relaxed);
+    }
+    packet_.reset();
+    event_open_ = false;
+}
+
+void CMEProtocolAdapter::end_batch()
+{
+    batching_ = false;
+
+    // Latency-bounded packing carries the packet over to the next batch
+    if (max_latency_.count() > 0) {
+        flush_entries();
+        poll();
+    } else {
+        flush_batch();
+    }
+}
+
+void CMEProtocolAdapter::poll()
+{
+    if (transport_) {
+        transport_->poll();
+    }
+    if (max_latency_.count() == 0 || packet_.empty() || event_open_) {
+        return;
+    }
+    if (std::chrono::steady_clock::now() - packet_started_ >= max_latency_) {
+        emit_packet();
+    }
 }
 
-std::vector<uint8_t> CMEProtocolAdapter::encode_incremental_refresh(
+MDPriceLevel CMEProtocolAdapter::quote_entry(
     const market_core::Instrument& instrument,
     const market_core::QuoteEvent& event)
 {
-    IncrementalRefresh refresh;
-    refresh.transact_time = event.timestamp_ns;
-
-    // Set match event indicator
-    refresh.match_event_indicator.end_of_event = true;
-    refresh.match_event_indicator.last_quote_msg = true;
+    const CMEInstrumentContext& context = contexts_.get(instrument);
 
-    // Create price level entry
-    MDPriceLevel level;
-    level.security_id = get_cme_security_id(instrument);
+    MDPriceLevel level = context.book_entry;
     level.rpt_seq = event.rpt_seq.value_or(event.sequence_number);
-    level.price = price_to_cme(event.price, instrument);
+    level.price = context.to_price(event.price);
     level.quantity = static_cast<int32_t>(event.quantity);
     level.number_of_orders = event.order_count;
     level.price_level = event.price_level.value_or(1);
     level.update_action = to_cme_update_action(event.action);
     level.entry_type = to_cme_entry_type(event.side);
-    level.tradeable_size = static_cast<int32_t>(event.quantity);
-
-    refresh.entries.push_back(level);
-
-    return CMEEncoder::encode_incremental_refresh_book(refresh);
+    level.tradeable_size = static_cast<int32_t>(event.quantity); // Usually same as quantity
+    return level;
 }
 
-std::vector<uint8_t> CMEProtocolAdapter::encode_trade_summary(
+MDPriceLevel CMEProtocolAdapter::trade_entry(
     const market_core::Instrument& instrument,
     const market_core::TradeEvent& event)
 {
-    // For now, encode trade as incremental refresh with trade entry type
-    IncrementalRefresh refresh;
-    refresh.transact_time = event.timestamp_ns;
-
-    refresh.match_event_indicator.end_of_event = true;
-    refresh.match_event_indicator.last_trade_msg = true;
-
-    MDPriceLevel trade_entry;
-    trade_entry.security_id = get_cme_security_id(instrument);
-    trade_entry.rpt_seq = event.rpt_seq.value_or(event.sequence_number);
-    trade_entry.price = price_to_cme(event.price, instrument);
-    trade_entry.quantity = static_cast<int32_t>(event.quantity);
-    trade_entry.number_of_orders = 1;
-    trade_entry.price_level = 1;
-    trade_entry.update_action = MDUpdateAction::New;
-    trade_entry.entry_type = MDEntryType::Trade;
-    trade_entry.tradeable_size = 0; // N/A for trades
-
-    refresh.entries.push_back(trade_entry);
-
-    return CMEEncoder::encode_incremental_refresh_book(refresh);
+    const CMEInstrumentContext& context = contexts_.get(instrument);
+
+    MDPriceLevel trade = context.book_entry;
+    trade.rpt_seq = event.rpt_seq.value_or(event.sequence_number);
+    trade.price = context.to_price(event.price);
+    trade.quantity = static_cast<int32_t>(event.quantity);
+    trade.number_of_orders = 1;
+    trade.price_level = 1;
+    trade.update_action = MDUpdateAction::New;
+    trade.entry_type = MDEntryType::Trade;
+    trade.tradeable_size = 0; // N/A for trades
+    return trade;
 }
 
 std::vector<uint8_t> CMEProtocolAdapter::encode_snapshot_full_refresh(
     const market_core::Instrument& instrument,
-    const market_core::SnapshotEvent& event)
+    const market_core::SnapshotEvent& event,
+    uint32_t last_msg_seq_num_processed,
+    uint32_t tot_num_reports)
 {
+    const CMEInstrumentContext& context = contexts_.get(instrument);
+
     SnapshotFullRefresh snapshot;
-    snapshot.security_id = get_cme_security_id(instrument);
+    snapshot.security_id = context.security_id;
     snapshot.transact_time = event.timestamp_ns;
     snapshot.rpt_seq = event.rpt_seq.value_or(event.sequence_number);
+    snapshot.last_msg_seq_num_processed = last_msg_seq_num_processed;
+    snapshot.tot_num_reports = tot_num_reports;
+    snapshot.bid_entries.reserve(event.bid_levels.size());
+    snapshot.ask_entries.reserve(event.ask_levels.size());
 
     // Convert bid levels
     for (const auto& bid : event.bid_levels) {
         MDPriceLevel level;
         level.security_id = snapshot.security_id;
         level.rpt_seq = bid.rpt_seq.value_or(bid.sequence_number);
-        level.price = price_to_cme(bid.price, instrument);
+        level.price = context.to_price(bid.price);
         level.quantity = static_cast<int32_t>(bid.quantity);
         level.number_of_orders = bid.order_count;
         level.price_level = bid.price_level.value_or(static_cast<uint8_t>(snapshot.bid_entries.size() + 1));
@@ -196,7 +277,7 @@ std::vector<uint8_t> CMEProtocolAdapter::encode_snapshot_full_refresh(
         MDPriceLevel level;
         level.security_id = snapshot.security_id;
         level.rpt_seq = ask.rpt_seq.value_or(ask.sequence_number);
-        level.price = price_to_cme(ask.price, instrument);
+        level.price = context.to_price(ask.price);
         level.quantity = static_cast<int32_t>(ask.quantity);
         level.number_of_orders = ask.order_count;
         level.price_level = ask.price_level.value_or(static_cast<uint8_t>(snapshot.ask_entries.size() + 1));
@@ -217,28 +298,91 @@ std::vector<uint8_t> CMEProtocolAdapter::encode_snapshot_full_refresh(
         snapshot.total_volume = *event.total_volume;
     }
 
-    return CMEEncoder::encode_snapshot_full_refresh(snapshot);
+    // Empty when the book is deeper than one entry group can count
+    std::vector<uint8_t> encoded(CMEFastEncoder::snapshot_full_refresh_length(
+        snapshot.bid_entries.size() + snapshot.ask_entries.size()));
+    encoded.resize(CMEFastEncoder::encode_snapshot_full_refresh(snapshot, encoded.data(), encoded.size()));
+    return encoded;
+}
+
+MDOrderEntry CMEProtocolAdapter::order_entry(
+    const market_core::Instrument& instrument,
+    const market_core::OrderEvent& event)
+{
+    const CMEInstrumentContext& context = contexts_.get(instrument);
+
+    MDOrderEntry entry = context.order_entry;
+    entry.order_id = event.order_id;
+    entry.order_priority = event.priority;
+    entry.price = context.to_price(event.price);
+    entry.display_qty = static_cast<int32_t>(event.quantity);
+    entry.update_action = to_cme_update_action(event.action);
+    entry.entry_type = to_cme_entry_type(event.side);
+    return entry;
+}
+
+std::vector<std::vector<uint8_t>> CMEProtocolAdapter::encode_order_book_snapshot(
+    const market_core::Instrument& instrument,
+    const market_core::SnapshotEvent& event,
+    uint32_t last_msg_seq_num_processed,
+    uint32_t tot_num_reports)
+{
+    constexpr size_t chunk_size = CMEEncoder::max_snapshot_order_entries();
+    size_t no_chunks = (event.orders.size() + chunk_size - 1) / chunk_size;
+    const CMEInstrumentContext& context = contexts_.get(instrument);
+
+    std::vector<std::vector<uint8_t>> messages;
+    messages.reserve(no_chunks);
+
+    for (size_t chunk = 0; chunk < no_chunks; ++chunk) {
+        SnapshotFullRefreshOrderBook snapshot;
+        snapshot.security_id = context.security_id;
+        snapshot.last_msg_seq_num_processed = last_msg_seq_num_processed;
+        snapshot.tot_num_reports = tot_num_reports;
+        snapshot.no_chunks = static_cast<uint32_t>(no_chunks);
+        snapshot.current_chunk = static_cast<uint32_t>(chunk + 1);
+        snapshot.transact_time = event.timestamp_ns;
+
+        size_t begin = chunk * chunk_size;
+        size_t end = std::min(begin + chunk_size, event.orders.size());
+        for (size_t i = begin; i < end; ++i) {
+            const auto& order = event.orders[i];
+
+            MDOrderEntry entry;
+            entry.order_id = order.order_id;
+            entry.order_priority = order.priority;
+            entry.price = context.to_price(order.price);
+            entry.display_qty = static_cast<int32_t>(order.quantity);
+            entry.security_id = context.security_id;
+            entry.update_action = MDUpdateAction::New;
+            entry.entry_type = to_cme_entry_type(order.side);
+
+            snapshot.entries.push_back(entry);
+        }
+
+        std::vector<uint8_t> encoded(CMEFastEncoder::snapshot_full_refresh_order_book_length(snapshot.entries.size()));
+        CMEFastEncoder::encode_snapshot_full_refresh_order_book(snapshot, encoded.data(), encoded.size());
+        messages.push_back(std::move(encoded));
+    }
+
+    return messages;
 }
 
-std::vector<uint8_t> CMEProtocolAdapter::encode_statistics(
+MDPriceLevel CMEProtocolAdapter::statistics_entry(
     const market_core::Instrument& instrument,
     const market_core::StatisticsEvent& event)
 {
     // Encode as incremental refresh with statistics entry
-    IncrementalRefresh refresh;
-    refresh.transact_time = event.timestamp_ns;
-
-    refresh.match_event_indicator.end_of_event = true;
-    refresh.match_event_indicator.last_stats_msg = true;
+    const CMEInstrumentContext& context = contexts_.get(instrument);
 
-    MDPriceLevel stats_entry;
-    stats_entry.security_id = get_cme_security_id(instrument);
+    MDPriceLevel stats_entry = context.book_entry;
     stats_entry.rpt_seq = event.sequence_number;
-    stats_entry.price = price_to_cme(event.value, instrument);
+    stats_entry.price = context.to_price(event.value);
     stats_entry.quantity = event.volume ? static_cast<int32_t>(*event.volume) : 0;
     stats_entry.number_of_orders = 0;
     stats_entry.price_level = 1;
     stats_entry.update_action = MDUpdateAction::New;
+    stats_entry.tradeable_size = 0;
 
     // Map statistics type to CME entry type
     switch (event.stat_type) {
@@ -265,9 +409,7 @@ std::vector<uint8_t> CMEProtocolAdapter::encode_statistics(
         break;
     }
 
-    refresh.entries.push_back(stats_entry);
-
-    return CMEEncoder::encode_incremental_refresh_book(refresh);
+    return stats_entry;
 }
 
 std::vector<uint8_t> CMEProtocolAdapter::encode_security_status(
@@ -302,51 +444,171 @@ std::vector<uint8_t> CMEProtocolAdapter::encode_security_status(
     }
 
     return CMEEncoder::encode_security_status(
-        get_cme_security_id(instrument),
+        contexts_.get(instrument).security_id,
         trading_status,
         event.timestamp_ns);
 }
 
-std::vector<uint8_t> CMEProtocolAdapter::create_packet_header(uint64_t sending_time)
+uint8_t* CMEProtocolAdapter::reserve_message(size_t length)
 {
-    return CMEEncoder::encode_packet_header(get_next_sequence(), sending_time);
+    // Start a new packet when this message would overflow the current one.
+    // A full packet only waits for an open match event under latency
+    // packing.
+    bool full = packet_.message_count() >= batch_size_ && !(max_latency_.count() > 0 && event_open_);
+    if (!packet_.empty() && (full || !packet_.fits(length))) {
+        emit_packet();
+    }
+    if (!packet_.fits(length)) {
+        return nullptr;
+    }
+    if (packet_.empty()) {
+        packet_started_ = std::chrono::steady_clock::now();
+    }
+    return packet_.message_buffer();
 }
 
-std::vector<uint8_t> CMEProtocolAdapter::encode_message_size(uint16_t size)
+void CMEProtocolAdapter::commit_message(size_t length, bool end_of_event)
 {
-    return CMEEncoder::encode_message_size(size);
+    packet_.commit_message(length);
+    event_open_ = !end_of_event;
+
+    // Without a transport messages accumulate until a flush
+    if (!transport_) {
+        return;
+    }
+
+    if (max_latency_.count() > 0) {
+        // Full or overdue packets go out at the next event boundary
+        if (!event_open_ && packet_.message_count() >= batch_size_) {
+            emit_packet();
+        } else {
+            poll();
+        }
+        return;
+    }
+
+    // Outside a batch, each message is its own packet
+    if (!batching_) {
+        emit_packet();
+    }
 }
 
-void CMEProtocolAdapter::send_message(const std::vector<uint8_t>& message)
+bool CMEProtocolAdapter::coalesce_entry(
+    const MDPriceLevel& entry,
+    uint64_t transact_time,
+    MatchEventIndicator flags)
 {
-    if (current_batch_.size() >= batch_size_) {
-        flush_batch();
+    if (!coalesce_updates_ || !batching_) {
+        return false;
     }
 
-    current_batch_.push_back(message);
+    if (pending_entries_.size() >= MAX_COALESCED_ENTRIES) {
+        flush_entries(false);
+    }
+    if (pending_entries_.empty()) {
+        pending_indicator_ = {};
+    }
+    pending_entries_.push_back(entry);
+    pending_transact_time_ = transact_time;
+    pending_indicator_.last_quote_msg |= flags.last_quote_msg;
+    pending_indicator_.last_trade_msg |= flags.last_trade_msg;
+    pending_indicator_.last_stats_msg |= flags.last_stats_msg;
+    return true;
+}
 
-    // Send immediately if transport doesn't support batching
-    if (!transport_) {
+void CMEProtocolAdapter::flush_entries(bool end_of_event)
+{
+    if (pending_entries_.empty()) {
         return;
     }
 
-    // For single message sends, flush immediately
-    flush_batch();
+    // The last_*_msg flags describe the whole run, so only its final
+    // message carries them
+    MatchEventIndicator indicator {};
+    if (end_of_event) {
+        indicator = pending_indicator_;
+        indicator.end_of_event = true;
+    }
+
+    write_book_entries(pending_transact_time_, indicator, pending_entries_.data(), pending_entries_.size());
+    pending_entries_.clear();
 }
 
-void CMEProtocolAdapter::send_batch(const std::vector<std::vector<uint8_t>>& messages)
+void CMEProtocolAdapter::send_book_entries(
+    uint64_t transact_time,
+    MatchEventIndicator indicator,
+    const MDPriceLevel* entries,
+    size_t count)
 {
-    if (!transport_ || messages.empty()) {
+    flush_entries();
+    write_book_entries(transact_time, indicator, entries, count);
+}
+
+void CMEProtocolAdapter::write_book_entries(
+    uint64_t transact_time,
+    MatchEventIndicator indicator,
+    const MDPriceLevel* entries,
+    size_t count)
+{
+    size_t length = CMEFastEncoder::incremental_refresh_book_length(count);
+    uint8_t* buffer = reserve_message(length);
+    if (!buffer) {
         return;
     }
 
-    // Create complete packet with CME header
-    uint64_t sending_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::system_clock::now().time_since_epoch())
-                                .count();
+    // More entries than a group can count: nothing is committed
+    if (!CMEFastEncoder::encode_incremental_refresh_book(
+            transact_time, indicator.to_byte(), entries, count, buffer, length)) {
+        return;
+    }
+    commit_message(length, indicator.end_of_event);
+}
+
+void CMEProtocolAdapter::send_order_entries(
+    uint64_t transact_time,
+    MatchEventIndicator indicator,
+    const MDOrderEntry* entries,
+    size_t count)
+{
+    flush_entries();
+
+    size_t length = CMEFastEncoder::incremental_refresh_order_book_length(count);
+    uint8_t* buffer = reserve_message(length);
+    if (!buffer) {
+        return;
+    }
+
+    // More entries than a group can count: nothing is committed
+    if (!CMEFastEncoder::encode_incremental_refresh_order_book(
+            transact_time, indicator.to_byte(), entries, count, buffer, length)) {
+        return;
+    }
+    commit_message(length, indicator.end_of_event);
+}
+
+void CMEProtocolAdapter::send_message(const std::vector<uint8_t>& message)
+{
+    flush_entries();
 
-    auto packet = CMEEncoder::create_packet(get_next_sequence(), sending_time, messages);
-    transport_->send_message(packet);
+    uint8_t* buffer = reserve_message(message.size());
+    if (buffer) {
+        std::memcpy(buffer, message.data(), message.size());
+        commit_message(message.size(), true);
+        return;
+    }
+
+    // Larger than a whole packet (e.g. a deep snapshot): send it alone
+    if (transport_) {
+        uint32_t sequence = get_next_sequence();
+        auto packet = CMEEncoder::create_packet(sequence, now_ns(), { message });
+        transport_->send_message(packet);
+        if (journal_) {
+            journal_->record(sequence, packet.data(), packet.size());
+        }
+        last_sent_sequence_.store(sequence, std::memory_order_release);
+        packets_sent_.fetch_add(1, std::memory_order_relaxed);
+        messages_sent_.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
 MDUpdateAction CMEProtocolAdapter::to_cme_update_action(market_core::UpdateAction action)
@@ -377,29 +639,4 @@ MDEntryType CMEProtocolAdapter::to_cme_entry_type(market_core::Side side)
     }
 }
 
-uint32_t CMEProtocolAdapter::get_cme_security_id(const market_core::Instrument& instrument)
-{
-    // Try to get CME-specific security ID
-    auto cme_id = instrument.get_external_id("CME_SECURITY_ID");
-    if (cme_id) {
-        return std::stoul(*cme_id);
-    }
-
-    // Fallback to internal instrument ID
-    return instrument.instrument_id;
-}
-
-int64_t CMEProtocolAdapter::price_to_cme(double price, const market_core::Instrument& instrument)
-{
-    // Get price decimals from instrument properties, default to 2
-    int decimals = instrument.get_property<int64_t>("price_decimals").value_or(2);
-
-    double multiplier = 1.0;
-    for (int i = 0; i < decimals; ++i) {
-        multiplier *= 10.0;
-    }
-
-    return static_cast<int64_t>(price * multiplier);
-}
-
 } // namespace cme_protocol
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "../include/cme_snapshot_cycle.h"
+#include "rate_scheduler.h"
+
+namespace cme_protocol {
+
+CMESnapshotCycle::CMESnapshotCycle(
+    std::shared_ptr<market_core::OrderBookManager> book_manager,
+    std::shared_ptr<CMEProtocolAdapter> snapshot_adapter,
+    std::shared_ptr<const CMEProtocolAdapter> incremental_adapter,
+    const Config& config)
+    : book_manager_(std::move(book_manager))
+    , snapshot_adapter_(std::move(snapshot_adapter))
+    , incremental_adapter_(std::move(incremental_adapter))
+    , config_(config)
+    , event_(0)
+{
+}
+
+CMESnapshotCycle::~CMESnapshotCycle()
+{
+    stop();
+}
+
+void CMESnapshotCycle::start()
+{
+    if (thread_.joinable()) {
+        return;
+    }
+    stopping_ = false;
+    thread_ = std::thread(&CMESnapshotCycle::run, this);
+}
+
+void CMESnapshotCycle::stop()
+{
+    stopping_ = true;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+size_t CMESnapshotCycle::run_cycle()
+{
+    auto started = std::chrono::steady_clock::now();
+    size_t total = begin_cycle();
+    size_t sent = 0;
+    for (uint32_t instrument_id : cycle_ids_) {
+        sent += publish(instrument_id, static_cast<uint32_t>(total)) ? 1 : 0;
+    }
+    end_cycle(started);
+    return sent;
+}
+
+CMESnapshotCycle::Statistics CMESnapshotCycle::get_statistics() const
+{
+    Statistics stats;
+    stats.cycles = cycles_.load(std::memory_order_relaxed);
+    stats.snapshots = snapshots_.load(std::memory_order_relaxed);
+    stats.last_cycle_ns = last_cycle_ns_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void CMESnapshotCycle::run()
+{
+    // Sleep rather than spin between snapshots; the CPU belongs to the
+    // incremental feed
+    market_core::RateScheduler::Config pacing;
+    pacing.target_rate = config_.snapshots_per_second;
+    pacing.spin_threshold = std::chrono::nanoseconds(0);
+    market_core::RateScheduler scheduler(pacing);
+
+    const auto stop_check = std::chrono::milliseconds(10);
+    while (!stopping_) {
+        auto started = std::chrono::steady_clock::now();
+        size_t total = begin_cycle();
+        if (total == 0) {
+            std::this_thread::sleep_for(stop_check);
+            continue;
+        }
+
+        size_t next = 0;
+        while (next < total && !stopping_) {
+            scheduler.wait_next(stop_check);
+            for (size_t due = scheduler.poll(total - next); due > 0; --due) {
+                publish(cycle_ids_[next++], static_cast<uint32_t>(total));
+            }
+        }
+        if (next == total) {
+            end_cycle(started);
+        }
+    }
+    snapshot_adapter_->flush_batch();
+}
+
+size_t CMESnapshotCycle::begin_cycle()
+{
+    // Only instruments with a book are reported, so totNumReports matches
+    // what the cycle actually sends
+    cycle_ids_.clear();
+    for (uint32_t instrument_id : book_manager_->get_all_instrument_ids()) {
+        if (config_.instrument_filter && !config_.instrument_filter(instrument_id)) {
+            continue;
+        }
+        auto instrument = book_manager_->get_instrument(instrument_id);
+        if (instrument && book_manager_->get_order_book(instrument_id)) {
+            // Picks up security ID or price scale changes once per cycle
+            snapshot_adapter_->register_instrument(*instrument);
+            cycle_ids_.push_back(instrument_id);
+        }
+    }
+
+    // The snapshot channel's packet sequence restarts with every cycle
+    snapshot_adapter_->flush_batch();
+    snapshot_adapter_->reset_sequence();
+    return cycle_ids_.size();
+}
+
+bool CMESnapshotCycle::publish(uint32_t instrument_id, uint32_t tot_num_reports)
+{
+    auto instrument = book_manager_->get_instrument(instrument_id);
+    if (!instrument) {
+        return false;
+    }
+
+    // Read before the copy: the book already reflects every update in
+    // packets up to this sequence
+    uint32_t last_msg_seq_num_processed = incremental_adapter_ ? incremental_adapter_->last_sent_sequence() : 0;
+    if (!book_manager_->capture_snapshot(instrument_id, event_, config_.max_depth)) {
+        return false;
+    }
+
+    event_.sequence_number = event_.rpt_seq.value_or(0);
+    snapshot_adapter_->send_snapshot(*instrument, event_, last_msg_seq_num_processed, tot_num_reports);
+    snapshots_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void CMESnapshotCycle::end_cycle(std::chrono::steady_clock::time_point started)
+{
+    snapshot_adapter_->flush_batch();
+    auto elapsed = std::chrono::steady_clock::now() - started;
+    last_cycle_ns_.store(static_cast<uint64_t>(
+                             std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+        std::memory_order_relaxed);
+    cycles_.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace cme_protocol
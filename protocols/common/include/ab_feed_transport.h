@@ -0,0 +1,88 @@
+#pragma once
+
+#include "protocol_adapter.h"
+#include <chrono>
+#include <netinet/in.h>
+#include <string>
+#include <vector>
+
+namespace market_protocols {
+
+// A/B feed transport: every packet goes to both the A and B groups of a
+// channel from the caller's buffer, so the adapter encodes it once.
+//
+// Without a B delay both datagrams leave in one sendmmsg() call whose two
+// headers share a single iovec. With a B delay, A is sent at once and B
+// is copied into a reusable slot and sent once due, from the next
+// send_packet() or poll(); call poll() from idle loops so a quiet feed
+// still releases B on time.
+class ABFeedTransport : public IMessageTransport {
+public:
+    ABFeedTransport(const std::string& host_a, uint16_t port_a,
+        const std::string& host_b, uint16_t port_b);
+    ~ABFeedTransport() override;
+
+    ABFeedTransport(const ABFeedTransport&) = delete;
+    ABFeedTransport& operator=(const ABFeedTransport&) = delete;
+
+    // IMessageTransport interface
+    bool send_message(const std::vector<uint8_t>& data) override;
+    bool send_packet(const uint8_t* data, size_t length) override;
+    std::string get_transport_type() const override { return "UDP-AB"; }
+    bool is_connected() const override { return socket_fd_ >= 0; }
+
+    bool initialize();
+    void close();
+
+    // B-side lag behind A, for arbitration testing; 0 sends both together
+    void set_b_delay(std::chrono::nanoseconds delay) { b_delay_ = delay; }
+    std::chrono::nanoseconds get_b_delay() const { return b_delay_; }
+
+    // Send delayed B packets that are due; returns how many were sent
+    size_t poll() override;
+
+    // Delayed B packets still waiting
+    size_t pending_b() const { return delayed_count_; }
+
+    void set_ttl(int ttl);
+    void set_send_buffer_size(size_t size);
+
+    // Statistics
+    uint64_t packets_a() const { return packets_a_; }
+    uint64_t packets_b() const { return packets_b_; }
+    uint64_t send_errors() const { return send_errors_; }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct DelayedPacket {
+        clock::time_point due;
+        std::vector<uint8_t> data; // Capacity kept across reuse
+    };
+
+    std::string host_a_;
+    uint16_t port_a_;
+    std::string host_b_;
+    uint16_t port_b_;
+    int socket_fd_ = -1;
+    struct sockaddr_in addr_a_;
+    struct sockaddr_in addr_b_;
+
+    std::chrono::nanoseconds b_delay_ { 0 };
+
+    // Ring of delayed B packets in due order; grows only when full
+    std::vector<DelayedPacket> delayed_;
+    size_t delayed_head_ = 0;
+    size_t delayed_count_ = 0;
+
+    uint64_t packets_a_ = 0;
+    uint64_t packets_b_ = 0;
+    uint64_t send_errors_ = 0;
+
+    bool send_to(const struct sockaddr_in& addr, const uint8_t* data, size_t length);
+    bool send_both(const uint8_t* data, size_t length);
+    void enqueue_b(const uint8_t* data, size_t length, clock::time_point due);
+    size_t send_due_b(clock::time_point now);
+};
+
+} // namespace market_protocols
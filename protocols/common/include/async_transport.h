@@ -0,0 +1,106 @@
+#pragma once
+
+#include "../../core/include/spsc_queue.h"
+#include "latency_histogram.h"
+#include "protocol_adapter.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace market_protocols {
+
+// Moves socket syscalls off the encoding thread. send_packet() copies the
+// packet into a preallocated slot and queues it; a dedicated sender
+// thread drains the queue and hands each run of packets to the inner
+// transport's send_packets(), so batching transports get whole runs.
+//
+// Slots cycle between two SPSC queues: free slots go back from the sender
+// thread, filled ones forward to it. Only one thread may send through the
+// wrapper at a time. The inner transport belongs to the sender thread
+// between start() and stop(), including its poll().
+class AsyncTransport : public IMessageTransport {
+public:
+    enum class OverflowPolicy {
+        BLOCK, // Wait for a free slot; the caller absorbs back-pressure
+        DROP // Fail the send and count it
+    };
+
+    struct Config {
+        size_t slots = 4096; // Packets in flight
+        size_t slot_size = 2048; // Largest packet accepted
+        OverflowPolicy overflow = OverflowPolicy::BLOCK;
+        int cpu = -1; // Pin the sender thread to this CPU; -1 leaves it floating
+        std::chrono::microseconds idle_sleep { 0 }; // 0 busy-polls when idle
+    };
+
+    static constexpr size_t MAX_BATCH = 64; // Packets per inner send_packets()
+
+    AsyncTransport(std::shared_ptr<IMessageTransport> inner, const Config& config);
+    explicit AsyncTransport(std::shared_ptr<IMessageTransport> inner)
+        : AsyncTransport(std::move(inner), Config())
+    {
+    }
+    ~AsyncTransport() override;
+
+    AsyncTransport(const AsyncTransport&) = delete;
+    AsyncTransport& operator=(const AsyncTransport&) = delete;
+
+    void start();
+    void stop(); // Sends whatever is still queued first
+    bool is_running() const { return thread_.joinable(); }
+
+    // IMessageTransport interface
+    bool send_message(const std::vector<uint8_t>& data) override;
+    bool send_packet(const uint8_t* data, size_t length) override;
+    std::string get_transport_type() const override { return "ASYNC-" + inner_->get_transport_type(); }
+    bool is_connected() const override { return inner_->is_connected(); }
+
+    const std::shared_ptr<IMessageTransport>& inner() const { return inner_; }
+    const Config& config() const { return config_; }
+
+    // Statistics
+    size_t queue_depth() const { return ready_.size(); }
+    size_t max_queue_depth() const { return max_queue_depth_.load(std::memory_order_relaxed); }
+    uint64_t packets_queued() const { return packets_queued_.load(std::memory_order_relaxed); }
+    uint64_t packets_sent() const { return packets_sent_.load(std::memory_order_relaxed); }
+    uint64_t send_failures() const { return send_failures_.load(std::memory_order_relaxed); }
+    uint64_t drops() const { return drops_.load(std::memory_order_relaxed); }
+    uint64_t oversize_drops() const { return oversize_drops_.load(std::memory_order_relaxed); }
+    uint64_t backpressure_waits() const { return backpressure_waits_.load(std::memory_order_relaxed); }
+
+    // Enqueue-to-send latency, recorded once the inner send returns
+    const LatencyHistogram& send_latency() const { return send_latency_; }
+
+private:
+    struct QueuedPacket {
+        uint32_t slot;
+        uint32_t length;
+        int64_t queued_ns; // steady_clock
+    };
+
+    std::shared_ptr<IMessageTransport> inner_;
+    Config config_;
+    std::unique_ptr<uint8_t[]> slots_;
+    market_core::SpscQueue<QueuedPacket> ready_; // Encoder -> sender
+    market_core::SpscQueue<uint32_t> free_; // Sender -> encoder
+
+    std::thread thread_;
+    std::atomic<bool> stopping_ { false };
+
+    std::atomic<size_t> max_queue_depth_ { 0 };
+    std::atomic<uint64_t> packets_queued_ { 0 };
+    std::atomic<uint64_t> packets_sent_ { 0 };
+    std::atomic<uint64_t> send_failures_ { 0 };
+    std::atomic<uint64_t> drops_ { 0 };
+    std::atomic<uint64_t> oversize_drops_ { 0 };
+    std::atomic<uint64_t> backpressure_waits_ { 0 };
+    LatencyHistogram send_latency_;
+
+    uint8_t* slot_data(uint32_t slot) { return slots_.get() + static_cast<size_t>(slot) * config_.slot_size; }
+    bool acquire_slot(uint32_t& slot);
+    size_t send_run(const QueuedPacket* packets, size_t count);
+    void run();
+};
+
+} // namespace market_protocols
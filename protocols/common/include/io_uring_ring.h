@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+namespace market_protocols {
+
+// Minimal io_uring submission/completion ring over the raw syscalls, so
+// the build needs only kernel headers, not liburing.
+//
+// get_sqe() hands out zeroed submission entries; submit() publishes them
+// with one io_uring_enter() (none with SQ polling unless the kernel
+// thread sleeps) and can wait for completions; drain_completions() walks
+// and retires what the kernel has finished. One thread owns a ring.
+class IoUringRing {
+public:
+    IoUringRing() = default;
+    ~IoUringRing();
+
+    IoUringRing(const IoUringRing&) = delete;
+    IoUringRing& operator=(const IoUringRing&) = delete;
+
+    // False (errno set) when the kernel lacks io_uring or it is disabled.
+    // sq_poll asks for a kernel submission thread; without the privilege
+    // or support the ring falls back to plain submission.
+    bool init(unsigned entries, bool sq_poll = false);
+    void close();
+    bool is_open() const { return ring_fd_ >= 0; }
+    bool sq_polling() const { return sq_poll_; }
+
+    // Whether this kernel can set up a ring at all
+    static bool supported();
+
+    // Registered buffers for the *_FIXED opcodes
+    bool register_buffers(const struct iovec* buffers, unsigned count);
+
+    // Next free submission entry, zeroed; nullptr while the queue is full
+    struct io_uring_sqe* get_sqe();
+
+    // Publish queued entries and wait for at least wait_for completions;
+    // returns entries consumed by the kernel or -errno
+    int submit(unsigned wait_for = 0);
+
+    // Publish queued entries and return once the kernel has consumed all
+    // of them, so each acts on the file its descriptor names right now
+    void submit_all();
+
+    // Call handler(const io_uring_cqe&) for each ready completion
+    template <typename Handler>
+    unsigned drain_completions(Handler&& handler)
+    {
+        unsigned head = *cq_head_;
+        unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        unsigned count = 0;
+        while (head != tail) {
+            handler(cqes_[head & *cq_mask_]);
+            ++head;
+            ++count;
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        return count;
+    }
+
+    unsigned sq_entries() const { return sq_entries_; }
+    uint64_t enter_calls() const { return enter_calls_; }
+
+private:
+    int ring_fd_ = -1;
+    bool sq_poll_ = false;
+    unsigned sq_entries_ = 0;
+
+    void* sq_ring_ = nullptr;
+    size_t sq_ring_size_ = 0;
+    void* cq_ring_ = nullptr;
+    size_t cq_ring_size_ = 0;
+    struct io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_size_ = 0;
+
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_mask_ = nullptr;
+    unsigned* sq_flags_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sqe_tail_ = 0; // Entries handed out, published on submit()
+
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned* cq_mask_ = nullptr;
+    struct io_uring_cqe* cqes_ = nullptr;
+
+    uint64_t enter_calls_ = 0;
+
+    bool map_rings(const struct io_uring_params& params);
+};
+
+} // namespace market_protocols
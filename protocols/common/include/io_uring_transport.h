@@ -0,0 +1,192 @@
+#pragma once
+
+#include "io_uring_ring.h"
+#include "protocol_adapter.h"
+#include <deque>
+#include <memory>
+#include <netinet/in.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace market_protocols {
+
+// Fixed-size packet slots in one region registered with a ring, so sends
+// use the *_FIXED opcodes and skip per-call page pinning. Falls back to
+// plain buffers when registration is refused.
+class IoUringSlotPool {
+public:
+    IoUringSlotPool(size_t slots, size_t slot_size);
+
+    bool register_with(IoUringRing& ring);
+    bool registered() const { return registered_; }
+
+    bool acquire(uint32_t& slot);
+    void release(uint32_t slot) { free_.push_back(slot); }
+    size_t available() const { return free_.size(); }
+    size_t slot_count() const { return slot_count_; }
+    size_t slot_size() const { return slot_size_; }
+    uint8_t* data(uint32_t slot) { return memory_.get() + static_cast<size_t>(slot) * slot_size_; }
+
+    // Write length bytes from a slot (starting at offset) to fd
+    void prepare_write(struct io_uring_sqe* sqe, int fd, uint32_t slot, size_t offset, size_t length);
+    // Same through send(MSG_NOSIGNAL), so a closed peer is an error, not SIGPIPE
+    void prepare_send(struct io_uring_sqe* sqe, int fd, uint32_t slot, size_t offset, size_t length);
+
+private:
+    size_t slot_count_;
+    size_t slot_size_;
+    std::unique_ptr<uint8_t[]> memory_;
+    std::vector<uint32_t> free_;
+    bool registered_ = false;
+};
+
+// UDP transport that sends through io_uring: each packet is copied to a
+// registered slot and written to a connected socket, and a batch from
+// send_packets() goes to the kernel in one io_uring_enter() (none with SQ
+// polling while the kernel thread is awake).
+//
+// Sends complete asynchronously: send_packet() reports whether the packet
+// was queued, and failures show up in send_errors() once reaped by a
+// later send, poll() or flush().
+class IoUringTransport : public IMessageTransport {
+public:
+    struct Config {
+        size_t slots = 1024; // Packets in flight
+        size_t slot_size = 2048; // Largest packet accepted
+        bool sq_poll = false; // Kernel submission thread
+    };
+
+    IoUringTransport(const std::string& host, uint16_t port, const Config& config);
+    IoUringTransport(const std::string& host, uint16_t port)
+        : IoUringTransport(host, port, Config())
+    {
+    }
+    ~IoUringTransport() override;
+
+    IoUringTransport(const IoUringTransport&) = delete;
+    IoUringTransport& operator=(const IoUringTransport&) = delete;
+
+    // False when the socket or ring cannot be set up, e.g. io_uring is
+    // disabled; callers fall back to UDPTransport
+    bool initialize();
+    void close();
+
+    // IMessageTransport interface
+    bool send_message(const std::vector<uint8_t>& data) override;
+    bool send_packet(const uint8_t* data, size_t length) override;
+    size_t send_packets(const PacketRef* packets, size_t count) override;
+    size_t poll() override; // Retires completed sends
+    std::string get_transport_type() const override { return "UDP-IO_URING"; }
+    bool is_connected() const override { return socket_fd_ >= 0; }
+
+    // Wait until every queued packet has completed
+    void flush();
+
+    bool fixed_buffers() const { return pool_.registered(); }
+    bool sq_polling() const { return ring_.sq_polling(); }
+
+    // Statistics
+    uint64_t packets_sent() const { return packets_sent_; }
+    uint64_t send_errors() const { return send_errors_; }
+    size_t in_flight() const { return pool_.slot_count() - pool_.available(); }
+    uint64_t enter_calls() const { return ring_.enter_calls(); }
+
+private:
+    std::string host_;
+    uint16_t port_;
+    Config config_;
+    int socket_fd_ = -1;
+    IoUringRing ring_;
+    IoUringSlotPool pool_;
+
+    uint64_t packets_sent_ = 0;
+    uint64_t send_errors_ = 0;
+
+    bool queue_packet(const uint8_t* data, size_t length);
+    struct io_uring_sqe* next_sqe();
+    size_t reap();
+};
+
+// Ordered writes to many stream sockets through one ring, without ever
+// blocking or spinning on a slow peer.
+//
+// Bytes are copied into slots queued per socket; small writes share a
+// slot until it is submitted. Sends go out with MSG_NOSIGNAL, which the
+// fixed-buffer write opcode cannot carry, so these slots are not
+// registered. Each socket has at most one write
+// in flight, so its bytes leave in order; short writes continue from
+// where they stopped, and EAGAIN on a non-blocking socket re-arms behind
+// a POLLOUT wait. poll() submits and retires everything in one enter.
+class IoUringStreamWriter {
+public:
+    struct Config {
+        size_t slots = 1024;
+        size_t slot_size = 4096;
+        bool sq_poll = false;
+    };
+
+    IoUringStreamWriter();
+    explicit IoUringStreamWriter(const Config& config);
+
+    IoUringStreamWriter(const IoUringStreamWriter&) = delete;
+    IoUringStreamWriter& operator=(const IoUringStreamWriter&) = delete;
+
+    bool initialize();
+    bool is_open() const { return ring_.is_open(); }
+
+    // Queue bytes for fd. False if the socket failed earlier or the slots
+    // cannot hold them; nothing is queued then.
+    bool write(int fd, const uint8_t* data, size_t length);
+    bool write(int fd, const std::vector<uint8_t>& data) { return write(fd, data.data(), data.size()); }
+
+    // Submit queued writes and retire completions; returns completions
+    size_t poll();
+
+    // Drop fd's queued bytes; call before closing it. A write already
+    // handed to the ring is submitted against fd first, then cancelled
+    // if it is still waiting on the peer.
+    void remove(int fd);
+
+    bool failed(int fd) const;
+    size_t queued_bytes(int fd) const;
+    size_t capacity() const { return pool_.slot_count() * pool_.slot_size(); } // Bytes all streams can queue
+
+    // Statistics
+    uint64_t bytes_written() const { return bytes_written_; }
+    uint64_t write_errors() const { return write_errors_; }
+    uint64_t enter_calls() const { return ring_.enter_calls(); }
+
+private:
+    struct Stream {
+        uint64_t generation = 0;
+        std::deque<uint32_t> slots; // Front is in flight when in_flight
+        bool in_flight = false;
+        bool failed = false;
+        size_t queued_bytes = 0;
+    };
+
+    struct SlotState {
+        int fd = -1;
+        uint64_t generation = 0;
+        size_t offset = 0; // Written so far
+        size_t length = 0;
+    };
+
+    Config config_;
+    IoUringRing ring_;
+    IoUringSlotPool pool_;
+    std::vector<SlotState> slot_states_;
+    std::unordered_map<int, Stream> streams_;
+    uint64_t next_generation_ = 1;
+
+    uint64_t bytes_written_ = 0;
+    uint64_t write_errors_ = 0;
+
+    struct io_uring_sqe* next_sqe();
+    void submit_front(int fd, Stream& stream, bool wait_writable);
+    void complete(const struct io_uring_cqe& cqe);
+    void fail(Stream& stream);
+};
+
+} // namespace market_protocols
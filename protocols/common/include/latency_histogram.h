@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace market_protocols {
+
+// Latency histogram with power-of-two nanosecond buckets: bucket i holds
+// samples in [2^(i-1), 2^i) ns, bucket 0 holds 0. One thread records;
+// any thread may read, seeing counts that are individually exact but not
+// a consistent snapshot.
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKETS = 40; // Up to ~9 minutes
+
+    void record(uint64_t nanoseconds)
+    {
+        size_t bucket = nanoseconds == 0 ? 0 : 64 - static_cast<size_t>(__builtin_clzll(nanoseconds));
+        if (bucket >= BUCKETS) {
+            bucket = BUCKETS - 1;
+        }
+        counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+        if (nanoseconds > max_.load(std::memory_order_relaxed)) {
+            max_.store(nanoseconds, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t count() const
+    {
+        uint64_t total = 0;
+        for (const auto& bucket : counts_) {
+            total += bucket.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    uint64_t bucket_count(size_t bucket) const { return counts_[bucket].load(std::memory_order_relaxed); }
+    uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    // Upper bound of the bucket holding the given quantile (0..1); 0 when
+    // empty
+    uint64_t percentile(double quantile) const
+    {
+        uint64_t total = count();
+        if (total == 0) {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(quantile * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+            seen += counts_[bucket].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                return bucket == 0 ? 0 : (uint64_t(1) << bucket) - 1;
+            }
+        }
+        return max();
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> counts_ {};
+    std::atomic<uint64_t> max_ { 0 };
+};
+
+} // namespace market_protocols
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace market_protocols {
+
+// The last `capacity` packets of one channel, indexed by sequence number,
+// for retransmission.
+//
+// One writer, any number of readers, no locks. Packets live in fixed
+// max_packet_size slots of one preallocated buffer, so record() is a
+// memcpy and two stores. Each slot is a seqlock keyed by the packet's
+// sequence number: record() clears the key, copies the packet in and
+// publishes the key; read() copies out and keeps the copy only if the key
+// is unchanged afterwards. A reader racing the writer gets a miss, never a
+// torn packet, and the writer never waits for readers.
+class PacketJournal {
+public:
+    static constexpr size_t DEFAULT_MAX_PACKET_SIZE = 1500;
+
+    // capacity is rounded up to a power of two
+    explicit PacketJournal(size_t capacity, size_t max_packet_size = DEFAULT_MAX_PACKET_SIZE);
+
+    PacketJournal(const PacketJournal&) = delete;
+    PacketJournal& operator=(const PacketJournal&) = delete;
+
+    // Writer side. Sequence 0 is never journaled; packets larger than a
+    // slot are dropped (and counted) rather than truncated.
+    void record(uint32_t sequence, const uint8_t* data, size_t length);
+
+    // Append the packet to out; false if it was never journaled, has been
+    // overwritten, or was being overwritten during the copy
+    bool read(uint32_t sequence, std::vector<uint8_t>& out) const;
+
+    // Sequence range the journal can currently serve (0 while empty).
+    // first_sequence() may already be overwritten by the time it is read.
+    uint32_t last_sequence() const { return last_sequence_.load(std::memory_order_acquire); }
+    uint32_t first_sequence() const;
+
+    size_t capacity() const { return mask_ + 1; }
+    size_t max_packet_size() const { return max_packet_size_; }
+    uint64_t oversized_packets() const { return oversized_.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> sequence { 0 }; // 0 while empty or being written
+        std::atomic<uint32_t> length { 0 };
+    };
+
+    size_t mask_;
+    size_t max_packet_size_;
+    std::unique_ptr<Slot[]> slots_;
+    std::unique_ptr<uint8_t[]> data_; // capacity * max_packet_size_
+    std::atomic<uint32_t> last_sequence_ { 0 };
+    std::atomic<uint64_t> oversized_ { 0 };
+};
+
+} // namespace market_protocols
@@ -47,6 +47,11 @@ public:
         const market_core::StatusEvent& event)
         = 0;
 
+    // Order-level (MBO) updates; ignored by protocols without order detail
+    virtual void process_order_event(
+        const market_core::Instrument& /*instrument*/,
+        const market_core::OrderEvent& /*event*/) { }
+
     // Instrument definition
     virtual void send_instrument_definition(
         const market_core::Instrument& instrument)
@@ -71,6 +76,12 @@ public:
     virtual void send_heartbeat() { }
 };
 
+// A packet in caller memory, for batched sends
+struct PacketRef {
+    const uint8_t* data;
+    size_t length;
+};
+
 // Message transport interface
 class IMessageTransport {
 public:
@@ -79,6 +90,26 @@ public:
     // Send encoded message
     virtual bool send_message(const std::vector<uint8_t>& data) = 0;
 
+    // Send a packet that lives in caller memory, valid only for the call.
+    // Transports that can write straight from the buffer should override
+    // this; the default copies into a vector.
+    virtual bool send_packet(const uint8_t* data, size_t length)
+    {
+        return send_message(std::vector<uint8_t>(data, data + length));
+    }
+
+    // Send packets that live in caller memory, in order. Transports that
+    // can put many datagrams in one syscall override this; the default
+    // stops at the first failure. Returns how many were sent.
+    virtual size_t send_packets(const PacketRef* packets, size_t count)
+    {
+        size_t sent = 0;
+        while (sent < count && send_packet(packets[sent].data, packets[sent].length)) {
+            ++sent;
+        }
+        return sent;
+    }
+
     // Send multiple messages as batch (if supported)
     virtual bool send_batch(const std::vector<std::vector<uint8_t>>& messages)
     {
@@ -89,6 +120,10 @@ public:
         return success;
     }
 
+    // Deferred work such as delayed sends; call from the sending thread's
+    // idle loop. Returns the number of packets sent.
+    virtual size_t poll() { return 0; }
+
     // Transport info
     virtual std::string get_transport_type() const = 0; // "UDP", "TCP", etc.
     virtual bool is_connected() const = 0;
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "packet_journal.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace market_protocols {
+
+// TCP replay of journaled packets for gap recovery.
+//
+// A client sends ReplayRequests (10 bytes, little-endian) and gets back,
+// for each, a ReplayResponse header (12 bytes) followed by `count` packets
+// from begin_sequence on, each prefixed with its uint16 length. Packets
+// are copied out of the channel's PacketJournal on the server's own
+// thread and sessions are served with non-blocking sockets, so neither
+// the publisher nor other sessions ever wait on a slow client.
+struct ReplayRequest {
+    static constexpr size_t WIRE_SIZE = 10;
+
+    uint16_t channel_id = 0;
+    uint32_t begin_sequence = 0;
+    uint32_t end_sequence = 0; // Inclusive
+
+    void encode(uint8_t* buffer) const;
+    static ReplayRequest decode(const uint8_t* buffer);
+};
+
+struct ReplayResponse {
+    static constexpr size_t WIRE_SIZE = 12;
+
+    enum class Status : uint8_t {
+        OK = 0,
+        PARTIAL = 1, // Part of the range is no longer (or not yet) journaled
+        UNKNOWN_CHANNEL = 2,
+        INVALID_RANGE = 3
+    };
+
+    uint16_t channel_id = 0;
+    Status status = Status::OK;
+    uint32_t begin_sequence = 0; // First packet sent
+    uint32_t count = 0; // Packets that follow
+
+    void encode(uint8_t* buffer) const;
+    static ReplayResponse decode(const uint8_t* buffer);
+};
+
+class ReplayServer {
+public:
+    struct Config {
+        uint16_t port = 0; // 0 picks an ephemeral port
+        size_t max_sessions = 16;
+        uint32_t max_packets_per_request = 2000; // Longer ranges are cut short
+    };
+
+    explicit ReplayServer(const Config& config);
+    ~ReplayServer();
+
+    ReplayServer(const ReplayServer&) = delete;
+    ReplayServer& operator=(const ReplayServer&) = delete;
+
+    // Register channels before start()
+    void add_channel(uint16_t channel_id, std::shared_ptr<const PacketJournal> journal);
+
+    // Listen and serve on a background thread; false if the port is unavailable
+    bool start();
+    void stop();
+    bool is_running() const { return thread_.joinable(); }
+
+    uint16_t port() const { return port_; }
+
+    // Statistics
+    uint64_t requests_served() const { return requests_served_.load(std::memory_order_relaxed); }
+    uint64_t packets_replayed() const { return packets_replayed_.load(std::memory_order_relaxed); }
+
+private:
+    struct Session {
+        int fd = -1;
+        std::vector<uint8_t> input;
+        std::vector<uint8_t> output; // Response being written
+        size_t output_offset = 0;
+    };
+
+    Config config_;
+    std::map<uint16_t, std::shared_ptr<const PacketJournal>> channels_;
+    int listen_fd_ = -1;
+    uint16_t port_ = 0;
+
+    std::thread thread_;
+    std::atomic<bool> stopping_ { false };
+    std::vector<Session> sessions_;
+
+    std::atomic<uint64_t> requests_served_ { 0 };
+    std::atomic<uint64_t> packets_replayed_ { 0 };
+
+    void run();
+    void accept_sessions();
+    bool read_requests(Session& session); // False when the session is closed
+    bool write_output(Session& session);
+    void serve(Session& session, const ReplayRequest& request);
+};
+
+} // namespace market_protocols
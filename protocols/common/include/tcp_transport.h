@@ -13,6 +13,8 @@ public:
     static void close_socket(int socket_fd);
 
     static std::vector<uint8_t> receive_data(int socket_fd, size_t max_size = 8192);
+    // Receive into caller-owned memory; 0 when nothing is available
+    static size_t receive_into(int socket_fd, uint8_t* buffer, size_t size);
     static bool send_data(int socket_fd, const std::vector<uint8_t>& data);
 
     static bool set_non_blocking(int socket_fd);
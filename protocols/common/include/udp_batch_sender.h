@@ -0,0 +1,64 @@
+#pragma once
+
+#include "protocol_adapter.h"
+#include <cstdint>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <vector>
+
+namespace market_protocols {
+
+// Sends many datagrams to one cached destination per syscall.
+//
+// Packets go out through sendmmsg(), up to MAX_MESSAGES headers per call.
+// With GSO on, each run of equal-sized packets (the last may be shorter)
+// becomes one header whose iovecs the kernel splits back into datagrams
+// via UDP_SEGMENT, so a single header can carry up to MAX_GSO_SEGMENTS
+// packets. Payloads are never copied.
+//
+// The socket belongs to the caller; the sender only borrows it.
+class UDPBatchSender {
+public:
+    static constexpr size_t MAX_MESSAGES = 64;
+    static constexpr size_t MAX_GSO_SEGMENTS = 64; // Kernel UDP_MAX_SEGMENTS
+    static constexpr size_t MAX_GSO_BYTES = 65507; // Largest UDP payload over IPv4
+
+    UDPBatchSender();
+
+    void attach(int socket_fd, const struct sockaddr_in& destination);
+    void detach() { socket_fd_ = -1; }
+
+    // Turn GSO on if the kernel supports UDP_SEGMENT on this socket;
+    // returns whether it is now in use
+    bool set_gso_enabled(bool enabled);
+    bool gso_enabled() const { return gso_; }
+
+    // Send packets in order; returns how many went out before the
+    // first failure
+    size_t send(const PacketRef* packets, size_t count);
+
+    // Statistics
+    uint64_t syscalls() const { return syscalls_; }
+    uint64_t datagrams_sent() const { return datagrams_sent_; }
+    uint64_t send_errors() const { return send_errors_; }
+
+private:
+    int socket_fd_ = -1;
+    struct sockaddr_in destination_;
+    bool gso_ = false;
+
+    // Scratch reused across calls
+    std::vector<struct mmsghdr> messages_;
+    std::vector<struct iovec> iovecs_;
+    std::vector<size_t> packets_per_message_;
+    std::vector<uint8_t> control_;
+
+    uint64_t syscalls_ = 0;
+    uint64_t datagrams_sent_ = 0;
+    uint64_t send_errors_ = 0;
+
+    // Packets from first that one GSO header can carry
+    size_t gso_run(const PacketRef* packets, size_t count) const;
+};
+
+} // namespace market_protocols
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "udp_batch_sender.h"
 #include <cstdint>
 #include <netinet/in.h>
 #include <string>
@@ -26,6 +27,12 @@ public:
     bool send(const std::vector<uint8_t>& data);
     bool send(const uint8_t* data, size_t length);
 
+    // Send many datagrams per syscall (sendmmsg, plus UDP GSO where the
+    // kernel has it); returns how many were sent
+    size_t send_packets(const market_protocols::PacketRef* packets, size_t count);
+    bool send_batch(const std::vector<std::vector<uint8_t>>& messages);
+    const market_protocols::UDPBatchSender& batch_sender() const { return batch_; }
+
     // Receive data
     std::vector<uint8_t> receive(size_t max_size = 65536);
 
@@ -50,6 +57,8 @@ private:
     std::string interface_ip_;
     bool is_sender_;
     std::string last_error_;
+    market_protocols::UDPBatchSender batch_;
+    std::vector<market_protocols::PacketRef> batch_refs_;
 
     bool join_multicast_group();
     bool set_multicast_interface();
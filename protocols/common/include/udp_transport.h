@@ -1,6 +1,7 @@
 #pragma once
 
 #include "protocol_adapter.h"
+#include "udp_batch_sender.h"
 #include <netinet/in.h>
 #include <string>
 
@@ -14,6 +15,9 @@ public:
 
     // IMessageTransport interface
     bool send_message(const std::vector<uint8_t>& data) override;
+    bool send_packet(const uint8_t* data, size_t length) override;
+    size_t send_packets(const PacketRef* packets, size_t count) override;
+    bool send_batch(const std::vector<std::vector<uint8_t>>& messages) override;
     std::string get_transport_type() const override { return "UDP"; }
     bool is_connected() const override { return socket_fd_ > 0; }
 
@@ -29,12 +33,18 @@ public:
     void set_send_buffer_size(size_t size);
     void set_ttl(int ttl);
 
+    // UDP GSO for batched sends, on by default where the kernel has it
+    bool set_gso_enabled(bool enabled) { return batch_.set_gso_enabled(enabled); }
+    const UDPBatchSender& batch_sender() const { return batch_; }
+
 private:
     std::string host_;
     uint16_t port_;
     int socket_fd_;
     struct sockaddr_in dest_addr_;
     bool is_multicast_;
+    UDPBatchSender batch_;
+    std::vector<PacketRef> batch_refs_;
 
     bool setup_socket();
     bool is_multicast_address(const std::string& ip);
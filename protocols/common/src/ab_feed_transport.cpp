@@ -0,0 +1,206 @@
+#include "../include/ab_feed_transport.h"
+#include <arpa/inet.h>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace market_protocols {
+
+static bool resolve_address(const std::string& host, uint16_t port, struct sockaddr_in& addr)
+{
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    return inet_pton(AF_INET, host.c_str(), &addr.sin_addr) > 0;
+}
+
+static bool is_multicast(const struct sockaddr_in& addr)
+{
+    uint32_t ip_addr = ntohl(addr.sin_addr.s_addr);
+    return (ip_addr >= 0xE0000000) && (ip_addr <= 0xEFFFFFFF);
+}
+
+ABFeedTransport::ABFeedTransport(const std::string& host_a, uint16_t port_a,
+    const std::string& host_b, uint16_t port_b)
+    : host_a_(host_a)
+    , port_a_(port_a)
+    , host_b_(host_b)
+    , port_b_(port_b)
+{
+    memset(&addr_a_, 0, sizeof(addr_a_));
+    memset(&addr_b_, 0, sizeof(addr_b_));
+}
+
+ABFeedTransport::~ABFeedTransport()
+{
+    close();
+}
+
+bool ABFeedTransport::initialize()
+{
+    if (socket_fd_ >= 0) {
+        return true; // Already initialized
+    }
+
+    if (!resolve_address(host_a_, port_a_, addr_a_) || !resolve_address(host_b_, port_b_, addr_b_)) {
+        return false;
+    }
+
+    // One socket serves both groups
+    socket_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    if (socket_fd_ < 0) {
+        return false;
+    }
+
+    if (is_multicast(addr_a_) || is_multicast(addr_b_)) {
+        int ttl = 1;
+        if (setsockopt(socket_fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0) {
+            close();
+            return false;
+        }
+
+        int loop = 0;
+        setsockopt(socket_fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+    }
+
+    return true;
+}
+
+void ABFeedTransport::close()
+{
+    if (socket_fd_ >= 0) {
+        ::close(socket_fd_);
+        socket_fd_ = -1;
+    }
+}
+
+bool ABFeedTransport::send_message(const std::vector<uint8_t>& data)
+{
+    return send_packet(data.data(), data.size());
+}
+
+bool ABFeedTransport::send_packet(const uint8_t* data, size_t length)
+{
+    if (socket_fd_ < 0 && !initialize()) {
+        return false;
+    }
+
+    if (b_delay_.count() <= 0 && delayed_count_ == 0) {
+        return send_both(data, length);
+    }
+
+    // Delayed B: A goes now, B joins the queue behind earlier B packets
+    auto now = clock::now();
+    bool sent = send_to(addr_a_, data, length);
+    if (sent) {
+        ++packets_a_;
+    }
+    send_due_b(now);
+    enqueue_b(data, length, now + b_delay_);
+    return sent;
+}
+
+size_t ABFeedTransport::poll()
+{
+    if (delayed_count_ == 0) {
+        return 0;
+    }
+    return send_due_b(clock::now());
+}
+
+bool ABFeedTransport::send_to(const struct sockaddr_in& addr, const uint8_t* data, size_t length)
+{
+    ssize_t sent = sendto(socket_fd_, data, length, 0,
+        reinterpret_cast<const struct sockaddr*>(&addr), sizeof(addr));
+    if (sent != static_cast<ssize_t>(length)) {
+        ++send_errors_;
+        return false;
+    }
+    return true;
+}
+
+bool ABFeedTransport::send_both(const uint8_t* data, size_t length)
+{
+    // Both datagrams reference the same bytes; one syscall sends the pair
+    struct iovec iov;
+    iov.iov_base = const_cast<uint8_t*>(data);
+    iov.iov_len = length;
+
+    struct mmsghdr messages[2];
+    memset(messages, 0, sizeof(messages));
+    messages[0].msg_hdr.msg_name = &addr_a_;
+    messages[0].msg_hdr.msg_namelen = sizeof(addr_a_);
+    messages[0].msg_hdr.msg_iov = &iov;
+    messages[0].msg_hdr.msg_iovlen = 1;
+    messages[1].msg_hdr = messages[0].msg_hdr;
+    messages[1].msg_hdr.msg_name = &addr_b_;
+
+    int sent = sendmmsg(socket_fd_, messages, 2, 0);
+    if (sent < 0) {
+        sent = 0;
+    }
+
+    // A partial send leaves B behind; retry it on its own
+    if (sent == 1 && send_to(addr_b_, data, length)) {
+        sent = 2;
+    }
+
+    packets_a_ += sent >= 1 ? 1 : 0;
+    packets_b_ += sent == 2 ? 1 : 0;
+    send_errors_ += static_cast<uint64_t>(2 - sent);
+    return sent == 2;
+}
+
+void ABFeedTransport::enqueue_b(const uint8_t* data, size_t length, clock::time_point due)
+{
+    if (delayed_count_ == delayed_.size()) {
+        // Unroll the ring into a larger one, oldest first
+        std::vector<DelayedPacket> grown(delayed_.empty() ? 64 : delayed_.size() * 2);
+        for (size_t i = 0; i < delayed_count_; ++i) {
+            grown[i] = std::move(delayed_[(delayed_head_ + i) % delayed_.size()]);
+        }
+        delayed_ = std::move(grown);
+        delayed_head_ = 0;
+    }
+
+    DelayedPacket& slot = delayed_[(delayed_head_ + delayed_count_) % delayed_.size()];
+    slot.due = due;
+    slot.data.assign(data, data + length);
+    ++delayed_count_;
+}
+
+size_t ABFeedTransport::send_due_b(clock::time_point now)
+{
+    size_t sent = 0;
+    while (delayed_count_ > 0) {
+        DelayedPacket& head = delayed_[delayed_head_];
+        if (head.due > now) {
+            break;
+        }
+        if (send_to(addr_b_, head.data.data(), head.data.size())) {
+            ++packets_b_;
+        }
+        delayed_head_ = (delayed_head_ + 1) % delayed_.size();
+        --delayed_count_;
+        ++sent;
+    }
+    return sent;
+}
+
+void ABFeedTransport::set_ttl(int ttl)
+{
+    if (socket_fd_ >= 0) {
+        setsockopt(socket_fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+    }
+}
+
+void ABFeedTransport::set_send_buffer_size(size_t size)
+{
+    if (socket_fd_ >= 0) {
+        int buf_size = static_cast<int>(size);
+        setsockopt(socket_fd_, SOL_SOCKET, SO_SNDBUF, &buf_size, sizeof(buf_size));
+    }
+}
+
+} // namespace market_protocols
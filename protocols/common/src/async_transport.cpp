@@ -0,0 +1,160 @@
+#include "../include/async_transport.h"
+#include <algorithm>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+
+namespace market_protocols {
+
+static int64_t steady_now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static void pin_current_thread(int cpu)
+{
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+}
+
+AsyncTransport::AsyncTransport(std::shared_ptr<IMessageTransport> inner, const Config& config)
+    : inner_(std::move(inner))
+    , config_(config)
+    , slots_(new uint8_t[config.slots * config.slot_size])
+    , ready_(config.slots)
+    , free_(config.slots)
+{
+    for (uint32_t slot = 0; slot < config_.slots; ++slot) {
+        free_.try_push(slot);
+    }
+}
+
+AsyncTransport::~AsyncTransport()
+{
+    stop();
+}
+
+void AsyncTransport::start()
+{
+    if (thread_.joinable()) {
+        return;
+    }
+    stopping_ = false;
+    thread_ = std::thread(&AsyncTransport::run, this);
+}
+
+void AsyncTransport::stop()
+{
+    stopping_ = true;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool AsyncTransport::send_message(const std::vector<uint8_t>& data)
+{
+    return send_packet(data.data(), data.size());
+}
+
+bool AsyncTransport::send_packet(const uint8_t* data, size_t length)
+{
+    if (length > config_.slot_size) {
+        oversize_drops_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint32_t slot;
+    if (!acquire_slot(slot)) {
+        return false;
+    }
+
+    std::memcpy(slot_data(slot), data, length);
+    ready_.try_push({ slot, static_cast<uint32_t>(length), steady_now_ns() }); // Never full: one entry per slot
+    packets_queued_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool AsyncTransport::acquire_slot(uint32_t& slot)
+{
+    if (free_.try_pop(&slot, 1) == 1) {
+        return true;
+    }
+
+    // Without a sender thread no slot will come back
+    if (config_.overflow == OverflowPolicy::DROP || !thread_.joinable()) {
+        drops_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    backpressure_waits_.fetch_add(1, std::memory_order_relaxed);
+    while (free_.try_pop(&slot, 1) == 0) {
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+size_t AsyncTransport::send_run(const QueuedPacket* packets, size_t count)
+{
+    PacketRef refs[MAX_BATCH];
+    for (size_t i = 0; i < count; ++i) {
+        refs[i] = { slot_data(packets[i].slot), packets[i].length };
+    }
+
+    // A failed packet is lost like any UDP datagram; the rest still go
+    size_t offset = 0;
+    size_t sent = 0;
+    while (offset < count) {
+        size_t run = inner_->send_packets(refs + offset, count - offset);
+        sent += run;
+        offset += run;
+        if (offset < count) {
+            send_failures_.fetch_add(1, std::memory_order_relaxed);
+            ++offset;
+        }
+    }
+
+    int64_t now = steady_now_ns();
+    for (size_t i = 0; i < count; ++i) {
+        send_latency_.record(static_cast<uint64_t>(std::max<int64_t>(0, now - packets[i].queued_ns)));
+        free_.try_push(packets[i].slot);
+    }
+    packets_sent_.fetch_add(sent, std::memory_order_relaxed);
+    return sent;
+}
+
+void AsyncTransport::run()
+{
+    if (config_.cpu >= 0) {
+        pin_current_thread(config_.cpu);
+    }
+
+    QueuedPacket batch[MAX_BATCH];
+    while (true) {
+        // Read the flag first so packets queued before stop() are sent
+        bool stopping = stopping_.load(std::memory_order_acquire);
+        size_t count = ready_.try_pop(batch, MAX_BATCH);
+        if (count > 0) {
+            size_t depth = count + ready_.size();
+            if (depth > max_queue_depth_.load(std::memory_order_relaxed)) {
+                max_queue_depth_.store(depth, std::memory_order_relaxed);
+            }
+            send_run(batch, count);
+            continue;
+        }
+        if (stopping) {
+            break;
+        }
+
+        // Idle: deferred sends of the inner transport, then back off
+        inner_->poll();
+        if (config_.idle_sleep.count() > 0) {
+            std::this_thread::sleep_for(config_.idle_sleep);
+        }
+    }
+}
+
+} // namespace market_protocols
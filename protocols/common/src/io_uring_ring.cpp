@@ -0,0 +1,203 @@
+#include "../include/io_uring_ring.h"
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+namespace market_protocols {
+
+static int io_uring_setup(unsigned entries, struct io_uring_params* params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+IoUringRing::~IoUringRing()
+{
+    close();
+}
+
+bool IoUringRing::supported()
+{
+    static const bool available = [] {
+        IoUringRing probe;
+        return probe.init(2);
+    }();
+    return available;
+}
+
+bool IoUringRing::init(unsigned entries, bool sq_poll)
+{
+    close();
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    if (sq_poll) {
+        params.flags = IORING_SETUP_SQPOLL;
+        params.sq_thread_idle = 100; // ms before the kernel thread sleeps
+        ring_fd_ = io_uring_setup(entries, &params);
+        sq_poll_ = ring_fd_ >= 0;
+    }
+    if (ring_fd_ < 0) {
+        memset(&params, 0, sizeof(params));
+        ring_fd_ = io_uring_setup(entries, &params);
+    }
+    if (ring_fd_ < 0) {
+        return false;
+    }
+
+    if (!map_rings(params)) {
+        int error = errno;
+        close();
+        errno = error;
+        return false;
+    }
+    return true;
+}
+
+bool IoUringRing::map_rings(const struct io_uring_params& params)
+{
+    sq_entries_ = params.sq_entries;
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+    // Kernels with a single mapping share one region for both rings
+    bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single && cq_ring_size_ > sq_ring_size_) {
+        sq_ring_size_ = cq_ring_size_;
+    }
+
+    sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        ring_fd_, IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED) {
+        sq_ring_ = nullptr;
+        return false;
+    }
+
+    if (single) {
+        cq_ring_ = sq_ring_;
+    } else {
+        cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+            ring_fd_, IORING_OFF_CQ_RING);
+        if (cq_ring_ == MAP_FAILED) {
+            cq_ring_ = nullptr;
+            return false;
+        }
+    }
+
+    sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        ring_fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        return false;
+    }
+    sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+
+    auto* sq = static_cast<uint8_t*>(sq_ring_);
+    sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_flags_ = reinterpret_cast<unsigned*>(sq + params.sq_off.flags);
+    sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    sqe_tail_ = *sq_tail_;
+
+    auto* cq = static_cast<uint8_t*>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+    return true;
+}
+
+void IoUringRing::close()
+{
+    if (sqes_ != nullptr) {
+        munmap(sqes_, sqes_size_);
+        sqes_ = nullptr;
+    }
+    if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+        munmap(cq_ring_, cq_ring_size_);
+    }
+    cq_ring_ = nullptr;
+    if (sq_ring_ != nullptr) {
+        munmap(sq_ring_, sq_ring_size_);
+        sq_ring_ = nullptr;
+    }
+    if (ring_fd_ >= 0) {
+        ::close(ring_fd_);
+        ring_fd_ = -1;
+    }
+    sq_poll_ = false;
+}
+
+bool IoUringRing::register_buffers(const struct iovec* buffers, unsigned count)
+{
+    return syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS, buffers, count) == 0;
+}
+
+struct io_uring_sqe* IoUringRing::get_sqe()
+{
+    unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (sqe_tail_ - head >= sq_entries_) {
+        return nullptr;
+    }
+
+    unsigned index = sqe_tail_ & *sq_mask_;
+    sq_array_[index] = index;
+    struct io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    ++sqe_tail_;
+    return sqe;
+}
+
+int IoUringRing::submit(unsigned wait_for)
+{
+    __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+    unsigned pending = sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+
+    unsigned flags = wait_for > 0 ? IORING_ENTER_GETEVENTS : 0;
+    if (sq_poll_) {
+        // The kernel thread picks entries up itself unless it went idle;
+        // the fence orders the tail store before the flags load
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(sq_flags_, __ATOMIC_RELAXED) & IORING_SQ_NEED_WAKEUP) {
+            flags |= IORING_ENTER_SQ_WAKEUP;
+        }
+        if (flags == 0) {
+            return static_cast<int>(pending);
+        }
+    } else if (pending == 0 && wait_for == 0) {
+        return 0;
+    }
+
+    int result;
+    do {
+        result = io_uring_enter(ring_fd_, pending, wait_for, flags);
+        ++enter_calls_;
+    } while (result < 0 && errno == EINTR);
+    return result < 0 ? -errno : result;
+}
+
+void IoUringRing::submit_all()
+{
+    // A kernel submission thread takes entries in its own time
+    while (submit() >= 0 && __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) != sqe_tail_) {
+    }
+}
+
+} // namespace market_protocols
@@ -0,0 +1,441 @@
+#include "../include/io_uring_transport.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace market_protocols {
+
+static constexpr uint64_t POLL_FLAG = uint64_t(1) << 62; // user_data of a POLLOUT wait: flag | slot
+static constexpr uint64_t CANCEL_TAG = ~uint64_t(0); // user_data of cancellations
+
+IoUringSlotPool::IoUringSlotPool(size_t slots, size_t slot_size)
+    : slot_count_(slots)
+    , slot_size_(slot_size)
+    , memory_(new uint8_t[slots * slot_size])
+{
+    free_.reserve(slots);
+    for (size_t slot = slots; slot > 0; --slot) {
+        free_.push_back(static_cast<uint32_t>(slot - 1));
+    }
+}
+
+bool IoUringSlotPool::register_with(IoUringRing& ring)
+{
+    struct iovec region;
+    region.iov_base = memory_.get();
+    region.iov_len = slot_count_ * slot_size_;
+    registered_ = ring.register_buffers(&region, 1);
+    return registered_;
+}
+
+bool IoUringSlotPool::acquire(uint32_t& slot)
+{
+    if (free_.empty()) {
+        return false;
+    }
+    slot = free_.back();
+    free_.pop_back();
+    return true;
+}
+
+void IoUringSlotPool::prepare_write(struct io_uring_sqe* sqe, int fd, uint32_t slot, size_t offset, size_t length)
+{
+    sqe->opcode = registered_ ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(data(slot) + offset);
+    sqe->len = static_cast<uint32_t>(length);
+    sqe->off = 0; // Sockets ignore the file position
+    sqe->buf_index = 0;
+    sqe->user_data = slot;
+}
+
+void IoUringSlotPool::prepare_send(struct io_uring_sqe* sqe, int fd, uint32_t slot, size_t offset, size_t length)
+{
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(data(slot) + offset);
+    sqe->len = static_cast<uint32_t>(length);
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = slot;
+}
+
+// ===========================
+// IoUringTransport
+// ===========================
+
+IoUringTransport::IoUringTransport(const std::string& host, uint16_t port, const Config& config)
+    : host_(host)
+    , port_(port)
+    , config_(config)
+    , pool_(config.slots, config.slot_size)
+{
+}
+
+IoUringTransport::~IoUringTransport()
+{
+    close();
+}
+
+bool IoUringTransport::initialize()
+{
+    if (socket_fd_ >= 0) {
+        return true; // Already initialized
+    }
+
+    struct sockaddr_in dest_addr;
+    memset(&dest_addr, 0, sizeof(dest_addr));
+    dest_addr.sin_family = AF_INET;
+    dest_addr.sin_port = htons(port_);
+    if (inet_pton(AF_INET, host_.c_str(), &dest_addr.sin_addr) <= 0) {
+        return false;
+    }
+
+    socket_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+    if (socket_fd_ < 0) {
+        return false;
+    }
+
+    uint32_t ip_addr = ntohl(dest_addr.sin_addr.s_addr);
+    if (ip_addr >= 0xE0000000 && ip_addr <= 0xEFFFFFFF) {
+        int ttl = 1;
+        setsockopt(socket_fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+        int loop = 0;
+        setsockopt(socket_fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+    }
+
+    // A connected socket lets each datagram go out as a plain write
+    if (connect(socket_fd_, reinterpret_cast<struct sockaddr*>(&dest_addr), sizeof(dest_addr)) < 0
+        || !ring_.init(static_cast<unsigned>(config_.slots), config_.sq_poll)) {
+        close();
+        return false;
+    }
+    pool_.register_with(ring_);
+    return true;
+}
+
+void IoUringTransport::close()
+{
+    if (ring_.is_open()) {
+        flush();
+        ring_.close();
+    }
+    if (socket_fd_ >= 0) {
+        ::close(socket_fd_);
+        socket_fd_ = -1;
+    }
+}
+
+bool IoUringTransport::send_message(const std::vector<uint8_t>& data)
+{
+    return send_packet(data.data(), data.size());
+}
+
+bool IoUringTransport::send_packet(const uint8_t* data, size_t length)
+{
+    if (socket_fd_ < 0 && !initialize()) {
+        return false;
+    }
+
+    bool queued = queue_packet(data, length);
+    ring_.submit();
+    reap();
+    return queued;
+}
+
+size_t IoUringTransport::send_packets(const PacketRef* packets, size_t count)
+{
+    if (socket_fd_ < 0 && !initialize()) {
+        return 0;
+    }
+
+    size_t queued = 0;
+    while (queued < count && queue_packet(packets[queued].data, packets[queued].length)) {
+        ++queued;
+    }
+    ring_.submit();
+    reap();
+    return queued;
+}
+
+size_t IoUringTransport::poll()
+{
+    if (!ring_.is_open()) {
+        return 0;
+    }
+    ring_.submit();
+    return reap();
+}
+
+void IoUringTransport::flush()
+{
+    while (in_flight() > 0) {
+        if (ring_.submit(1) < 0) {
+            break;
+        }
+        reap();
+    }
+}
+
+bool IoUringTransport::queue_packet(const uint8_t* data, size_t length)
+{
+    if (length > pool_.slot_size()) {
+        ++send_errors_;
+        return false;
+    }
+
+    // Every slot in flight: wait for the kernel to finish some
+    uint32_t slot;
+    while (!pool_.acquire(slot)) {
+        if (reap() == 0 && ring_.submit(1) < 0) {
+            return false;
+        }
+    }
+
+    memcpy(pool_.data(slot), data, length);
+    pool_.prepare_write(next_sqe(), socket_fd_, slot, 0, length);
+    return true;
+}
+
+struct io_uring_sqe* IoUringTransport::next_sqe()
+{
+    struct io_uring_sqe* sqe;
+    while ((sqe = ring_.get_sqe()) == nullptr) {
+        ring_.submit();
+    }
+    return sqe;
+}
+
+size_t IoUringTransport::reap()
+{
+    return ring_.drain_completions([this](const struct io_uring_cqe& cqe) {
+        if (cqe.res < 0) {
+            ++send_errors_;
+        } else {
+            ++packets_sent_;
+        }
+        pool_.release(static_cast<uint32_t>(cqe.user_data));
+    });
+}
+
+// ===========================
+// IoUringStreamWriter
+// ===========================
+
+IoUringStreamWriter::IoUringStreamWriter()
+    : IoUringStreamWriter(Config())
+{
+}
+
+IoUringStreamWriter::IoUringStreamWriter(const Config& config)
+    : config_(config)
+    , pool_(config.slots, config.slot_size)
+    , slot_states_(config.slots)
+{
+}
+
+bool IoUringStreamWriter::initialize()
+{
+    // Room for a POLLOUT wait beside every write
+    return ring_.init(static_cast<unsigned>(config_.slots * 2), config_.sq_poll);
+}
+
+bool IoUringStreamWriter::write(int fd, const uint8_t* data, size_t length)
+{
+    if (length == 0) {
+        return true;
+    }
+
+    auto inserted = streams_.emplace(fd, Stream());
+    Stream& stream = inserted.first->second;
+    if (inserted.second) {
+        stream.generation = next_generation_++;
+    }
+    if (stream.failed) {
+        return false;
+    }
+
+    // Only a slot the kernel has not been given can take more bytes
+    auto tail_room = [&]() -> size_t {
+        if (stream.slots.empty() || (stream.in_flight && stream.slots.size() == 1)) {
+            return 0;
+        }
+        return pool_.slot_size() - slot_states_[stream.slots.back()].length;
+    };
+    auto slots_needed = [&]() -> size_t {
+        size_t room = tail_room();
+        return length <= room ? 0 : (length - room + pool_.slot_size() - 1) / pool_.slot_size();
+    };
+
+    if (pool_.available() < slots_needed()) {
+        poll();
+        if (stream.failed || pool_.available() < slots_needed()) {
+            return false;
+        }
+    }
+
+    size_t copied = 0;
+    size_t room = tail_room();
+    if (room > 0) {
+        SlotState& state = slot_states_[stream.slots.back()];
+        size_t chunk = length < room ? length : room;
+        memcpy(pool_.data(stream.slots.back()) + state.length, data, chunk);
+        state.length += chunk;
+        copied = chunk;
+    }
+    while (copied < length) {
+        uint32_t slot = 0;
+        pool_.acquire(slot);
+        size_t chunk = length - copied < pool_.slot_size() ? length - copied : pool_.slot_size();
+        memcpy(pool_.data(slot), data + copied, chunk);
+        slot_states_[slot] = { fd, stream.generation, 0, chunk };
+        stream.slots.push_back(slot);
+        copied += chunk;
+    }
+    stream.queued_bytes += length;
+
+    if (!stream.in_flight) {
+        submit_front(fd, stream, false);
+    }
+    return true;
+}
+
+size_t IoUringStreamWriter::poll()
+{
+    if (!ring_.is_open()) {
+        return 0;
+    }
+
+    // Completions may queue follow-on writes; submit those too
+    size_t total = 0;
+    size_t completed;
+    do {
+        ring_.submit();
+        completed = ring_.drain_completions([this](const struct io_uring_cqe& cqe) { complete(cqe); });
+        total += completed;
+    } while (completed > 0);
+    return total;
+}
+
+void IoUringStreamWriter::remove(int fd)
+{
+    auto it = streams_.find(fd);
+    if (it == streams_.end()) {
+        return;
+    }
+
+    // An in-flight slot comes back through its completion
+    Stream& stream = it->second;
+    if (stream.in_flight) {
+        // The send must reach the kernel while fd still names this
+        // socket: after close() the number may belong to a new one
+        ring_.submit_all();
+
+        // Neither a wait on a stalled peer nor its send may outlive the
+        // session and keep the closed socket's file open
+        uint32_t slot = stream.slots.front();
+        for (uint64_t target : { POLL_FLAG | slot, static_cast<uint64_t>(slot) }) {
+            struct io_uring_sqe* cancel = next_sqe();
+            cancel->opcode = IORING_OP_ASYNC_CANCEL;
+            cancel->fd = -1;
+            cancel->addr = target;
+            cancel->user_data = CANCEL_TAG;
+        }
+        ring_.submit_all();
+    }
+    for (size_t i = stream.in_flight ? 1 : 0; i < stream.slots.size(); ++i) {
+        pool_.release(stream.slots[i]);
+    }
+    streams_.erase(it);
+}
+
+bool IoUringStreamWriter::failed(int fd) const
+{
+    auto it = streams_.find(fd);
+    return it != streams_.end() && it->second.failed;
+}
+
+size_t IoUringStreamWriter::queued_bytes(int fd) const
+{
+    auto it = streams_.find(fd);
+    return it == streams_.end() ? 0 : it->second.queued_bytes;
+}
+
+struct io_uring_sqe* IoUringStreamWriter::next_sqe()
+{
+    struct io_uring_sqe* sqe;
+    while ((sqe = ring_.get_sqe()) == nullptr) {
+        ring_.submit();
+    }
+    return sqe;
+}
+
+void IoUringStreamWriter::submit_front(int fd, Stream& stream, bool wait_writable)
+{
+    if (wait_writable) {
+        struct io_uring_sqe* wait = next_sqe();
+        wait->opcode = IORING_OP_POLL_ADD;
+        wait->fd = fd;
+        wait->poll32_events = POLLOUT;
+        wait->flags = IOSQE_IO_LINK;
+        wait->user_data = POLL_FLAG | stream.slots.front();
+    }
+
+    uint32_t slot = stream.slots.front();
+    const SlotState& state = slot_states_[slot];
+    pool_.prepare_send(next_sqe(), fd, slot, state.offset, state.length - state.offset);
+    stream.in_flight = true;
+}
+
+void IoUringStreamWriter::complete(const struct io_uring_cqe& cqe)
+{
+    if (cqe.user_data == CANCEL_TAG || (cqe.user_data & POLL_FLAG)) {
+        return;
+    }
+
+    uint32_t slot = static_cast<uint32_t>(cqe.user_data);
+    SlotState& state = slot_states_[slot];
+    auto it = streams_.find(state.fd);
+    if (it == streams_.end() || it->second.generation != state.generation) {
+        pool_.release(slot); // Stream removed while the write was in flight
+        return;
+    }
+
+    Stream& stream = it->second;
+    stream.in_flight = false;
+    if (cqe.res == -EAGAIN || cqe.res == -ECANCELED) {
+        submit_front(state.fd, stream, true);
+        return;
+    }
+    if (cqe.res <= 0) {
+        ++write_errors_;
+        fail(stream);
+        return;
+    }
+
+    size_t written = static_cast<size_t>(cqe.res);
+    bytes_written_ += written;
+    stream.queued_bytes -= written;
+    state.offset += written;
+    if (state.offset == state.length) {
+        stream.slots.pop_front();
+        pool_.release(slot);
+    }
+    if (!stream.slots.empty()) {
+        submit_front(state.fd, stream, false);
+    }
+}
+
+void IoUringStreamWriter::fail(Stream& stream)
+{
+    for (uint32_t slot : stream.slots) {
+        pool_.release(slot);
+    }
+    stream.slots.clear();
+    stream.queued_bytes = 0;
+    stream.failed = true;
+}
+
+} // namespace market_protocols
@@ -0,0 +1,81 @@
+#include "../include/packet_journal.h"
+#include <cstring>
+
+namespace market_protocols {
+
+static size_t round_up_power_of_two(size_t value)
+{
+    size_t power = 1;
+    while (power < value) {
+        power <<= 1;
+    }
+    return power;
+}
+
+PacketJournal::PacketJournal(size_t capacity, size_t max_packet_size)
+    : mask_(round_up_power_of_two(capacity > 0 ? capacity : 1) - 1)
+    , max_packet_size_(max_packet_size)
+    , slots_(new Slot[mask_ + 1])
+    , data_(new uint8_t[(mask_ + 1) * max_packet_size])
+{
+}
+
+void PacketJournal::record(uint32_t sequence, const uint8_t* data, size_t length)
+{
+    if (sequence == 0) {
+        return;
+    }
+
+    Slot& slot = slots_[sequence & mask_];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (length > max_packet_size_) {
+        // The slot stays empty; its old packet is gone either way
+        oversized_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        std::memcpy(data_.get() + (sequence & mask_) * max_packet_size_, data, length);
+        slot.length.store(static_cast<uint32_t>(length), std::memory_order_relaxed);
+        slot.sequence.store(sequence, std::memory_order_release);
+    }
+    last_sequence_.store(sequence, std::memory_order_release);
+}
+
+bool PacketJournal::read(uint32_t sequence, std::vector<uint8_t>& out) const
+{
+    if (sequence == 0) {
+        return false;
+    }
+
+    const Slot& slot = slots_[sequence & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != sequence) {
+        return false;
+    }
+
+    size_t length = slot.length.load(std::memory_order_relaxed);
+    if (length > max_packet_size_) {
+        return false;
+    }
+    size_t offset = out.size();
+    out.resize(offset + length);
+    std::memcpy(out.data() + offset, data_.get() + (sequence & mask_) * max_packet_size_, length);
+
+    // Overwritten while copying: drop the copy
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+        out.resize(offset);
+        return false;
+    }
+    return true;
+}
+
+uint32_t PacketJournal::first_sequence() const
+{
+    uint32_t last = last_sequence();
+    if (last == 0) {
+        return 0;
+    }
+    return last > mask_ ? static_cast<uint32_t>(last - mask_) : 1;
+}
+
+} // namespace market_protocols
@@ -0,0 +1,291 @@
+#include "../include/replay_server.h"
+#include "../include/tcp_transport.h"
+#include <algorithm>
+#include <cstring>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+
+namespace market_protocols {
+
+static void put_u16(uint8_t* buffer, uint16_t value)
+{
+    buffer[0] = static_cast<uint8_t>(value);
+    buffer[1] = static_cast<uint8_t>(value >> 8);
+}
+
+static void put_u32(uint8_t* buffer, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {
+        buffer[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+static uint16_t get_u16(const uint8_t* buffer)
+{
+    return static_cast<uint16_t>(buffer[0] | (buffer[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* buffer)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(buffer[i]) << (8 * i);
+    }
+    return value;
+}
+
+void ReplayRequest::encode(uint8_t* buffer) const
+{
+    put_u16(buffer, channel_id);
+    put_u32(buffer + 2, begin_sequence);
+    put_u32(buffer + 6, end_sequence);
+}
+
+ReplayRequest ReplayRequest::decode(const uint8_t* buffer)
+{
+    ReplayRequest request;
+    request.channel_id = get_u16(buffer);
+    request.begin_sequence = get_u32(buffer + 2);
+    request.end_sequence = get_u32(buffer + 6);
+    return request;
+}
+
+void ReplayResponse::encode(uint8_t* buffer) const
+{
+    put_u16(buffer, channel_id);
+    buffer[2] = static_cast<uint8_t>(status);
+    buffer[3] = 0;
+    put_u32(buffer + 4, begin_sequence);
+    put_u32(buffer + 8, count);
+}
+
+ReplayResponse ReplayResponse::decode(const uint8_t* buffer)
+{
+    ReplayResponse response;
+    response.channel_id = get_u16(buffer);
+    response.status = static_cast<Status>(buffer[2]);
+    response.begin_sequence = get_u32(buffer + 4);
+    response.count = get_u32(buffer + 8);
+    return response;
+}
+
+ReplayServer::ReplayServer(const Config& config)
+    : config_(config)
+{
+}
+
+ReplayServer::~ReplayServer()
+{
+    stop();
+}
+
+void ReplayServer::add_channel(uint16_t channel_id, std::shared_ptr<const PacketJournal> journal)
+{
+    channels_[channel_id] = std::move(journal);
+}
+
+bool ReplayServer::start()
+{
+    if (thread_.joinable()) {
+        return true;
+    }
+
+    try {
+        listen_fd_ = protocol_common::TCPTransport::create_server_socket(config_.port);
+    } catch (const std::exception&) {
+        return false;
+    }
+    protocol_common::TCPTransport::set_non_blocking(listen_fd_);
+
+    struct sockaddr_in addr;
+    socklen_t length = sizeof(addr);
+    getsockname(listen_fd_, reinterpret_cast<struct sockaddr*>(&addr), &length);
+    port_ = ntohs(addr.sin_port);
+
+    stopping_ = false;
+    thread_ = std::thread(&ReplayServer::run, this);
+    return true;
+}
+
+void ReplayServer::stop()
+{
+    stopping_ = true;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    for (auto& session : sessions_) {
+        protocol_common::TCPTransport::close_socket(session.fd);
+    }
+    sessions_.clear();
+    protocol_common::TCPTransport::close_socket(listen_fd_);
+    listen_fd_ = -1;
+}
+
+void ReplayServer::run()
+{
+    std::vector<struct pollfd> fds;
+    while (!stopping_) {
+        // Sessions with a response in flight wait for POLLOUT and read
+        // no further requests until it is written
+        fds.clear();
+        fds.push_back({ listen_fd_, POLLIN, 0 });
+        for (const auto& session : sessions_) {
+            short events = session.output.empty() ? POLLIN : POLLOUT;
+            fds.push_back({ session.fd, events, 0 });
+        }
+
+        if (::poll(fds.data(), fds.size(), 50) <= 0) {
+            continue;
+        }
+
+        // Sessions accepted below are not in fds yet
+        size_t polled = sessions_.size();
+        if (fds[0].revents & POLLIN) {
+            accept_sessions();
+        }
+
+        for (size_t i = 0; i < polled; ++i) {
+            Session& session = sessions_[i];
+            short revents = fds[i + 1].revents;
+            bool open = true;
+            if (revents & (POLLERR | POLLNVAL)) {
+                open = false;
+            } else if (revents & POLLOUT) {
+                open = write_output(session);
+            } else if (revents & (POLLIN | POLLHUP)) {
+                open = read_requests(session);
+            }
+            if (!open) {
+                protocol_common::TCPTransport::close_socket(session.fd);
+                session.fd = -1;
+            }
+        }
+
+        sessions_.erase(
+            std::remove_if(sessions_.begin(), sessions_.end(),
+                [](const Session& session) { return session.fd < 0; }),
+            sessions_.end());
+    }
+}
+
+void ReplayServer::accept_sessions()
+{
+    while (true) {
+        int fd = accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        if (sessions_.size() >= config_.max_sessions) {
+            protocol_common::TCPTransport::close_socket(fd);
+            continue;
+        }
+        protocol_common::TCPTransport::set_non_blocking(fd);
+        protocol_common::TCPTransport::set_socket_options(fd);
+
+        Session session;
+        session.fd = fd;
+        sessions_.push_back(std::move(session));
+    }
+}
+
+bool ReplayServer::read_requests(Session& session)
+{
+    uint8_t buffer[4096];
+    ssize_t received = recv(session.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (received == 0) {
+        return false;
+    }
+    if (received < 0) {
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    }
+    session.input.insert(session.input.end(), buffer, buffer + received);
+
+    // One response at a time; the rest stay buffered until it is written
+    size_t offset = 0;
+    if (session.input.size() >= ReplayRequest::WIRE_SIZE) {
+        serve(session, ReplayRequest::decode(session.input.data()));
+        offset = ReplayRequest::WIRE_SIZE;
+    }
+    session.input.erase(session.input.begin(), session.input.begin() + offset);
+    return session.output.empty() || write_output(session);
+}
+
+bool ReplayServer::write_output(Session& session)
+{
+    while (session.output_offset < session.output.size()) {
+        ssize_t sent = send(session.fd, session.output.data() + session.output_offset,
+            session.output.size() - session.output_offset, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        session.output_offset += static_cast<size_t>(sent);
+    }
+    session.output.clear();
+    session.output_offset = 0;
+
+    // Serve the next buffered request, if any
+    if (session.input.size() >= ReplayRequest::WIRE_SIZE) {
+        serve(session, ReplayRequest::decode(session.input.data()));
+        session.input.erase(session.input.begin(), session.input.begin() + ReplayRequest::WIRE_SIZE);
+        return write_output(session);
+    }
+    return true;
+}
+
+void ReplayServer::serve(Session& session, const ReplayRequest& request)
+{
+    ReplayResponse response;
+    response.channel_id = request.channel_id;
+    session.output.resize(ReplayResponse::WIRE_SIZE);
+    session.output_offset = 0;
+
+    auto it = channels_.find(request.channel_id);
+    if (it == channels_.end()) {
+        response.status = ReplayResponse::Status::UNKNOWN_CHANNEL;
+    } else if (request.begin_sequence == 0 || request.end_sequence < request.begin_sequence) {
+        response.status = ReplayResponse::Status::INVALID_RANGE;
+    } else {
+        const PacketJournal& journal = *it->second;
+        uint32_t last = journal.last_sequence();
+        uint32_t begin = std::max(request.begin_sequence, journal.first_sequence());
+        uint32_t end = std::min(request.end_sequence, last);
+        if (end >= begin && end - begin >= config_.max_packets_per_request) {
+            end = begin + config_.max_packets_per_request - 1;
+        }
+
+        // Packets overwritten since first_sequence() was read move the
+        // start forward; a miss after the first packet ends the response
+        response.begin_sequence = begin;
+        for (uint32_t sequence = begin; last != 0 && sequence <= end; ++sequence) {
+            size_t prefix = session.output.size();
+            session.output.resize(prefix + 2);
+            if (!journal.read(sequence, session.output)) {
+                session.output.resize(prefix);
+                if (response.count > 0) {
+                    break;
+                }
+                response.begin_sequence = sequence + 1;
+                continue;
+            }
+            put_u16(session.output.data() + prefix, static_cast<uint16_t>(session.output.size() - prefix - 2));
+            ++response.count;
+        }
+
+        bool complete = response.count > 0 && response.begin_sequence == request.begin_sequence
+            && response.begin_sequence + response.count - 1 == request.end_sequence;
+        response.status = complete ? ReplayResponse::Status::OK : ReplayResponse::Status::PARTIAL;
+        if (response.count == 0) {
+            response.begin_sequence = 0;
+        }
+        packets_replayed_.fetch_add(response.count, std::memory_order_relaxed);
+    }
+
+    response.encode(session.output.data());
+    requests_served_.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace market_protocols
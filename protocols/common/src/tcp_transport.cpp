@@ -71,11 +71,16 @@ void TCPTransport::close_socket(int socket_fd)
 std::vector<uint8_t> TCPTransport::receive_data(int socket_fd, size_t max_size)
 {
     std::vector<uint8_t> buffer(max_size);
+    buffer.resize(receive_into(socket_fd, buffer.data(), max_size));
+    return buffer;
+}
 
-    ssize_t bytes_received = recv(socket_fd, buffer.data(), max_size, MSG_DONTWAIT);
+size_t TCPTransport::receive_into(int socket_fd, uint8_t* buffer, size_t size)
+{
+    ssize_t bytes_received = recv(socket_fd, buffer, size, MSG_DONTWAIT);
     if (bytes_received < 0) {
         if (errno == EAGAIN || errno == EWOULDBLOCK) {
-            return {}; // No data available (non-blocking)
+            return 0; // No data available (non-blocking)
         }
         throw std::runtime_error("Failed to receive data: " + std::string(strerror(errno)));
     }
@@ -84,8 +89,7 @@ std::vector<uint8_t> TCPTransport::receive_data(int socket_fd, size_t max_size)
         throw std::runtime_error("Connection closed by peer");
     }
 
-    buffer.resize(bytes_received);
-    return buffer;
+    return static_cast<size_t>(bytes_received);
 }
 
 bool TCPTransport::send_data(int socket_fd, const std::vector<uint8_t>& data)
@@ -0,0 +1,135 @@
+#include "../include/udp_batch_sender.h"
+#include <cerrno>
+#include <cstring>
+#include <netinet/udp.h>
+#include <sys/uio.h>
+
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103 // Linux 4.18+, missing from older libc headers
+#endif
+
+namespace market_protocols {
+
+static constexpr size_t CONTROL_SPACE = CMSG_SPACE(sizeof(uint16_t));
+
+UDPBatchSender::UDPBatchSender()
+    : messages_(MAX_MESSAGES)
+    , iovecs_(MAX_MESSAGES * MAX_GSO_SEGMENTS)
+    , packets_per_message_(MAX_MESSAGES)
+    , control_(MAX_MESSAGES * CONTROL_SPACE)
+{
+    memset(&destination_, 0, sizeof(destination_));
+}
+
+void UDPBatchSender::attach(int socket_fd, const struct sockaddr_in& destination)
+{
+    socket_fd_ = socket_fd;
+    destination_ = destination;
+    gso_ = false;
+}
+
+bool UDPBatchSender::set_gso_enabled(bool enabled)
+{
+    gso_ = false;
+    if (!enabled || socket_fd_ < 0) {
+        return false;
+    }
+
+    // A zero segment size leaves the socket's sends unchanged; kernels
+    // without UDP GSO reject the option outright
+    int segment_size = 0;
+    gso_ = setsockopt(socket_fd_, SOL_UDP, UDP_SEGMENT, &segment_size, sizeof(segment_size)) == 0;
+    return gso_;
+}
+
+size_t UDPBatchSender::gso_run(const PacketRef* packets, size_t count) const
+{
+    size_t segment = packets[0].length;
+    size_t bytes = segment;
+    size_t run = 1;
+    while (run < count && run < MAX_GSO_SEGMENTS) {
+        size_t length = packets[run].length;
+        if (length > segment || length == 0 || bytes + length > MAX_GSO_BYTES) {
+            break;
+        }
+        bytes += length;
+        ++run;
+        if (length < segment) {
+            break; // Only the last segment may be short
+        }
+    }
+    return run;
+}
+
+size_t UDPBatchSender::send(const PacketRef* packets, size_t count)
+{
+    if (socket_fd_ < 0) {
+        return 0;
+    }
+
+    size_t sent = 0;
+    while (sent < count) {
+        // Fill headers from the next unsent packet
+        size_t message_count = 0;
+        size_t iovec_count = 0;
+        size_t next = sent;
+        while (next < count && message_count < MAX_MESSAGES) {
+            size_t run = gso_ ? gso_run(packets + next, count - next) : 1;
+
+            struct msghdr& header = messages_[message_count].msg_hdr;
+            memset(&header, 0, sizeof(header));
+            header.msg_name = &destination_;
+            header.msg_namelen = sizeof(destination_);
+            header.msg_iov = &iovecs_[iovec_count];
+            header.msg_iovlen = run;
+            for (size_t i = 0; i < run; ++i) {
+                iovecs_[iovec_count].iov_base = const_cast<uint8_t*>(packets[next + i].data);
+                iovecs_[iovec_count].iov_len = packets[next + i].length;
+                ++iovec_count;
+            }
+
+            if (run > 1) {
+                header.msg_control = &control_[message_count * CONTROL_SPACE];
+                header.msg_controllen = CONTROL_SPACE;
+                struct cmsghdr* control = CMSG_FIRSTHDR(&header);
+                control->cmsg_level = SOL_UDP;
+                control->cmsg_type = UDP_SEGMENT;
+                control->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                uint16_t segment = static_cast<uint16_t>(packets[next].length);
+                memcpy(CMSG_DATA(control), &segment, sizeof(segment));
+            }
+
+            packets_per_message_[message_count] = run;
+            ++message_count;
+            next += run;
+        }
+
+        int result;
+        do {
+            result = sendmmsg(socket_fd_, messages_.data(), static_cast<unsigned int>(message_count), 0);
+        } while (result < 0 && errno == EINTR);
+        ++syscalls_;
+
+        if (result <= 0) {
+            // Devices that cannot segment reject GSO sends; retry the
+            // same packets one datagram per header
+            if (result < 0 && gso_ && (errno == EIO || errno == EINVAL)) {
+                gso_ = false;
+                continue;
+            }
+            ++send_errors_;
+            break;
+        }
+
+        for (int i = 0; i < result; ++i) {
+            sent += packets_per_message_[i];
+            datagrams_sent_ += packets_per_message_[i];
+        }
+    }
+    return sent;
+}
+
+} // namespace market_protocols
@@ -58,6 +58,8 @@ bool UDPTransport::create_multicast_sender(const std::string& multicast_ip,
     // Set default TTL for multicast
     set_ttl(1); // Local network only by default
 
+    batch_.attach(socket_fd_, send_addr_);
+    batch_.set_gso_enabled(true);
     return true;
 }
 
@@ -135,6 +137,29 @@ bool UDPTransport::send(const uint8_t* data, size_t length)
     return true;
 }
 
+size_t UDPTransport::send_packets(const market_protocols::PacketRef* packets, size_t count)
+{
+    if (socket_fd_ < 0 || !is_sender_) {
+        last_error_ = "Socket not configured for sending";
+        return 0;
+    }
+
+    size_t sent = batch_.send(packets, count);
+    if (sent < count) {
+        last_error_ = "Batch send failed after " + std::to_string(sent) + " of " + std::to_string(count) + " packets: " + std::string(strerror(errno));
+    }
+    return sent;
+}
+
+bool UDPTransport::send_batch(const std::vector<std::vector<uint8_t>>& messages)
+{
+    batch_refs_.clear();
+    for (const auto& message : messages) {
+        batch_refs_.push_back({ message.data(), message.size() });
+    }
+    return send_packets(batch_refs_.data(), batch_refs_.size()) == messages.size();
+}
+
 std::vector<uint8_t> UDPTransport::receive(size_t max_size)
 {
     if (socket_fd_ < 0 || is_sender_) {
@@ -205,6 +230,7 @@ void UDPTransport::close()
         ::close(socket_fd_);
         socket_fd_ = -1;
     }
+    batch_.detach();
 }
 
 bool UDPTransport::join_multicast_group()
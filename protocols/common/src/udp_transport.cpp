@@ -63,10 +63,17 @@ bool UDPTransport::setup_socket()
         setsockopt(socket_fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
     }
 
+    batch_.attach(socket_fd_, dest_addr_);
+    batch_.set_gso_enabled(true);
     return true;
 }
 
 bool UDPTransport::send_message(const std::vector<uint8_t>& data)
+{
+    return send_packet(data.data(), data.size());
+}
+
+bool UDPTransport::send_packet(const uint8_t* data, size_t length)
 {
     if (socket_fd_ < 0) {
         if (!initialize()) {
@@ -74,10 +81,30 @@ bool UDPTransport::send_message(const std::vector<uint8_t>& data)
         }
     }
 
-    ssize_t sent = sendto(socket_fd_, data.data(), data.size(), 0,
+    ssize_t sent = sendto(socket_fd_, data, length, 0,
         (struct sockaddr*)&dest_addr_, sizeof(dest_addr_));
 
-    return sent == static_cast<ssize_t>(data.size());
+    return sent == static_cast<ssize_t>(length);
+}
+
+size_t UDPTransport::send_packets(const PacketRef* packets, size_t count)
+{
+    if (socket_fd_ < 0) {
+        if (!initialize()) {
+            return 0;
+        }
+    }
+
+    return batch_.send(packets, count);
+}
+
+bool UDPTransport::send_batch(const std::vector<std::vector<uint8_t>>& messages)
+{
+    batch_refs_.clear();
+    for (const auto& message : messages) {
+        batch_refs_.push_back({ message.data(), message.size() });
+    }
+    return send_packets(batch_refs_.data(), batch_refs_.size()) == messages.size();
 }
 
 void UDPTransport::close()
@@ -86,6 +113,7 @@ void UDPTransport::close()
         ::close(socket_fd_);
         socket_fd_ = -1;
     }
+    batch_.detach();
 }
 
 bool UDPTransport::join_multicast_group(const std::string& group_ip)
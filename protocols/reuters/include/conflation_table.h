@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../../core/include/market_events.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace reuters_protocol {
+
+// Latest quote per key between conflation flushes.
+//
+// Quotes sit in a flat table with a slot per book level (or per
+// instrument side) ever seen; an update overwrites its slot and marks it
+// dirty. A flush visits only the dirty slots, in the order they first
+// changed, so its cost follows what changed rather than the book size.
+class ConflationTable {
+public:
+    enum class Granularity {
+        LEVEL, // Instrument, side and price level
+        INSTRUMENT // Instrument and side: latest quote only
+    };
+
+    explicit ConflationTable(Granularity granularity = Granularity::LEVEL);
+
+    // True if the quote replaced one not yet flushed. A DELETE of a level
+    // whose ADD is still pending cancels both; an ADD of a level whose
+    // DELETE is still pending is sent after it.
+    bool update(const market_core::QuoteEvent& quote);
+
+    // Forget the instrument's pending updates (a snapshot supersedes
+    // them); returns how many were dropped
+    size_t discard(uint32_t instrument_id);
+
+    // Calls func(const QuoteEvent&) for each dirty slot (its held DELETE
+    // first) and clears them. References stay valid until the next update().
+    template <typename Func>
+    void flush(Func&& func)
+    {
+        for (uint32_t index : dirty_) {
+            Slot& slot = slots_[index];
+            slot.dirty = false;
+            if (slot.deleted) {
+                func(static_cast<const market_core::QuoteEvent&>(*slot.deleted));
+            }
+            func(static_cast<const market_core::QuoteEvent&>(slot.quote));
+        }
+        dirty_.clear();
+    }
+
+    size_t pending() const { return dirty_.size(); }
+    size_t size() const { return slots_.size(); }
+    uint64_t conflated() const { return conflated_; }
+
+private:
+    struct Slot {
+        market_core::QuoteEvent quote;
+        std::optional<market_core::QuoteEvent> deleted; // Sent before quote
+        bool dirty;
+    };
+
+    Granularity granularity_;
+    std::vector<Slot> slots_;
+    std::unordered_map<uint64_t, uint32_t> index_; // Key -> slot
+    std::vector<uint32_t> dirty_; // Slots changed since the last flush
+    uint64_t conflated_ = 0;
+
+    uint64_t key_for(const market_core::QuoteEvent& quote) const;
+};
+
+} // namespace reuters_protocol
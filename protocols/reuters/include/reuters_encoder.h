@@ -44,6 +44,10 @@ public:
 
     static std::vector<uint8_t> encode_heartbeat();
 
+    // SecurityStatus telling a slow client that dropped_messages updates
+    // never reached it; applSeqNo carries the count
+    static std::vector<uint8_t> encode_gap_notification(uint64_t dropped_messages);
+
     // Market Data Messages
     static std::vector<uint8_t> encode_security_definition(
         const market_core::Instrument& instrument);
@@ -57,6 +61,13 @@ public:
     static std::vector<uint8_t> encode_market_data_incremental(
         const market_core::TradeEvent& trade);
 
+    // One MarketDataIncrementalRefresh with an entry per quote
+    static std::vector<uint8_t> encode_market_data_incremental(
+        const std::vector<const market_core::QuoteEvent*>& quotes);
+
+    // Closes the updates of conflation interval conflation_id
+    static std::vector<uint8_t> encode_end_of_conflation(uint64_t conflation_id);
+
     // Market Data Request Response
     static std::vector<uint8_t> encode_market_data_request_rejection(
         const std::string& md_req_id,
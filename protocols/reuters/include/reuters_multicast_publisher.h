@@ -2,6 +2,7 @@
 
 #include "../../common/include/udp_multicast_transport.h"
 #include "../../core/include/market_events.h"
+#include "conflation_table.h"
 #include "reuters_encoder.h"
 #include <atomic>
 #include <chrono>
@@ -44,6 +45,7 @@ struct ReutersMulticastConfig {
     uint32_t snapshot_interval_seconds = 60;
     uint32_t heartbeat_interval_seconds = 30;
     uint32_t conflation_interval_ms = 0; // 0 = no conflation
+    bool conflate_by_level = true; // false: latest quote per instrument side
 
     // Book parameters
     uint32_t book_depth = 10;
@@ -66,6 +68,12 @@ public:
     void publish_security_definition(const market_core::Instrument& instrument);
     void publish_statistics(const market_core::StatisticsEvent& stats);
 
+    // With a conflation interval, quotes are held and sent once per
+    // interval as batched incrementals followed by EndOfConflation.
+    // poll() flushes when the interval is due; call it from the loop.
+    void poll();
+    void flush_conflation();
+
     // Heartbeat and sequence management
     void send_heartbeat();
     void send_end_of_conflation();
@@ -84,6 +92,8 @@ public:
         uint64_t definitions_sent = 0;
         uint64_t heartbeats_sent = 0;
         uint64_t bytes_sent = 0;
+        uint64_t quotes_conflated = 0; // Superseded before being sent
+        uint64_t conflation_intervals = 0; // Flushes that sent updates
         std::chrono::steady_clock::time_point start_time;
     };
 
@@ -115,12 +125,23 @@ private:
     // Timing
     std::chrono::steady_clock::time_point last_heartbeat_;
     std::chrono::steady_clock::time_point last_snapshot_;
+    std::chrono::steady_clock::time_point next_conflation_;
+
+    // Quotes waiting for the next conflation flush
+    ConflationTable conflation_;
+    uint64_t conflation_id_;
+    std::unordered_map<int, std::vector<const market_core::QuoteEvent*>> conflation_batches_;
+
+    // Entries per conflated incremental; keeps a packet within 1400 bytes
+    static constexpr size_t MAX_CONFLATED_ENTRIES = 13;
 
     // Internal methods
     bool create_multicast_socket(const MulticastChannelConfig& config,
         std::unique_ptr<protocol_common::UDPTransport>& transport);
     void send_to_both_feeds(const std::vector<uint8_t>& message, int channel_id);
     void send_to_channel_feeds(const std::vector<uint8_t>& message, int channel_id);
+    void send_incremental(const std::vector<uint8_t>& message, int channel_id);
+    void send_end_of_conflation(int channel_id);
     std::vector<uint8_t> add_sequence_header(const std::vector<uint8_t>& message,
         uint64_t sequence, int channel_id);
 };
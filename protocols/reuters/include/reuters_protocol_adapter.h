@@ -2,14 +2,21 @@
 
 #include "../../core/include/market_data_generator.h"
 #include "../../core/include/market_events.h"
+#include "../../protocols/common/include/io_uring_transport.h"
 #include "../../protocols/common/include/tcp_transport.h"
 #include "lseg_sbe/Establish.h"
 #include "lseg_sbe/MessageHeader.h"
 #include "lseg_sbe/Negotiate.h"
 #include "reuters_encoder.h"
 #include "reuters_multicast_publisher.h"
+#include "session_output_queue.h"
+#include "sofh_frame_buffer.h"
+#include "subscription_index.h"
+#include <functional>
 #include <memory>
+#include <queue>
 #include <string>
+#include <sys/epoll.h>
 #include <unordered_map>
 #include <vector>
 
@@ -34,8 +41,17 @@ struct ClientSession {
     int socket_fd;
     std::string username;
 
-    // Market data subscriptions
-    std::vector<std::string> subscribed_instruments;
+    // Event loop bookkeeping
+    uint32_t serial; // Tells a reused descriptor from the one it replaced
+    std::chrono::steady_clock::time_point last_heartbeat;
+    std::chrono::steady_clock::time_point timer_deadline; // Latest scheduled check
+    SOFHFrameBuffer receive_buffer; // Bytes of a frame still arriving
+    SessionOutputQueue output; // Bytes the client has not taken yet
+    bool write_armed; // EPOLLOUT requested while output is queued
+    bool closing; // Closed at the end of the current loop iteration
+
+    // Market data subscriptions (instruments are held in the adapter's
+    // SubscriptionIndex)
     bool snapshot_requested;
     bool incremental_requested;
 
@@ -44,6 +60,9 @@ struct ClientSession {
         , flow_type(FlowType::UNSEQUENCED)
         , keepalive_interval(30000)
         , socket_fd(-1)
+        , serial(0)
+        , write_armed(false)
+        , closing(false)
         , snapshot_requested(false)
         , incremental_requested(false)
     {
@@ -62,19 +81,55 @@ public:
     // Single-threaded server operations
     bool initialize();
     bool initialize_with_multicast(); // Initialize with multicast support
-    void run_once(); // Process one iteration of server loop
+    // Process one iteration of the server loop, waiting up to timeout_ms
+    // for socket events. Cost follows ready sockets and due timers, not
+    // the number of sessions.
+    void run_once(int timeout_ms = 0);
     void shutdown();
 
+    // Inactivity before a session is dropped (default 60s)
+    void set_session_timeout(std::chrono::milliseconds timeout) { session_timeout_ = timeout; }
+    size_t session_count() const { return sessions_.size(); }
+    // Sessions receiving events for the instrument
+    size_t subscriber_count(uint32_t instrument_id) const { return subscriptions_.subscriber_count(instrument_id); }
+
+    // Send session traffic through an io_uring ring instead of blocking
+    // send() calls; false (sends stay synchronous) if the kernel refuses.
+    // The output limit and policy still apply per session, to the bytes
+    // the ring holds for it; frames there cannot be conflated.
+    bool enable_io_uring();
+    bool io_uring_enabled() const { return writer_ != nullptr; }
+
+    // Output limit and slow-consumer policy for sessions accepted later
+    void set_output_config(const SessionOutputQueue::Config& config) { output_config_ = config; }
+
+    // Per-session output backlog
+    struct SessionQueueStats {
+        int socket_fd;
+        std::string session_id;
+        size_t depth; // Frames queued
+        size_t queued_bytes;
+        size_t max_queued_bytes;
+        uint64_t drops;
+        uint64_t conflations;
+    };
+    std::vector<SessionQueueStats> get_session_queue_stats() const;
+
     // Statistics
     struct Statistics {
         size_t sessions_created;
         size_t messages_sent;
         size_t messages_received;
         size_t market_events_processed;
+        size_t messages_conflated; // Replaced in a slow client's queue
+        size_t messages_dropped; // Discarded for a slow client
+        size_t slow_consumer_disconnects;
         std::chrono::steady_clock::time_point start_time;
     };
 
     const Statistics& get_statistics() const { return stats_; }
+    // Null unless initialised with multicast
+    const ReutersMulticastPublisher* multicast_publisher() const { return multicast_publisher_.get(); }
 
 private:
     uint16_t port_;
@@ -86,24 +141,58 @@ private:
     std::unique_ptr<ReutersMulticastPublisher> multicast_publisher_;
 
     std::unordered_map<int, std::unique_ptr<ClientSession>> sessions_;
+    SubscriptionIndex subscriptions_;
+    std::unique_ptr<market_protocols::IoUringStreamWriter> writer_;
+    SessionOutputQueue::Config output_config_;
+    std::vector<int> pending_close_;
+
+    // Edge-triggered epoll over the listener and every session socket
+    int epoll_fd_;
+    std::vector<epoll_event> events_;
+    uint32_t next_serial_;
+
+    // Next keepalive/timeout check per session, soonest first. Entries
+    // are not removed when a session reschedules or closes; a popped
+    // entry that no longer matches its session is skipped.
+    struct SessionTimer {
+        std::chrono::steady_clock::time_point deadline;
+        int socket_fd;
+        uint32_t serial;
+        bool operator>(const SessionTimer& other) const { return deadline > other.deadline; }
+    };
+    std::priority_queue<SessionTimer, std::vector<SessionTimer>, std::greater<SessionTimer>> timers_;
+    std::chrono::milliseconds session_timeout_;
 
     // Core server operations
     void accept_new_connections();
-    void process_client_messages();
-    void send_heartbeats();
-    void cleanup_inactive_sessions();
+    void process_client_messages(int timeout_ms);
+    void read_session(ClientSession& session);
+    void run_timers();
+    void schedule_timer(ClientSession& session);
+    void close_session(int socket_fd);
+    void schedule_close(ClientSession& session);
+    void close_pending_sessions();
+    void flush_session(ClientSession& session);
+    void set_write_interest(ClientSession& session, bool armed);
 
     // Message handling
-    void handle_client_message(ClientSession& session, const std::vector<uint8_t>& data);
-    void handle_negotiate(ClientSession& session, const std::vector<uint8_t>& payload);
-    void handle_establish(ClientSession& session, const std::vector<uint8_t>& payload);
-    void handle_market_data_request(ClientSession& session, const std::vector<uint8_t>& payload);
-    void handle_security_definition_request(ClientSession& session, const std::vector<uint8_t>& payload);
+    // Frames and payloads are views into the session's receive buffer
+    void handle_client_message(ClientSession& session, const uint8_t* frame, size_t length);
+    void handle_negotiate(ClientSession& session, const uint8_t* payload, size_t size);
+    void handle_establish(ClientSession& session, const uint8_t* payload, size_t size);
+    void handle_market_data_request(ClientSession& session, const uint8_t* payload, size_t size);
+    void handle_security_definition_request(ClientSession& session, const uint8_t* payload, size_t size);
 
     // Market data distribution
-    void send_to_session(ClientSession& session, const std::vector<uint8_t>& message);
+    // Frames with the same non-zero conflation key may replace each
+    // other in a slow client's queue
+    void send_to_session(ClientSession& session, const std::vector<uint8_t>& message,
+        uint64_t conflation_key = 0);
+    void queue_to_session(ClientSession& session, const std::vector<uint8_t>& message, uint64_t conflation_key);
+    void write_to_ring(ClientSession& session, const std::vector<uint8_t>& message);
+    SessionOutputQueue::Config session_output_config() const;
     void broadcast_to_subscribed_sessions(const std::vector<uint8_t>& message,
-        const std::string& instrument_id = "");
+        uint32_t instrument_id, uint64_t conflation_key = 0);
 
     // Session management
     std::string generate_session_id();
@@ -120,7 +209,9 @@ private:
 
     static constexpr size_t MAX_BUFFER_SIZE = 8192;
     static constexpr uint32_t DEFAULT_KEEPALIVE_MS = 30000;
+    static constexpr uint32_t MIN_KEEPALIVE_MS = 100;
     static constexpr uint32_t SESSION_TIMEOUT_MS = 60000;
+    static constexpr size_t MAX_RING_SHARE = 4; // A session holds at most 1/4 of the io_uring slots
 };
 
 } // namespace reuters_protocol
\ No newline at end of file
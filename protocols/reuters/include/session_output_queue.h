@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace reuters_protocol {
+
+// What a session's output queue does when a slow client lets it fill
+enum class SlowConsumerPolicy {
+    CONFLATE, // Replace a queued update for the same key; drop if none
+    DROP, // Drop new frames, then send a gap notice once drained
+    DISCONNECT // Close the session
+};
+
+// Bounded per-session output for a non-blocking socket.
+//
+// send() writes straight to the socket while nothing is queued; whatever
+// the kernel does not take is queued and written later by flush() (on
+// EPOLLOUT) with gathered sends, so a slow client never blocks the
+// thread fanning out market data. Past max_bytes the policy decides.
+class SessionOutputQueue {
+public:
+    struct Config {
+        size_t max_bytes = 1024 * 1024; // Unsent bytes held per session
+        SlowConsumerPolicy policy = SlowConsumerPolicy::CONFLATE;
+    };
+
+    enum class Result {
+        SENT, // Written to the socket
+        QUEUED, // Waiting for writability
+        CONFLATED, // Replaced a queued frame with the same key
+        DROPPED, // Discarded under the DROP or CONFLATE policy
+        DISCONNECT, // Queue full under DISCONNECT, or the socket failed
+    };
+
+    SessionOutputQueue();
+    explicit SessionOutputQueue(const Config& config);
+
+    void configure(const Config& config) { config_ = config; }
+
+    // Under CONFLATE, a frame that would take the queue past max_bytes
+    // replaces a queued one with the same non-zero key (latest state
+    // wins). The replacement goes to the tail, so it never overtakes
+    // frames queued before it. Below the limit every frame is kept.
+    Result send(int fd, const uint8_t* data, size_t length, uint64_t conflation_key = 0);
+
+    // Write queued frames; false if the socket failed
+    bool flush(int fd);
+
+    // For a transport that keeps its own backlog (e.g. an io_uring
+    // writer): the limit and policy for a frame joining backlog unsent
+    // bytes. SENT means pass it on; nothing is kept here, so nothing can
+    // be conflated and CONFLATE drops like DROP.
+    Result admit(size_t backlog, size_t length);
+    // The transport refused a frame admit() passed: a drop (or disconnect)
+    Result refuse() { return overflow(); }
+
+    bool empty() const { return frames_.empty(); }
+    size_t depth() const { return frames_.size() - replaced_; }
+    size_t queued_bytes() const { return queued_bytes_; }
+
+    // Frames dropped since the last gap notice, once the queue (or the
+    // transport's backlog) has drained below half its limit; resets the
+    // count. 0 otherwise.
+    uint64_t take_gap() { return take_gap(queued_bytes_); }
+    uint64_t take_gap(size_t backlog);
+    bool gap_pending() const { return gap_ > 0; }
+
+    // Statistics
+    size_t max_queued_bytes() const { return max_queued_bytes_; }
+    uint64_t drops() const { return drops_; }
+    uint64_t conflations() const { return conflations_; }
+
+private:
+    // A replaced frame stays in place with no bytes until it reaches the
+    // front or the queue is compacted
+    struct Frame {
+        std::vector<uint8_t> bytes;
+        uint64_t key = 0;
+    };
+
+    static constexpr size_t MAX_IOVECS = 64;
+    static constexpr size_t MAX_SPARE = 64;
+
+    Config config_;
+    std::deque<Frame> frames_;
+    size_t front_offset_ = 0; // Bytes of the front frame already sent
+    size_t queued_bytes_ = 0;
+    uint64_t front_index_ = 0; // Position of frames_.front() in the stream
+    std::unordered_map<uint64_t, uint64_t> keyed_; // Key -> stream position
+    std::vector<std::vector<uint8_t>> spare_; // Recycled frame storage
+    size_t replaced_ = 0; // Emptied frames still in frames_
+
+    uint64_t gap_ = 0;
+    size_t max_queued_bytes_ = 0;
+    uint64_t drops_ = 0;
+    uint64_t conflations_ = 0;
+
+    bool conflate(const uint8_t* data, size_t length, uint64_t key);
+    void enqueue(const uint8_t* data, size_t length, uint64_t key);
+    void pop_front();
+    void compact();
+    Result overflow();
+};
+
+} // namespace reuters_protocol
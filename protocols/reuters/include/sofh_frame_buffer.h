@@ -0,0 +1,76 @@
+#pragma once
+
+#include "reuters_messages.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace reuters_protocol {
+
+// Per-session receive buffer that turns a TCP byte stream into SOFH
+// frames. Reads land directly in free space at the end; extract() hands
+// each complete frame to the handler in place, then moves any partial
+// tail to the front. The buffer only grows for a frame larger than its
+// capacity, so steady-state receives do not allocate.
+class SOFHFrameBuffer {
+public:
+    explicit SOFHFrameBuffer(size_t capacity = 8192, size_t max_frame = 65536)
+        : data_(capacity)
+        , max_frame_(max_frame)
+    {
+    }
+
+    // Free space for the next read, and how many bytes it received
+    uint8_t* write_data() { return data_.data() + length_; }
+    size_t write_space() const { return data_.size() - length_; }
+    void commit(size_t bytes) { length_ += bytes; }
+
+    size_t buffered() const { return length_; }
+
+    // Call handler(const uint8_t* frame, size_t length) for each complete
+    // frame, SOFH included. Views are valid only during the call. False
+    // if a frame declares an impossible length; the stream cannot be
+    // resynchronised then and the connection should be dropped.
+    template <typename Handler>
+    bool extract(Handler&& handler)
+    {
+        size_t offset = 0;
+        bool valid = true;
+        while (length_ - offset >= SOFHeader::size()) {
+            size_t frame_length = frame_length_at(offset);
+            if (frame_length < SOFHeader::size() || frame_length > max_frame_) {
+                valid = false;
+                break;
+            }
+            if (length_ - offset < frame_length) {
+                // Make room for the rest of an oversized frame
+                if (frame_length > data_.size()) {
+                    data_.resize(frame_length);
+                }
+                break;
+            }
+            handler(data_.data() + offset, frame_length);
+            offset += frame_length;
+        }
+
+        if (offset > 0) {
+            memmove(data_.data(), data_.data() + offset, length_ - offset);
+            length_ -= offset;
+        }
+        return valid;
+    }
+
+private:
+    std::vector<uint8_t> data_;
+    size_t length_ = 0;
+    size_t max_frame_;
+
+    size_t frame_length_at(size_t offset) const
+    {
+        uint32_t net_length;
+        memcpy(&net_length, data_.data() + offset, sizeof(net_length));
+        return ntohl(net_length);
+    }
+};
+
+} // namespace reuters_protocol
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace reuters_protocol {
+
+struct ClientSession;
+
+// Instrument -> subscribed sessions, kept up to date as requests arrive
+// so fanning out an event touches only the sessions that want it.
+//
+// Sessions subscribed to every instrument sit on their own list and are
+// never also listed under a single instrument, so each is visited once.
+class SubscriptionIndex {
+public:
+    // False if the session already receives the instrument
+    bool subscribe(ClientSession* session, uint32_t instrument_id);
+    bool unsubscribe(ClientSession* session, uint32_t instrument_id);
+
+    // Replaces any single-instrument subscriptions
+    void subscribe_all(ClientSession* session);
+
+    // Drop every subscription the session holds
+    void remove(ClientSession* session);
+
+    // Calls func(ClientSession&) for each session receiving the instrument
+    template <typename Func>
+    void for_each_subscriber(uint32_t instrument_id, Func&& func) const
+    {
+        for (ClientSession* session : all_) {
+            func(*session);
+        }
+        auto it = by_instrument_.find(instrument_id);
+        if (it != by_instrument_.end()) {
+            for (ClientSession* session : it->second) {
+                func(*session);
+            }
+        }
+    }
+
+    size_t subscriber_count(uint32_t instrument_id) const;
+    bool is_subscribed(const ClientSession* session, uint32_t instrument_id) const;
+    size_t session_count() const { return by_session_.size(); }
+    bool empty() const { return by_session_.empty(); }
+
+private:
+    struct SessionSubscriptions {
+        bool all = false;
+        std::vector<uint32_t> instruments;
+    };
+
+    std::vector<ClientSession*> all_;
+    std::unordered_map<uint32_t, std::vector<ClientSession*>> by_instrument_;
+    std::unordered_map<const ClientSession*, SessionSubscriptions> by_session_;
+
+    void unlist(ClientSession* session, uint32_t instrument_id);
+};
+
+} // namespace reuters_protocol
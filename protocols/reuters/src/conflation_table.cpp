@@ -0,0 +1,85 @@
+#include "../include/conflation_table.h"
+#include <algorithm>
+
+namespace reuters_protocol {
+
+ConflationTable::ConflationTable(Granularity granularity)
+    : granularity_(granularity)
+{
+}
+
+bool ConflationTable::update(const market_core::QuoteEvent& quote)
+{
+    uint64_t key = key_for(quote);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        uint32_t slot = static_cast<uint32_t>(slots_.size());
+        slots_.push_back({ quote, std::nullopt, true });
+        index_.emplace(key, slot);
+        dirty_.push_back(slot);
+        return false;
+    }
+
+    Slot& slot = slots_[it->second];
+    if (!slot.dirty) {
+        slot.quote = quote;
+        slot.deleted.reset();
+        slot.dirty = true;
+        dirty_.push_back(it->second);
+        return false;
+    }
+
+    bool same_level = slot.quote.price_level == quote.price_level;
+
+    // Consumers still hold the level the pending DELETE removes; an ADD
+    // in its place goes out after it, not instead of it
+    if (same_level && !slot.deleted && slot.quote.action == market_core::UpdateAction::DELETE
+        && quote.action == market_core::UpdateAction::ADD) {
+        slot.deleted = slot.quote;
+        slot.quote = quote;
+        return false;
+    }
+
+    // Consumers never saw the pending ADD: a change to it is still an ADD,
+    // and a delete leaves nothing to send but a DELETE held ahead of it
+    bool unseen_add = same_level && slot.quote.action == market_core::UpdateAction::ADD;
+    slot.quote = quote;
+    ++conflated_;
+    if (unseen_add && quote.action == market_core::UpdateAction::DELETE) {
+        if (slot.deleted) {
+            slot.quote = *slot.deleted;
+            slot.deleted.reset();
+        } else {
+            slot.dirty = false;
+            dirty_.erase(std::find(dirty_.begin(), dirty_.end(), it->second));
+        }
+    } else if (unseen_add && quote.action == market_core::UpdateAction::CHANGE) {
+        slot.quote.action = market_core::UpdateAction::ADD;
+    }
+    return true;
+}
+
+size_t ConflationTable::discard(uint32_t instrument_id)
+{
+    auto first = std::stable_partition(dirty_.begin(), dirty_.end(), [&](uint32_t slot) {
+        return slots_[slot].quote.instrument_id != instrument_id;
+    });
+    size_t discarded = static_cast<size_t>(dirty_.end() - first);
+    for (auto it = first; it != dirty_.end(); ++it) {
+        slots_[*it].dirty = false;
+    }
+    dirty_.erase(first, dirty_.end());
+    return discarded;
+}
+
+uint64_t ConflationTable::key_for(const market_core::QuoteEvent& quote) const
+{
+    uint64_t key = (static_cast<uint64_t>(quote.instrument_id) << 32)
+        | (static_cast<uint64_t>(quote.side) << 24);
+    if (granularity_ == Granularity::LEVEL) {
+        key |= quote.price_level.value_or(1);
+    }
+    return key;
+}
+
+} // namespace reuters_protocol
@@ -1,4 +1,5 @@
 #include "../include/reuters_encoder.h"
+#include "../include/lseg_sbe/EndOfConflation.h"
 #include "../include/lseg_sbe/Establish.h"
 #include "../include/lseg_sbe/Heartbeat.h"
 #include "../include/lseg_sbe/MarketDataIncrementalRefresh.h"
@@ -7,6 +8,7 @@
 #include "../include/lseg_sbe/MessageHeader.h"
 #include "../include/lseg_sbe/Negotiate.h"
 #include "../include/lseg_sbe/SecurityDefinition.h"
+#include "../include/lseg_sbe/SecurityStatus.h"
 #include "../include/lseg_sbe/SessionReject.h"
 #include "../include/lseg_sbe/Terminate.h"
 #include <algorithm>
@@ -16,6 +18,10 @@
 
 namespace reuters_protocol {
 
+// Fixed 8-byte fields; the setters copy all 8 bytes
+static constexpr char APPL_ID[8] = "FXMD01";
+static constexpr char SECURITY_TYPE_FX[8] = "FOR"; // FX Forward/Spot
+
 std::vector<uint8_t> ReutersEncoder::encode_negotiate_response(
     const std::string& session_id,
     FlowType flow_type,
@@ -252,6 +258,34 @@ std::vector<uint8_t> ReutersEncoder::encode_heartbeat()
     return buffer;
 }
 
+std::vector<uint8_t> ReutersEncoder::encode_gap_notification(uint64_t dropped_messages)
+{
+    std::vector<uint8_t> buffer(MAX_MESSAGE_SIZE);
+    size_t message_offset = SOFHeader::size();
+
+    lseg_sbe::SecurityStatus status;
+    status.wrapForEncode(
+        reinterpret_cast<char*>(buffer.data()),
+        message_offset,
+        buffer.size() - message_offset);
+
+    status.putApplID(APPL_ID)
+        .applSeqNo(dropped_messages)
+        .mDSecurityTradingStatus(lseg_sbe::SecurityTradingStatusEnum::Value::Pause)
+        .mDHaltReason(lseg_sbe::HaltReasonEnum::Value::Fast_Market);
+
+    size_t sbe_encoded_length = status.encodedLength();
+
+    SOFHeader sofh;
+    sofh.message_length = static_cast<uint32_t>(SOFHeader::size() + sbe_encoded_length);
+    sofh.encoding_type = BIG_ENDIAN_ENCODING;
+    sofh.decryption_id = 0;
+    sofh.pack(buffer.data());
+
+    buffer.resize(sofh.message_length);
+    return buffer;
+}
+
 std::vector<uint8_t> ReutersEncoder::encode_security_definition(
     const market_core::Instrument& instrument)
 {
@@ -265,13 +299,13 @@ std::vector<uint8_t> ReutersEncoder::encode_security_definition(
         buffer.size() - message_offset);
 
     // Map our core Instrument to LSEG SecurityDefinition
-    secDef.putApplID("FXMD01") // Application ID
+    secDef.putApplID(APPL_ID) // Application ID
         .securityStatus(lseg_sbe::SecurityStatusEnum::Value::Active)
         .putSymbol(instrument.primary_symbol);
 
     // Set FX-specific fields if it's an FX instrument
     if (instrument.get_type() == market_core::InstrumentType::FX_SPOT) {
-        secDef.putSecurityType("FOR") // FX Forward/Spot
+        secDef.putSecurityType(SECURITY_TYPE_FX)
             .putCurrency1("USD") // Extract from instrument
             .putCurrency2("EUR") // Extract from instrument
             .exDestination(lseg_sbe::ExDestinationEnum::Value::MTF)
@@ -303,9 +337,9 @@ std::vector<uint8_t> ReutersEncoder::encode_market_data_snapshot(
         buffer.size() - message_offset);
 
     // Set snapshot header fields
-    mdSnapshot.putApplID("FXMD01")
+    mdSnapshot.putApplID(APPL_ID)
         .putSecurityID(std::to_string(snapshot.instrument_id))
-        .putSecurityType("FOR");
+        .putSecurityType(SECURITY_TYPE_FX);
 
     // Create MD entries for bid/ask levels
     auto& entries = mdSnapshot.mDEntriesCount(snapshot.bid_levels.size() + snapshot.ask_levels.size());
@@ -355,7 +389,7 @@ std::vector<uint8_t> ReutersEncoder::encode_market_data_incremental(
         buffer.size() - message_offset);
 
     // Set incremental header
-    mdIncremental.putApplID("FXMD01");
+    mdIncremental.putApplID(APPL_ID);
 
     // Create single MD entry for the quote update
     auto& entries = mdIncremental.mDIncGrpCount(1);
@@ -392,7 +426,7 @@ std::vector<uint8_t> ReutersEncoder::encode_market_data_incremental(
         message_offset,
         buffer.size() - message_offset);
 
-    mdIncremental.putApplID("FXMD01");
+    mdIncremental.putApplID(APPL_ID);
 
     // Create trade entry
     auto& entries = mdIncremental.mDIncGrpCount(1);
@@ -416,6 +450,71 @@ std::vector<uint8_t> ReutersEncoder::encode_market_data_incremental(
     return buffer;
 }
 
+std::vector<uint8_t> ReutersEncoder::encode_market_data_incremental(
+    const std::vector<const market_core::QuoteEvent*>& quotes)
+{
+    std::vector<uint8_t> buffer(MAX_MESSAGE_SIZE);
+    size_t message_offset = SOFHeader::size();
+
+    lseg_sbe::MarketDataIncrementalRefresh mdIncremental;
+    mdIncremental.wrapForEncode(
+        reinterpret_cast<char*>(buffer.data()),
+        message_offset,
+        buffer.size() - message_offset);
+
+    mdIncremental.putApplID(APPL_ID);
+
+    auto& entries = mdIncremental.mDIncGrpCount(static_cast<uint16_t>(quotes.size()));
+    for (const auto* quote : quotes) {
+        auto& entry = entries.next();
+        entry.mDUpdateAction(static_cast<lseg_sbe::UpdateActionEnum::Value>(quote->action))
+            .mDEntryType(quote->side == market_core::Side::BID ? lseg_sbe::EntryTypeEnum::Value::Bid : lseg_sbe::EntryTypeEnum::Value::Offer)
+            .putSecurityID(std::to_string(quote->instrument_id))
+            .mDPriceLevel(quote->price_level.value_or(1))
+            .numberOfOrders(quote->order_count);
+        entry.mDEntryPx().mantissa(to_sbe_decimal(quote->price));
+        entry.mDEntrySize().mantissa(to_sbe_quantity(quote->quantity));
+        entry.partiesCount(0); // Later entries start after this group
+    }
+
+    size_t sbe_encoded_length = mdIncremental.encodedLength();
+
+    SOFHeader sofh;
+    sofh.message_length = static_cast<uint32_t>(SOFHeader::size() + sbe_encoded_length);
+    sofh.encoding_type = BIG_ENDIAN_ENCODING;
+    sofh.decryption_id = 0;
+    sofh.pack(buffer.data());
+
+    buffer.resize(sofh.message_length);
+    return buffer;
+}
+
+std::vector<uint8_t> ReutersEncoder::encode_end_of_conflation(uint64_t conflation_id)
+{
+    std::vector<uint8_t> buffer(MAX_MESSAGE_SIZE);
+    size_t message_offset = SOFHeader::size();
+
+    lseg_sbe::EndOfConflation endOfConflation;
+    endOfConflation.wrapForEncode(
+        reinterpret_cast<char*>(buffer.data()),
+        message_offset,
+        buffer.size() - message_offset);
+
+    endOfConflation.conflationID(conflation_id)
+        .putDecryptionKey(std::string());
+
+    size_t sbe_encoded_length = endOfConflation.encodedLength();
+
+    SOFHeader sofh;
+    sofh.message_length = static_cast<uint32_t>(SOFHeader::size() + sbe_encoded_length);
+    sofh.encoding_type = BIG_ENDIAN_ENCODING;
+    sofh.decryption_id = 0;
+    sofh.pack(buffer.data());
+
+    buffer.resize(sofh.message_length);
+    return buffer;
+}
+
 std::vector<uint8_t> ReutersEncoder::encode_market_data_request_rejection(
     const std::string& md_req_id,
     const std::string& rejection_reason)
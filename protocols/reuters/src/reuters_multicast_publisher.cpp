@@ -1,4 +1,5 @@
 #include "../include/reuters_multicast_publisher.h"
+#include <algorithm>
 #include <arpa/inet.h>
 #include <cstring>
 #include <iostream>
@@ -43,10 +44,14 @@ void MulticastMessageHeader::unpack(const uint8_t* buffer)
 // ReutersMulticastPublisher implementation
 ReutersMulticastPublisher::ReutersMulticastPublisher(const ReutersMulticastConfig& config)
     : config_(config)
+    , conflation_(config.conflate_by_level ? ConflationTable::Granularity::LEVEL
+                                           : ConflationTable::Granularity::INSTRUMENT)
+    , conflation_id_(0)
 {
     stats_.start_time = std::chrono::steady_clock::now();
     last_heartbeat_ = stats_.start_time;
     last_snapshot_ = stats_.start_time;
+    next_conflation_ = stats_.start_time + std::chrono::milliseconds(config_.conflation_interval_ms);
 }
 
 ReutersMulticastPublisher::~ReutersMulticastPublisher()
@@ -157,8 +162,8 @@ bool ReutersMulticastPublisher::initialize()
 
 void ReutersMulticastPublisher::shutdown()
 {
-    // Send end-of-stream messages
-    send_end_of_conflation();
+    // Send what conflation still holds
+    flush_conflation();
 
     // Close all sockets
     incremental_transport_a_.reset();
@@ -171,46 +176,81 @@ void ReutersMulticastPublisher::shutdown()
 
 void ReutersMulticastPublisher::publish_incremental(const market_core::QuoteEvent& quote)
 {
-    // Encode the quote update
-    auto message = ReutersEncoder::encode_market_data_incremental(quote);
-
-    // Get channel for this instrument
-    int channel_id = get_channel_for_instrument(quote.instrument_id);
-
-    if (channel_id > 0 && channel_enabled_[channel_id]) {
-        // Send to channel-specific feeds
-        send_to_channel_feeds(message, channel_id);
-    } else {
-        // Send to global feeds
-        send_to_both_feeds(message, 0);
+    // Held until the next flush when conflating
+    if (config_.conflation_interval_ms > 0) {
+        if (conflation_.update(quote)) {
+            stats_.quotes_conflated++;
+        }
+        return;
     }
 
-    stats_.messages_sent_a++;
-    stats_.messages_sent_b++;
-    stats_.bytes_sent += message.size() * 2;
+    // Encode the quote update
+    auto message = ReutersEncoder::encode_market_data_incremental(quote);
+    send_incremental(message, get_channel_for_instrument(quote.instrument_id));
 }
 
 void ReutersMulticastPublisher::publish_incremental(const market_core::TradeEvent& trade)
 {
-    // Encode the trade
+    // Trades are events, not state, and are never conflated
     auto message = ReutersEncoder::encode_market_data_incremental(trade);
+    send_incremental(message, get_channel_for_instrument(trade.instrument_id));
+}
 
-    // Get channel for this instrument
-    int channel_id = get_channel_for_instrument(trade.instrument_id);
+void ReutersMulticastPublisher::poll()
+{
+    if (config_.conflation_interval_ms == 0)
+        return;
 
-    if (channel_id > 0 && channel_enabled_[channel_id]) {
-        send_to_channel_feeds(message, channel_id);
-    } else {
-        send_to_both_feeds(message, 0);
+    auto now = std::chrono::steady_clock::now();
+    if (now < next_conflation_)
+        return;
+
+    flush_conflation();
+    next_conflation_ = now + std::chrono::milliseconds(config_.conflation_interval_ms);
+}
+
+void ReutersMulticastPublisher::flush_conflation()
+{
+    if (conflation_.pending() == 0)
+        return;
+
+    // Group the interval's updates by the feed that carries them
+    for (auto& [channel_id, batch] : conflation_batches_) {
+        batch.clear();
+    }
+    conflation_.flush([&](const market_core::QuoteEvent& quote) {
+        int channel_id = get_channel_for_instrument(quote.instrument_id);
+        if (channel_id > 0 && !is_channel_enabled(channel_id)) {
+            channel_id = 0;
+        }
+        conflation_batches_[channel_id].push_back(&quote);
+    });
+
+    // Each feed gets its updates in as few packets as fit, then the marker
+    ++conflation_id_;
+    std::vector<const market_core::QuoteEvent*> chunk;
+    for (const auto& [channel_id, batch] : conflation_batches_) {
+        for (size_t i = 0; i < batch.size(); i += MAX_CONFLATED_ENTRIES) {
+            auto end = batch.begin() + std::min(i + MAX_CONFLATED_ENTRIES, batch.size());
+            chunk.assign(batch.begin() + i, end);
+            send_incremental(ReutersEncoder::encode_market_data_incremental(chunk), channel_id);
+        }
+        if (!batch.empty()) {
+            send_end_of_conflation(channel_id);
+        }
     }
 
-    stats_.messages_sent_a++;
-    stats_.messages_sent_b++;
-    stats_.bytes_sent += message.size() * 2;
+    stats_.conflation_intervals++;
 }
 
 void ReutersMulticastPublisher::publish_snapshot(const market_core::SnapshotEvent& snapshot)
 {
+    // Quotes still held for the instrument predate the snapshot; flushed
+    // later they would be applied on top of it
+    if (config_.conflation_interval_ms > 0) {
+        stats_.quotes_conflated += conflation_.discard(snapshot.instrument_id);
+    }
+
     // Encode the snapshot
     auto message = ReutersEncoder::encode_market_data_snapshot(snapshot);
 
@@ -273,23 +313,29 @@ void ReutersMulticastPublisher::send_end_of_conflation()
 {
     // Send end-of-conflation marker if using conflation
     if (config_.conflation_interval_ms > 0) {
-        // Create end-of-conflation message
-        MulticastMessageHeader header;
-        header.sequence_number = get_next_sequence_number(0);
-        header.channel_id = 0;
-        header.send_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-            std::chrono::system_clock::now().time_since_epoch())
-                                  .count();
-        header.message_count = 0;
-        header.flags = 0x02; // End-of-stream flag
-
-        std::vector<uint8_t> packet(MulticastMessageHeader::SIZE);
-        header.pack(packet.data());
-
-        send_to_both_feeds(packet, 0);
+        send_end_of_conflation(0);
+
+        for (const auto& [channel_id, enabled] : channel_enabled_) {
+            if (enabled) {
+                send_end_of_conflation(channel_id);
+            }
+        }
     }
 }
 
+void ReutersMulticastPublisher::send_end_of_conflation(int channel_id)
+{
+    auto message = ReutersEncoder::encode_end_of_conflation(conflation_id_);
+    if (channel_id > 0) {
+        send_to_channel_feeds(message, channel_id);
+    } else {
+        send_to_both_feeds(message, 0);
+    }
+    stats_.messages_sent_a++;
+    stats_.messages_sent_b++;
+    stats_.bytes_sent += message.size() * 2;
+}
+
 uint64_t ReutersMulticastPublisher::get_next_sequence_number(int channel_id)
 {
     return ++sequence_numbers_[channel_id];
@@ -334,6 +380,21 @@ void ReutersMulticastPublisher::send_to_both_feeds(const std::vector<uint8_t>& m
     }
 }
 
+void ReutersMulticastPublisher::send_incremental(const std::vector<uint8_t>& message, int channel_id)
+{
+    if (channel_id > 0 && channel_enabled_[channel_id]) {
+        // Send to channel-specific feeds
+        send_to_channel_feeds(message, channel_id);
+    } else {
+        // Send to global feeds
+        send_to_both_feeds(message, 0);
+    }
+
+    stats_.messages_sent_a++;
+    stats_.messages_sent_b++;
+    stats_.bytes_sent += message.size() * 2;
+}
+
 void ReutersMulticastPublisher::send_to_channel_feeds(const std::vector<uint8_t>& message, int channel_id)
 {
     // Add sequence header
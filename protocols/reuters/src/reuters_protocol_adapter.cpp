@@ -1,21 +1,48 @@
 #include "../include/reuters_protocol_adapter.h"
 #include "../../protocols/common/include/tcp_transport.h"
 #include "../include/reuters_encoder.h"
+#include "../include/lseg_sbe/MarketDataRequest.h"
 #include <algorithm>
+#include <climits>
+#include <cstdlib>
 #include <iostream>
-#include <poll.h>
 #include <random>
 #include <sstream>
 #include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
 
 namespace reuters_protocol {
 
+// Output queue conflation keys; the low byte tells the kinds apart
+static uint64_t snapshot_key(uint32_t instrument_id)
+{
+    return (static_cast<uint64_t>(instrument_id) << 32) | 2;
+}
+
+// A level change replaces only a queued change to the same instrument,
+// side and level. An ADD or DELETE renumbers the levels behind it, so it
+// is never keyed.
+static uint64_t quote_key(const market_core::QuoteEvent& quote)
+{
+    if (quote.action != market_core::UpdateAction::CHANGE
+        && quote.action != market_core::UpdateAction::OVERLAY)
+        return 0;
+    return (static_cast<uint64_t>(quote.instrument_id) << 32)
+        | (static_cast<uint64_t>(quote.side) << 16)
+        | (static_cast<uint64_t>(quote.price_level.value_or(1)) << 8) | 1;
+}
+
 ReutersProtocolAdapter::ReutersProtocolAdapter(uint16_t port)
     : port_(port)
     , server_socket_(-1)
     , running_(false)
     , stats_ {}
     , use_multicast_(false)
+    , epoll_fd_(-1)
+    , events_(256)
+    , next_serial_(1)
+    , session_timeout_(SESSION_TIMEOUT_MS)
 {
     stats_.start_time = std::chrono::steady_clock::now();
 }
@@ -27,6 +54,10 @@ ReutersProtocolAdapter::ReutersProtocolAdapter(uint16_t port, const ReutersMulti
     , stats_ {}
     , use_multicast_(true)
     , multicast_config_(multicast_config)
+    , epoll_fd_(-1)
+    , events_(256)
+    , next_serial_(1)
+    , session_timeout_(SESSION_TIMEOUT_MS)
 {
     stats_.start_time = std::chrono::steady_clock::now();
 }
@@ -39,14 +70,24 @@ ReutersProtocolAdapter::~ReutersProtocolAdapter()
 bool ReutersProtocolAdapter::initialize()
 {
     try {
-        server_socket_ = protocol_common::TCPTransport::create_server_socket(port_);
+        // Thousands of clients may connect at once
+        server_socket_ = protocol_common::TCPTransport::create_server_socket(port_, SOMAXCONN);
         protocol_common::TCPTransport::set_non_blocking(server_socket_);
-
-        running_ = true;
-        return true;
     } catch (const std::exception& e) {
         return false;
     }
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event {};
+    event.events = EPOLLIN | EPOLLET;
+    event.data.u64 = static_cast<uint32_t>(server_socket_);
+    if (epoll_fd_ < 0 || epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, server_socket_, &event) < 0) {
+        shutdown();
+        return false;
+    }
+
+    running_ = true;
+    return true;
 }
 
 bool ReutersProtocolAdapter::initialize_with_multicast()
@@ -69,19 +110,36 @@ bool ReutersProtocolAdapter::initialize_with_multicast()
     return true;
 }
 
-void ReutersProtocolAdapter::run_once()
+bool ReutersProtocolAdapter::enable_io_uring()
+{
+    auto writer = std::make_unique<market_protocols::IoUringStreamWriter>();
+    if (!writer->initialize()) {
+        return false;
+    }
+    writer_ = std::move(writer);
+    return true;
+}
+
+void ReutersProtocolAdapter::run_once(int timeout_ms)
 {
     if (!running_)
         return;
 
     // Single-threaded event loop iteration
-    accept_new_connections();
-    process_client_messages();
-    send_heartbeats();
-    cleanup_inactive_sessions();
+    close_pending_sessions(); // Marked while fanning out market data
+    process_client_messages(timeout_ms);
+    run_timers();
+    close_pending_sessions();
+
+    // One enter submits this iteration's writes and reaps finished ones
+    if (writer_) {
+        writer_->poll();
+    }
 
-    // Send multicast heartbeats if needed
+    // Flush conflated quotes when due and send multicast heartbeats if needed
     if (use_multicast_ && multicast_publisher_) {
+        multicast_publisher_->poll();
+
         static auto last_heartbeat = std::chrono::steady_clock::now();
         auto now = std::chrono::steady_clock::now();
         if (std::chrono::duration_cast<std::chrono::seconds>(now - last_heartbeat).count() >= 30) {
@@ -110,14 +168,40 @@ void ReutersProtocolAdapter::shutdown()
                 "Server shutdown");
             send_to_session(*session, terminate_msg);
         }
-        protocol_common::TCPTransport::close_socket(socket_fd);
     }
-    sessions_.clear();
+
+    // Give queued terminates a bounded chance to leave
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        bool pending = false;
+        for (const auto& [socket_fd, session] : sessions_) {
+            if (writer_) {
+                pending = pending || writer_->queued_bytes(socket_fd) > 0;
+            } else if (!session->output.empty() && session->output.flush(socket_fd)) {
+                pending = pending || !session->output.empty();
+            }
+        }
+        if (!pending) {
+            break;
+        }
+        if (writer_) {
+            writer_->poll();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    while (!sessions_.empty()) {
+        close_session(sessions_.begin()->first);
+    }
+    timers_ = decltype(timers_)();
 
     if (server_socket_ >= 0) {
         protocol_common::TCPTransport::close_socket(server_socket_);
         server_socket_ = -1;
     }
+    if (epoll_fd_ >= 0) {
+        ::close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
 }
 
 void ReutersProtocolAdapter::on_market_event(
@@ -156,26 +240,30 @@ void ReutersProtocolAdapter::on_market_event(
         }
     }
 
+    // Nothing to encode when no session wants the instrument
+    if (subscriptions_.subscriber_count(event->instrument_id) == 0)
+        return;
+
     // Also send to TCP sessions if they exist
     switch (event->type) {
     case market_core::MarketEvent::QUOTE_UPDATE: {
         auto quote = std::static_pointer_cast<market_core::QuoteEvent>(event);
         auto msg = ReutersEncoder::encode_market_data_incremental(*quote);
-        broadcast_to_subscribed_sessions(msg, std::to_string(quote->instrument_id));
+        broadcast_to_subscribed_sessions(msg, quote->instrument_id, quote_key(*quote));
         break;
     }
 
     case market_core::MarketEvent::TRADE: {
         auto trade = std::static_pointer_cast<market_core::TradeEvent>(event);
         auto msg = ReutersEncoder::encode_market_data_incremental(*trade);
-        broadcast_to_subscribed_sessions(msg, std::to_string(trade->instrument_id));
+        broadcast_to_subscribed_sessions(msg, trade->instrument_id);
         break;
     }
 
     case market_core::MarketEvent::SNAPSHOT: {
         auto snapshot = std::static_pointer_cast<market_core::SnapshotEvent>(event);
         auto msg = ReutersEncoder::encode_market_data_snapshot(*snapshot);
-        broadcast_to_subscribed_sessions(msg, std::to_string(snapshot->instrument_id));
+        broadcast_to_subscribed_sessions(msg, snapshot->instrument_id, snapshot_key(snapshot->instrument_id));
         break;
     }
 
@@ -183,6 +271,7 @@ void ReutersProtocolAdapter::on_market_event(
     case market_core::MarketEvent::STATUS_CHANGE:
     case market_core::MarketEvent::BOOK_CLEAR:
     case market_core::MarketEvent::IMBALANCE:
+    case market_core::MarketEvent::ORDER_UPDATE:
         // Could implement these later if needed
         break;
     }
@@ -190,80 +279,128 @@ void ReutersProtocolAdapter::on_market_event(
 
 void ReutersProtocolAdapter::accept_new_connections()
 {
-    int client_fd = protocol_common::TCPTransport::accept_connection(server_socket_);
-    if (client_fd < 0)
-        return; // No pending connections
-
-    // Set client socket options
-    protocol_common::TCPTransport::set_non_blocking(client_fd);
-    protocol_common::TCPTransport::set_socket_options(client_fd);
-
-    // Create new session
-    auto session = std::make_unique<ClientSession>();
-    session->socket_fd = client_fd;
-    session->state = SessionState::DISCONNECTED;
-    session->last_activity = std::chrono::steady_clock::now();
+    // Edge-triggered: the listener only signals again once drained
+    while (true) {
+        int client_fd;
+        try {
+            client_fd = protocol_common::TCPTransport::accept_connection(server_socket_);
+        } catch (const std::exception& e) {
+            return; // E.g. out of descriptors; retried on the next connection
+        }
+        if (client_fd < 0)
+            return; // No pending connections
+
+        // Set client socket options
+        protocol_common::TCPTransport::set_non_blocking(client_fd);
+        protocol_common::TCPTransport::set_socket_options(client_fd);
+
+        // Create new session
+        auto session = std::make_unique<ClientSession>();
+        session->socket_fd = client_fd;
+        session->state = SessionState::DISCONNECTED;
+        session->serial = next_serial_++;
+        session->last_activity = std::chrono::steady_clock::now();
+        session->last_heartbeat = session->last_activity;
+        session->output.configure(session_output_config());
+
+        epoll_event event {};
+        event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+        event.data.u64 = (static_cast<uint64_t>(session->serial) << 32) | static_cast<uint32_t>(client_fd);
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, client_fd, &event) < 0) {
+            protocol_common::TCPTransport::close_socket(client_fd);
+            continue;
+        }
 
-    sessions_[client_fd] = std::move(session);
-    stats_.sessions_created++;
+        schedule_timer(*session);
+        sessions_[client_fd] = std::move(session);
+        stats_.sessions_created++;
+    }
 }
 
-void ReutersProtocolAdapter::process_client_messages()
+void ReutersProtocolAdapter::process_client_messages(int timeout_ms)
 {
-    // Use poll to check all client sockets for data
-    std::vector<pollfd> poll_fds;
-    for (const auto& [socket_fd, session] : sessions_) {
-        poll_fds.push_back({ socket_fd, POLLIN, 0 });
-    }
-
-    if (poll_fds.empty())
-        return;
-
-    int ready = poll(poll_fds.data(), poll_fds.size(), 0); // Non-blocking
-    if (ready <= 0)
-        return;
+    int ready = epoll_wait(epoll_fd_, events_.data(), static_cast<int>(events_.size()), timeout_ms);
 
-    for (const auto& pfd : poll_fds) {
-        if (!(pfd.revents & POLLIN))
+    for (int i = 0; i < ready; ++i) {
+        int fd = static_cast<int>(events_[i].data.u64 & 0xFFFFFFFF);
+        uint32_t serial = static_cast<uint32_t>(events_[i].data.u64 >> 32);
+        if (fd == server_socket_ && serial == 0) {
+            accept_new_connections();
             continue;
+        }
 
-        auto session_it = sessions_.find(pfd.fd);
-        if (session_it == sessions_.end())
+        // The session may have closed, and its descriptor been reused,
+        // earlier in this batch
+        auto session_it = sessions_.find(fd);
+        if (session_it == sessions_.end() || session_it->second->serial != serial)
             continue;
 
         auto& session = *session_it->second;
+        if (events_[i].events & EPOLLOUT) {
+            flush_session(session);
+        }
+        if (session.closing)
+            continue;
 
-        try {
-            auto data = protocol_common::TCPTransport::receive_data(pfd.fd);
-            if (!data.empty()) {
-                session.last_activity = std::chrono::steady_clock::now();
-                handle_client_message(session, data);
+        if (events_[i].events & EPOLLIN) {
+            read_session(session);
+        } else if (events_[i].events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+            close_session(fd);
+        }
+    }
+
+    // A full batch suggests more are waiting; take them next iteration
+    if (ready == static_cast<int>(events_.size())) {
+        events_.resize(events_.size() * 2);
+    }
+}
+
+void ReutersProtocolAdapter::read_session(ClientSession& session)
+{
+    int fd = session.socket_fd;
+    auto& buffer = session.receive_buffer;
+    try {
+        // Drain the socket: no further edge arrives until it is empty
+        while (true) {
+            size_t received = protocol_common::TCPTransport::receive_into(
+                fd, buffer.write_data(), buffer.write_space());
+            if (received == 0)
+                break;
+
+            buffer.commit(received);
+            session.last_activity = std::chrono::steady_clock::now();
+
+            // Pipelined requests arrive several to a read, or split
+            // across reads; dispatch each complete frame in place
+            bool framed = buffer.extract([&](const uint8_t* frame, size_t length) {
                 stats_.messages_received++;
+                try {
+                    handle_client_message(session, frame, length);
+                } catch (const std::exception& e) {
+                    // The SBE flyweights reject a body that does not fit
+                    terminate_session(session, TerminationCode::UNSPECIFIED_ERROR, "Malformed message");
+                }
+            });
+            if (!framed) {
+                terminate_session(session, TerminationCode::UNSPECIFIED_ERROR, "Invalid message framing");
+                close_session(fd);
+                return;
             }
-        } catch (const std::exception& e) {
-            // Connection closed or error
-            terminate_session(session, TerminationCode::UNSPECIFIED_ERROR, "Connection error");
         }
+    } catch (const std::exception& e) {
+        // Connection closed or error
+        close_session(fd);
     }
 }
 
 void ReutersProtocolAdapter::handle_client_message(
     ClientSession& session,
-    const std::vector<uint8_t>& data)
+    const uint8_t* frame,
+    size_t length)
 {
-    if (data.size() < SOFHeader::size())
-        return;
-
-    // Parse SOFH header
-    SOFHeader sofh;
-    sofh.unpack(data.data());
-
-    if (data.size() < sofh.message_length)
-        return; // Incomplete message
-
-    // Extract SBE message
-    const uint8_t* sbe_data = data.data() + SOFHeader::size();
-    size_t sbe_size = sofh.message_length - SOFHeader::size();
+    // The SOFH length was validated when the frame was extracted
+    const uint8_t* sbe_data = frame + SOFHeader::size();
+    size_t sbe_size = length - SOFHeader::size();
 
     if (sbe_size < lseg_sbe::MessageHeader::encodedLength())
         return;
@@ -278,19 +415,19 @@ void ReutersProtocolAdapter::handle_client_message(
     // Route message based on template ID
     switch (template_id) {
     case MessageTypes::NEGOTIATE:
-        handle_negotiate(session, { sbe_data, sbe_data + sbe_size });
+        handle_negotiate(session, sbe_data, sbe_size);
         break;
 
     case MessageTypes::ESTABLISH:
-        handle_establish(session, { sbe_data, sbe_data + sbe_size });
+        handle_establish(session, sbe_data, sbe_size);
         break;
 
     case MessageTypes::MARKET_DATA_REQUEST:
-        handle_market_data_request(session, { sbe_data, sbe_data + sbe_size });
+        handle_market_data_request(session, sbe_data, sbe_size);
         break;
 
     case MessageTypes::SECURITY_DEFINITION_REQUEST:
-        handle_security_definition_request(session, { sbe_data, sbe_data + sbe_size });
+        handle_security_definition_request(session, sbe_data, sbe_size);
         break;
 
     case MessageTypes::HEARTBEAT:
@@ -305,7 +442,8 @@ void ReutersProtocolAdapter::handle_client_message(
 
 void ReutersProtocolAdapter::handle_negotiate(
     ClientSession& session,
-    const std::vector<uint8_t>& payload)
+    const uint8_t* payload,
+    size_t size)
 {
     if (session.state != SessionState::DISCONNECTED) {
         terminate_session(session, TerminationCode::UNSPECIFIED_ERROR, "Invalid state for negotiate");
@@ -314,8 +452,8 @@ void ReutersProtocolAdapter::handle_negotiate(
 
     // Parse negotiate message to extract credentials
     lseg_sbe::Negotiate negotiate;
-    negotiate.wrapForDecode(const_cast<char*>(reinterpret_cast<const char*>(payload.data())),
-        0, negotiate.sbeBlockLength(), negotiate.sbeSchemaVersion(), payload.size());
+    negotiate.wrapForDecode(const_cast<char*>(reinterpret_cast<const char*>(payload)),
+        0, negotiate.sbeBlockLength(), negotiate.sbeSchemaVersion(), size);
 
     // Extract session ID and credentials
     std::string session_id(negotiate.sessionID(), negotiate.sessionIDLength());
@@ -343,7 +481,8 @@ void ReutersProtocolAdapter::handle_negotiate(
 
 void ReutersProtocolAdapter::handle_establish(
     ClientSession& session,
-    const std::vector<uint8_t>& payload)
+    const uint8_t* payload,
+    size_t size)
 {
     if (session.state != SessionState::NEGOTIATED) {
         terminate_session(session, TerminationCode::UNSPECIFIED_ERROR, "Invalid state for establish");
@@ -352,10 +491,15 @@ void ReutersProtocolAdapter::handle_establish(
 
     // Parse establish message
     lseg_sbe::Establish establish;
-    establish.wrapForDecode(const_cast<char*>(reinterpret_cast<const char*>(payload.data())),
-        0, establish.sbeBlockLength(), establish.sbeSchemaVersion(), payload.size());
+    establish.wrapForDecode(const_cast<char*>(reinterpret_cast<const char*>(payload)),
+        0, establish.sbeBlockLength(), establish.sbeSchemaVersion(), size);
 
+    // A tiny interval would have us heartbeat continuously; the ack
+    // tells the client the interval actually used
     session.keepalive_interval = establish.keepAliveInterval();
+    if (session.keepalive_interval > 0 && session.keepalive_interval < MIN_KEEPALIVE_MS) {
+        session.keepalive_interval = MIN_KEEPALIVE_MS;
+    }
     session.state = SessionState::ESTABLISHING;
 
     // Send establishment acknowledgment
@@ -364,30 +508,76 @@ void ReutersProtocolAdapter::handle_establish(
     send_to_session(session, ack);
 
     session.state = SessionState::ESTABLISHED;
+    schedule_timer(session); // Heartbeats now follow the keepalive interval
 }
 
 void ReutersProtocolAdapter::handle_market_data_request(
     ClientSession& session,
-    const std::vector<uint8_t>& payload)
+    const uint8_t* payload,
+    size_t size)
 {
     if (session.state != SessionState::ESTABLISHED)
         return;
 
-    // Parse market data request
-    // For simplicity, subscribe to all instruments
-    session.incremental_requested = true;
-    session.snapshot_requested = true;
+    // The body follows the message header, at the client's block length
+    char* buffer = const_cast<char*>(reinterpret_cast<const char*>(payload));
+    lseg_sbe::MessageHeader header;
+    header.wrap(buffer, 0, 0, size);
+    lseg_sbe::MarketDataRequest request;
+    request.wrapForDecode(buffer, lseg_sbe::MessageHeader::encodedLength(),
+        header.blockLength(), header.version(), size);
+
+    auto request_type = request.subscriptionRequestType();
+    std::string md_req_id = request.getMDReqIDAsString();
+
+    // Groups are read in order; entry types are not filtered on
+    auto& entry_types = request.mDEntryTypeGrp();
+    while (entry_types.hasNext()) {
+        entry_types.next();
+    }
 
-    // Could parse specific instrument subscriptions from payload
-    session.subscribed_instruments.clear();
-    session.subscribed_instruments.push_back("all"); // Subscribe to all
+    // Securities are named by instrument ID, as in published updates
+    std::vector<uint32_t> instrument_ids;
+    auto& symbols = request.relatedSymGrp();
+    while (symbols.hasNext()) {
+        std::string security_id = symbols.next().getSecurityIDAsString();
+        char* end = nullptr;
+        unsigned long id = std::strtoul(security_id.c_str(), &end, 10);
+        if (security_id.empty() || *end != '\0' || id > UINT32_MAX) {
+            auto reject = ReutersEncoder::encode_market_data_request_rejection(
+                md_req_id, "Unknown security " + security_id);
+            send_to_session(session, reject);
+            return;
+        }
+        instrument_ids.push_back(static_cast<uint32_t>(id));
+    }
 
-    (void)payload; // Suppress unused warning
+    // No securities listed means every instrument
+    if (request_type == lseg_sbe::SubscriptionRequestTypeEnum::Unsubscribe) {
+        if (instrument_ids.empty()) {
+            subscriptions_.remove(&session);
+        }
+        for (uint32_t id : instrument_ids) {
+            subscriptions_.unsubscribe(&session, id);
+        }
+        return;
+    }
+
+    // Snapshots are not cached, so a snapshot request also subscribes
+    session.incremental_requested = true;
+    session.snapshot_requested = true;
+    if (instrument_ids.empty()) {
+        subscriptions_.subscribe_all(&session);
+    }
+    for (uint32_t id : instrument_ids) {
+        subscriptions_.subscribe(&session, id);
+    }
 }
 
 void ReutersProtocolAdapter::handle_security_definition_request(
     ClientSession& session,
-    const std::vector<uint8_t>& payload)
+    const uint8_t* payload,
+    size_t size)
 {
     if (session.state != SessionState::ESTABLISHED)
         return;
@@ -399,84 +589,237 @@ void ReutersProtocolAdapter::handle_security_definition_request(
     sample_fx.tick_size = 0.00001;
 
     (void)payload; // Suppress unused warning
+    (void)size;
 
     auto sec_def = ReutersEncoder::encode_security_definition(sample_fx);
     send_to_session(session, sec_def);
 }
 
-void ReutersProtocolAdapter::send_heartbeats()
+void ReutersProtocolAdapter::schedule_timer(ClientSession& session)
+{
+    // Established sessions need a heartbeat after half a quiet keepalive
+    // interval; every session is dropped after the inactivity timeout
+    auto deadline = session.last_activity + session_timeout_;
+    if (session.state == SessionState::ESTABLISHED && session.keepalive_interval > 0) {
+        auto quiet_since = std::max(session.last_activity, session.last_heartbeat);
+        deadline = std::min(deadline, quiet_since + std::chrono::milliseconds(session.keepalive_interval / 2));
+    }
+
+    // Never due at or before the instant run_timers() is processing
+    deadline = std::max(deadline, std::chrono::steady_clock::now() + std::chrono::milliseconds(1));
+    session.timer_deadline = deadline;
+    timers_.push({ deadline, session.socket_fd, session.serial });
+}
+
+void ReutersProtocolAdapter::run_timers()
 {
     auto now = std::chrono::steady_clock::now();
 
-    for (auto& [socket_fd, session] : sessions_) {
-        if (session->state != SessionState::ESTABLISHED)
-            continue;
+    while (!timers_.empty() && timers_.top().deadline <= now) {
+        SessionTimer timer = timers_.top();
+        timers_.pop();
+
+        auto it = sessions_.find(timer.socket_fd);
+        if (it == sessions_.end() || it->second->serial != timer.serial
+            || it->second->timer_deadline != timer.deadline)
+            continue; // Superseded
 
-        auto time_since_activity = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - session->last_activity)
-                                       .count();
+        auto& session = *it->second;
+        if (now - session.last_activity >= session_timeout_) {
+            terminate_session(session, TerminationCode::UNSPECIFIED_ERROR, "Session timeout");
+            close_session(timer.socket_fd);
+            continue;
+        }
 
-        if (time_since_activity > session->keepalive_interval / 2) {
+        auto quiet_since = std::max(session.last_activity, session.last_heartbeat);
+        if (session.state == SessionState::ESTABLISHED && session.keepalive_interval > 0
+            && now - quiet_since >= std::chrono::milliseconds(session.keepalive_interval / 2)) {
             auto heartbeat = ReutersEncoder::encode_heartbeat();
-            send_to_session(*session, heartbeat);
+            send_to_session(session, heartbeat);
+            session.last_heartbeat = now;
         }
+        schedule_timer(session);
     }
 }
 
-void ReutersProtocolAdapter::cleanup_inactive_sessions()
+void ReutersProtocolAdapter::close_session(int socket_fd)
 {
-    auto now = std::chrono::steady_clock::now();
-
-    for (auto it = sessions_.begin(); it != sessions_.end();) {
-        auto& session = *it->second;
+    // Queued bytes must not land on a socket that reuses the descriptor
+    if (writer_) {
+        writer_->remove(socket_fd);
+    }
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, socket_fd, nullptr);
+    protocol_common::TCPTransport::close_socket(socket_fd);
+    auto it = sessions_.find(socket_fd);
+    if (it != sessions_.end()) {
+        subscriptions_.remove(it->second.get());
+        sessions_.erase(it);
+    }
+}
 
-        auto inactive_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - session.last_activity)
-                                 .count();
+void ReutersProtocolAdapter::schedule_close(ClientSession& session)
+{
+    // Callers may be iterating sessions_; close once they are done
+    if (!session.closing) {
+        session.closing = true;
+        pending_close_.push_back(session.socket_fd);
+    }
+}
 
-        if (inactive_time > SESSION_TIMEOUT_MS) {
-            terminate_session(session, TerminationCode::UNSPECIFIED_ERROR, "Session timeout");
-            protocol_common::TCPTransport::close_socket(it->first);
-            it = sessions_.erase(it);
-        } else {
-            ++it;
+void ReutersProtocolAdapter::close_pending_sessions()
+{
+    for (int socket_fd : pending_close_) {
+        auto it = sessions_.find(socket_fd);
+        if (it != sessions_.end() && it->second->closing) {
+            close_session(socket_fd);
         }
     }
+    pending_close_.clear();
+}
+
+void ReutersProtocolAdapter::set_write_interest(ClientSession& session, bool armed)
+{
+    epoll_event event {};
+    event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    if (armed) {
+        event.events |= EPOLLOUT;
+    }
+    event.data.u64 = (static_cast<uint64_t>(session.serial) << 32) | static_cast<uint32_t>(session.socket_fd);
+    epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, session.socket_fd, &event);
+    session.write_armed = armed;
+}
+
+void ReutersProtocolAdapter::flush_session(ClientSession& session)
+{
+    if (!session.output.flush(session.socket_fd)) {
+        schedule_close(session);
+        return;
+    }
+
+    // Tell a client that lost updates once it has caught up
+    if (uint64_t dropped = session.output.take_gap()) {
+        queue_to_session(session, ReutersEncoder::encode_gap_notification(dropped), 0);
+    }
+    if (session.output.empty() && session.write_armed) {
+        set_write_interest(session, false);
+    }
 }
 
 void ReutersProtocolAdapter::send_to_session(
     ClientSession& session,
-    const std::vector<uint8_t>& message)
+    const std::vector<uint8_t>& message,
+    uint64_t conflation_key)
 {
-    if (protocol_common::TCPTransport::send_data(session.socket_fd, message)) {
-        stats_.messages_sent++;
+    if (session.closing)
+        return;
+
+    if (writer_) {
+        if (uint64_t dropped = session.output.take_gap(writer_->queued_bytes(session.socket_fd))) {
+            write_to_ring(session, ReutersEncoder::encode_gap_notification(dropped));
+        }
+        write_to_ring(session, message);
+        return;
     }
+
+    if (uint64_t dropped = session.output.take_gap()) {
+        queue_to_session(session, ReutersEncoder::encode_gap_notification(dropped), 0);
+    }
+    queue_to_session(session, message, conflation_key);
 }
 
-void ReutersProtocolAdapter::broadcast_to_subscribed_sessions(
-    const std::vector<uint8_t>& message,
-    const std::string& instrument_id)
+void ReutersProtocolAdapter::write_to_ring(ClientSession& session, const std::vector<uint8_t>& message)
 {
-    for (auto& [socket_fd, session] : sessions_) {
-        if (session->state != SessionState::ESTABLISHED)
-            continue;
-        if (!session->incremental_requested && !session->snapshot_requested)
-            continue;
+    // The ring sends on the next run_once(); the session's limit and
+    // policy apply to what it still holds for this socket
+    auto result = session.output.admit(writer_->queued_bytes(session.socket_fd), message.size());
+    if (result == SessionOutputQueue::Result::SENT && !writer_->write(session.socket_fd, message)) {
+        result = writer_->failed(session.socket_fd) ? SessionOutputQueue::Result::DISCONNECT : session.output.refuse();
+    }
+
+    switch (result) {
+    case SessionOutputQueue::Result::SENT:
+        stats_.messages_sent++;
+        break;
+    case SessionOutputQueue::Result::DROPPED:
+        stats_.messages_dropped++;
+        break;
+    case SessionOutputQueue::Result::DISCONNECT:
+        if (!writer_->failed(session.socket_fd)) {
+            stats_.slow_consumer_disconnects++;
+        }
+        schedule_close(session);
+        break;
+    default:
+        break;
+    }
+}
 
-        // Check if session is subscribed to this instrument
-        if (!session->subscribed_instruments.empty() && session->subscribed_instruments[0] != "all") {
+SessionOutputQueue::Config ReutersProtocolAdapter::session_output_config() const
+{
+    // No one session may take more than a share of the ring's shared slots
+    SessionOutputQueue::Config config = output_config_;
+    if (writer_) {
+        config.max_bytes = std::min(config.max_bytes, writer_->capacity() / MAX_RING_SHARE);
+    }
+    return config;
+}
 
-            auto it = std::find(session->subscribed_instruments.begin(),
-                session->subscribed_instruments.end(),
-                instrument_id);
-            if (it == session->subscribed_instruments.end())
-                continue;
+void ReutersProtocolAdapter::queue_to_session(
+    ClientSession& session,
+    const std::vector<uint8_t>& message,
+    uint64_t conflation_key)
+{
+    // Never blocks: what the socket does not take waits for EPOLLOUT
+    switch (session.output.send(session.socket_fd, message.data(), message.size(), conflation_key)) {
+    case SessionOutputQueue::Result::SENT:
+    case SessionOutputQueue::Result::QUEUED:
+        stats_.messages_sent++;
+        break;
+    case SessionOutputQueue::Result::CONFLATED:
+        stats_.messages_conflated++;
+        break;
+    case SessionOutputQueue::Result::DROPPED:
+        stats_.messages_dropped++;
+        break;
+    case SessionOutputQueue::Result::DISCONNECT:
+        if (!session.output.empty()) {
+            stats_.slow_consumer_disconnects++;
         }
+        schedule_close(session);
+        return;
+    }
 
-        send_to_session(*session, message);
+    if (!session.output.empty() && !session.write_armed) {
+        set_write_interest(session, true);
     }
 }
 
+std::vector<ReutersProtocolAdapter::SessionQueueStats> ReutersProtocolAdapter::get_session_queue_stats() const
+{
+    std::vector<SessionQueueStats> result;
+    result.reserve(sessions_.size());
+    for (const auto& [socket_fd, session] : sessions_) {
+        const auto& output = session->output;
+        size_t queued_bytes = writer_ ? writer_->queued_bytes(socket_fd) : output.queued_bytes();
+        result.push_back({ socket_fd, session->session_id, output.depth(), queued_bytes,
+            output.max_queued_bytes(), output.drops(), output.conflations() });
+    }
+    return result;
+}
+
+void ReutersProtocolAdapter::broadcast_to_subscribed_sessions(
+    const std::vector<uint8_t>& message,
+    uint32_t instrument_id,
+    uint64_t conflation_key)
+{
+    // Only the instrument's subscribers are visited; send_to_session
+    // defers any close, so the lists stay intact while iterating
+    subscriptions_.for_each_subscriber(instrument_id, [&](ClientSession& session) {
+        if (session.state == SessionState::ESTABLISHED)
+            send_to_session(session, message, conflation_key);
+    });
+}
+
 std::string ReutersProtocolAdapter::generate_session_id()
 {
     static std::random_device rd;
@@ -0,0 +1,238 @@
+#include "../include/session_output_queue.h"
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+namespace reuters_protocol {
+
+SessionOutputQueue::SessionOutputQueue()
+    : SessionOutputQueue(Config())
+{
+}
+
+SessionOutputQueue::SessionOutputQueue(const Config& config)
+    : config_(config)
+{
+}
+
+SessionOutputQueue::Result SessionOutputQueue::send(int fd, const uint8_t* data, size_t length, uint64_t conflation_key)
+{
+    // After a drop nothing more goes out until the gap notice can
+    if (gap_ > 0) {
+        ++gap_;
+        ++drops_;
+        return Result::DROPPED;
+    }
+
+    // Nothing ahead of this frame: try the socket directly
+    if (frames_.empty()) {
+        ssize_t sent = ::send(fd, data, length, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent == static_cast<ssize_t>(length)) {
+            return Result::SENT;
+        }
+        if (sent < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return Result::DISCONNECT;
+            }
+            sent = 0;
+        }
+
+        // A frame the kernel has started on can no longer be replaced
+        enqueue(data, length, sent > 0 ? 0 : conflation_key);
+        front_offset_ = static_cast<size_t>(sent);
+        queued_bytes_ -= front_offset_;
+        return Result::QUEUED;
+    }
+
+    if (queued_bytes_ + length > config_.max_bytes) {
+        // Past the limit CONFLATE may still make room by replacing
+        if (config_.policy == SlowConsumerPolicy::CONFLATE && conflation_key != 0
+            && conflate(data, length, conflation_key)) {
+            return Result::CONFLATED;
+        }
+        return overflow();
+    }
+    enqueue(data, length, conflation_key);
+    return Result::QUEUED;
+}
+
+bool SessionOutputQueue::flush(int fd)
+{
+    while (!frames_.empty()) {
+        struct iovec iovecs[MAX_IOVECS];
+        size_t count = 0;
+        for (auto it = frames_.begin(); it != frames_.end() && count < MAX_IOVECS; ++it, ++count) {
+            size_t offset = count == 0 ? front_offset_ : 0;
+            iovecs[count].iov_base = it->bytes.data() + offset;
+            iovecs[count].iov_len = it->bytes.size() - offset;
+        }
+
+        // sendmsg rather than writev: a closed peer must not raise SIGPIPE
+        struct msghdr message = {};
+        message.msg_iov = iovecs;
+        message.msg_iovlen = count;
+        ssize_t sent = sendmsg(fd, &message, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+
+        // Replaced frames have nothing left and pop with the frame ahead
+        size_t remaining = static_cast<size_t>(sent);
+        queued_bytes_ -= remaining;
+        while (!frames_.empty()) {
+            size_t left = frames_.front().bytes.size() - front_offset_;
+            if (remaining < left) {
+                front_offset_ += remaining;
+                break;
+            }
+            remaining -= left;
+            pop_front();
+        }
+    }
+    return true;
+}
+
+SessionOutputQueue::Result SessionOutputQueue::admit(size_t backlog, size_t length)
+{
+    if (gap_ > 0) {
+        ++gap_;
+        ++drops_;
+        return Result::DROPPED;
+    }
+    if (backlog + length > config_.max_bytes) {
+        return overflow();
+    }
+    if (backlog + length > max_queued_bytes_) {
+        max_queued_bytes_ = backlog + length;
+    }
+    return Result::SENT;
+}
+
+uint64_t SessionOutputQueue::take_gap(size_t backlog)
+{
+    if (gap_ == 0 || backlog > config_.max_bytes / 2) {
+        return 0;
+    }
+    uint64_t dropped = gap_;
+    gap_ = 0;
+    return dropped;
+}
+
+bool SessionOutputQueue::conflate(const uint8_t* data, size_t length, uint64_t key)
+{
+    auto it = keyed_.find(key);
+    if (it == keyed_.end()) {
+        return false;
+    }
+
+    size_t index = static_cast<size_t>(it->second - front_index_);
+    Frame& frame = frames_[index];
+    if (index == 0 && front_offset_ > 0) {
+        return false; // Partly written
+    }
+    if (queued_bytes_ - frame.bytes.size() + length > config_.max_bytes) {
+        return false;
+    }
+
+    // Empty the old frame where it stands and queue the new one at the tail
+    queued_bytes_ -= frame.bytes.size();
+    if (spare_.size() < MAX_SPARE) {
+        spare_.push_back(std::move(frame.bytes));
+    }
+    frame.bytes = {};
+    frame.key = 0;
+    keyed_.erase(it);
+    if (index == 0) {
+        pop_front();
+    } else {
+        ++replaced_;
+    }
+    enqueue(data, length, key);
+    ++conflations_;
+
+    if (replaced_ > frames_.size() / 2) {
+        compact();
+    }
+    return true;
+}
+
+void SessionOutputQueue::enqueue(const uint8_t* data, size_t length, uint64_t key)
+{
+    Frame frame;
+    if (!spare_.empty()) {
+        frame.bytes = std::move(spare_.back());
+        spare_.pop_back();
+    }
+    frame.bytes.assign(data, data + length);
+    frame.key = key;
+    if (key != 0) {
+        keyed_[key] = front_index_ + frames_.size();
+    }
+    frames_.push_back(std::move(frame));
+
+    queued_bytes_ += length;
+    if (queued_bytes_ > max_queued_bytes_) {
+        max_queued_bytes_ = queued_bytes_;
+    }
+}
+
+void SessionOutputQueue::pop_front()
+{
+    Frame& frame = frames_.front();
+    if (frame.key != 0) {
+        auto it = keyed_.find(frame.key);
+        if (it != keyed_.end() && it->second == front_index_) {
+            keyed_.erase(it);
+        }
+    }
+    if (spare_.size() < MAX_SPARE && frame.bytes.capacity() > 0) {
+        spare_.push_back(std::move(frame.bytes));
+    }
+
+    frames_.pop_front();
+    ++front_index_;
+    front_offset_ = 0;
+
+    // The front frame always has bytes to send
+    while (!frames_.empty() && frames_.front().bytes.empty()) {
+        frames_.pop_front();
+        ++front_index_;
+        --replaced_;
+    }
+}
+
+// Drop emptied frames once they are most of the queue, so a client that
+// never drains does not accumulate them; keyed positions are renumbered
+void SessionOutputQueue::compact()
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < frames_.size(); ++i) {
+        if (frames_[i].bytes.empty()) {
+            continue;
+        }
+        if (frames_[i].key != 0) {
+            keyed_[frames_[i].key] = front_index_ + kept;
+        }
+        if (kept != i) {
+            frames_[kept] = std::move(frames_[i]);
+        }
+        ++kept;
+    }
+    frames_.resize(kept);
+    replaced_ = 0;
+}
+
+SessionOutputQueue::Result SessionOutputQueue::overflow()
+{
+    if (config_.policy == SlowConsumerPolicy::DISCONNECT) {
+        return Result::DISCONNECT;
+    }
+    ++gap_;
+    ++drops_;
+    return Result::DROPPED;
+}
+
+} // namespace reuters_protocol
@@ -0,0 +1,111 @@
+#include "../include/subscription_index.h"
+#include <algorithm>
+
+namespace reuters_protocol {
+
+// Order within a subscriber list does not matter; swap out and pop
+static void erase_unordered(std::vector<ClientSession*>& sessions, ClientSession* session)
+{
+    auto it = std::find(sessions.begin(), sessions.end(), session);
+    if (it != sessions.end()) {
+        *it = sessions.back();
+        sessions.pop_back();
+    }
+}
+
+bool SubscriptionIndex::subscribe(ClientSession* session, uint32_t instrument_id)
+{
+    auto& subscriptions = by_session_[session];
+    if (subscriptions.all) {
+        return false;
+    }
+    auto& instruments = subscriptions.instruments;
+    if (std::find(instruments.begin(), instruments.end(), instrument_id) != instruments.end()) {
+        return false;
+    }
+
+    instruments.push_back(instrument_id);
+    by_instrument_[instrument_id].push_back(session);
+    return true;
+}
+
+bool SubscriptionIndex::unsubscribe(ClientSession* session, uint32_t instrument_id)
+{
+    auto it = by_session_.find(session);
+    if (it == by_session_.end()) {
+        return false;
+    }
+
+    auto& instruments = it->second.instruments;
+    auto found = std::find(instruments.begin(), instruments.end(), instrument_id);
+    if (found == instruments.end()) {
+        return false;
+    }
+    *found = instruments.back();
+    instruments.pop_back();
+    unlist(session, instrument_id);
+
+    if (!it->second.all && instruments.empty()) {
+        by_session_.erase(it);
+    }
+    return true;
+}
+
+void SubscriptionIndex::subscribe_all(ClientSession* session)
+{
+    auto& subscriptions = by_session_[session];
+    if (subscriptions.all) {
+        return;
+    }
+    for (uint32_t instrument_id : subscriptions.instruments) {
+        unlist(session, instrument_id);
+    }
+    subscriptions.instruments.clear();
+    subscriptions.all = true;
+    all_.push_back(session);
+}
+
+void SubscriptionIndex::remove(ClientSession* session)
+{
+    auto it = by_session_.find(session);
+    if (it == by_session_.end()) {
+        return;
+    }
+    if (it->second.all) {
+        erase_unordered(all_, session);
+    }
+    for (uint32_t instrument_id : it->second.instruments) {
+        unlist(session, instrument_id);
+    }
+    by_session_.erase(it);
+}
+
+size_t SubscriptionIndex::subscriber_count(uint32_t instrument_id) const
+{
+    auto it = by_instrument_.find(instrument_id);
+    return all_.size() + (it != by_instrument_.end() ? it->second.size() : 0);
+}
+
+bool SubscriptionIndex::is_subscribed(const ClientSession* session, uint32_t instrument_id) const
+{
+    auto it = by_session_.find(session);
+    if (it == by_session_.end()) {
+        return false;
+    }
+    const auto& instruments = it->second.instruments;
+    return it->second.all || std::find(instruments.begin(), instruments.end(), instrument_id) != instruments.end();
+}
+
+void SubscriptionIndex::unlist(ClientSession* session, uint32_t instrument_id)
+{
+    auto it = by_instrument_.find(instrument_id);
+    if (it == by_instrument_.end()) {
+        return;
+    }
+    erase_unordered(it->second, session);
+    if (it->second.empty()) {
+        by_instrument_.erase(it);
+    }
+}
+
+} // namespace reuters_protocol
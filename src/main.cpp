@@ -30,6 +30,7 @@ void print_usage(const char* program_name)
               << "Options:\n"
               << "  -c, --config FILE      Configuration file (default: config/server_config.json)\n"
               << "  -s, --scenario TYPE    Market scenario: normal, fast, thin, recovery\n"
+              << "  -b, --feed-b           Also publish incrementals to the config's incremental_feed_b\n"
               << "  -l, --list-scenarios   List available scenarios\n"
               << "  -v, --verbose          Enable verbose logging\n"
               << "  -h, --help             Show this help message\n\n"
@@ -48,10 +49,12 @@ int main(int argc, char* argv[])
     std::string config_file = "config/server_config.json";
     std::string scenario_name;
     bool verbose = false;
+    bool feed_b = false;
 
     static struct option long_options[] = {
         { "config", required_argument, 0, 'c' },
         { "scenario", required_argument, 0, 's' },
+        { "feed-b", no_argument, 0, 'b' },
         { "list-scenarios", no_argument, 0, 'l' },
         { "verbose", no_argument, 0, 'v' },
         { "help", no_argument, 0, 'h' },
@@ -59,7 +62,7 @@ int main(int argc, char* argv[])
     };
 
     int opt;
-    while ((opt = getopt_long(argc, argv, "c:s:lvh", long_options, nullptr)) != -1) {
+    while ((opt = getopt_long(argc, argv, "c:s:blvh", long_options, nullptr)) != -1) {
         switch (opt) {
         case 'c':
             config_file = optarg;
@@ -67,6 +70,9 @@ int main(int argc, char* argv[])
         case 's':
             scenario_name = optarg;
             break;
+        case 'b':
+            feed_b = true;
+            break;
         case 'l': {
             auto& scenario_mgr = cme_mock::ScenarioManager::instance();
             std::cout << "Available market scenarios:\n";
@@ -180,6 +186,15 @@ int main(int argc, char* argv[])
             std::cerr << "Failed to initialize incremental publisher" << std::endl;
             return 1;
         }
+        const auto& feed_b_config = config.network().incremental_feed_b;
+        if (feed_b && (feed_b_config.ip.empty() || feed_b_config.port == 0)) {
+            std::cerr << "No incremental_feed_b in " << config_file << std::endl;
+            return 1;
+        }
+        if (feed_b && !incremental_publisher->set_feed_b(feed_b_config.ip, feed_b_config.port)) {
+            std::cerr << "Failed to configure incremental feed B" << std::endl;
+            return 1;
+        }
 
         if (!definition_publisher->initialize()) {
             std::cerr << "Failed to initialize definition publisher" << std::endl;
@@ -190,7 +205,11 @@ int main(int argc, char* argv[])
         std::cout << "Snapshot feed: " << config.network().snapshot_feed.ip
                   << ":" << config.network().snapshot_feed.port << std::endl;
         std::cout << "Incremental feed: " << config.network().incremental_feed_a.ip
-                  << ":" << config.network().incremental_feed_a.port << std::endl;
+                  << ":" << config.network().incremental_feed_a.port;
+        if (feed_b) {
+            std::cout << " (B: " << feed_b_config.ip << ":" << feed_b_config.port << ")";
+        }
+        std::cout << std::endl;
         std::cout << "Definition feed: " << config.network().snapshot_feed.ip
                   << ":" << (config.network().snapshot_feed.port + 1) << std::endl;
 
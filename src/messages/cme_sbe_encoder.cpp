@@ -4,12 +4,6 @@
 
 namespace cme_mock {
 
-bool CMESBEEncoder::is_fx_instrument(uint32_t security_id)
-{
-    // FX instruments are security IDs 31-40 (Channel 330)
-    return security_id >= 31 && security_id <= 40;
-}
-
 std::vector<uint8_t> CMESBEEncoder::encode_packet_header(
     uint32_t sequence_number,
     uint64_t sending_time)
@@ -6,65 +6,11 @@
 namespace cme_mock {
 
 // SBEDecoder implementation
-uint8_t SBEDecoder::decode_uint8()
-{
-    if (!can_read(1))
-        return 0;
-    return buffer_[offset_++];
-}
-
-uint16_t SBEDecoder::decode_uint16()
-{
-    if (!can_read(2))
-        return 0;
-    uint16_t value = buffer_[offset_] | (buffer_[offset_ + 1] << 8);
-    offset_ += 2;
-    return value;
-}
-
-uint32_t SBEDecoder::decode_uint32()
-{
-    if (!can_read(4))
-        return 0;
-    uint32_t value = buffer_[offset_] | (buffer_[offset_ + 1] << 8) | (buffer_[offset_ + 2] << 16) | (buffer_[offset_ + 3] << 24);
-    offset_ += 4;
-    return value;
-}
-
-uint64_t SBEDecoder::decode_uint64()
-{
-    if (!can_read(8))
-        return 0;
-    uint64_t value = 0;
-    for (int i = 0; i < 8; ++i) {
-        value |= static_cast<uint64_t>(buffer_[offset_ + i]) << (i * 8);
-    }
-    offset_ += 8;
-    return value;
-}
-
-int32_t SBEDecoder::decode_int32()
-{
-    return static_cast<int32_t>(decode_uint32());
-}
-
-int64_t SBEDecoder::decode_int64()
-{
-    return static_cast<int64_t>(decode_uint64());
-}
-
-char SBEDecoder::decode_char()
-{
-    if (!can_read(1))
-        return 0;
-    return static_cast<char>(buffer_[offset_++]);
-}
-
 std::string SBEDecoder::decode_string(size_t length)
 {
     if (!can_read(length))
         return "";
-    std::string result(reinterpret_cast<const char*>(&buffer_[offset_]), length);
+    std::string result(reinterpret_cast<const char*>(data_ + offset_), length);
     offset_ += length;
     return result;
 }
@@ -77,7 +23,7 @@ double SBEDecoder::decode_price(uint8_t decimals)
 
 void SBEDecoder::skip(size_t bytes)
 {
-    offset_ = std::min(offset_ + bytes, buffer_.size());
+    offset_ += std::min(bytes, remaining());
 }
 
 // MDPMessageDecoder implementation
@@ -6,6 +6,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 namespace cme_mock {
@@ -15,6 +16,8 @@ UDPPublisher::UDPPublisher(const std::string& ip_address, uint16_t port)
     , port_(port)
     , socket_fd_(-1)
 {
+    std::memset(&dest_addr_, 0, sizeof(dest_addr_));
+    std::memset(&secondary_addr_, 0, sizeof(secondary_addr_));
 }
 
 UDPPublisher::~UDPPublisher()
@@ -24,6 +27,13 @@ UDPPublisher::~UDPPublisher()
 
 bool UDPPublisher::initialize()
 {
+    dest_addr_.sin_family = AF_INET;
+    dest_addr_.sin_port = htons(port_);
+    if (inet_pton(AF_INET, ip_address_.c_str(), &dest_addr_.sin_addr) <= 0) {
+        LOG_ERROR("Invalid IP address: " + ip_address_);
+        return false;
+    }
+
     // Create UDP socket
     socket_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
     if (socket_fd_ < 0) {
@@ -38,9 +48,8 @@ bool UDPPublisher::initialize()
     }
 
     // Check if this is a multicast address (224.0.0.0 to 239.255.255.255)
-    struct sockaddr_in addr;
-    if (inet_pton(AF_INET, ip_address_.c_str(), &addr.sin_addr) > 0) {
-        uint32_t ip_host = ntohl(addr.sin_addr.s_addr);
+    {
+        uint32_t ip_host = ntohl(dest_addr_.sin_addr.s_addr);
         if (ip_host >= 0xE0000000 && ip_host <= 0xEFFFFFFF) {
             // This is a multicast address, set multicast options
             LOG_INFO("Configuring multicast for address: " + ip_address_);
@@ -69,6 +78,22 @@ bool UDPPublisher::initialize()
     return true;
 }
 
+bool UDPPublisher::set_secondary_destination(const std::string& ip_address, uint16_t port)
+{
+    std::memset(&secondary_addr_, 0, sizeof(secondary_addr_));
+    secondary_addr_.sin_family = AF_INET;
+    secondary_addr_.sin_port = htons(port);
+    if (inet_pton(AF_INET, ip_address.c_str(), &secondary_addr_.sin_addr) <= 0) {
+        LOG_ERROR("Invalid IP address: " + ip_address);
+        return false;
+    }
+
+    secondary_ip_ = ip_address;
+    secondary_port_ = port;
+    LOG_INFO("UDP publisher also sending to " + ip_address + ":" + std::to_string(port));
+    return true;
+}
+
 bool UDPPublisher::send(const uint8_t* data, size_t length)
 {
     if (socket_fd_ < 0) {
@@ -76,19 +101,37 @@ bool UDPPublisher::send(const uint8_t* data, size_t length)
         return false;
     }
 
-    struct sockaddr_in dest_addr;
-    std::memset(&dest_addr, 0, sizeof(dest_addr));
-    dest_addr.sin_family = AF_INET;
-    dest_addr.sin_port = htons(port_);
+    if (!secondary_ip_.empty()) {
+        // Both datagrams share one iovec
+        struct iovec iov;
+        iov.iov_base = const_cast<uint8_t*>(data);
+        iov.iov_len = length;
+
+        struct mmsghdr messages[2];
+        std::memset(messages, 0, sizeof(messages));
+        messages[0].msg_hdr.msg_name = &dest_addr_;
+        messages[0].msg_hdr.msg_namelen = sizeof(dest_addr_);
+        messages[0].msg_hdr.msg_iov = &iov;
+        messages[0].msg_hdr.msg_iovlen = 1;
+        messages[1].msg_hdr = messages[0].msg_hdr;
+        messages[1].msg_hdr.msg_name = &secondary_addr_;
+
+        int sent_count = sendmmsg(socket_fd_, messages, 2, 0);
+        syscalls_++;
+        if (sent_count != 2) {
+            LOG_ERROR("Failed to send A/B UDP packet: " + std::string(strerror(errno)));
+            errors_++;
+            return false;
+        }
 
-    if (inet_pton(AF_INET, ip_address_.c_str(), &dest_addr.sin_addr) <= 0) {
-        LOG_ERROR("Invalid IP address: " + ip_address_);
-        errors_++;
-        return false;
+        messages_sent_ += 2;
+        bytes_sent_ += 2 * length;
+        return true;
     }
 
     ssize_t sent = sendto(socket_fd_, data, length, 0,
-        (struct sockaddr*)&dest_addr, sizeof(dest_addr));
+        (struct sockaddr*)&dest_addr_, sizeof(dest_addr_));
+    syscalls_++;
 
     if (sent < 0) {
         LOG_ERROR("Failed to send UDP packet: " + std::string(strerror(errno)));
@@ -123,14 +166,54 @@ void UDPPublisher::queue_message(const std::vector<uint8_t>& message)
 
 bool UDPPublisher::flush_queue()
 {
-    bool all_sent = true;
+    if (message_queue_.empty()) {
+        return true;
+    }
+    if (socket_fd_ < 0) {
+        LOG_ERROR("Socket not initialized");
+        message_queue_.clear();
+        return false;
+    }
+
+    // One header per datagram; with a secondary destination each message
+    // gets a second header over the same iovec
+    size_t destinations = secondary_ip_.empty() ? 1 : 2;
+    auto& iovecs = flush_iovecs_;
+    auto& headers = flush_headers_;
+    iovecs.resize(message_queue_.size());
+    headers.resize(message_queue_.size() * destinations);
+    std::memset(headers.data(), 0, headers.size() * sizeof(struct mmsghdr));
+    for (size_t i = 0; i < message_queue_.size(); ++i) {
+        iovecs[i].iov_base = message_queue_[i].data();
+        iovecs[i].iov_len = message_queue_[i].size();
+        for (size_t d = 0; d < destinations; ++d) {
+            struct msghdr& header = headers[i * destinations + d].msg_hdr;
+            header.msg_name = d == 0 ? &dest_addr_ : &secondary_addr_;
+            header.msg_namelen = sizeof(struct sockaddr_in);
+            header.msg_iov = &iovecs[i];
+            header.msg_iovlen = 1;
+        }
+    }
 
-    for (const auto& message : message_queue_) {
-        if (!send(message)) {
-            all_sent = false;
+    // sendmmsg() caps each call at UIO_MAXIOV headers
+    size_t offset = 0;
+    while (offset < headers.size()) {
+        int sent_count = sendmmsg(socket_fd_, headers.data() + offset,
+            static_cast<unsigned int>(headers.size() - offset), 0);
+        syscalls_++;
+        if (sent_count <= 0) {
+            LOG_ERROR("Failed to send queued UDP packets: " + std::string(strerror(errno)));
+            break;
+        }
+        for (int i = 0; i < sent_count; ++i) {
+            bytes_sent_ += headers[offset + i].msg_len;
         }
+        messages_sent_ += static_cast<uint64_t>(sent_count);
+        offset += static_cast<size_t>(sent_count);
     }
 
+    bool all_sent = offset == headers.size();
+    errors_ += headers.size() - offset;
     message_queue_.clear();
     return all_sent;
 }
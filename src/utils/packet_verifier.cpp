@@ -1,4 +1,5 @@
 #include "utils/packet_verifier.h"
+#include "messages/sbe_decoder.h"
 #include "utils/hexdump.h"
 #include "utils/logger.h"
 #include <iostream>
@@ -11,8 +12,6 @@ PacketVerificationResult PacketVerifier::verify_packet(const std::vector<uint8_t
     result.is_valid = false;
     result.error_message = "";
 
-    size_t offset = 0;
-
     try {
         // Step 1: Verify minimum packet size (header + at least one message)
         if (packet.size() < 14) { // 12 header + 2 size + 0 message minimum
@@ -21,90 +20,63 @@ PacketVerificationResult PacketVerifier::verify_packet(const std::vector<uint8_t
         }
 
         // Step 2: Parse packet header (12 bytes)
-        if (offset + 12 > packet.size()) {
-            result.error_message = "Cannot read packet header";
-            return result;
-        }
-
-        uint32_t sequence_number = packet[offset] | (packet[offset + 1] << 8) | (packet[offset + 2] << 16) | (packet[offset + 3] << 24);
+        MDPPacketView view(packet);
+        result.sequence_number = view.sequence_number();
+        result.sending_time = view.sending_time();
 
-        uint64_t sending_time = 0;
-        for (int i = 0; i < 8; ++i) {
-            sending_time |= (static_cast<uint64_t>(packet[offset + 4 + i]) << (i * 8));
-        }
-
-        result.sequence_number = sequence_number;
-        result.sending_time = sending_time;
-        offset += 12;
+        LOG_INFO("Packet header: seq=" + std::to_string(result.sequence_number) + ", time=" + std::to_string(result.sending_time));
 
-        LOG_INFO("Packet header: seq=" + std::to_string(sequence_number) + ", time=" + std::to_string(sending_time));
-
-        // Step 3: Walk through messages
+        // Step 3: Walk through messages in place; the view stops at the
+        // first size field that does not describe a whole message
         int message_count = 0;
-        while (offset < packet.size()) {
-            // Check if we have at least 2 bytes for message size
-            if (offset + 2 > packet.size()) {
-                result.error_message = "Incomplete message size field at offset " + std::to_string(offset);
-                return result;
-            }
-
-            // Read message size (2 bytes, little-endian)
-            uint16_t message_size = packet[offset] | (packet[offset + 1] << 8);
-            offset += 2;
-
-            LOG_INFO("Message " + std::to_string(message_count + 1) + ": size=" + std::to_string(message_size) + " bytes at offset " + std::to_string(offset - 2));
+        auto it = view.begin();
+        for (; it != view.end(); ++it) {
+            const MDPMessage& message = *it;
+            size_t size_offset = it.offset();
 
-            // Verify message size is reasonable
-            if (message_size == 0) {
-                result.error_message = "Zero-length message at offset " + std::to_string(offset - 2);
-                return result;
-            }
+            LOG_INFO("Message " + std::to_string(message_count + 1) + ": size=" + std::to_string(message.size) + " bytes at offset " + std::to_string(size_offset));
 
-            if (message_size > 1024) { // Reasonable max size
-                result.error_message = "Message too large: " + std::to_string(message_size) + " bytes at offset " + std::to_string(offset - 2);
+            if (message.size > 1024) { // Reasonable max size
+                result.error_message = "Message too large: " + std::to_string(message.size) + " bytes at offset " + std::to_string(size_offset);
                 return result;
             }
 
-            // Check if we have enough data for the message
-            if (offset + message_size > packet.size()) {
-                result.error_message = "Incomplete message: need " + std::to_string(message_size) + " bytes but only " + std::to_string(packet.size() - offset) + " available at offset " + std::to_string(offset);
-                return result;
-            }
-
-            // Parse SBE message header (first 8 bytes of message)
-            if (message_size < 8) {
-                result.error_message = "Message too small for SBE header: " + std::to_string(message_size) + " bytes";
-                return result;
-            }
-
-            uint16_t block_length = packet[offset] | (packet[offset + 1] << 8);
-            uint16_t template_id = packet[offset + 2] | (packet[offset + 3] << 8);
-            uint16_t schema_id = packet[offset + 4] | (packet[offset + 5] << 8);
-            uint16_t version = packet[offset + 6] | (packet[offset + 7] << 8);
-
             MessageInfo msg_info;
-            msg_info.size_field_offset = offset - 2;
-            msg_info.message_offset = offset;
-            msg_info.size = message_size;
-            msg_info.block_length = block_length;
-            msg_info.template_id = template_id;
-            msg_info.schema_id = schema_id;
-            msg_info.version = version;
+            msg_info.size_field_offset = size_offset;
+            msg_info.message_offset = size_offset + MDPPacketView::SIZE_FIELD;
+            msg_info.size = message.size;
+            msg_info.block_length = message.block_length;
+            msg_info.template_id = message.template_id;
+            msg_info.schema_id = message.schema_id;
+            msg_info.version = message.version;
 
             result.messages.push_back(msg_info);
 
-            LOG_INFO("  SBE header: blockLen=" + std::to_string(block_length) + ", templateId=" + std::to_string(template_id) + ", schemaId=" + std::to_string(schema_id) + ", version=" + std::to_string(version));
+            LOG_INFO("  SBE header: blockLen=" + std::to_string(message.block_length) + ", templateId=" + std::to_string(message.template_id) + ", schemaId=" + std::to_string(message.schema_id) + ", version=" + std::to_string(message.version));
 
-            // CRITICAL: Advance by exactly the message size (this is what client does)
-            offset += message_size;
             message_count++;
-
-            LOG_INFO("  Advanced to offset " + std::to_string(offset) + " (remaining: " + std::to_string(packet.size() - offset) + " bytes)");
         }
 
-        // Step 4: Verify we consumed exactly the entire packet
+        // Step 4: Verify we consumed exactly the entire packet, and if not
+        // explain why the walk stopped
+        size_t offset = it.offset();
         if (offset != packet.size()) {
-            result.error_message = "Packet parsing error: ended at offset " + std::to_string(offset) + " but packet size is " + std::to_string(packet.size());
+            if (offset + MDPPacketView::SIZE_FIELD > packet.size()) {
+                result.error_message = "Incomplete message size field at offset " + std::to_string(offset);
+                return result;
+            }
+
+            uint16_t message_size = load_le<uint16_t>(packet.data() + offset);
+            size_t available = packet.size() - offset - MDPPacketView::SIZE_FIELD;
+            if (message_size == 0) {
+                result.error_message = "Zero-length message at offset " + std::to_string(offset);
+            } else if (message_size > available) {
+                result.error_message = "Incomplete message: need " + std::to_string(message_size) + " bytes but only " + std::to_string(available) + " available at offset " + std::to_string(offset + MDPPacketView::SIZE_FIELD);
+            } else if (message_size < MDPMessage::HEADER_SIZE) {
+                result.error_message = "Message too small for SBE header: " + std::to_string(message_size) + " bytes";
+            } else {
+                result.error_message = "Packet parsing error: ended at offset " + std::to_string(offset) + " but packet size is " + std::to_string(packet.size());
+            }
             return result;
         }
 
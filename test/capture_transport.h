@@ -0,0 +1,55 @@
+#pragma once
+
+#include "protocol_adapter.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Keeps every packet and the thread that sent it; can be held shut to
+// let a sender's queue fill, and can fail every Nth packet. Read packets
+// directly once the senders have stopped, or through size() meanwhile.
+class CaptureTransport : public market_protocols::IMessageTransport {
+public:
+    std::vector<std::vector<uint8_t>> packets;
+    std::vector<std::thread::id> threads;
+    std::atomic<bool> hold { false };
+    size_t fail_every = 0;
+    size_t batches = 0;
+
+    bool send_message(const std::vector<uint8_t>& data) override
+    {
+        return send_packet(data.data(), data.size());
+    }
+    bool send_packet(const uint8_t* data, size_t length) override
+    {
+        while (hold.load()) {
+            std::this_thread::yield();
+        }
+        ++attempts_;
+        if (fail_every != 0 && attempts_ % fail_every == 0) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        packets.emplace_back(data, data + length);
+        threads.push_back(std::this_thread::get_id());
+        return true;
+    }
+    size_t send_packets(const market_protocols::PacketRef* refs, size_t count) override
+    {
+        ++batches;
+        return IMessageTransport::send_packets(refs, count);
+    }
+    std::string get_transport_type() const override { return "CAPTURE"; }
+    bool is_connected() const override { return true; }
+
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return packets.size();
+    }
+
+private:
+    std::mutex mutex_;
+    size_t attempts_ = 0;
+};
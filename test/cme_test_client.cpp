@@ -125,48 +125,36 @@ private:
         }
         std::cout << std::dec << std::endl;
 
-        cme_mock::SBEDecoder decoder(data);
-
-        // Decode packet header
-        uint32_t seq_num;
-        uint64_t sending_time;
-        if (!cme_mock::MDPMessageDecoder::decode_packet_header(decoder, seq_num, sending_time)) {
+        cme_mock::MDPPacketView packet(data);
+        if (!packet.valid()) {
             LOG_WARNING("Failed to decode packet header");
             std::cout << "Failed to decode packet header" << std::endl;
             return;
         }
-
-        // Decode message size field (uint16)
-        if (!decoder.can_read(2)) {
-            std::cout << "Failed to decode message size field" << std::endl;
-            return;
-        }
-        uint16_t message_size = decoder.decode_uint16();
-        std::cout << "Message size: " << message_size << " bytes" << std::endl;
-
-        // Decode message header
-        uint16_t block_length, schema_id, version;
-        uint16_t template_id = cme_mock::MDPMessageDecoder::decode_message_header(
-            decoder, block_length, schema_id, version);
-
-        std::cout << "[HEADER] Seq: " << seq_num << ", Template: " << template_id
-                  << ", Schema: " << schema_id << ", Version: " << version
-                  << ", Block: " << block_length << std::endl;
-
-        if (template_id == cme_mock::TEMPLATE_SNAPSHOT_FULL_REFRESH || template_id == cme_mock::TEMPLATE_FX_SNAPSHOT_FULL_REFRESH) {
-            cme_mock::SnapshotFullRefresh snapshot;
-            snapshot.header.sequence_number = seq_num;
-            snapshot.header.sending_time = sending_time;
-
-            if (cme_mock::MDPMessageDecoder::decode_snapshot_full_refresh(decoder, snapshot)) {
-                process_snapshot(snapshot);
-                snapshots_received_++;
-                last_snapshot_seq_ = seq_num;
+        uint32_t seq_num = packet.sequence_number();
+
+        for (const auto& message : packet) {
+            std::cout << "Message size: " << message.size << " bytes" << std::endl;
+            std::cout << "[HEADER] Seq: " << seq_num << ", Template: " << message.template_id
+                      << ", Schema: " << message.schema_id << ", Version: " << message.version
+                      << ", Block: " << message.block_length << std::endl;
+
+            if (message.template_id == cme_mock::TEMPLATE_SNAPSHOT_FULL_REFRESH || message.template_id == cme_mock::TEMPLATE_FX_SNAPSHOT_FULL_REFRESH) {
+                cme_mock::SnapshotFullRefresh snapshot;
+                snapshot.header.sequence_number = seq_num;
+                snapshot.header.sending_time = packet.sending_time();
+
+                auto body = message.body();
+                if (cme_mock::MDPMessageDecoder::decode_snapshot_full_refresh(body, snapshot)) {
+                    process_snapshot(snapshot);
+                    snapshots_received_++;
+                    last_snapshot_seq_ = seq_num;
+                } else {
+                    std::cout << "Failed to decode snapshot message" << std::endl;
+                }
             } else {
-                std::cout << "Failed to decode snapshot message" << std::endl;
+                std::cout << "Unknown template ID: " << message.template_id << std::endl;
             }
-        } else {
-            std::cout << "Unknown template ID: " << template_id << std::endl;
         }
     }
 
@@ -181,47 +169,35 @@ private:
         }
         std::cout << std::dec << std::endl;
 
-        cme_mock::SBEDecoder decoder(data);
-
-        // Decode packet header
-        uint32_t seq_num;
-        uint64_t sending_time;
-        if (!cme_mock::MDPMessageDecoder::decode_packet_header(decoder, seq_num, sending_time)) {
+        cme_mock::MDPPacketView packet(data);
+        if (!packet.valid()) {
             std::cout << "Failed to decode packet header" << std::endl;
             return;
         }
-
-        // Decode message size field (uint16)
-        if (!decoder.can_read(2)) {
-            std::cout << "Failed to decode message size field" << std::endl;
-            return;
-        }
-        uint16_t message_size = decoder.decode_uint16();
-        std::cout << "Message size: " << message_size << " bytes" << std::endl;
-
-        // Decode message header
-        uint16_t block_length, schema_id, version;
-        uint16_t template_id = cme_mock::MDPMessageDecoder::decode_message_header(
-            decoder, block_length, schema_id, version);
-
-        std::cout << "[HEADER] Seq: " << seq_num << ", Template: " << template_id
-                  << ", Schema: " << schema_id << ", Version: " << version
-                  << ", Block: " << block_length << std::endl;
-
-        if (template_id == cme_mock::TEMPLATE_INCREMENTAL_REFRESH_BOOK || template_id == cme_mock::TEMPLATE_FX_INCREMENTAL_REFRESH_BOOK || template_id == cme_mock::TEMPLATE_FX_INCREMENTAL_REFRESH_TRADE) {
-            cme_mock::IncrementalRefresh incremental;
-            incremental.header.sequence_number = seq_num;
-            incremental.header.sending_time = sending_time;
-
-            if (cme_mock::MDPMessageDecoder::decode_incremental_refresh(decoder, incremental)) {
-                process_incremental(incremental);
-                incrementals_received_++;
-                last_incremental_seq_ = seq_num;
+        uint32_t seq_num = packet.sequence_number();
+
+        for (const auto& message : packet) {
+            std::cout << "Message size: " << message.size << " bytes" << std::endl;
+            std::cout << "[HEADER] Seq: " << seq_num << ", Template: " << message.template_id
+                      << ", Schema: " << message.schema_id << ", Version: " << message.version
+                      << ", Block: " << message.block_length << std::endl;
+
+            if (message.template_id == cme_mock::TEMPLATE_INCREMENTAL_REFRESH_BOOK || message.template_id == cme_mock::TEMPLATE_FX_INCREMENTAL_REFRESH_BOOK || message.template_id == cme_mock::TEMPLATE_FX_INCREMENTAL_REFRESH_TRADE) {
+                cme_mock::IncrementalRefresh incremental;
+                incremental.header.sequence_number = seq_num;
+                incremental.header.sending_time = packet.sending_time();
+
+                auto body = message.body();
+                if (cme_mock::MDPMessageDecoder::decode_incremental_refresh(body, incremental)) {
+                    process_incremental(incremental);
+                    incrementals_received_++;
+                    last_incremental_seq_ = seq_num;
+                } else {
+                    std::cout << "Failed to decode incremental message" << std::endl;
+                }
             } else {
-                std::cout << "Failed to decode incremental message" << std::endl;
+                std::cout << "Unknown template ID: " << message.template_id << std::endl;
             }
-        } else {
-            std::cout << "Unknown template ID: " << template_id << std::endl;
         }
     }
 
@@ -17,37 +17,30 @@ void analyze_message(const std::vector<uint8_t>& data)
     }
     std::cout << std::dec << std::endl;
 
-    cme_mock::SBEDecoder decoder(data);
-
-    // Try to decode packet header
-    uint32_t seq_num;
-    uint64_t sending_time;
-    if (cme_mock::MDPMessageDecoder::decode_packet_header(decoder, seq_num, sending_time)) {
-        std::cout << "Packet Header - Seq: " << seq_num << ", Time: " << sending_time << std::endl;
-
-        // Try to decode message header
-        uint16_t block_length, schema_id, version;
-        uint16_t template_id = cme_mock::MDPMessageDecoder::decode_message_header(
-            decoder, block_length, schema_id, version);
+    cme_mock::MDPPacketView packet(data);
+    if (!packet.valid()) {
+        std::cout << "Failed to decode packet header" << std::endl;
+        return;
+    }
+    std::cout << "Packet Header - Seq: " << packet.sequence_number() << ", Time: " << packet.sending_time() << std::endl;
 
-        std::cout << "Message Header - Template: " << template_id
-                  << ", Schema: " << schema_id << ", Version: " << version
-                  << ", Block Length: " << block_length << std::endl;
+    for (const auto& message : packet) {
+        std::cout << "Message Header - Template: " << message.template_id
+                  << ", Schema: " << message.schema_id << ", Version: " << message.version
+                  << ", Block Length: " << message.block_length << std::endl;
 
         // Identify message type
-        if (template_id == cme_mock::TEMPLATE_SNAPSHOT_FULL_REFRESH) {
+        if (message.template_id == cme_mock::TEMPLATE_SNAPSHOT_FULL_REFRESH) {
             std::cout << "Message Type: SNAPSHOT_FULL_REFRESH" << std::endl;
-        } else if (template_id == cme_mock::TEMPLATE_INCREMENTAL_REFRESH_BOOK) {
+        } else if (message.template_id == cme_mock::TEMPLATE_INCREMENTAL_REFRESH_BOOK) {
             std::cout << "Message Type: INCREMENTAL_REFRESH_BOOK" << std::endl;
-        } else if (template_id == cme_mock::TEMPLATE_ADMIN_HEARTBEAT) {
+        } else if (message.template_id == cme_mock::TEMPLATE_ADMIN_HEARTBEAT) {
             std::cout << "Message Type: ADMIN_HEARTBEAT" << std::endl;
-        } else if (template_id == cme_mock::TEMPLATE_CHANNEL_RESET) {
+        } else if (message.template_id == cme_mock::TEMPLATE_CHANNEL_RESET) {
             std::cout << "Message Type: CHANNEL_RESET" << std::endl;
         } else {
-            std::cout << "Message Type: UNKNOWN (ID: " << template_id << ")" << std::endl;
+            std::cout << "Message Type: UNKNOWN (ID: " << message.template_id << ")" << std::endl;
         }
-    } else {
-        std::cout << "Failed to decode packet header" << std::endl;
     }
 }
 
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <cstdint>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+// Non-blocking UDP socket bound to an ephemeral loopback port. A
+// receive_buffer above 0 sets SO_RCVBUF, so a burst sent before the
+// test drains is not dropped by the kernel.
+class Receiver {
+public:
+    explicit Receiver(int receive_buffer = 0)
+    {
+        fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+        if (receive_buffer > 0) {
+            setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &receive_buffer, sizeof(receive_buffer));
+        }
+
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+
+        socklen_t length = sizeof(addr);
+        getsockname(fd_, reinterpret_cast<struct sockaddr*>(&addr), &length);
+        port_ = ntohs(addr.sin_port);
+    }
+    ~Receiver() { ::close(fd_); }
+
+    Receiver(const Receiver&) = delete;
+    Receiver& operator=(const Receiver&) = delete;
+
+    uint16_t port() const { return port_; }
+
+    // Every datagram waiting on the socket
+    std::vector<std::vector<uint8_t>> drain()
+    {
+        std::vector<std::vector<uint8_t>> packets;
+        uint8_t buffer[2048];
+        ssize_t received;
+        while ((received = recv(fd_, buffer, sizeof(buffer), 0)) > 0) {
+            packets.emplace_back(buffer, buffer + received);
+        }
+        return packets;
+    }
+
+private:
+    int fd_;
+    uint16_t port_ = 0;
+};
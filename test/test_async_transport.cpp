@@ -0,0 +1,217 @@
+#include "async_transport.h"
+#include "capture_transport.h"
+#include "test_check.h"
+#include "udp_transport.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace market_protocols;
+
+static std::vector<uint8_t> make_packet(uint32_t sequence, size_t length)
+{
+    std::vector<uint8_t> packet(length, static_cast<uint8_t>(sequence));
+    std::memcpy(packet.data(), &sequence, sizeof(sequence));
+    return packet;
+}
+
+static void wait_for(const std::function<bool()>& done)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!done() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+int main()
+{
+    std::cout << "Testing Async Transport\n"
+              << std::endl;
+
+    // Test 1: Packets reach the inner transport in order, from the sender
+    // thread, in batches
+    std::cout << "=== Test 1: Ordered Hand-Off ===" << std::endl;
+    {
+        auto capture = std::make_shared<CaptureTransport>();
+        AsyncTransport::Config config;
+        config.slots = 256;
+        AsyncTransport transport(capture, config);
+        transport.start();
+
+        std::vector<std::vector<uint8_t>> sent;
+        for (uint32_t i = 0; i < 2000; ++i) {
+            sent.push_back(make_packet(i, 40 + i % 200));
+            check(transport.send_message(sent.back()), "queued");
+        }
+        transport.stop();
+
+        check(capture->packets == sent, "every packet, in order, byte for byte");
+        bool off_thread = true;
+        for (const auto& id : capture->threads) {
+            off_thread &= id != std::this_thread::get_id();
+        }
+        check(off_thread, "sent from the sender thread");
+        check(capture->batches < sent.size(), "runs handed over as batches");
+        check(transport.packets_queued() == 2000 && transport.packets_sent() == 2000, "counters");
+        check(transport.queue_depth() == 0, "queue drained");
+        check(transport.send_latency().count() == 2000, "latency recorded per packet");
+        check(transport.get_transport_type() == "ASYNC-CAPTURE", "transport type");
+    }
+
+    // Test 2: DROP fails sends once every slot is in flight
+    std::cout << "=== Test 2: Drop Policy ===" << std::endl;
+    {
+        auto capture = std::make_shared<CaptureTransport>();
+        capture->hold = true;
+        AsyncTransport::Config config;
+        config.slots = 16;
+        config.overflow = AsyncTransport::OverflowPolicy::DROP;
+        AsyncTransport transport(capture, config);
+        transport.start();
+
+        size_t accepted = 0;
+        for (uint32_t i = 0; i < 100; ++i) {
+            accepted += transport.send_message(make_packet(i, 64)) ? 1 : 0;
+        }
+        check(accepted == 16, "one packet per slot accepted");
+        check(transport.drops() == 84, "the rest dropped and counted");
+
+        capture->hold = false;
+        wait_for([&] { return capture->size() == 16; });
+        check(transport.send_message(make_packet(100, 64)), "slots recycled once sent");
+        transport.stop();
+        check(capture->packets.size() == 17, "accepted packets all sent");
+        check(transport.max_queue_depth() >= 1, "queue depth tracked");
+    }
+
+    // Test 3: BLOCK waits for the sender instead of losing packets
+    std::cout << "=== Test 3: Back-Pressure ===" << std::endl;
+    {
+        auto capture = std::make_shared<CaptureTransport>();
+        capture->hold = true;
+        AsyncTransport::Config config;
+        config.slots = 8;
+        AsyncTransport transport(capture, config);
+        transport.start();
+
+        std::thread release([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            capture->hold = false;
+        });
+        for (uint32_t i = 0; i < 100; ++i) {
+            transport.send_message(make_packet(i, 64));
+        }
+        release.join();
+        transport.stop();
+
+        check(capture->packets.size() == 100, "nothing lost");
+        check(transport.backpressure_waits() > 0, "waits counted");
+        check(transport.drops() == 0, "no drops");
+    }
+
+    // Test 4: Oversized packets and inner failures are counted, and a
+    // failure does not hold up the packets behind it
+    std::cout << "=== Test 4: Failures ===" << std::endl;
+    {
+        auto capture = std::make_shared<CaptureTransport>();
+        capture->fail_every = 3;
+        AsyncTransport::Config config;
+        config.slot_size = 128;
+        AsyncTransport transport(capture, config);
+        transport.start();
+
+        check(!transport.send_message(make_packet(0, 129)), "oversized packet refused");
+        for (uint32_t i = 0; i < 30; ++i) {
+            transport.send_message(make_packet(i, 64));
+        }
+        transport.stop();
+
+        check(transport.oversize_drops() == 1, "oversize counted");
+        check(transport.send_failures() == 10, "every third send failed");
+        check(transport.packets_sent() == 20 && capture->packets.size() == 20, "the rest went out");
+    }
+
+    // Test 5: Histogram buckets and percentiles
+    std::cout << "=== Test 5: Latency Histogram ===" << std::endl;
+    {
+        LatencyHistogram histogram;
+        check(histogram.percentile(0.5) == 0, "empty");
+        for (int i = 0; i < 90; ++i) {
+            histogram.record(100); // [64, 128)
+        }
+        for (int i = 0; i < 10; ++i) {
+            histogram.record(5000); // [4096, 8192)
+        }
+        histogram.record(0);
+        check(histogram.count() == 101, "count");
+        check(histogram.bucket_count(0) == 1 && histogram.bucket_count(7) == 90 && histogram.bucket_count(13) == 10, "buckets");
+        check(histogram.percentile(0.5) == 127, "median bucket");
+        check(histogram.percentile(0.99) == 8191, "tail bucket");
+        check(histogram.max() == 5000, "max");
+    }
+
+    // Benchmark: time on the encoding thread per packet, synchronous
+    // sendto against the async hand-off
+    std::cout << "\n=== Benchmark ===" << std::endl;
+    {
+        int receiver = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(receiver, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+        socklen_t length = sizeof(addr);
+        getsockname(receiver, reinterpret_cast<struct sockaddr*>(&addr), &length);
+        uint16_t port = ntohs(addr.sin_port);
+
+        // Bursts that fit the queue, with room to drain in between, as
+        // the generator produces them
+        std::vector<uint8_t> packet(200, 0x5A);
+        const int bursts = 50;
+        const int burst_size = 1000;
+        auto time_bursts = [&](IMessageTransport& transport) {
+            std::chrono::nanoseconds busy { 0 };
+            for (int b = 0; b < bursts; ++b) {
+                auto start = std::chrono::steady_clock::now();
+                for (int i = 0; i < burst_size; ++i) {
+                    transport.send_packet(packet.data(), packet.size());
+                }
+                busy += std::chrono::steady_clock::now() - start;
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            return static_cast<double>(busy.count()) / (bursts * burst_size);
+        };
+
+        auto udp = std::make_shared<UDPTransport>("127.0.0.1", port);
+        udp->initialize();
+        double direct_ns = time_bursts(*udp);
+
+        AsyncTransport transport(udp);
+        transport.start();
+        double async_ns = time_bursts(transport);
+        transport.stop();
+        ::close(receiver);
+
+        const auto& latency = transport.send_latency();
+        std::cout << "  Synchronous sendto: " << direct_ns << " ns/packet on the caller" << std::endl;
+        std::cout << "  Async hand-off:     " << async_ns << " ns/packet on the caller, "
+                  << transport.backpressure_waits() << " back-pressure waits" << std::endl;
+        std::cout << "  Enqueue-to-send:    p50 < " << latency.percentile(0.5) << " ns, p99 < "
+                  << latency.percentile(0.99) << " ns, max " << latency.max() << " ns" << std::endl;
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll async transport tests passed!" << std::endl;
+    return 0;
+}
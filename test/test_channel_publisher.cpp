@@ -0,0 +1,187 @@
+#include "capture_transport.h"
+#include "cme_channel_publisher.h"
+#include "cme_encoder.h"
+#include "market_data_generator.h"
+#include "test_check.h"
+#include <cstring>
+#include <iostream>
+
+using namespace market_core;
+
+static std::shared_ptr<FuturesInstrument> make_instrument(uint32_t id, const std::string& group)
+{
+    auto instrument = std::make_shared<FuturesInstrument>(id, group + std::to_string(id));
+    instrument->tick_size = 0.25;
+    instrument->set_property("initial_price", 4500.0);
+    instrument->set_property("product_group", group);
+    return instrument;
+}
+
+// Security IDs of the template 46 entries in a packet
+static std::vector<uint32_t> entry_security_ids(const std::vector<uint8_t>& packet)
+{
+    std::vector<uint32_t> ids;
+    size_t offset = 12;
+    while (offset + 2 <= packet.size()) {
+        uint16_t size;
+        std::memcpy(&size, packet.data() + offset, 2);
+        char* message = const_cast<char*>(reinterpret_cast<const char*>(packet.data() + offset + 2));
+
+        cme_sbe::MessageHeader header(message, size);
+        if (header.templateId() == cme_sbe::MDIncrementalRefreshBook46::sbeTemplateId()) {
+            cme_sbe::MDIncrementalRefreshBook46 decoded;
+            decoded.wrapForDecode(message, header.encodedLength(), header.blockLength(), header.version(), size);
+            auto& entries = decoded.noMDEntries();
+            while (entries.hasNext()) {
+                ids.push_back(static_cast<uint32_t>(entries.next().securityID()));
+            }
+        }
+        offset += 2 + size;
+    }
+    return ids;
+}
+
+int main()
+{
+    std::cout << "Testing CME Channel Publisher\n"
+              << std::endl;
+
+    // Test 1: Instruments map to channels from configuration
+    std::cout << "=== Test 1: Channel Registry ===" << std::endl;
+    {
+        cme_protocol::CMEChannelConfig equity;
+        equity.channel_id = 310;
+        equity.product_groups = { "Equity" };
+        cme_protocol::CMEChannelConfig fx;
+        fx.channel_id = 330;
+        fx.product_groups = { "FX" };
+        fx.instrument_ids = { 7 };
+
+        cme_protocol::CMEChannelRegistry registry;
+        check(registry.add_channel(equity) == 0 && registry.add_channel(fx) == 1, "channel indices");
+
+        check(registry.assign(*make_instrument(1, "Equity")) == 0, "product group to equity channel");
+        check(registry.assign(*make_instrument(2, "FX")) == 1, "product group to FX channel");
+        check(registry.assign(*make_instrument(7, "Equity")) == 1, "explicit ID beats product group");
+        check(registry.assign(*make_instrument(3, "Rates")) == 0, "unclaimed to the first channel");
+        check(registry.channel_index(99) == 0, "unknown instrument to the first channel");
+
+        uint32_t large = cme_protocol::CMEChannelRegistry::MAX_DENSE_ID + 3;
+        check(registry.assign(*make_instrument(large, "FX")) == 1 && registry.channel_index(large) == 1,
+            "large IDs use the sparse fallback");
+
+        check(registry.instruments(0) == std::vector<uint32_t>({ 1, 3 }), "equity members");
+        check(registry.instruments(1) == std::vector<uint32_t>({ 2, 7, large }), "FX members");
+
+        // Re-assignment moves the instrument between member lists
+        check(registry.assign(*make_instrument(2, "Equity")) == 0, "re-assigned");
+        check(registry.instruments(1) == std::vector<uint32_t>({ 7, large }), "left its old channel");
+        check(registry.find(330) == &registry.channels()[1] && registry.find(320) == nullptr, "find by channel ID");
+
+        // Channels as listed in a server config
+        const std::string json = R"({
+            "network": { "incremental_feed_a": { "ip": "224.0.28.64", "port": 14310 } },
+            "channels": [
+                { "id": 310, "name": "Equity", "product_groups": ["Equity"] },
+                { "id": 330, "name": "FX [Spot+]", "product_groups": ["FX", "Metals"],
+                  "instrument_ids": [7, 8], "cpu": 3,
+                  "incremental_feed": { "ip": "224.0.28.66", "port": 14312 } }
+            ],
+            "instruments": [ { "security_id": 1, "product_group": "Equity" } ]
+        })";
+        std::vector<cme_protocol::CMEChannelConfig> configured;
+        check(cme_protocol::CMEChannelRegistry::parse_channels(json, configured) && configured.size() == 2,
+            "two channels parsed");
+        if (configured.size() == 2) {
+            check(configured[0].channel_id == 310 && configured[0].product_groups == std::vector<std::string>({ "Equity" })
+                    && configured[0].incremental_ip.empty() && configured[0].cpu == -1,
+                "first channel");
+            check(configured[1].channel_id == 330 && configured[1].name == "FX [Spot+]"
+                    && configured[1].product_groups == std::vector<std::string>({ "FX", "Metals" })
+                    && configured[1].instrument_ids == std::vector<uint32_t>({ 7, 8 }) && configured[1].cpu == 3,
+                "second channel");
+            check(configured[1].incremental_ip == "224.0.28.66" && configured[1].incremental_port == 14312,
+                "second channel feed");
+        }
+        configured.clear();
+        check(!cme_protocol::CMEChannelRegistry::parse_channels(R"({ "channels": [ { "name": "no id" } ] })", configured)
+                && !cme_protocol::CMEChannelRegistry::parse_channels("{}", configured)
+                && !cme_protocol::CMEChannelRegistry::load_channels("/nonexistent/config.json", configured),
+            "no channels");
+    }
+
+    // Test 2: Each channel publishes its own instruments in its own
+    // sequence space, from its own thread
+    std::cout << "=== Test 2: Multi-Channel Publishing ===" << std::endl;
+    {
+        auto manager = std::make_shared<OrderBookManager>();
+        for (uint32_t id = 1; id <= 12; ++id) {
+            auto instrument = make_instrument(id, id <= 8 ? "Equity" : "FX");
+            manager->add_instrument(instrument);
+            manager->create_order_book(id);
+        }
+
+        auto publisher = std::make_shared<cme_protocol::CMEMultiChannelPublisher>(manager);
+        std::vector<std::shared_ptr<CaptureTransport>> transports;
+        for (uint16_t channel_id : { 310, 330 }) {
+            cme_protocol::CMEChannelConfig config;
+            config.channel_id = channel_id;
+            config.product_groups = { channel_id == 310 ? "Equity" : "FX" };
+            config.queue_capacity = 64; // Exercise back-pressure
+            auto& channel = publisher->add_channel(config);
+
+            transports.push_back(std::make_shared<CaptureTransport>());
+            channel.adapter()->set_transport(transports.back());
+            channel.adapter()->set_batch_size(1000);
+        }
+        publisher->assign_instruments();
+        check(publisher->registry().instruments(1).size() == 4, "four FX instruments");
+
+        MarketDataGenerator generator(manager);
+        generator.add_record_listener(publisher);
+        publisher->start();
+        for (int i = 0; i < 20; ++i) {
+            generator.generate_batch(500);
+        }
+        publisher->stop();
+
+        const auto& stats = generator.get_statistics();
+        uint64_t events = stats.quotes_generated + stats.trades_generated + stats.orders_generated;
+        uint64_t published = publisher->channel_at(0).events_published() + publisher->channel_at(1).events_published();
+        std::cout << "  " << events << " events, " << publisher->channel_at(0).events_published() << " on 310, "
+                  << publisher->channel_at(1).events_published() << " on 330, "
+                  << publisher->channel_at(0).queue_full_waits() + publisher->channel_at(1).queue_full_waits()
+                  << " full-queue waits" << std::endl;
+        check(published == events, "every event published once");
+        check(publisher->channel_at(0).backlog() == 0 && publisher->channel_at(1).backlog() == 0, "queues drained");
+
+        for (size_t c = 0; c < 2; ++c) {
+            const auto& packets = transports[c]->packets;
+            bool contiguous = !packets.empty();
+            bool own_instruments = true;
+            size_t entries = 0;
+            for (size_t i = 0; i < packets.size(); ++i) {
+                uint32_t sequence;
+                std::memcpy(&sequence, packets[i].data(), 4);
+                contiguous &= sequence == i + 1;
+                for (uint32_t id : entry_security_ids(packets[i])) {
+                    own_instruments &= publisher->registry().channel_index(id) == c;
+                    ++entries;
+                }
+            }
+            std::string name = c == 0 ? "310" : "330";
+            check(contiguous, name + " sequence numbers start at 1 and are contiguous");
+            check(own_instruments, name + " carries only its own instruments");
+            check(entries == publisher->channel_at(c).events_published(), name + " entry per event");
+        }
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll channel publisher tests passed!" << std::endl;
+    return 0;
+}
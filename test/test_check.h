@@ -0,0 +1,16 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+
+// Shared by the test programs: check() reports a failed condition and
+// counts it; main() returns non-zero when failures > 0.
+inline int failures = 0;
+
+inline void check(bool condition, const std::string& what)
+{
+    if (!condition) {
+        std::cout << "  FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
@@ -0,0 +1,292 @@
+#include "capture_transport.h"
+#include "cme_encoder.h"
+#include "cme_event_listener.h"
+#include "cme_protocol_adapter.h"
+#include "market_data_generator.h"
+#include "order_book_manager.h"
+#include "test_check.h"
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+using namespace market_core;
+
+// Walk the size-prefixed messages after the 12-byte packet header
+static size_t count_messages(const std::vector<uint8_t>& packet)
+{
+    size_t count = 0;
+    size_t offset = 12;
+    while (offset + 2 <= packet.size()) {
+        uint16_t size;
+        std::memcpy(&size, packet.data() + offset, 2);
+        offset += 2 + size;
+        ++count;
+    }
+    return offset == packet.size() ? count : 0;
+}
+
+struct BookMessage {
+    uint8_t match_event_indicator;
+    uint8_t entries;
+};
+
+// Template 46 messages in a packet. Offsets past the 8-byte SBE header:
+// matchEventIndicator at 8, NoMDEntries numInGroup at blockLength + 2.
+static std::vector<BookMessage> book_messages(const std::vector<uint8_t>& packet)
+{
+    std::vector<BookMessage> messages;
+    size_t offset = 12;
+    while (offset + 2 <= packet.size()) {
+        uint16_t size;
+        uint16_t block_length;
+        uint16_t template_id;
+        std::memcpy(&size, packet.data() + offset, 2);
+        const uint8_t* message = packet.data() + offset + 2;
+        std::memcpy(&block_length, message, 2);
+        std::memcpy(&template_id, message + 2, 2);
+        if (template_id == 46) {
+            messages.push_back({ message[8 + 8], message[8 + block_length + 2] });
+        }
+        offset += 2 + size;
+    }
+    return messages;
+}
+
+static uint32_t packet_sequence(const std::vector<uint8_t>& packet)
+{
+    uint32_t sequence;
+    std::memcpy(&sequence, packet.data(), 4);
+    return sequence;
+}
+
+struct Fixture {
+    std::shared_ptr<OrderBookManager> manager = std::make_shared<OrderBookManager>();
+    std::shared_ptr<MarketDataGenerator> generator;
+    std::shared_ptr<CaptureTransport> transport = std::make_shared<CaptureTransport>();
+    std::shared_ptr<cme_protocol::CMEProtocolAdapter> adapter = std::make_shared<cme_protocol::CMEProtocolAdapter>();
+    std::shared_ptr<cme_protocol::CMEEventListener> listener;
+
+    explicit Fixture(uint32_t instruments)
+    {
+        for (uint32_t id = 1; id <= instruments; ++id) {
+            auto instrument = std::make_shared<FuturesInstrument>(id, "ES" + std::to_string(id));
+            instrument->tick_size = 0.25;
+            instrument->set_property("initial_price", 4500.0);
+            manager->add_instrument(instrument);
+            manager->create_order_book(id);
+        }
+
+        generator = std::make_shared<MarketDataGenerator>(manager);
+        adapter->set_transport(transport);
+        adapter->set_batch_size(1000);
+        listener = std::make_shared<cme_protocol::CMEEventListener>(manager, adapter);
+        generator->add_listener(listener);
+    }
+
+    uint64_t events() const
+    {
+        const auto& stats = generator->get_statistics();
+        return stats.quotes_generated + stats.trades_generated + stats.orders_generated;
+    }
+};
+
+int main()
+{
+    std::cout << "Testing CME Protocol Adapter\n"
+              << std::endl;
+
+    // Test 1: Single updates keep one packet per message
+    std::cout << "=== Test 1: Unbatched Updates ===" << std::endl;
+    {
+        Fixture fixture(2);
+        for (int i = 0; i < 50; ++i) {
+            fixture.generator->generate_update(static_cast<uint32_t>(i % 2 + 1));
+        }
+
+        check(fixture.transport->packets.size() == fixture.events(), "one packet per event");
+        for (const auto& packet : fixture.transport->packets) {
+            check(count_messages(packet) == 1, "single message packet");
+        }
+    }
+
+    // Test 2: A generated batch is packed into MTU-sized packets
+    std::cout << "=== Test 2: Batched Packing ===" << std::endl;
+    {
+        Fixture fixture(8);
+        fixture.generator->generate_batch(2000);
+
+        const auto& packets = fixture.transport->packets;
+        size_t messages = 0;
+        bool within_mtu = true;
+        bool contiguous = true;
+        for (size_t i = 0; i < packets.size(); ++i) {
+            messages += count_messages(packets[i]);
+            within_mtu &= packets[i].size() <= fixture.adapter->max_message_size();
+            contiguous &= packet_sequence(packets[i]) == i + 1;
+        }
+
+        std::cout << "  " << fixture.events() << " events in " << packets.size() << " packets" << std::endl;
+        check(messages == fixture.events(), "every event encoded once");
+        check(packets.size() < fixture.events() / 4, "events share packets");
+        check(within_mtu, "packets within MTU");
+        check(contiguous, "packet sequence numbers contiguous");
+    }
+
+    // Test 3: batch_size still caps messages per packet
+    std::cout << "=== Test 3: Batch Size Cap ===" << std::endl;
+    {
+        Fixture fixture(4);
+        fixture.adapter->set_batch_size(5);
+        fixture.generator->generate_batch(200);
+
+        bool capped = true;
+        for (const auto& packet : fixture.transport->packets) {
+            capped &= count_messages(packet) <= 5;
+        }
+        check(capped, "at most batch_size messages per packet");
+    }
+
+    // Test 4: Latency-bounded packing of single updates
+    std::cout << "=== Test 4: Latency-Bounded Packing ===" << std::endl;
+    {
+        Fixture fixture(2);
+        fixture.adapter->set_max_latency(std::chrono::seconds(10));
+        for (int i = 0; i < 500; ++i) {
+            fixture.generator->generate_update(static_cast<uint32_t>(i % 2 + 1));
+        }
+
+        const auto& packets = fixture.transport->packets;
+        check(!packets.empty() && packets.size() < fixture.events() / 4, "single updates share packets");
+        bool within_mtu = true;
+        for (const auto& packet : packets) {
+            within_mtu &= packet.size() <= fixture.adapter->max_message_size();
+        }
+        check(within_mtu, "packets within MTU");
+
+        // The tail waits for its deadline, then goes out on poll()
+        size_t before = packets.size();
+        fixture.adapter->poll();
+        check(packets.size() == before, "tail held until the deadline");
+        fixture.adapter->set_max_latency(std::chrono::microseconds(50));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        fixture.adapter->poll();
+        check(packets.size() == before + 1, "overdue tail flushed by poll");
+
+        std::cout << "  " << fixture.adapter->messages_sent() << " messages in "
+                  << fixture.adapter->packets_sent() << " packets" << std::endl;
+        check(fixture.adapter->messages_sent() == fixture.events(), "every event sent once");
+        check(fixture.adapter->packets_sent() == packets.size(), "packet counter");
+
+        Fixture capped(2);
+        capped.adapter->set_max_latency(std::chrono::seconds(10));
+        capped.adapter->set_batch_size(5);
+        for (int i = 0; i < 100; ++i) {
+            capped.generator->generate_update(static_cast<uint32_t>(i % 2 + 1));
+        }
+        bool at_cap = !capped.transport->packets.empty();
+        for (const auto& packet : capped.transport->packets) {
+            at_cap &= count_messages(packet) == 5;
+        }
+        check(at_cap, "batch_size closes latency-packed packets");
+    }
+
+    // Test 5: Update runs coalesce into multi-entry template 46 messages
+    std::cout << "=== Test 5: Update Coalescing ===" << std::endl;
+    {
+        auto transport = std::make_shared<CaptureTransport>();
+        cme_protocol::CMEProtocolAdapter adapter;
+        adapter.set_transport(transport);
+        adapter.set_batch_size(1000);
+        adapter.set_coalesce_updates(true);
+
+        FuturesInstrument first(1, "ESZ4");
+        FuturesInstrument second(2, "NQZ4");
+        first.tick_size = second.tick_size = 0.25;
+
+        adapter.begin_batch();
+        for (int i = 0; i < 100; ++i) {
+            QuoteEvent quote(i % 2 ? 2 : 1);
+            quote.price = 4500.0 + i * 0.25;
+            quote.quantity = 10;
+            adapter.process_quote_event(i % 2 ? second : first, quote);
+        }
+        adapter.end_batch();
+
+        std::vector<BookMessage> messages;
+        for (const auto& packet : transport->packets) {
+            auto decoded = book_messages(packet);
+            messages.insert(messages.end(), decoded.begin(), decoded.end());
+        }
+
+        size_t per_message = cme_protocol::CMEEncoder::max_incremental_book_entries();
+        size_t expected = (100 + per_message - 1) / per_message;
+        check(messages.size() == expected, "100 quotes in " + std::to_string(expected) + " messages");
+
+        size_t entries = 0;
+        size_t event_ends = 0;
+        for (const auto& message : messages) {
+            entries += message.entries;
+            event_ends += (message.match_event_indicator & 0x80) ? 1 : 0;
+        }
+        check(entries == 100, "one entry per quote");
+        check(event_ends == 1 && (messages.back().match_event_indicator & 0x84) == 0x84,
+            "end-of-event and last-quote only on the last message");
+        check(transport->packets.size() == messages.size(), "a full run fills a packet");
+
+        // Generated batches mix quotes and trades in one run
+        Fixture fixture(8);
+        fixture.adapter->set_coalesce_updates(true);
+        fixture.generator->generate_batch(2000);
+
+        size_t batch_messages = 0;
+        size_t batch_entries = 0;
+        for (const auto& packet : fixture.transport->packets) {
+            for (const auto& message : book_messages(packet)) {
+                ++batch_messages;
+                batch_entries += message.entries;
+            }
+        }
+        std::cout << "  " << fixture.events() << " events in " << batch_messages << " messages, "
+                  << fixture.transport->packets.size() << " packets" << std::endl;
+        check(batch_entries == fixture.events(), "every event encoded once");
+        check(batch_messages < fixture.events() / 10, "updates share messages");
+    }
+
+    // Test 6: Encoding contexts are resolved once per instrument
+    std::cout << "=== Test 6: Instrument Encoding Context ===" << std::endl;
+    {
+        FuturesInstrument instrument(7, "ZNZ4");
+        instrument.tick_size = 0.015625;
+        instrument.external_ids["CME_SECURITY_ID"] = "54321";
+        instrument.set_property("price_decimals", int64_t(6));
+
+        cme_protocol::CMEInstrumentContextTable table;
+        const auto& context = table.add(instrument);
+        check(context.security_id == 54321, "security ID from external IDs");
+        check(context.tick_mantissa == 15625, "tick in mantissa units");
+        check(context.to_price(110.5) == 110500000, "price scaled by decimals");
+        check(context.book_entry.security_id == 54321 && context.order_entry.security_id == 54321,
+            "entry templates carry the security ID");
+        check(&table.get(instrument) == &context, "lookups hit the dense table");
+
+        // Changed IDs are picked up by re-registering, not by lookups
+        instrument.external_ids["CME_SECURITY_ID"] = "99";
+        check(table.get(instrument).security_id == 54321, "lookup does no string work");
+        check(table.add(instrument).security_id == 99, "re-registration re-resolves");
+
+        FuturesInstrument unregistered(3, "CLZ4");
+        check(table.get(unregistered).security_id == 3, "unregistered falls back to instrument ID");
+        FuturesInstrument large(cme_protocol::CMEInstrumentContextTable::MAX_DENSE_ID + 5, "LARGE");
+        check(table.get(large).security_id == large.instrument_id && table.get(large).resolved,
+            "large IDs use the sparse fallback");
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll CME adapter tests passed!" << std::endl;
+    return 0;
+}
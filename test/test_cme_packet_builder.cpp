@@ -0,0 +1,238 @@
+#include "cme_encoder.h"
+#include "cme_protocol_adapter.h"
+#include "test_check.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+using namespace market_core;
+
+// Count heap allocations so the packet path can be checked for zero
+static std::atomic<uint64_t> allocation_count { 0 };
+
+void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// Keeps the last packet; send_packet copies into a reused buffer
+class LastPacketTransport : public market_protocols::IMessageTransport {
+public:
+    std::vector<uint8_t> last;
+    uint64_t packets = 0;
+
+    LastPacketTransport() { last.reserve(2048); }
+
+    bool send_message(const std::vector<uint8_t>& data) override
+    {
+        return send_packet(data.data(), data.size());
+    }
+    bool send_packet(const uint8_t* data, size_t length) override
+    {
+        last.assign(data, data + length);
+        ++packets;
+        return true;
+    }
+    std::string get_transport_type() const override { return "LAST"; }
+    bool is_connected() const override { return true; }
+};
+
+static QuoteEvent make_quote(int i)
+{
+    QuoteEvent quote(1);
+    quote.timestamp_ns = 1700000000000000000ULL + i;
+    quote.sequence_number = static_cast<uint32_t>(i + 1);
+    quote.side = (i & 1) ? Side::ASK : Side::BID;
+    quote.price = (i & 1) ? 4500.25 : 4500.0;
+    quote.quantity = 100 + i % 50;
+    quote.order_count = 3;
+    quote.price_level = 1;
+    quote.action = UpdateAction::CHANGE;
+    return quote;
+}
+
+// The pre-builder path: encode into its own vector, then copy into a packet
+static std::vector<uint8_t> legacy_packet(const QuoteEvent& quote, uint32_t sequence, uint64_t sending_time)
+{
+    cme_protocol::IncrementalRefresh refresh;
+    refresh.transact_time = quote.timestamp_ns;
+    refresh.match_event_indicator = {};
+    refresh.match_event_indicator.end_of_event = true;
+    refresh.match_event_indicator.last_quote_msg = true;
+
+    cme_protocol::MDPriceLevel level;
+    level.security_id = 1;
+    level.rpt_seq = quote.sequence_number;
+    level.price = static_cast<int64_t>(quote.price * 100.0);
+    level.quantity = static_cast<int32_t>(quote.quantity);
+    level.number_of_orders = quote.order_count;
+    level.price_level = 1;
+    level.update_action = cme_protocol::MDUpdateAction::Change;
+    level.entry_type = quote.side == Side::BID ? cme_protocol::MDEntryType::Bid : cme_protocol::MDEntryType::Offer;
+    level.tradeable_size = level.quantity;
+    refresh.entries.push_back(level);
+
+    auto message = cme_protocol::CMEEncoder::encode_incremental_refresh_book(refresh);
+    return cme_protocol::CMEEncoder::create_packet(sequence, sending_time, { message });
+}
+
+int main()
+{
+    std::cout << "Testing CME Packet Builder\n"
+              << std::endl;
+
+    FuturesInstrument instrument(1, "ESZ4");
+    instrument.tick_size = 0.25;
+    instrument.external_ids["CME_SECURITY_ID"] = "1";
+
+    // Test 1: Builder layout
+    std::cout << "=== Test 1: Packet Layout ===" << std::endl;
+    {
+        cme_protocol::CMEPacketBuilder builder(64);
+        check(builder.empty() && builder.size() == 12, "starts with just the header");
+
+        const uint8_t first[] = { 1, 2, 3 };
+        const uint8_t second[] = { 4, 5 };
+        check(builder.append_message(first, sizeof(first)), "first message fits");
+        check(builder.append_message(second, sizeof(second)), "second message fits");
+        builder.finish(7, 99);
+
+        const uint8_t* data = builder.data();
+        uint32_t sequence;
+        uint64_t sending_time;
+        uint16_t size;
+        std::memcpy(&sequence, data, 4);
+        std::memcpy(&sending_time, data + 4, 8);
+        std::memcpy(&size, data + 12, 2);
+        check(sequence == 7 && sending_time == 99, "header stamped");
+        check(size == 3 && data[14] == 1 && data[16] == 3, "first message framed");
+        std::memcpy(&size, data + 17, 2);
+        check(size == 2 && data[19] == 4, "second message framed");
+        check(builder.size() == 21 && builder.message_count() == 2, "size and count");
+
+        uint8_t big[64] = {};
+        check(!builder.append_message(big, builder.message_capacity() + 1), "overflow rejected");
+        builder.reset();
+        check(builder.empty() && builder.fits(builder.max_message_length()), "reset empties the packet");
+    }
+
+    // Test 2: In-place encoding matches the vector encoder byte for byte
+    std::cout << "=== Test 2: Wire Compatibility ===" << std::endl;
+    {
+        auto transport = std::make_shared<LastPacketTransport>();
+        cme_protocol::CMEProtocolAdapter adapter;
+        adapter.set_transport(transport);
+
+        for (int i = 0; i < 4; ++i) {
+            QuoteEvent quote = make_quote(i);
+            adapter.process_quote_event(instrument, quote);
+
+            auto expected = legacy_packet(quote, static_cast<uint32_t>(i + 1), 0);
+            bool same_size = transport->last.size() == expected.size();
+            check(same_size, "packet size matches");
+            if (same_size) {
+                // Sending time differs; compare sequence and body
+                check(std::memcmp(transport->last.data(), expected.data(), 4) == 0, "sequence matches");
+                check(std::memcmp(transport->last.data() + 12, expected.data() + 12, expected.size() - 12) == 0,
+                    "messages match");
+            }
+        }
+    }
+
+    // Test 3: No allocation in steady state
+    std::cout << "=== Test 3: Allocation-Free Hot Path ===" << std::endl;
+    {
+        auto transport = std::make_shared<LastPacketTransport>();
+        cme_protocol::CMEProtocolAdapter adapter;
+        adapter.set_transport(transport);
+        adapter.set_batch_size(1000);
+
+        QuoteEvent quote = make_quote(0);
+        adapter.process_quote_event(instrument, quote); // Warm up
+
+        uint64_t before = allocation_count.load();
+        for (int i = 0; i < 100000; ++i) {
+            adapter.process_quote_event(instrument, quote);
+        }
+        adapter.begin_batch();
+        for (int i = 0; i < 100000; ++i) {
+            adapter.process_quote_event(instrument, quote);
+        }
+        adapter.end_batch();
+        uint64_t allocations = allocation_count.load() - before;
+
+        std::cout << "  " << allocations << " allocations for 200000 messages" << std::endl;
+        check(allocations == 0, "no allocation per message");
+    }
+
+    // Test 4: Throughput before/after
+    std::cout << "=== Test 4: Encode Throughput ===" << std::endl;
+    {
+        const int messages = 500000;
+        std::vector<QuoteEvent> quotes;
+        for (int i = 0; i < 64; ++i) {
+            quotes.push_back(make_quote(i));
+        }
+
+        auto transport = std::make_shared<LastPacketTransport>();
+        uint64_t sink = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < messages; ++i) {
+            auto packet = legacy_packet(quotes[i & 63], static_cast<uint32_t>(i), 0);
+            transport->send_packet(packet.data(), packet.size());
+            sink += packet.size();
+        }
+        double legacy_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        cme_protocol::CMEProtocolAdapter adapter;
+        adapter.set_transport(transport);
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < messages; ++i) {
+            adapter.process_quote_event(instrument, quotes[i & 63]);
+        }
+        double builder_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        adapter.set_batch_size(1000);
+        start = std::chrono::steady_clock::now();
+        adapter.begin_batch();
+        for (int i = 0; i < messages; ++i) {
+            adapter.process_quote_event(instrument, quotes[i & 63]);
+        }
+        adapter.end_batch();
+        double batched_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << std::fixed << std::setprecision(0)
+                  << "  vector encode + create_packet: " << messages / legacy_seconds << " msgs/s\n"
+                  << "  packet builder, 1 msg/packet:  " << messages / builder_seconds << " msgs/s\n"
+                  << "  packet builder, MTU packing:   " << messages / batched_seconds << " msgs/s"
+                  << " (checksum " << sink % 10 << ")" << std::endl;
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll CME packet builder tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,254 @@
+#include "market_data_generator.h"
+#include "order_book_manager.h"
+#include "test_check.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace market_core;
+
+// Count heap allocations so the record path can be checked for zero
+static std::atomic<uint64_t> allocation_count { 0 };
+
+void* operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+class CountingRecordListener : public IEventRecordListener {
+public:
+    uint64_t count = 0;
+    uint64_t quantity = 0;
+
+    void on_event_record(const EventRecord& record) override
+    {
+        ++count;
+        if (record.type == MarketEvent::QUOTE_UPDATE) {
+            quantity += record.quote.quantity;
+        }
+    }
+};
+
+class CountingEventListener : public IMarketEventListener {
+public:
+    uint64_t count = 0;
+
+    void on_market_event(const std::shared_ptr<MarketEvent>& event) override
+    {
+        if (event) {
+            ++count;
+        }
+    }
+};
+
+static std::shared_ptr<OrderBookManager> make_manager(uint32_t instruments)
+{
+    auto manager = std::make_shared<OrderBookManager>();
+    OrderBook::Config config;
+    config.storage = OrderBook::Storage::TICK_LADDER;
+
+    for (uint32_t id = 1; id <= instruments; ++id) {
+        auto instrument = std::make_shared<FuturesInstrument>(id, "ES" + std::to_string(id));
+        instrument->tick_size = 0.25;
+        instrument->set_property("initial_price", 4500.0);
+        manager->add_instrument(instrument);
+        manager->create_order_book(id, config);
+    }
+    return manager;
+}
+
+int main()
+{
+    std::cout << "Testing Event Records\n"
+              << std::endl;
+
+    // Test 1: Round trip through the class hierarchy
+    std::cout << "=== Test 1: Conversion ===" << std::endl;
+    {
+        QuoteEvent quote(7);
+        quote.timestamp_ns = 123;
+        quote.sequence_number = 9;
+        quote.side = Side::ASK;
+        quote.price = 1.08505;
+        quote.quantity = 1000000;
+        quote.action = UpdateAction::CHANGE;
+        quote.order_count = 3;
+        quote.price_level = 2;
+        quote.rpt_seq = 55;
+        quote.market_maker_id = "BANK_A";
+
+        EventRecord record;
+        check(to_record(quote, record), "quote converts");
+        check(record.quote.market_maker_id != 0, "market maker interned");
+        check(StringInterner::instance().intern("BANK_A") == record.quote.market_maker_id, "intern is stable");
+
+        QuoteEvent back = to_quote_event(record);
+        check(back.price == quote.price && back.quantity == quote.quantity && back.side == Side::ASK
+                && back.action == UpdateAction::CHANGE && back.timestamp_ns == 123 && back.sequence_number == 9,
+            "quote fields survive");
+        check(back.price_level == 2 && back.rpt_seq == 55 && !back.implied_quantity, "quote optionals survive");
+        check(back.market_maker_id == std::string("BANK_A"), "market maker survives");
+
+        TradeEvent trade(7);
+        trade.price = 4500.25;
+        trade.quantity = 5;
+        trade.trade_id = "T1";
+        to_record(trade, record);
+        auto event = to_market_event(record);
+        auto trade_back = std::static_pointer_cast<TradeEvent>(event);
+        check(event->type == MarketEvent::TRADE && trade_back->trade_id == std::string("T1")
+                && !trade_back->aggressor_side,
+            "trade round trip");
+
+        StatusEvent status(7);
+        status.status = StatusEvent::HALTED;
+        to_record(status, record);
+        check(to_status_event(record).status == StatusEvent::HALTED && !to_status_event(record).halt_reason,
+            "status round trip");
+
+        SnapshotEvent snapshot(7);
+        check(!to_record(snapshot, record), "snapshot has no record form");
+    }
+
+    // Test 2: Records drive the book the same way as events
+    std::cout << "=== Test 2: Book Application ===" << std::endl;
+    {
+        OrderBook by_event(1, "ES");
+        OrderBook by_record(1, "ES");
+
+        auto quote = std::make_shared<QuoteEvent>(1);
+        quote->side = Side::BID;
+        quote->price = 4500.00;
+        quote->quantity = 10;
+        by_event.apply_event(quote);
+
+        EventRecord record;
+        to_record(*quote, record);
+        by_record.apply_record(record);
+
+        check(by_event.get_best_bid() == by_record.get_best_bid() && by_record.bid_depth() == 1, "quote applied");
+
+        record.quote.action = UpdateAction::DELETE;
+        by_record.apply_record(record);
+        check(by_record.bid_depth() == 0, "delete applied");
+    }
+
+    // Test 3: Generator dispatch is allocation-free on the record path
+    std::cout << "=== Test 3: Allocation-Free Dispatch ===" << std::endl;
+    {
+        auto manager = make_manager(4);
+        MarketDataGenerator generator(manager);
+        auto listener = std::make_shared<CountingRecordListener>();
+        generator.add_record_listener(listener);
+
+        // Warm up books, ladders, trade history and sequence maps
+        for (int i = 0; i < 20000; ++i) {
+            generator.generate_update(static_cast<uint32_t>(i % 4 + 1));
+        }
+
+        uint64_t before = allocation_count.load();
+        for (int i = 0; i < 100000; ++i) {
+            generator.generate_update(static_cast<uint32_t>(i % 4 + 1));
+        }
+        uint64_t allocations = allocation_count.load() - before;
+
+        std::cout << "  " << allocations << " allocations over 100000 updates" << std::endl;
+        check(allocations == 0, "record path allocates nothing");
+        const auto& stats = generator.get_statistics();
+        check(listener->count == stats.quotes_generated + stats.trades_generated, "record listener saw every event");
+    }
+
+    // Test 4: Legacy listeners still work through the adapter
+    std::cout << "=== Test 4: Legacy Adapter ===" << std::endl;
+    {
+        auto manager = make_manager(1);
+        MarketDataGenerator generator(manager);
+        auto legacy = std::make_shared<CountingEventListener>();
+        auto modern = std::make_shared<CountingRecordListener>();
+        generator.add_listener(legacy);
+        generator.add_record_listener(modern);
+
+        for (int i = 0; i < 1000; ++i) {
+            generator.generate_update(1);
+        }
+        check(legacy->count > 0 && legacy->count == modern->count, "both listener kinds notified");
+
+        generator.remove_listener(legacy);
+        uint64_t legacy_seen = legacy->count;
+        for (int i = 0; i < 100; ++i) {
+            generator.generate_update(1);
+        }
+        check(legacy->count == legacy_seen && modern->count > legacy_seen, "legacy listener removed");
+
+        // Expired listeners are pruned during dispatch
+        modern.reset();
+        generator.generate_update(1);
+    }
+
+    // Test 5: Batches arrive through on_market_events in generation order
+    std::cout << "=== Test 5: Batch Dispatch ===" << std::endl;
+    {
+        class BatchListener : public IEventRecordListener {
+        public:
+            uint64_t batches = 0;
+            uint64_t records = 0;
+            size_t largest = 0;
+            bool ordered = true;
+            uint32_t last_sequence[5] = {};
+
+            void on_event_record(const EventRecord&) override { }
+            void on_market_events(EventRecordSpan batch) override
+            {
+                ++batches;
+                records += batch.size();
+                largest = std::max(largest, batch.size());
+                for (const auto& record : batch) {
+                    ordered &= record.sequence_number > last_sequence[record.instrument_id];
+                    last_sequence[record.instrument_id] = record.sequence_number;
+                }
+            }
+        };
+
+        auto manager = make_manager(4);
+        MarketDataGenerator generator(manager);
+        auto config = generator.get_config();
+        config.max_batch_events = 64;
+        generator.set_config(config);
+
+        auto listener = std::make_shared<BatchListener>();
+        generator.add_record_listener(listener);
+
+        generator.generate_batch(1000);
+        const auto& stats = generator.get_statistics();
+        uint64_t events = stats.quotes_generated + stats.trades_generated;
+
+        check(listener->records == events, "batch listener saw every event");
+        check(listener->largest == 64 && listener->batches == (events + 63) / 64, "batches capped at max_batch_events");
+        check(listener->ordered, "records in generation order");
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll event record tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,262 @@
+#include "io_uring_transport.h"
+#include "loopback_receiver.h"
+#include "test_check.h"
+#include "udp_transport.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace market_protocols;
+
+// Room for every datagram a test sends before it drains
+static constexpr int RECEIVE_BUFFER = 4 * 1024 * 1024;
+
+// Connected loopback TCP pair; the writing end is non-blocking with a
+// small send buffer so writes come up short and hit EAGAIN
+static bool tcp_pair(int& writer, int& reader)
+{
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(listener, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+    listen(listener, 1);
+    socklen_t length = sizeof(addr);
+    getsockname(listener, reinterpret_cast<struct sockaddr*>(&addr), &length);
+
+    writer = socket(AF_INET, SOCK_STREAM, 0);
+    int buffer_size = 16 * 1024;
+    setsockopt(writer, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+    bool connected = connect(writer, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == 0;
+    reader = accept(listener, nullptr, nullptr);
+    ::close(listener);
+    fcntl(writer, F_SETFL, fcntl(writer, F_GETFL, 0) | O_NONBLOCK);
+    fcntl(reader, F_SETFL, fcntl(reader, F_GETFL, 0) | O_NONBLOCK);
+    return connected && reader >= 0;
+}
+
+static std::vector<std::vector<uint8_t>> make_packets(size_t count)
+{
+    std::vector<std::vector<uint8_t>> packets;
+    for (size_t i = 0; i < count; ++i) {
+        std::vector<uint8_t> packet(60 + (i * 37) % 1300);
+        for (size_t b = 0; b < packet.size(); ++b) {
+            packet[b] = static_cast<uint8_t>(i * 31 + b);
+        }
+        packets.push_back(packet);
+    }
+    return packets;
+}
+
+int main()
+{
+    std::cout << "Testing io_uring Transport\n"
+              << std::endl;
+
+    if (!IoUringRing::supported()) {
+        std::cout << "io_uring is not available on this kernel; skipping" << std::endl;
+        return 0;
+    }
+
+    auto packets = make_packets(150);
+
+    // Test 1: A batch goes out in order through one submission
+    std::cout << "=== Test 1: Batched Datagrams ===" << std::endl;
+    {
+        Receiver receiver(RECEIVE_BUFFER);
+        IoUringTransport::Config config;
+        config.slots = 64; // Fewer slots than packets: recycles mid-batch
+        IoUringTransport transport("127.0.0.1", receiver.port(), config);
+        check(transport.initialize(), "transport initializes");
+        std::cout << "  Registered buffers: " << (transport.fixed_buffers() ? "yes" : "no") << std::endl;
+
+        std::vector<PacketRef> refs;
+        for (const auto& packet : packets) {
+            refs.push_back({ packet.data(), packet.size() });
+        }
+        check(transport.send_packets(refs.data(), refs.size()) == packets.size(), "all packets queued");
+        transport.flush();
+
+        check(transport.in_flight() == 0, "nothing left in flight");
+        check(transport.packets_sent() == packets.size() && transport.send_errors() == 0, "completions counted");
+        check(receiver.drain() == packets, "datagrams match, in order");
+        check(transport.enter_calls() < packets.size(), "fewer syscalls than packets");
+    }
+
+    // Test 2: Single sends and refusals
+    std::cout << "=== Test 2: Single Sends ===" << std::endl;
+    {
+        Receiver receiver(RECEIVE_BUFFER);
+        IoUringTransport::Config config;
+        config.slot_size = 512;
+        IoUringTransport transport("127.0.0.1", receiver.port(), config);
+        check(transport.initialize(), "transport initializes");
+
+        std::vector<uint8_t> small(100, 0x11);
+        std::vector<uint8_t> large(513, 0x22);
+        check(transport.send_message(small), "small packet queued");
+        check(!transport.send_message(large), "oversized packet refused");
+        transport.flush();
+        check(transport.packets_sent() == 1 && transport.send_errors() == 1, "counters");
+        check(receiver.drain() == std::vector<std::vector<uint8_t>>({ small }), "only the small packet arrives");
+    }
+
+    // Test 3: Stream writes stay ordered through short writes and EAGAIN
+    std::cout << "=== Test 3: Stream Writer ===" << std::endl;
+    {
+        int writer_fd;
+        int reader_fd;
+        check(tcp_pair(writer_fd, reader_fd), "TCP pair connected");
+
+        IoUringStreamWriter::Config config;
+        config.slots = 512;
+        config.slot_size = 1024;
+        IoUringStreamWriter writer(config);
+        check(writer.initialize(), "writer initializes");
+
+        // Far more than the socket buffers hold, in uneven pieces
+        std::vector<uint8_t> expected;
+        for (uint32_t i = 0; i < 400; ++i) {
+            std::vector<uint8_t> message(1 + (i * 97) % 1500);
+            for (size_t b = 0; b < message.size(); ++b) {
+                message[b] = static_cast<uint8_t>(i + b);
+            }
+            check(writer.write(writer_fd, message), "message queued");
+            expected.insert(expected.end(), message.begin(), message.end());
+        }
+        check(writer.queued_bytes(writer_fd) > 0, "bytes waiting on the peer");
+
+        std::vector<uint8_t> received;
+        uint8_t buffer[65536];
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (received.size() < expected.size() && std::chrono::steady_clock::now() < deadline) {
+            writer.poll();
+            ssize_t count = recv(reader_fd, buffer, sizeof(buffer), 0);
+            if (count > 0) {
+                received.insert(received.end(), buffer, buffer + count);
+            }
+        }
+        check(received == expected, "byte stream intact and in order");
+        check(writer.queued_bytes(writer_fd) == 0 && writer.bytes_written() == expected.size(), "all bytes written");
+
+        // A closed peer fails the stream; later writes are refused
+        ::close(reader_fd);
+        std::vector<uint8_t> message(4096, 0x33);
+        for (int i = 0; i < 50 && !writer.failed(writer_fd); ++i) {
+            writer.write(writer_fd, message);
+            writer.poll();
+            usleep(1000);
+        }
+        check(writer.failed(writer_fd) && writer.write_errors() > 0, "peer close detected");
+        check(!writer.write(writer_fd, message), "failed stream refuses writes");
+
+        writer.remove(writer_fd);
+        check(!writer.failed(writer_fd) && writer.queued_bytes(writer_fd) == 0, "removed");
+        ::close(writer_fd);
+    }
+
+    // Test 4: Removing a stream settles its kernel work before close()
+    std::cout << "=== Test 4: Remove Before Close ===" << std::endl;
+    {
+        IoUringStreamWriter writer;
+        check(writer.initialize(), "writer initializes");
+        uint8_t buffer[65536];
+
+        // Bytes prepared but not yet submitted must not reach a socket
+        // that later takes over the descriptor number
+        int old_writer;
+        int old_reader;
+        check(tcp_pair(old_writer, old_reader), "TCP pair connected");
+        std::vector<uint8_t> farewell(100, 0x7E);
+        writer.write(old_writer, farewell);
+        writer.remove(old_writer);
+        ::close(old_writer);
+
+        int new_writer;
+        int new_reader;
+        check(tcp_pair(new_writer, new_reader), "second pair connected");
+        writer.poll();
+        usleep(10000);
+        check(recv(new_reader, buffer, sizeof(buffer), 0) < 0, "new socket receives nothing");
+        check(recv(old_reader, buffer, sizeof(buffer), 0) == static_cast<ssize_t>(farewell.size()),
+            "old peer gets the bytes sent before close");
+        ::close(old_reader);
+
+        // A stalled peer's POLLOUT wait must not keep the socket open
+        std::vector<uint8_t> bulk(4096, 0x55);
+        for (int i = 0; i < 200; ++i) {
+            writer.write(new_writer, bulk);
+        }
+        writer.poll();
+        check(writer.queued_bytes(new_writer) > 0, "stream stalled behind the peer");
+        writer.remove(new_writer);
+        ::close(new_writer);
+
+        ssize_t count;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while ((count = recv(new_reader, buffer, sizeof(buffer), 0)) != 0
+            && std::chrono::steady_clock::now() < deadline) {
+            writer.poll();
+        }
+        check(count == 0, "peer sees the connection close");
+        ::close(new_reader);
+    }
+
+    // Benchmark: io_uring against the sendmmsg path on loopback
+    std::cout << "\n=== Benchmark ===" << std::endl;
+    {
+        Receiver receiver(RECEIVE_BUFFER);
+        std::vector<uint8_t> packet(200, 0x5A);
+        std::vector<PacketRef> refs(64, { packet.data(), packet.size() });
+        const size_t batches = 2000;
+        const uint64_t total = batches * refs.size();
+
+        UDPTransport udp("127.0.0.1", receiver.port());
+        udp.initialize();
+        udp.set_gso_enabled(false);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < batches; ++b) {
+            udp.send_packets(refs.data(), refs.size());
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        receiver.drain();
+        std::cout << "  sendmmsg: " << static_cast<uint64_t>(total / seconds) << " packets/sec, "
+                  << static_cast<double>(udp.batch_sender().syscalls()) / total << " syscalls/packet" << std::endl;
+
+        for (bool sq_poll : { false, true }) {
+            IoUringTransport::Config config;
+            config.sq_poll = sq_poll;
+            IoUringTransport transport("127.0.0.1", receiver.port(), config);
+            transport.initialize();
+            if (sq_poll && !transport.sq_polling()) {
+                std::cout << "  io_uring + SQPOLL: not permitted here, skipped" << std::endl;
+                continue;
+            }
+
+            start = std::chrono::steady_clock::now();
+            for (size_t b = 0; b < batches; ++b) {
+                transport.send_packets(refs.data(), refs.size());
+            }
+            transport.flush();
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            receiver.drain();
+            std::cout << "  io_uring" << (sq_poll ? " + SQPOLL" : "") << ": " << static_cast<uint64_t>(total / seconds)
+                      << " packets/sec, " << static_cast<double>(transport.enter_calls()) / total
+                      << " syscalls/packet" << std::endl;
+        }
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll io_uring transport tests passed!" << std::endl;
+    return 0;
+}
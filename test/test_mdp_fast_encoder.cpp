@@ -0,0 +1,347 @@
+#include "cme_encoder.h"
+#include "cme_fast_encoder.h"
+#include "test_check.h"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+using namespace cme_protocol;
+
+static MDPriceLevel make_level(size_t i)
+{
+    MDPriceLevel level;
+    level.update_action = static_cast<MDUpdateAction>(i % 3);
+    level.entry_type = i % 2 == 0 ? MDEntryType::Bid : MDEntryType::Offer;
+    level.security_id = 1000 + static_cast<uint32_t>(i);
+    level.rpt_seq = 50 + static_cast<uint32_t>(i);
+    level.price = 450025 + static_cast<int64_t>(i) * 25;
+    level.quantity = 10 + static_cast<int32_t>(i);
+    level.number_of_orders = 3 + static_cast<uint32_t>(i);
+    level.price_level = static_cast<uint8_t>(1 + i % 10);
+    level.tradeable_size = level.quantity - 1;
+    return level;
+}
+
+static MDOrderEntry make_order(size_t i)
+{
+    MDOrderEntry order;
+    order.order_id = 900000 + i;
+    order.order_priority = 7000 + i;
+    order.price = 450000 - static_cast<int64_t>(i) * 25;
+    order.display_qty = 5 + static_cast<int32_t>(i);
+    order.security_id = 42;
+    order.update_action = MDUpdateAction::Change;
+    order.entry_type = i % 2 == 0 ? MDEntryType::Bid : MDEntryType::Offer;
+    return order;
+}
+
+static cme_sbe::MessageHeader wrap_header(std::vector<uint8_t>& buffer)
+{
+    return cme_sbe::MessageHeader(reinterpret_cast<char*>(buffer.data()), buffer.size());
+}
+
+int main()
+{
+    std::cout << "Testing MDP Fast Encoder\n"
+              << std::endl;
+
+    // Test 1: Template 46 matches the flyweight encoder byte for byte
+    std::cout << "=== Test 1: Incremental Refresh Book (46) ===" << std::endl;
+    {
+        std::vector<MDPriceLevel> levels;
+        for (size_t i = 0; i < 6; ++i) {
+            levels.push_back(make_level(i));
+        }
+
+        std::vector<uint8_t> generic(CMEEncoder::MAX_MESSAGE_SIZE, 0);
+        std::vector<uint8_t> fast(CMEEncoder::MAX_MESSAGE_SIZE, 0);
+        size_t generic_length = CMEEncoder::encode_incremental_refresh_book(
+            123456789, 0x84, levels.data(), levels.size(), generic.data(), generic.size());
+        size_t fast_length = CMEFastEncoder::encode_incremental_refresh_book(
+            123456789, 0x84, levels.data(), levels.size(), fast.data(), fast.size());
+        check(fast_length == generic_length && fast_length == CMEFastEncoder::incremental_refresh_book_length(6),
+            "length");
+        check(std::memcmp(fast.data(), generic.data(), fast_length) == 0, "same bytes as the flyweight encoder");
+
+        auto header = wrap_header(fast);
+        cme_sbe::MDIncrementalRefreshBook46 decoded;
+        decoded.wrapForDecode(reinterpret_cast<char*>(fast.data()), header.encodedLength(),
+            header.blockLength(), header.version(), fast_length);
+        check(header.templateId() == 46 && header.schemaId() == cme_sbe::MDIncrementalRefreshBook46::sbeSchemaId(),
+            "header");
+        check(decoded.transactTime() == 123456789 && decoded.matchEventIndicator().rawValue() == 0x84, "root block");
+
+        auto& entries = decoded.noMDEntries();
+        check(entries.count() == 6, "entry count");
+        bool fields = true;
+        for (size_t i = 0; entries.hasNext(); ++i) {
+            auto& entry = entries.next();
+            const MDPriceLevel& level = levels[i];
+            fields &= entry.mDEntryPx().mantissa() == level.price * 100;
+            fields &= entry.mDEntrySize() == level.quantity;
+            fields &= entry.securityID() == static_cast<int32_t>(level.security_id);
+            fields &= entry.rptSeq() == level.rpt_seq;
+            fields &= entry.numberOfOrders() == static_cast<int32_t>(level.number_of_orders);
+            fields &= entry.mDPriceLevel() == level.price_level;
+            fields &= entry.mDUpdateActionRaw() == static_cast<uint8_t>(level.update_action);
+            fields &= entry.mDEntryTypeRaw() == static_cast<char>(level.entry_type);
+            fields &= entry.tradeableSize() == level.tradeable_size;
+        }
+        check(fields, "entry fields decode");
+        check(decoded.noOrderIDEntries().count() == 0, "empty order ID group");
+        check(decoded.encodedLength() + header.encodedLength() == fast_length, "decoder consumes the whole message");
+
+        check(CMEFastEncoder::encode_incremental_refresh_book(
+                  1, 0, levels.data(), levels.size(), fast.data(), fast_length - 1)
+                == 0,
+            "refuses a short buffer");
+    }
+
+    // Test 2: Template 47 matches the flyweight encoder byte for byte
+    std::cout << "=== Test 2: Incremental Refresh Order Book (47) ===" << std::endl;
+    {
+        std::vector<MDOrderEntry> orders;
+        for (size_t i = 0; i < 5; ++i) {
+            orders.push_back(make_order(i));
+        }
+
+        std::vector<uint8_t> generic(CMEEncoder::MAX_MESSAGE_SIZE, 0);
+        std::vector<uint8_t> fast(CMEEncoder::MAX_MESSAGE_SIZE, 0);
+        size_t generic_length = CMEEncoder::encode_incremental_refresh_order_book(
+            555, 0x80, orders.data(), orders.size(), generic.data(), generic.size());
+        size_t fast_length = CMEFastEncoder::encode_incremental_refresh_order_book(
+            555, 0x80, orders.data(), orders.size(), fast.data(), fast.size());
+        check(fast_length == generic_length, "length");
+        check(std::memcmp(fast.data(), generic.data(), fast_length) == 0, "same bytes as the flyweight encoder");
+
+        auto header = wrap_header(fast);
+        cme_sbe::MDIncrementalRefreshOrderBook47 decoded;
+        decoded.wrapForDecode(reinterpret_cast<char*>(fast.data()), header.encodedLength(),
+            header.blockLength(), header.version(), fast_length);
+        auto& entries = decoded.noMDEntries();
+        bool fields = entries.count() == 5;
+        for (size_t i = 0; entries.hasNext(); ++i) {
+            auto& entry = entries.next();
+            fields &= entry.orderID() == orders[i].order_id;
+            fields &= entry.mDOrderPriority() == orders[i].order_priority;
+            fields &= entry.mDEntryPx().mantissa() == orders[i].price * 100;
+            fields &= entry.mDDisplayQty() == orders[i].display_qty;
+            fields &= entry.securityID() == 42;
+            fields &= entry.mDEntryTypeRaw() == static_cast<char>(orders[i].entry_type);
+        }
+        check(fields, "entry fields decode");
+    }
+
+    // Test 3: Template 48 decodes with the generated decoder
+    std::cout << "=== Test 3: Trade Summary (48) ===" << std::endl;
+    {
+        std::vector<MDTrade> trades(3);
+        for (size_t i = 0; i < trades.size(); ++i) {
+            trades[i].security_id = 42;
+            trades[i].rpt_seq = 100 + static_cast<uint32_t>(i);
+            trades[i].price = 450050;
+            trades[i].quantity = 2 + static_cast<int32_t>(i);
+            trades[i].number_of_orders = 2;
+            trades[i].aggressor_side = static_cast<uint8_t>(1 + i % 2);
+            trades[i].trade_entry_id = 8000 + static_cast<uint32_t>(i);
+        }
+
+        std::vector<uint8_t> fast(CMEEncoder::MAX_MESSAGE_SIZE, 0xAA);
+        size_t length = CMEFastEncoder::encode_trade_summary(
+            999, 0x81, trades.data(), trades.size(), fast.data(), fast.size());
+        check(length == CMEFastEncoder::trade_summary_length(3), "length");
+
+        auto header = wrap_header(fast);
+        check(header.templateId() == 48 && header.blockLength() == 11, "header");
+        cme_sbe::MDIncrementalRefreshTradeSummary48 decoded;
+        decoded.wrapForDecode(reinterpret_cast<char*>(fast.data()), header.encodedLength(),
+            header.blockLength(), header.version(), length);
+        check(decoded.transactTime() == 999 && decoded.matchEventIndicator().rawValue() == 0x81, "root block");
+
+        auto& entries = decoded.noMDEntries();
+        bool fields = entries.count() == 3;
+        for (size_t i = 0; entries.hasNext(); ++i) {
+            auto& entry = entries.next();
+            fields &= entry.mDEntryPx().mantissa() == trades[i].price * 100;
+            fields &= entry.mDEntrySize() == trades[i].quantity;
+            fields &= entry.securityID() == 42;
+            fields &= entry.rptSeq() == trades[i].rpt_seq;
+            fields &= entry.numberOfOrders() == 2;
+            fields &= entry.aggressorSideRaw() == trades[i].aggressor_side;
+            fields &= entry.mDUpdateActionRaw() == static_cast<uint8_t>(MDUpdateAction::New);
+            fields &= entry.mDTradeEntryID() == trades[i].trade_entry_id;
+        }
+        check(fields, "entry fields decode");
+        check(decoded.noOrderIDEntries().count() == 0, "empty order ID group");
+        check(decoded.encodedLength() + header.encodedLength() == length, "decoder consumes the whole message");
+    }
+
+    // Test 4: Template 52 decodes with the generated decoder and matches
+    // the flyweight encoder once its untouched fields carry their null value
+    std::cout << "=== Test 4: Snapshot Full Refresh (52) ===" << std::endl;
+    {
+        SnapshotFullRefresh snapshot;
+        snapshot.security_id = 42;
+        snapshot.transact_time = 777;
+        snapshot.rpt_seq = 31;
+        snapshot.last_msg_seq_num_processed = 1200;
+        snapshot.tot_num_reports = 4;
+        for (size_t i = 0; i < 4; ++i) {
+            snapshot.bid_entries.push_back(make_level(i));
+            snapshot.ask_entries.push_back(make_level(i + 4));
+        }
+
+        std::vector<uint8_t> fast(CMEEncoder::MAX_MESSAGE_SIZE, 0xAA);
+        size_t length = CMEFastEncoder::encode_snapshot_full_refresh(snapshot, fast.data(), fast.size());
+        auto generic = CMEEncoder::encode_snapshot_full_refresh(snapshot);
+        check(length == generic.size(), "length");
+
+        cme_sbe::SnapshotFullRefresh52 nulls;
+        nulls.wrapForDecode(reinterpret_cast<char*>(generic.data()), wrap_header(generic).encodedLength(),
+            cme_sbe::SnapshotFullRefresh52::sbeBlockLength(), cme_sbe::SnapshotFullRefresh52::sbeSchemaVersion(),
+            generic.size());
+        nulls.mDSecurityTradingStatus(cme_sbe::SecurityTradingStatus::NULL_VALUE);
+        nulls.highLimitPrice().mantissa(cme_sbe::PRICENULL9::mantissaNullValue());
+        nulls.lowLimitPrice().mantissa(cme_sbe::PRICENULL9::mantissaNullValue());
+        nulls.maxPriceVariation().mantissa(cme_sbe::PRICENULL9::mantissaNullValue());
+        auto& null_entries = nulls.noMDEntries();
+        while (null_entries.hasNext()) {
+            null_entries.next()
+                .tradingReferenceDate(cme_sbe::SnapshotFullRefresh52::NoMDEntries::tradingReferenceDateNullValue())
+                .openCloseSettlFlag(cme_sbe::OpenCloseSettlFlag::NULL_VALUE);
+        }
+        check(std::memcmp(fast.data(), generic.data(), length) == 0, "same bytes as the flyweight encoder");
+
+        auto header = wrap_header(fast);
+        cme_sbe::SnapshotFullRefresh52 decoded;
+        decoded.wrapForDecode(reinterpret_cast<char*>(fast.data()), header.encodedLength(),
+            header.blockLength(), header.version(), length);
+        check(header.templateId() == 52, "header");
+        check(decoded.lastMsgSeqNumProcessed() == 1200 && decoded.totNumReports() == 4
+                && decoded.securityID() == 42 && decoded.rptSeq() == 31 && decoded.transactTime() == 777,
+            "root block");
+        check(decoded.highLimitPrice().mantissa() == cme_sbe::PRICENULL9::mantissaNullValue()
+                && decoded.mDSecurityTradingStatusRaw() == 255,
+            "null root fields");
+
+        auto& entries = decoded.noMDEntries();
+        bool fields = entries.count() == 8;
+        for (size_t i = 0; entries.hasNext(); ++i) {
+            auto& entry = entries.next();
+            const MDPriceLevel& level = i < 4 ? snapshot.bid_entries[i] : snapshot.ask_entries[i - 4];
+            fields &= entry.mDEntryPx().mantissa() == level.price * 100;
+            fields &= entry.mDEntrySize() == level.quantity;
+            fields &= entry.numberOfOrders() == static_cast<int32_t>(level.number_of_orders);
+            fields &= entry.mDPriceLevel() == static_cast<int8_t>(level.price_level);
+            fields &= entry.mDEntryTypeRaw() == (i < 4 ? '0' : '1');
+            fields &= entry.tradingReferenceDate() == 65535 && entry.openCloseSettlFlagRaw() == 255;
+        }
+        check(fields, "entry fields decode");
+    }
+
+    // Test 5: Template 53 matches the flyweight encoder byte for byte
+    std::cout << "=== Test 5: Snapshot Full Refresh Order Book (53) ===" << std::endl;
+    {
+        SnapshotFullRefreshOrderBook snapshot;
+        snapshot.security_id = 42;
+        snapshot.last_msg_seq_num_processed = 1200;
+        snapshot.tot_num_reports = 4;
+        snapshot.no_chunks = 2;
+        snapshot.current_chunk = 1;
+        snapshot.transact_time = 888;
+        for (size_t i = 0; i < 7; ++i) {
+            snapshot.entries.push_back(make_order(i));
+        }
+
+        auto generic = CMEEncoder::encode_snapshot_full_refresh_order_book(snapshot);
+        std::vector<uint8_t> fast(CMEEncoder::MAX_MESSAGE_SIZE, 0xAA);
+        size_t length = CMEFastEncoder::encode_snapshot_full_refresh_order_book(snapshot, fast.data(), fast.size());
+        check(length == generic.size(), "length");
+        check(std::memcmp(fast.data(), generic.data(), length) == 0, "same bytes as the flyweight encoder");
+    }
+
+    // Test 6: A group counts at most 255 entries; more fails the encode
+    // rather than wrapping numInGroup under the full message length
+    std::cout << "=== Test 6: Entry Count Limit ===" << std::endl;
+    {
+        std::vector<MDPriceLevel> levels;
+        for (size_t i = 0; i < 256; ++i) {
+            levels.push_back(make_level(i));
+        }
+        std::vector<uint8_t> buffer(CMEFastEncoder::incremental_refresh_book_length(levels.size()));
+        check(CMEFastEncoder::encode_incremental_refresh_book(1, 0x80, levels.data(), 255, buffer.data(), buffer.size())
+                == CMEFastEncoder::incremental_refresh_book_length(255),
+            "255 entries encode");
+        check(CMEFastEncoder::encode_incremental_refresh_book(1, 0x80, levels.data(), 256, buffer.data(), buffer.size()) == 0,
+            "256 entries rejected (46)");
+
+        SnapshotFullRefresh snapshot;
+        snapshot.bid_entries.assign(levels.begin(), levels.begin() + 128);
+        snapshot.ask_entries.assign(levels.begin() + 128, levels.end());
+        buffer.resize(CMEFastEncoder::snapshot_full_refresh_length(levels.size()));
+        check(CMEFastEncoder::encode_snapshot_full_refresh(snapshot, buffer.data(), buffer.size()) == 0,
+            "256 entries rejected (52)");
+
+        SnapshotFullRefreshOrderBook orders;
+        for (size_t i = 0; i < 256; ++i) {
+            orders.entries.push_back(make_order(i));
+        }
+        buffer.resize(CMEFastEncoder::snapshot_full_refresh_order_book_length(orders.entries.size()));
+        check(CMEFastEncoder::encode_snapshot_full_refresh_order_book(orders, buffer.data(), buffer.size()) == 0,
+            "256 entries rejected (53)");
+    }
+
+    // Test 7: Encode cost per message, flyweight path against fixed layout
+    std::cout << "=== Test 7: Benchmark ===" << std::endl;
+    {
+        const int iterations = 200000;
+        std::vector<MDPriceLevel> levels;
+        for (size_t i = 0; i < 4; ++i) {
+            levels.push_back(make_level(i));
+        }
+        std::vector<MDOrderEntry> orders { make_order(0) };
+        std::vector<uint8_t> buffer(CMEEncoder::MAX_MESSAGE_SIZE);
+        uint64_t sink = 0;
+
+        auto time = [&](const char* name, auto&& encode) {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                sink += encode(static_cast<uint64_t>(i));
+                sink += buffer[i & 63];
+            }
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                               .count();
+            std::cout << "  " << name << std::fixed << std::setprecision(1)
+                      << static_cast<double>(elapsed) / iterations << " ns/message" << std::endl;
+        };
+
+        time("46 x4 flyweight: ", [&](uint64_t t) {
+            return CMEEncoder::encode_incremental_refresh_book(
+                t, 0x84, levels.data(), levels.size(), buffer.data(), buffer.size());
+        });
+        time("46 x4 fixed:     ", [&](uint64_t t) {
+            return CMEFastEncoder::encode_incremental_refresh_book(
+                t, 0x84, levels.data(), levels.size(), buffer.data(), buffer.size());
+        });
+        time("47 x1 flyweight: ", [&](uint64_t t) {
+            return CMEEncoder::encode_incremental_refresh_order_book(
+                t, 0x84, orders.data(), orders.size(), buffer.data(), buffer.size());
+        });
+        time("47 x1 fixed:     ", [&](uint64_t t) {
+            return CMEFastEncoder::encode_incremental_refresh_order_book(
+                t, 0x84, orders.data(), orders.size(), buffer.data(), buffer.size());
+        });
+        check(sink != 0, "benchmark ran");
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll MDP fast encoder tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,193 @@
+#include "order_book_manager.h"
+#include "test_check.h"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+
+using namespace market_core;
+
+static void add_instruments(OrderBookManager& manager, uint32_t first, uint32_t count)
+{
+    for (uint32_t id = first; id < first + count; ++id) {
+        auto instrument = std::make_shared<FuturesInstrument>(id, "F" + std::to_string(id));
+        instrument->tick_size = 0.25;
+        manager.add_instrument(instrument);
+        manager.create_order_book(id);
+    }
+}
+
+static std::shared_ptr<QuoteEvent> make_quote(uint32_t instrument_id, Side side, double price, uint64_t quantity)
+{
+    auto quote = std::make_shared<QuoteEvent>(instrument_id);
+    quote->side = side;
+    quote->price = price;
+    quote->quantity = quantity;
+    quote->action = UpdateAction::ADD;
+    return quote;
+}
+
+// Apply events_per_thread pre-built quotes from each thread while one extra
+// thread takes snapshots; returns events per second
+static double run_contention(size_t shard_count, int threads, int events_per_thread)
+{
+    const uint32_t instruments = 256;
+    OrderBookManager manager(shard_count);
+    add_instruments(manager, 1, instruments);
+
+    std::vector<std::vector<std::shared_ptr<MarketEvent>>> work(threads);
+    for (int t = 0; t < threads; ++t) {
+        std::mt19937 rng(t);
+        std::uniform_int_distribution<uint32_t> id_dist(1, instruments);
+        std::uniform_int_distribution<int> tick_dist(1, 10);
+        work[t].reserve(events_per_thread);
+        for (int i = 0; i < events_per_thread; ++i) {
+            Side side = (i & 1) ? Side::BID : Side::ASK;
+            double offset = tick_dist(rng) * 0.25;
+            work[t].push_back(make_quote(id_dist(rng), side, side == Side::BID ? 100.0 - offset : 100.0 + offset, 10 + i));
+        }
+    }
+
+    std::atomic<bool> go { false };
+    std::atomic<bool> done { false };
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            for (const auto& event : work[t]) {
+                manager.apply_event(event);
+            }
+        });
+    }
+
+    std::thread snapshotter([&] {
+        while (!go.load(std::memory_order_acquire)) {
+        }
+        uint32_t id = 1;
+        while (!done.load(std::memory_order_relaxed)) {
+            manager.create_snapshot(id);
+            id = id % instruments + 1;
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    done.store(true);
+    snapshotter.join();
+
+    return threads * static_cast<double>(events_per_thread) / elapsed;
+}
+
+int main()
+{
+    std::cout << "Testing Sharded OrderBookManager\n"
+              << std::endl;
+
+    // Test 1: Registry growth and lookups
+    std::cout << "=== Test 1: Registry ===" << std::endl;
+    {
+        OrderBookManager manager(8);
+        add_instruments(manager, 1000, 1000);
+
+        check(manager.instrument_count() == 1000 && manager.book_count() == 1000, "counts");
+        check(manager.get_all_instrument_ids().size() == 1000, "all ids visible after growth");
+        check(!manager.add_instrument(std::make_shared<FuturesInstrument>(1500, "DUP")), "duplicate rejected");
+        check(!manager.create_order_book(1500), "duplicate book rejected");
+        check(!manager.create_order_book(5000), "book needs instrument");
+
+        auto [instrument, book] = manager.get_instrument_and_book(1999);
+        check(instrument && book && book->get_instrument_id() == 1999, "combined lookup");
+
+        manager.reset_all_books();
+        check(manager.book_count() == 0 && !manager.get_order_book(1999), "books reset");
+        check(manager.get_instrument(1999) != nullptr, "instruments survive reset");
+        check(manager.create_order_book(1999), "book recreated after reset");
+    }
+
+    // Test 2: Lock-free readers while the registry grows
+    std::cout << "=== Test 2: Concurrent Registry Readers ===" << std::endl;
+    {
+        OrderBookManager manager;
+        add_instruments(manager, 1, 16);
+
+        std::atomic<bool> stop { false };
+        std::atomic<int> misses { 0 };
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 4; ++r) {
+            readers.emplace_back([&] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    for (uint32_t id = 1; id <= 16; ++id) {
+                        if (!manager.get_order_book(id)) {
+                            misses++;
+                        }
+                    }
+                }
+            });
+        }
+
+        add_instruments(manager, 100, 5000);
+        stop.store(true);
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        check(misses.load() == 0, "existing books always visible");
+        check(manager.instrument_count() == 5016, "all concurrent adds registered");
+    }
+
+    // Test 3: Concurrent application on shared instruments
+    std::cout << "=== Test 3: Concurrent Apply ===" << std::endl;
+    {
+        OrderBookManager manager(4);
+        add_instruments(manager, 1, 8);
+
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 8; ++t) {
+            workers.emplace_back([&, t] {
+                for (int i = 0; i < 2000; ++i) {
+                    uint32_t id = static_cast<uint32_t>(i % 8 + 1);
+                    manager.apply_event(make_quote(id, Side::BID, 100.0 - (t * 2000 + i) * 0.25, 1));
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        size_t levels = 0;
+        for (const auto& book : manager.get_all_order_books()) {
+            levels += book->bid_depth();
+        }
+        check(levels == 16000, "no lost updates");
+    }
+
+    // Test 4: Contention benchmark, single lock vs sharded
+    std::cout << "=== Test 4: Contention ===" << std::endl;
+    {
+        std::cout << "  threads   1 shard (events/sec)   " << OrderBookManager::DEFAULT_SHARD_COUNT
+                  << " shards (events/sec)" << std::endl;
+        for (int threads : { 1, 2, 4, 8, 16 }) {
+            double single = run_contention(1, threads, 100000);
+            double sharded = run_contention(OrderBookManager::DEFAULT_SHARD_COUNT, threads, 100000);
+            std::cout << "  " << std::setw(7) << threads << std::fixed << std::setprecision(0)
+                      << std::setw(23) << single << std::setw(23) << sharded << std::endl;
+        }
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll order book manager tests passed!" << std::endl;
+    return 0;
+}
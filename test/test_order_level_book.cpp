@@ -0,0 +1,233 @@
+#include "market_data_generator.h"
+#include "order_book.h"
+#include "order_book_manager.h"
+#include "test_check.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+using namespace market_core;
+
+int main()
+{
+    std::cout << "Testing Market-By-Order Book\n"
+              << std::endl;
+
+    // Test 1: FIFO queues and aggregation
+    std::cout << "=== Test 1: Queue Priority ===" << std::endl;
+    {
+        OrderLevelBook book(0.25);
+
+        book.add_order(1, Side::BID, 4500.00, 100, 1, 0);
+        book.add_order(2, Side::BID, 4500.00, 200, 2, 0);
+        book.add_order(3, Side::BID, 4499.75, 50, 3, 0);
+        book.add_order(4, Side::ASK, 4500.25, 70, 4, 0);
+        check(!book.add_order(1, Side::ASK, 4501.00, 1, 5, 0), "duplicate order rejected");
+
+        auto level = book.get_level(Side::BID, 4500.00);
+        check(level && level->quantity == 300 && level->order_count == 2, "level aggregates orders");
+        check(book.best_price(Side::BID) == 4500.00 && book.best_price(Side::ASK) == 4500.25, "best prices");
+
+        // Size reduction keeps position, increase goes to the back
+        book.modify_order(1, 4500.00, 80, 1, 0);
+        auto orders = book.get_orders(Side::BID, 1);
+        check(orders.size() == 2 && orders[0].order_id == 1, "reduction keeps priority");
+
+        book.modify_order(1, 4500.00, 500, 6, 0);
+        orders = book.get_orders(Side::BID, 1);
+        check(orders.size() == 2 && orders[0].order_id == 2 && orders[1].order_id == 1, "increase loses priority");
+
+        // Price change moves the order and the aggregate
+        book.modify_order(3, 4500.00, 50, 7, 0);
+        check(book.level_count(Side::BID) == 1, "emptied level removed");
+        check(book.get_level(Side::BID, 4500.00)->order_count == 3, "order moved to new level");
+
+        book.fill_order(2, 150);
+        check(book.find_order(2)->quantity == 50, "partial fill");
+        book.fill_order(2, 50);
+        check(!book.find_order(2), "full fill removes order");
+
+        book.cancel_order(4);
+        check(!book.best_price(Side::ASK), "ask side empty after cancel");
+        check(book.order_count() == 2, "order count");
+    }
+
+    // Test 2: Order events drive the aggregated OrderBook
+    std::cout << "=== Test 2: OrderBook Integration ===" << std::endl;
+    {
+        OrderBook book(1, "ES");
+        OrderBook::Config config;
+        config.aggregate_by_price = false;
+        config.tick_size = 0.25;
+        book.set_config(config);
+
+        auto add = std::make_shared<OrderEvent>(1);
+        add->order_id = 10;
+        add->side = Side::ASK;
+        add->price = 4501.00;
+        add->quantity = 300;
+        add->priority = 1;
+        book.apply_event(add);
+
+        auto move = std::make_shared<OrderEvent>(1);
+        move->order_id = 10;
+        move->action = UpdateAction::CHANGE;
+        move->price = 4500.75;
+        move->quantity = 300;
+        move->priority = 2;
+        book.apply_event(move);
+
+        check(book.get_best_ask() == 4500.75 && book.ask_depth() == 1, "aggregated level follows order");
+
+        auto snapshot = book.create_snapshot_event();
+        check(snapshot->orders.size() == 1 && snapshot->orders[0].order_id == 10, "snapshot carries orders");
+
+        auto cancel = std::make_shared<OrderEvent>(1);
+        cancel->order_id = 10;
+        cancel->action = UpdateAction::DELETE;
+        book.apply_event(cancel);
+        check(book.is_empty(), "cancel empties book");
+    }
+
+    // Test 3: Orders whose level the ladder cannot hold are refused whole
+    std::cout << "=== Test 3: Outlier Orders ===" << std::endl;
+    {
+        OrderLevelBook book(0.25);
+        double far = 100.00 - (PriceLadder::MAX_CAPACITY + 10) * 0.25;
+        check(book.add_order(1, Side::BID, 100.00, 10, 1, 0), "near order");
+        check(!book.add_order(2, Side::BID, far, 10, 2, 0), "outlier add refused");
+        check(!book.find_order(2) && !book.get_level(Side::BID, far), "outlier not stored");
+        check(!book.add_order(3, Side::BID, 1e300, 10, 3, 0) && !book.get_level(Side::BID, 1e300),
+            "tick beyond int64 refused");
+
+        check(book.add_order(4, Side::BID, 99.75, 10, 4, 0), "second order");
+        check(!book.modify_order(4, far, 10, 5, 0), "outlier move refused");
+        auto order = book.find_order(4);
+        check(order && order->price == 99.75 && order->priority == 4, "refused move leaves the order");
+        check(book.get_orders(Side::BID).size() == book.order_count(), "every order on the ladder");
+
+        // Alone on its side, an order may move anywhere
+        check(book.add_order(5, Side::ASK, 100.25, 10, 6, 0), "ask order");
+        check(book.modify_order(5, 100.25 + (PriceLadder::MAX_CAPACITY + 10) * 0.25, 10, 7, 0), "lone order moves");
+        check(book.get_orders(Side::ASK).size() == 1, "moved order listed");
+
+        // The book reports the refusal, so the generator does not publish it
+        OrderBook mbo(1, "ES");
+        OrderBook::Config config;
+        config.aggregate_by_price = false;
+        config.tick_size = 0.25;
+        mbo.set_config(config);
+        auto add = std::make_shared<OrderEvent>(1);
+        add->order_id = 1;
+        add->side = Side::BID;
+        add->price = 100.00;
+        add->quantity = 10;
+        check(mbo.apply_event(add), "order applied");
+        add->order_id = 2;
+        add->price = far;
+        check(!mbo.apply_event(add), "outlier reported");
+        check(mbo.bid_depth() == 1 && mbo.get_orders(Side::BID).size() == 1, "book unchanged");
+    }
+
+    // Test 4: Random churn matches a naive recount
+    std::cout << "=== Test 4: Random Churn ===" << std::endl;
+    {
+        OrderLevelBook book(0.01, 16);
+        std::mt19937_64 rng(1234);
+        std::uniform_int_distribution<int> tick_dist(-50, 50);
+        std::unordered_map<uint64_t, uint64_t> expected;
+        uint64_t next_id = 1;
+
+        for (int i = 0; i < 200000; ++i) {
+            if (expected.empty() || rng() % 3 == 0) {
+                double price = 75.00 + tick_dist(rng) * 0.01;
+                Side side = price <= 75.00 ? Side::BID : Side::ASK;
+                book.add_order(next_id, side, price, 100, next_id, 0);
+                expected[next_id] = 100;
+                ++next_id;
+            } else {
+                uint64_t id = book.order_id_at(rng());
+                book.cancel_order(id);
+                expected.erase(id);
+            }
+        }
+
+        check(book.order_count() == expected.size(), "order count after churn");
+
+        uint64_t total = 0;
+        for (Side side : { Side::BID, Side::ASK }) {
+            for (const auto& level : book.get_levels(side)) {
+                total += level.quantity;
+            }
+        }
+        check(total == expected.size() * 100, "aggregated quantity after churn");
+    }
+
+    // Test 5: Throughput
+    std::cout << "=== Test 5: Throughput ===" << std::endl;
+    {
+        OrderLevelBook book(0.25, 1 << 16);
+        std::mt19937_64 rng(99);
+        std::uniform_int_distribution<int> tick_dist(1, 20);
+        const int events = 2000000;
+        uint64_t next_id = 1;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < events; ++i) {
+            uint64_t r = rng();
+            if (book.order_count() < 10000 || (r & 3) == 0) {
+                Side side = (r & 4) ? Side::BID : Side::ASK;
+                double offset = tick_dist(rng) * 0.25;
+                double price = side == Side::BID ? 4500.00 - offset : 4500.00 + offset;
+                book.add_order(next_id, side, price, 100, next_id, 0);
+                ++next_id;
+            } else if ((r & 3) == 1) {
+                book.modify_order(book.order_id_at(r >> 8), 4500.00 - 0.25, 50, next_id++, 0);
+            } else {
+                book.cancel_order(book.order_id_at(r >> 8));
+            }
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "  " << events << " order events in " << std::fixed << std::setprecision(3)
+                  << elapsed << " s (" << std::setprecision(0) << events / elapsed << " events/sec)" << std::endl;
+    }
+
+    // Test 6: Generator produces order events for MBO books
+    std::cout << "=== Test 6: Generator ===" << std::endl;
+    {
+        auto manager = std::make_shared<OrderBookManager>();
+        auto instrument = std::make_shared<FuturesInstrument>(1, "ESZ4");
+        instrument->tick_size = 0.25;
+        instrument->set_property("initial_price", 4500.0);
+        manager->add_instrument(instrument);
+
+        OrderBook::Config config;
+        config.aggregate_by_price = false;
+        manager->create_order_book(1, config);
+
+        MarketDataGenerator generator(manager);
+        auto market_config = generator.get_config();
+        market_config.trade_probability = 0.0;
+        generator.set_config(market_config);
+
+        for (int i = 0; i < 1000; ++i) {
+            generator.generate_update(1);
+        }
+
+        auto book = manager->get_order_book(1);
+        check(generator.get_statistics().orders_generated == 1000, "all updates were order events");
+        check(book->get_order_level_book()->order_count() > 0, "orders resting in book");
+        check(!book->is_crossed(), "generated book not crossed");
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll market-by-order tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,246 @@
+#include "capture_transport.h"
+#include "cme_protocol_adapter.h"
+#include "packet_journal.h"
+#include "replay_server.h"
+#include "test_check.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace market_core;
+using market_protocols::PacketJournal;
+using market_protocols::ReplayRequest;
+using market_protocols::ReplayResponse;
+
+// Packet whose bytes all derive from its sequence number
+static std::vector<uint8_t> make_packet(uint32_t sequence)
+{
+    std::vector<uint8_t> packet(20 + sequence % 100, static_cast<uint8_t>(sequence));
+    std::memcpy(packet.data(), &sequence, 4);
+    return packet;
+}
+
+// Blocking loopback client with a receive timeout
+class ReplayClient {
+public:
+    explicit ReplayClient(uint16_t port)
+    {
+        fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        struct timeval timeout = { 2, 0 };
+        setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(port);
+        connected_ = connect(fd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == 0;
+    }
+    ~ReplayClient() { ::close(fd_); }
+
+    bool connected() const { return connected_; }
+
+    void request(uint16_t channel_id, uint32_t begin, uint32_t end)
+    {
+        ReplayRequest request;
+        request.channel_id = channel_id;
+        request.begin_sequence = begin;
+        request.end_sequence = end;
+        uint8_t buffer[ReplayRequest::WIRE_SIZE];
+        request.encode(buffer);
+        send(fd_, buffer, sizeof(buffer), 0);
+    }
+
+    bool response(ReplayResponse& response, std::vector<std::vector<uint8_t>>& packets)
+    {
+        uint8_t header[ReplayResponse::WIRE_SIZE];
+        if (!receive(header, sizeof(header))) {
+            return false;
+        }
+        response = ReplayResponse::decode(header);
+
+        packets.clear();
+        for (uint32_t i = 0; i < response.count; ++i) {
+            uint8_t prefix[2];
+            if (!receive(prefix, 2)) {
+                return false;
+            }
+            std::vector<uint8_t> packet(prefix[0] | (prefix[1] << 8));
+            if (!receive(packet.data(), packet.size())) {
+                return false;
+            }
+            packets.push_back(std::move(packet));
+        }
+        return true;
+    }
+
+private:
+    int fd_;
+    bool connected_ = false;
+
+    bool receive(uint8_t* buffer, size_t length)
+    {
+        size_t received = 0;
+        while (received < length) {
+            ssize_t n = recv(fd_, buffer + received, length - received, 0);
+            if (n <= 0) {
+                return false;
+            }
+            received += static_cast<size_t>(n);
+        }
+        return true;
+    }
+};
+
+int main()
+{
+    std::cout << "Testing Packet Journal and Replay Server\n"
+              << std::endl;
+
+    // Test 1: The journal keeps the last capacity packets by sequence
+    std::cout << "=== Test 1: Journal Retention ===" << std::endl;
+    {
+        PacketJournal journal(6, 256); // Rounded up to 8
+        check(journal.capacity() == 8, "capacity rounded to a power of two");
+        check(journal.last_sequence() == 0 && journal.first_sequence() == 0, "empty journal");
+
+        for (uint32_t sequence = 1; sequence <= 20; ++sequence) {
+            auto packet = make_packet(sequence);
+            journal.record(sequence, packet.data(), packet.size());
+        }
+        check(journal.first_sequence() == 13 && journal.last_sequence() == 20, "retained range");
+
+        bool intact = true;
+        for (uint32_t sequence = 13; sequence <= 20; ++sequence) {
+            std::vector<uint8_t> out;
+            intact &= journal.read(sequence, out) && out == make_packet(sequence);
+        }
+        check(intact, "retained packets read back intact");
+
+        std::vector<uint8_t> out;
+        check(!journal.read(12, out) && out.empty(), "overwritten packet misses");
+        check(!journal.read(21, out) && !journal.read(0, out), "unsent sequences miss");
+
+        std::vector<uint8_t> oversized(300, 0xAB);
+        journal.record(21, oversized.data(), oversized.size());
+        check(!journal.read(21, out) && !journal.read(13, out), "oversized packet dropped, slot cleared");
+        check(journal.oversized_packets() == 1 && journal.last_sequence() == 21, "oversized counted");
+    }
+
+    // Test 2: Readers racing the writer never see a torn packet
+    std::cout << "=== Test 2: Concurrent Reads ===" << std::endl;
+    {
+        PacketJournal journal(64, 256);
+        const uint32_t total = 200000;
+        std::atomic<bool> done { false };
+
+        std::thread writer([&] {
+            for (uint32_t sequence = 1; sequence <= total; ++sequence) {
+                auto packet = make_packet(sequence);
+                journal.record(sequence, packet.data(), packet.size());
+            }
+            done = true;
+        });
+
+        uint64_t hits = 0;
+        bool consistent = true;
+        std::vector<uint8_t> out;
+        while (!done) {
+            uint32_t last = journal.last_sequence();
+            for (uint32_t back = 0; back < 64 && back < last; ++back) {
+                out.clear();
+                if (journal.read(last - back, out)) {
+                    consistent &= out == make_packet(last - back);
+                    ++hits;
+                }
+            }
+        }
+        writer.join();
+
+        std::cout << "  " << hits << " concurrent reads" << std::endl;
+        check(consistent, "every successful read is the requested packet");
+    }
+
+    // Test 3: The adapter journals what it sends; the server replays it
+    std::cout << "=== Test 3: TCP Replay ===" << std::endl;
+    {
+        auto transport = std::make_shared<CaptureTransport>();
+        auto journal = std::make_shared<PacketJournal>(32, 1400);
+        cme_protocol::CMEProtocolAdapter adapter;
+        adapter.set_transport(transport);
+        adapter.set_journal(journal);
+
+        FuturesInstrument instrument(1, "ESZ4");
+        instrument.tick_size = 0.25;
+        for (int i = 0; i < 50; ++i) {
+            QuoteEvent quote(1);
+            quote.price = 4500.0 + i * 0.25;
+            quote.quantity = 10;
+            adapter.process_quote_event(instrument, quote);
+        }
+        check(journal->last_sequence() == 50 && journal->first_sequence() == 19, "adapter journals each packet");
+
+        market_protocols::ReplayServer::Config config;
+        config.max_packets_per_request = 10;
+        market_protocols::ReplayServer server(config);
+        server.add_channel(310, journal);
+        check(server.start() && server.port() != 0, "server listening");
+
+        ReplayClient client(server.port());
+        check(client.connected(), "client connected");
+
+        ReplayResponse response;
+        std::vector<std::vector<uint8_t>> packets;
+
+        // Requests are pipelined and answered in order
+        client.request(310, 30, 35);
+        client.request(310, 40, 60);
+        client.request(310, 5, 20);
+        client.request(311, 1, 2);
+        client.request(310, 9, 8);
+
+        bool ok = client.response(response, packets);
+        bool identical = packets.size() == 6;
+        for (size_t i = 0; identical && i < packets.size(); ++i) {
+            identical = packets[i] == transport->packets[29 + i];
+        }
+        check(ok && response.status == ReplayResponse::Status::OK && response.begin_sequence == 30
+                && response.count == 6,
+            "full range replayed");
+        check(identical, "replayed packets match what was sent");
+
+        ok = client.response(response, packets);
+        check(ok && response.status == ReplayResponse::Status::PARTIAL && response.begin_sequence == 40
+                && response.count == 10,
+            "range capped at max packets per request");
+
+        ok = client.response(response, packets);
+        check(ok && response.status == ReplayResponse::Status::PARTIAL && response.begin_sequence == 19
+                && response.count == 2 && packets.back() == transport->packets[19],
+            "evicted start moves to the oldest retained packet");
+
+        ok = client.response(response, packets);
+        check(ok && response.status == ReplayResponse::Status::UNKNOWN_CHANNEL && response.count == 0,
+            "unknown channel rejected");
+
+        ok = client.response(response, packets);
+        check(ok && response.status == ReplayResponse::Status::INVALID_RANGE, "inverted range rejected");
+
+        check(server.requests_served() == 5 && server.packets_replayed() == 18, "server statistics");
+        server.stop();
+        check(!server.is_running(), "server stopped");
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll packet journal tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include "parallel_market_data_generator.h"
+#include "test_check.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+using namespace market_core;
+
+static uint64_t fnv1a(uint64_t hash, const void* data, size_t size)
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Hashes every record a shard emits, in order
+class FingerprintListener : public IEventRecordListener {
+public:
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    uint64_t records = 0;
+
+    void on_event_record(const EventRecord& record) override
+    {
+        hash = fnv1a(hash, &record, sizeof(record));
+        ++records;
+    }
+};
+
+static std::shared_ptr<OrderBookManager> make_manager(
+    uint32_t instruments,
+    OrderBook::Storage storage = OrderBook::Storage::PRICE_MAP,
+    uint32_t mbo_every = 0)
+{
+    auto manager = std::make_shared<OrderBookManager>();
+    for (uint32_t id = 1; id <= instruments; ++id) {
+        auto instrument = std::make_shared<FuturesInstrument>(id, "F" + std::to_string(id));
+        instrument->tick_size = 0.25;
+        instrument->set_property("initial_price", 100.0 + id % 50);
+        manager->add_instrument(instrument);
+
+        OrderBook::Config config;
+        config.storage = storage;
+        config.aggregate_by_price = mbo_every == 0 || id % mbo_every != 0;
+        manager->create_order_book(id, config);
+    }
+    return manager;
+}
+
+static uint64_t book_fingerprint(const OrderBookManager& manager)
+{
+    auto ids = manager.get_all_instrument_ids();
+    std::sort(ids.begin(), ids.end());
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (uint32_t id : ids) {
+        auto book = manager.get_order_book(id);
+        double bid = book->get_best_bid().value_or(0.0);
+        double ask = book->get_best_ask().value_or(0.0);
+        uint64_t depth = book->bid_depth() * 1000 + book->ask_depth();
+        uint64_t volume = book->get_stats().total_volume;
+        hash = fnv1a(hash, &bid, sizeof(bid));
+        hash = fnv1a(hash, &ask, sizeof(ask));
+        hash = fnv1a(hash, &depth, sizeof(depth));
+        hash = fnv1a(hash, &volume, sizeof(volume));
+    }
+    return hash;
+}
+
+struct RunResult {
+    std::vector<uint64_t> shard_hashes;
+    uint64_t books = 0;
+    uint64_t records = 0;
+};
+
+static RunResult run_seeded(uint64_t seed, size_t threads)
+{
+    auto manager = make_manager(2000, OrderBook::Storage::TICK_LADDER, 4);
+    ParallelMarketDataGenerator generator(manager, threads, seed);
+
+    MarketConfig config;
+    config.simulated_clock_start_ns = 1000000000ULL;
+    config.simulated_clock_step_ns = 1000;
+    generator.set_config(config);
+
+    std::vector<std::shared_ptr<FingerprintListener>> listeners;
+    for (size_t i = 0; i < threads; ++i) {
+        listeners.push_back(std::make_shared<FingerprintListener>());
+        generator.shard(i).add_record_listener(listeners.back());
+    }
+
+    generator.generate_all_instruments();
+    for (int round = 0; round < 5; ++round) {
+        generator.generate_batch(5000);
+    }
+
+    RunResult result;
+    for (const auto& listener : listeners) {
+        result.shard_hashes.push_back(listener->hash);
+        result.records += listener->records;
+    }
+    result.books = book_fingerprint(*manager);
+    return result;
+}
+
+int main()
+{
+    std::cout << "Testing Parallel Market Data Generation\n"
+              << std::endl;
+
+    // Test 1: Counter-based streams are reproducible and skippable
+    std::cout << "=== Test 1: Counter RNG ===" << std::endl;
+    {
+        CounterRng a(42, 0);
+        CounterRng b(42, 0);
+        CounterRng other_stream(42, 1);
+        CounterRng other_seed(43, 0);
+
+        bool same = true;
+        bool distinct_stream = true;
+        bool distinct_seed = true;
+        for (int i = 0; i < 1000; ++i) {
+            uint64_t value = a();
+            same &= value == b();
+            distinct_stream &= value != other_stream();
+            distinct_seed &= value != other_seed();
+        }
+        check(same, "same seed and stream repeat");
+        check(distinct_stream, "streams differ");
+        check(distinct_seed, "seeds differ");
+
+        CounterRng skipped(42, 0);
+        CounterRng stepped(42, 0);
+        skipped.discard(500);
+        for (int i = 0; i < 500; ++i) {
+            stepped();
+        }
+        check(skipped() == stepped(), "discard matches stepping");
+    }
+
+    // Test 2: Same seed and thread count reproduce the run exactly
+    std::cout << "=== Test 2: Deterministic Output ===" << std::endl;
+    {
+        for (size_t threads : { 1, 4 }) {
+            RunResult first = run_seeded(7, threads);
+            RunResult second = run_seeded(7, threads);
+            RunResult reseeded = run_seeded(8, threads);
+
+            std::cout << "  " << threads << " thread(s): " << first.records << " records, book hash "
+                      << std::hex << first.books << std::dec << std::endl;
+            check(first.records > 0, "records generated");
+            check(first.shard_hashes == second.shard_hashes, "per-shard streams identical");
+            check(first.books == second.books, "final books identical");
+            check(first.shard_hashes != reseeded.shard_hashes, "different seed differs");
+        }
+    }
+
+    // Test 3: Partitioning covers every instrument exactly once
+    std::cout << "=== Test 3: Partitioning ===" << std::endl;
+    {
+        auto manager = make_manager(1001);
+        ParallelMarketDataGenerator generator(manager, 4, 1);
+
+        std::vector<uint32_t> all;
+        for (size_t i = 0; i < generator.thread_count(); ++i) {
+            const auto& ids = generator.shard(i).get_instruments();
+            all.insert(all.end(), ids.begin(), ids.end());
+        }
+        std::sort(all.begin(), all.end());
+        check(all.size() == 1001, "every instrument assigned");
+        check(std::adjacent_find(all.begin(), all.end()) == all.end(), "no instrument assigned twice");
+
+        // More threads than instruments leaves idle shards
+        auto small = make_manager(2);
+        ParallelMarketDataGenerator wide(small, 4, 1);
+        wide.generate_batch(100);
+        check(wide.get_statistics().updates_generated == 200, "idle shards generate nothing");
+    }
+
+    // Test 4: Serialized listener sees every shard's output
+    std::cout << "=== Test 4: Shared Listener ===" << std::endl;
+    {
+        auto manager = make_manager(500);
+        ParallelMarketDataGenerator generator(manager, 4, 3);
+        auto listener = std::make_shared<FingerprintListener>();
+        generator.add_record_listener(listener);
+
+        generator.generate_all_instruments();
+        generator.generate_batch(1000);
+
+        auto stats = generator.get_statistics();
+        check(listener->records == stats.quotes_generated + stats.trades_generated + stats.orders_generated,
+            "shared listener saw every record");
+    }
+
+    // Test 5: Throughput across 50k instruments
+    std::cout << "=== Test 5: Scaling (50k instruments) ===" << std::endl;
+    {
+        const int updates_per_thread = 200000;
+        double base_rate = 0.0;
+        for (size_t threads : { 1, 2, 4, 8 }) {
+            auto manager = make_manager(50000);
+            ParallelMarketDataGenerator generator(manager, threads, 11);
+            generator.generate_all_instruments();
+            generator.reset_statistics();
+
+            auto start = std::chrono::steady_clock::now();
+            generator.generate_batch(updates_per_thread);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            double rate = generator.get_statistics().updates_generated / seconds;
+            if (threads == 1) {
+                base_rate = rate;
+            }
+            std::cout << "  " << threads << " thread(s): " << std::fixed << std::setprecision(0) << rate
+                      << " updates/s (" << std::setprecision(2) << rate / base_rate << "x)" << std::endl;
+        }
+        std::cout << "  hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll parallel generator tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include "order_book.h"
+#include "test_check.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+using namespace market_core;
+
+static PriceLevel make_level(double price, uint64_t quantity)
+{
+    PriceLevel level {};
+    level.price = price;
+    level.quantity = quantity;
+    level.order_count = 1;
+    return level;
+}
+
+static bool same_levels(const std::vector<PriceLevel>& a, const std::vector<PriceLevel>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].price != b[i].price || a[i].quantity != b[i].quantity) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static OrderBook::Config ladder_config(double tick_size, size_t capacity = PriceLadder::DEFAULT_CAPACITY)
+{
+    OrderBook::Config config;
+    config.storage = OrderBook::Storage::TICK_LADDER;
+    config.tick_size = tick_size;
+    config.ladder_capacity = capacity;
+    return config;
+}
+
+int main()
+{
+    std::cout << "Testing Tick Ladder Order Book\n"
+              << std::endl;
+
+    // Test 1: Basic ordering and best prices
+    std::cout << "=== Test 1: Basic Operations ===" << std::endl;
+    {
+        OrderBook book(1, "ES");
+        book.set_config(ladder_config(0.25));
+
+        book.add_level(Side::BID, make_level(4500.00, 100));
+        book.add_level(Side::BID, make_level(4499.50, 300));
+        book.add_level(Side::BID, make_level(4499.75, 200));
+        book.add_level(Side::ASK, make_level(4500.50, 250));
+        book.add_level(Side::ASK, make_level(4500.25, 100));
+
+        check(book.get_best_bid() == 4500.00, "best bid");
+        check(book.get_best_ask() == 4500.25, "best ask");
+        check(book.bid_depth() == 3 && book.ask_depth() == 2, "depth");
+
+        auto bids = book.get_bids();
+        check(bids.size() == 3 && bids[0].price == 4500.00 && bids[2].price == 4499.50, "bids descending");
+
+        book.remove_level(Side::BID, 4500.00);
+        check(book.get_best_bid() == 4499.75, "best bid after delete");
+
+        book.update_level(Side::ASK, make_level(4500.25, 0));
+        check(book.get_best_ask() == 4500.50, "zero quantity removes level");
+        check(!book.is_crossed(), "not crossed");
+    }
+
+    // Test 2: Fractional ticks compare by tick index, not double equality
+    std::cout << "=== Test 2: Float Keys ===" << std::endl;
+    {
+        OrderBook book(2, "EURUSD");
+        book.set_config(ladder_config(0.00001));
+
+        book.add_level(Side::BID, make_level(1.08505, 1000000));
+        book.remove_level(Side::BID, 1.08500 + 0.00005);
+        check(book.bid_depth() == 0, "delete by recomputed price");
+    }
+
+    // Test 3: Drift forces recentering and growth without losing levels
+    std::cout << "=== Test 3: Recentering ===" << std::endl;
+    {
+        OrderBook book(3, "CL");
+        book.set_config(ladder_config(0.01, 64));
+
+        book.add_level(Side::ASK, make_level(75.00, 10));
+        for (int i = 1; i <= 500; ++i) {
+            book.add_level(Side::ASK, make_level(75.00 + i * 0.01, 10));
+        }
+        check(book.ask_depth() == 501, "all levels retained after growth");
+        check(book.get_best_ask() == 75.00, "best ask survives recenter");
+
+        book.clear_side(Side::ASK);
+        book.add_level(Side::ASK, make_level(20.00, 5));
+        check(book.get_best_ask() == 20.00, "re-anchor on empty ladder");
+    }
+
+    // Test 4: Random operations match the price map book
+    std::cout << "=== Test 4: Equivalence With Price Map ===" << std::endl;
+    {
+        OrderBook map_book(4, "NQ");
+        OrderBook ladder_book(4, "NQ");
+        ladder_book.set_config(ladder_config(0.25, 64));
+
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> tick_dist(-400, 400);
+        std::uniform_int_distribution<int> op_dist(0, 9);
+
+        for (int i = 0; i < 20000; ++i) {
+            Side side = (i & 1) ? Side::BID : Side::ASK;
+            double price = 15000.00 + tick_dist(rng) * 0.25;
+            int op = op_dist(rng);
+
+            if (op < 6) {
+                auto level = make_level(price, 100 + i);
+                map_book.update_level(side, level);
+                ladder_book.update_level(side, level);
+            } else {
+                map_book.remove_level(side, price);
+                ladder_book.remove_level(side, price);
+            }
+        }
+
+        check(same_levels(map_book.get_bids(), ladder_book.get_bids()), "bids match");
+        check(same_levels(map_book.get_asks(), ladder_book.get_asks()), "asks match");
+        check(map_book.get_best_bid() == ladder_book.get_best_bid(), "best bid matches");
+        check(map_book.get_best_ask() == ladder_book.get_best_ask(), "best ask matches");
+
+        // Switching storage migrates levels
+        map_book.set_config(ladder_config(0.25));
+        ladder_book.set_config(OrderBook::Config {});
+        check(same_levels(map_book.get_bids(), ladder_book.get_bids()), "bids match after migration");
+    }
+
+    // Test 5: An outlier far from the book is refused instead of growing
+    // the ladder to span it
+    std::cout << "=== Test 5: Outlier Prices ===" << std::endl;
+    {
+        PriceLadder ladder(Side::ASK, 0.25);
+        check(ladder.set(make_level(4500.00, 10)) && ladder.set(make_level(4510.00, 10)), "near prices set");
+
+        check(!ladder.set(make_level(4500.00 * 1000, 10)), "outlier refused");
+        check(!ladder.set(make_level(1e300, 10)) && !ladder.erase(1e300), "tick beyond int64 refused");
+        check(ladder.size() == 2 && ladder.best_price() == 4500.00, "book untouched");
+        check(ladder.capacity() <= PriceLadder::MAX_CAPACITY, "capacity bounded");
+
+        // Up to MAX_CAPACITY ticks of occupied range still fits
+        double far = 4500.00 + (PriceLadder::MAX_CAPACITY - 1) * 0.25;
+        check(ladder.set(make_level(far, 10)) && ladder.capacity() == PriceLadder::MAX_CAPACITY, "widest range");
+        check(!ladder.set(make_level(far + 0.25, 10)) && !ladder.set(make_level(4499.75, 10)), "one tick wider");
+        check(ladder.levels().size() == 3 && ladder.levels().back().price == far, "levels kept");
+
+        // The order book reports what the ladder refuses; the price map takes it
+        OrderBook book(5, "ES");
+        book.set_config(ladder_config(0.25));
+        check(book.add_level(Side::BID, make_level(4500.00, 10)), "level added");
+        check(!book.update_level(Side::BID, make_level(100000.00, 10)), "outlier reported");
+        check(book.bid_depth() == 1 && book.get_best_bid() == 4500.00, "ladder book unchanged");
+
+        OrderBook map_book(5, "ES");
+        check(map_book.add_level(Side::BID, make_level(4500.00, 10))
+                && map_book.add_level(Side::BID, make_level(100000.00, 10)),
+            "price map takes both");
+        check(!map_book.set_config(ladder_config(0.25)), "migration to the ladder refused");
+        check(map_book.get_config().storage == OrderBook::Storage::PRICE_MAP && map_book.bid_depth() == 2,
+            "book keeps the price map and its levels");
+        map_book.remove_level(Side::BID, 100000.00);
+        check(map_book.set_config(ladder_config(0.25)) && map_book.bid_depth() == 1, "migrates once it fits");
+    }
+
+    // Test 6: Performance
+    std::cout << "=== Test 6: Performance ===" << std::endl;
+    {
+        const int iterations = 1000000;
+
+        for (auto storage : { OrderBook::Storage::PRICE_MAP, OrderBook::Storage::TICK_LADDER }) {
+            OrderBook book(5, "ES");
+            auto config = ladder_config(0.25);
+            config.storage = storage;
+            book.set_config(config);
+
+            std::mt19937 rng(7);
+            std::uniform_int_distribution<int> tick_dist(-20, 20);
+
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                double price = 4500.00 + tick_dist(rng) * 0.25;
+                Side side = price < 4500.00 ? Side::BID : Side::ASK;
+                book.update_level(side, make_level(price, (i % 5) * 100));
+            }
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                               .count();
+
+            std::cout << (storage == OrderBook::Storage::PRICE_MAP ? "  price map:   " : "  tick ladder: ")
+                      << std::fixed << std::setprecision(1)
+                      << static_cast<double>(elapsed) / iterations << " ns/update" << std::endl;
+        }
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll tick ladder tests passed!" << std::endl;
+    return 0;
+}
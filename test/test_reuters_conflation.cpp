@@ -0,0 +1,321 @@
+#include "conflation_table.h"
+#include "lseg_sbe/EndOfConflation.h"
+#include "lseg_sbe/MarketDataIncrementalRefresh.h"
+#include "reuters_encoder.h"
+#include "reuters_multicast_publisher.h"
+#include "loopback_receiver.h"
+#include "test_check.h"
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <thread>
+
+using namespace reuters_protocol;
+
+static market_core::QuoteEvent make_quote(uint32_t instrument_id, market_core::Side side, uint8_t level,
+    double price, market_core::UpdateAction action = market_core::UpdateAction::CHANGE)
+{
+    market_core::QuoteEvent quote(instrument_id);
+    quote.side = side;
+    quote.price_level = level;
+    quote.price = price;
+    quote.quantity = 1000000;
+    quote.action = action;
+    quote.order_count = 1;
+    return quote;
+}
+
+// Room for every datagram a test sends before it drains
+static constexpr int RECEIVE_BUFFER = 4 * 1024 * 1024;
+
+static MulticastChannelConfig loopback_channel(const Receiver& receiver)
+{
+    MulticastChannelConfig channel;
+    channel.multicast_ip = "127.0.0.1";
+    channel.port = receiver.port();
+    channel.interface_ip = "0.0.0.0";
+    channel.channel_id = 0;
+    return channel;
+}
+
+// Entries of a SOFH-framed MarketDataIncrementalRefresh, keyed by
+// security, side and level; false if the message does not decode
+using Entries = std::map<std::string, int64_t>;
+static bool decode_incremental(const uint8_t* frame, size_t length, Entries& entries)
+{
+    try {
+        char* buffer = const_cast<char*>(reinterpret_cast<const char*>(frame));
+        lseg_sbe::MarketDataIncrementalRefresh message;
+        message.wrapForDecode(buffer, SOFHeader::size(), message.sbeBlockLength(),
+            message.sbeSchemaVersion(), length);
+        auto& group = message.mDIncGrp();
+        while (group.hasNext()) {
+            auto& entry = group.next();
+            std::string key = entry.getSecurityIDAsString() + "/" + entry.mDEntryTypeRaw()
+                + "/" + std::to_string(entry.mDPriceLevel());
+            entries[key] = entry.mDEntryPx().mantissa();
+            auto& parties = entry.parties();
+            while (parties.hasNext()) {
+                parties.next();
+            }
+        }
+        return message.encodedLength() + SOFHeader::size() == length;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+static bool decode_end_of_conflation(const uint8_t* frame, size_t length, uint64_t& conflation_id)
+{
+    try {
+        char* buffer = const_cast<char*>(reinterpret_cast<const char*>(frame));
+        lseg_sbe::EndOfConflation message;
+        message.wrapForDecode(buffer, SOFHeader::size(), message.sbeBlockLength(),
+            message.sbeSchemaVersion(), length);
+        conflation_id = message.conflationID();
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+int main()
+{
+    std::cout << "Testing Reuters Conflation\n"
+              << std::endl;
+
+    using market_core::Side;
+    using market_core::UpdateAction;
+
+    // Test 1: Latest state per level, dirty slots flushed once in order
+    std::cout << "=== Test 1: Conflation Table ===" << std::endl;
+    {
+        ConflationTable table;
+        check(!table.update(make_quote(1, Side::BID, 1, 1.10)), "first update pending");
+        check(!table.update(make_quote(1, Side::ASK, 1, 1.11)), "other side separate");
+        check(!table.update(make_quote(2, Side::BID, 1, 2.20)), "other instrument separate");
+        check(table.update(make_quote(1, Side::BID, 1, 1.12)), "same level replaced");
+        check(!table.update(make_quote(1, Side::BID, 2, 1.09)), "other level separate");
+        check(table.pending() == 4 && table.conflated() == 1, "four dirty slots");
+
+        std::vector<double> prices;
+        table.flush([&](const market_core::QuoteEvent& quote) { prices.push_back(quote.price); });
+        check(prices == std::vector<double>({ 1.12, 1.11, 2.20, 1.09 }), "latest values in first-change order");
+        check(table.pending() == 0 && table.size() == 4, "flush clears dirty flags, keeps slots");
+
+        table.update(make_quote(2, Side::BID, 1, 2.21));
+        size_t flushed = 0;
+        table.flush([&](const market_core::QuoteEvent& quote) {
+            ++flushed;
+            check(quote.price == 2.21, "only the changed slot");
+        });
+        check(flushed == 1, "one slot flushed");
+
+        // An ADD the consumer never saw stays an ADD
+        table.update(make_quote(3, Side::ASK, 1, 3.30, UpdateAction::ADD));
+        table.update(make_quote(3, Side::ASK, 1, 3.31, UpdateAction::CHANGE));
+        table.flush([&](const market_core::QuoteEvent& quote) {
+            check(quote.action == UpdateAction::ADD && quote.price == 3.31, "add then change is an add");
+        });
+
+        // ...and an ADD then DELETE sends nothing
+        table.update(make_quote(4, Side::BID, 2, 4.40, UpdateAction::ADD));
+        table.update(make_quote(4, Side::ASK, 1, 4.41));
+        check(table.update(make_quote(4, Side::BID, 2, 4.40, UpdateAction::DELETE)), "delete conflated");
+        std::vector<double> sent;
+        table.flush([&](const market_core::QuoteEvent& quote) { sent.push_back(quote.price); });
+        check(sent == std::vector<double>({ 4.41 }), "add then delete cancelled");
+
+        // A DELETE then an ADD of the level sends both, in order
+        table.update(make_quote(5, Side::BID, 1, 5.50, UpdateAction::DELETE));
+        check(!table.update(make_quote(5, Side::BID, 1, 5.49, UpdateAction::ADD)), "add after delete kept");
+        table.update(make_quote(5, Side::BID, 1, 5.48));
+        std::vector<std::pair<UpdateAction, double>> actions;
+        auto record = [&](const market_core::QuoteEvent& quote) { actions.emplace_back(quote.action, quote.price); };
+        table.flush(record);
+        check(actions == std::vector<std::pair<UpdateAction, double>>({ { UpdateAction::DELETE, 5.50 }, { UpdateAction::ADD, 5.48 } }),
+            "delete, then the latest add");
+
+        // ...and deleting that ADD again leaves just the DELETE
+        table.update(make_quote(5, Side::BID, 1, 5.48, UpdateAction::DELETE));
+        table.update(make_quote(5, Side::BID, 1, 5.47, UpdateAction::ADD));
+        table.update(make_quote(5, Side::BID, 1, 5.47, UpdateAction::DELETE));
+        actions.clear();
+        table.flush(record);
+        check(actions == std::vector<std::pair<UpdateAction, double>>({ { UpdateAction::DELETE, 5.48 } }),
+            "delete, add, delete sends one delete");
+
+        // A snapshot supersedes what is pending for its instrument only
+        table.update(make_quote(1, Side::BID, 1, 1.13));
+        table.update(make_quote(2, Side::BID, 1, 2.22));
+        table.update(make_quote(1, Side::ASK, 1, 1.14));
+        check(table.discard(1) == 2 && table.pending() == 1, "instrument's slots discarded");
+        sent.clear();
+        table.flush([&](const market_core::QuoteEvent& quote) { sent.push_back(quote.price); });
+        check(sent == std::vector<double>({ 2.22 }), "other instruments kept");
+
+        ConflationTable by_instrument(ConflationTable::Granularity::INSTRUMENT);
+        by_instrument.update(make_quote(1, Side::BID, 1, 1.10));
+        check(by_instrument.update(make_quote(1, Side::BID, 3, 1.08)), "levels share a slot");
+        check(!by_instrument.update(make_quote(1, Side::ASK, 1, 1.11)), "sides do not");
+    }
+
+    // Test 2: Batched incrementals and the marker decode with the schema
+    std::cout << "=== Test 2: Batched Encoding ===" << std::endl;
+    {
+        std::vector<market_core::QuoteEvent> quotes;
+        for (uint8_t level = 1; level <= 5; ++level) {
+            quotes.push_back(make_quote(1001, Side::BID, level, 1.1 - level * 0.0001));
+            quotes.push_back(make_quote(1001, Side::ASK, level, 1.1 + level * 0.0001));
+        }
+        std::vector<const market_core::QuoteEvent*> batch;
+        for (const auto& quote : quotes) {
+            batch.push_back(&quote);
+        }
+
+        auto message = ReutersEncoder::encode_market_data_incremental(batch);
+        Entries entries;
+        check(decode_incremental(message.data(), message.size(), entries), "batch decodes to its length");
+        check(entries.size() == 10, "every entry present");
+        check(entries["1001/0/1"] == 109990000 && entries["1001/1/5"] == 110050000, "prices intact");
+
+        auto marker = ReutersEncoder::encode_end_of_conflation(42);
+        uint64_t conflation_id = 0;
+        check(decode_end_of_conflation(marker.data(), marker.size(), conflation_id) && conflation_id == 42,
+            "conflation ID carried");
+    }
+
+    // Test 3: The publisher holds quotes and flushes them per interval
+    std::cout << "=== Test 3: Conflated Publisher ===" << std::endl;
+    {
+        Receiver feed_a(RECEIVE_BUFFER), feed_b(RECEIVE_BUFFER), definitions(RECEIVE_BUFFER), snapshots(RECEIVE_BUFFER);
+        ReutersMulticastConfig config;
+        config.incremental_feed_a = loopback_channel(feed_a);
+        config.incremental_feed_b = loopback_channel(feed_b);
+        config.security_definition_feed = loopback_channel(definitions);
+        config.snapshot_feed = loopback_channel(snapshots);
+        config.conflation_interval_ms = 20;
+
+        ReutersMulticastPublisher publisher(config);
+        check(publisher.initialize(), "publisher initialised");
+
+        // 10 instruments x 2 sides x 5 levels, each updated 50 times
+        const size_t keys = 100;
+        for (int round = 0; round < 50; ++round) {
+            for (uint32_t instrument = 0; instrument < 10; ++instrument) {
+                for (uint8_t level = 1; level <= 5; ++level) {
+                    double price = 1.0 + round * 0.25; // Exact in binary
+                    publisher.publish_incremental(make_quote(instrument, Side::BID, level, price));
+                    publisher.publish_incremental(make_quote(instrument, Side::ASK, level, price));
+                }
+            }
+        }
+        publisher.poll();
+        check(feed_a.drain().empty(), "nothing sent before the interval");
+        check(publisher.get_statistics().quotes_conflated == keys * 49, "superseded quotes counted");
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(25));
+        publisher.poll();
+        auto packets = feed_a.drain();
+        size_t batches = (keys + 12) / 13;
+        check(packets.size() == batches + 1, "batched incrementals then one marker");
+        check(feed_b.drain().size() == packets.size(), "B feed mirrors A");
+
+        Entries entries;
+        bool decoded = true;
+        for (size_t i = 0; i + 1 < packets.size(); ++i) {
+            decoded = decoded && packets[i].size() <= 1400
+                && decode_incremental(packets[i].data() + MulticastMessageHeader::SIZE,
+                    packets[i].size() - MulticastMessageHeader::SIZE, entries);
+        }
+        check(decoded && entries.size() == keys, "every level sent once, packets within 1400 bytes");
+        check(entries["9/1/5"] == 1325000000, "latest price sent");
+
+        uint64_t conflation_id = 0;
+        const auto& last = packets.back();
+        check(decode_end_of_conflation(last.data() + MulticastMessageHeader::SIZE,
+                  last.size() - MulticastMessageHeader::SIZE, conflation_id)
+                && conflation_id == 1,
+            "EndOfConflation closes interval 1");
+
+        // Trades bypass conflation; a quiet interval sends nothing
+        market_core::TradeEvent trade(3);
+        publisher.publish_incremental(trade);
+        check(feed_a.drain().size() == 1, "trade sent immediately");
+        std::this_thread::sleep_for(std::chrono::milliseconds(25));
+        publisher.poll();
+        check(feed_a.drain().empty(), "no marker for an empty interval");
+
+        // A snapshot is not followed by quotes older than it
+        publisher.publish_incremental(make_quote(5, Side::BID, 1, 1.25));
+        market_core::SnapshotEvent snapshot(5);
+        publisher.publish_snapshot(snapshot);
+        check(snapshots.drain().size() == 1, "snapshot sent");
+        std::this_thread::sleep_for(std::chrono::milliseconds(25));
+        publisher.poll();
+        check(feed_a.drain().empty(), "pre-snapshot quote discarded");
+
+        publisher.publish_incremental(make_quote(1, Side::BID, 1, 1.5));
+        publisher.shutdown();
+        check(feed_a.drain().size() == 2, "shutdown flushes what is held");
+    }
+
+    // Benchmark: packets for a fast-moving book with and without conflation
+    std::cout << "\n=== Benchmark ===" << std::endl;
+    {
+        Receiver feed_a(RECEIVE_BUFFER), feed_b(RECEIVE_BUFFER), definitions(RECEIVE_BUFFER), snapshots(RECEIVE_BUFFER);
+        ReutersMulticastConfig config;
+        config.incremental_feed_a = loopback_channel(feed_a);
+        config.incremental_feed_b = loopback_channel(feed_b);
+        config.security_definition_feed = loopback_channel(definitions);
+        config.snapshot_feed = loopback_channel(snapshots);
+
+        // 20 instruments x 2 sides x 5 levels
+        std::vector<market_core::QuoteEvent> quotes;
+        for (uint32_t instrument = 0; instrument < 20; ++instrument) {
+            for (uint8_t level = 1; level <= 5; ++level) {
+                quotes.push_back(make_quote(instrument, Side::BID, level, 1.1));
+                quotes.push_back(make_quote(instrument, Side::ASK, level, 1.1));
+            }
+        }
+
+        for (uint32_t interval_ms : { 0u, 10u }) {
+            config.conflation_interval_ms = interval_ms;
+            ReutersMulticastPublisher publisher(config);
+            publisher.initialize();
+
+            // 1M updates/s offered for 200ms
+            const size_t updates = 200000;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < updates; ++i) {
+                auto due = start + std::chrono::microseconds(i);
+                while (std::chrono::steady_clock::now() < due) {
+                }
+                publisher.publish_incremental(quotes[i % quotes.size()]);
+                if (i % 64 == 0) {
+                    publisher.poll();
+                    feed_a.drain();
+                    feed_b.drain();
+                }
+            }
+            publisher.flush_conflation();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            const auto& stats = publisher.get_statistics();
+            std::cout << "  " << (interval_ms ? "Conflated " + std::to_string(interval_ms) + "ms" : std::string("Unconflated"))
+                      << ": " << stats.messages_sent_a << " packets for " << updates << " updates ("
+                      << static_cast<uint64_t>(stats.messages_sent_a / seconds) << " pkt/s per feed at "
+                      << static_cast<uint64_t>(updates / seconds) << " updates/s)" << std::endl;
+            publisher.shutdown();
+        }
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll Reuters conflation tests passed!" << std::endl;
+    return 0;
+}
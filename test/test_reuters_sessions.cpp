@@ -0,0 +1,380 @@
+#include "lseg_sbe/MarketDataRequest.h"
+#include "reuters_protocol_adapter.h"
+#include "sofh_frame_buffer.h"
+#include "test_check.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace reuters_protocol;
+
+// SOFH-framed client heartbeat, body_size bytes of SBE payload
+static std::vector<uint8_t> make_frame(size_t body_size = 0)
+{
+    std::vector<uint8_t> frame(SOFHeader::size() + SBEMessageHeader::size() + body_size, 0x55);
+    SOFHeader sofh;
+    sofh.message_length = static_cast<uint32_t>(frame.size());
+    sofh.pack(frame.data());
+    SBEMessageHeader header;
+    header.template_id = MessageTypes::HEARTBEAT;
+    header.pack(frame.data() + SOFHeader::size());
+    return frame;
+}
+
+// SOFH-framed session message with a zero-padded body; the adapter
+// reads Establish's keepAliveInterval from SBE offset 29
+static std::vector<uint8_t> make_session_frame(uint16_t template_id, uint32_t keepalive = 0)
+{
+    std::vector<uint8_t> frame(SOFHeader::size() + 256, 0);
+    SOFHeader sofh;
+    sofh.message_length = static_cast<uint32_t>(frame.size());
+    sofh.pack(frame.data());
+    SBEMessageHeader header;
+    header.template_id = template_id;
+    header.pack(frame.data() + SOFHeader::size());
+    uint32_t net_keepalive = htonl(keepalive);
+    memcpy(frame.data() + SOFHeader::size() + 29, &net_keepalive, sizeof(net_keepalive));
+    return frame;
+}
+
+// SOFH-framed MarketDataRequest subscribing to every instrument
+static std::vector<uint8_t> make_subscribe_all()
+{
+    std::vector<uint8_t> frame(1024, 0);
+    lseg_sbe::MarketDataRequest request;
+    request.wrapAndApplyHeader(reinterpret_cast<char*>(frame.data()), SOFHeader::size(), frame.size() - SOFHeader::size());
+    request.putMDReqID(std::string("REQ1"));
+    request.subscriptionRequestType(lseg_sbe::SubscriptionRequestTypeEnum::Subscribe);
+    request.mDEntryTypeGrpCount(1).next().mDEntryType(lseg_sbe::EntryTypeEnum::Bid);
+    request.relatedSymGrpCount(0);
+
+    SOFHeader sofh;
+    sofh.message_length = static_cast<uint32_t>(
+        SOFHeader::size() + lseg_sbe::MessageHeader::encodedLength() + request.encodedLength());
+    sofh.pack(frame.data());
+    frame.resize(sofh.message_length);
+    return frame;
+}
+
+// Run the loop until count frames have been received in total
+static bool run_until_received(ReutersProtocolAdapter& adapter, size_t count)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (adapter.get_statistics().messages_received < count && std::chrono::steady_clock::now() < deadline) {
+        adapter.run_once(1);
+    }
+    return adapter.get_statistics().messages_received == count;
+}
+
+// Non-blocking connect to the loopback listener; completes once accepted
+static int connect_client(uint16_t port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+    return fd;
+}
+
+// Run the loop until the adapter holds count sessions or time runs out
+static bool run_until_sessions(ReutersProtocolAdapter& adapter, size_t count, std::chrono::milliseconds limit)
+{
+    auto deadline = std::chrono::steady_clock::now() + limit;
+    while (adapter.session_count() != count && std::chrono::steady_clock::now() < deadline) {
+        adapter.run_once(1);
+    }
+    return adapter.session_count() == count;
+}
+
+// True once the server side has closed the connection
+static bool peer_closed(int fd)
+{
+    uint8_t buffer[4096];
+    ssize_t received;
+    while ((received = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+    }
+    return received == 0;
+}
+
+int main()
+{
+    std::cout << "Testing Reuters Session Event Loop\n"
+              << std::endl;
+
+    // Test 1: Frames come out whole however the stream is cut
+    std::cout << "=== Test 1: SOFH Frame Buffer ===" << std::endl;
+    {
+        std::vector<uint8_t> stream;
+        std::vector<size_t> lengths;
+        for (size_t i = 0; i < 50; ++i) {
+            auto frame = make_frame(i * 13 % 300);
+            lengths.push_back(frame.size());
+            stream.insert(stream.end(), frame.begin(), frame.end());
+        }
+
+        // Deliver in uneven reads, some spanning frames, some splitting them
+        SOFHFrameBuffer buffer(256);
+        std::vector<size_t> extracted;
+        bool valid = true;
+        size_t offset = 0;
+        for (size_t step = 1; offset < stream.size(); step = step * 7 % 97 + 1) {
+            size_t chunk = std::min({ step, stream.size() - offset, buffer.write_space() });
+            memcpy(buffer.write_data(), stream.data() + offset, chunk);
+            buffer.commit(chunk);
+            offset += chunk;
+            valid = valid && buffer.extract([&](const uint8_t* frame, size_t length) {
+                SOFHeader sofh;
+                sofh.unpack(frame);
+                valid = valid && sofh.message_length == length;
+                extracted.push_back(length);
+            });
+        }
+        check(valid, "frames well formed");
+        check(extracted == lengths, "every frame extracted once, in order");
+        check(buffer.buffered() == 0, "nothing left over");
+
+        // A frame larger than the buffer grows it once
+        SOFHFrameBuffer small(64);
+        auto large = make_frame(500);
+        size_t large_count = 0;
+        for (size_t sent = 0; sent < large.size();) {
+            size_t chunk = std::min(large.size() - sent, small.write_space());
+            memcpy(small.write_data(), large.data() + sent, chunk);
+            small.commit(chunk);
+            sent += chunk;
+            small.extract([&](const uint8_t*, size_t) { ++large_count; });
+        }
+        check(large_count == 1, "oversized frame reassembled");
+
+        // A length shorter than the SOFH itself cannot be resynchronised
+        SOFHFrameBuffer corrupt;
+        uint8_t bad[SOFHeader::size()] = {};
+        memcpy(corrupt.write_data(), bad, sizeof(bad));
+        corrupt.commit(sizeof(bad));
+        check(!corrupt.extract([](const uint8_t*, size_t) {}), "bad length rejected");
+    }
+
+    const uint16_t port = 21517;
+    const size_t client_count = 5000;
+    std::vector<int> clients;
+
+    ReutersProtocolAdapter adapter(port);
+    check(adapter.initialize(), "adapter listens");
+
+    // Test 2: Thousands of connections are all accepted
+    std::cout << "=== Test 2: Connection Storm ===" << std::endl;
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < client_count; ++i) {
+            clients.push_back(connect_client(port));
+            if (i % 256 == 255) {
+                adapter.run_once(); // Keep the accept queue short
+            }
+        }
+        check(run_until_sessions(adapter, client_count, std::chrono::seconds(10)), "every client has a session");
+        check(adapter.get_statistics().sessions_created == client_count, "sessions counted");
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  " << adapter.session_count() << " sessions in " << seconds * 1000 << "ms" << std::endl;
+    }
+
+    // Test 3: Pipelined and split frames from one client among thousands
+    std::cout << "=== Test 3: Pipelined Requests ===" << std::endl;
+    {
+        int client = clients[client_count / 2];
+        std::vector<uint8_t> batch;
+        for (int i = 0; i < 3; ++i) {
+            auto frame = make_frame(i * 10);
+            batch.insert(batch.end(), frame.begin(), frame.end());
+        }
+        send(client, batch.data(), batch.size(), 0);
+        check(run_until_received(adapter, 3), "three frames in one segment");
+
+        auto frame = make_frame(40);
+        send(client, frame.data(), 7, 0);
+        adapter.run_once(1);
+        check(adapter.get_statistics().messages_received == 3, "partial frame held back");
+        send(client, frame.data() + 7, frame.size() - 7, 0);
+        check(run_until_received(adapter, 4), "split frame completed");
+
+        // Garbage framing drops the session
+        uint8_t garbage[16] = {};
+        send(clients[0], garbage, sizeof(garbage), 0);
+        check(run_until_sessions(adapter, client_count - 1, std::chrono::seconds(2)), "bad framing closes session");
+        close(clients[0]);
+        clients.erase(clients.begin());
+    }
+
+    // Test 4: Disconnects remove their sessions
+    std::cout << "=== Test 4: Disconnects ===" << std::endl;
+    {
+        for (size_t i = 0; i < 100; ++i) {
+            close(clients.back());
+            clients.pop_back();
+        }
+        check(run_until_sessions(adapter, clients.size(), std::chrono::seconds(2)), "closed sessions dropped");
+    }
+
+    // Benchmark: an idle iteration should not grow with the session count
+    std::cout << "\n=== Benchmark ===" << std::endl;
+    {
+        const int iterations = 10000;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            adapter.run_once();
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  Idle run_once with " << adapter.session_count() << " sessions: " << ns / iterations
+                  << "ns" << std::endl;
+    }
+
+    adapter.shutdown();
+    for (int fd : clients) {
+        close(fd);
+    }
+
+    // Test 5: Idle sessions time out; active ones are kept
+    std::cout << "\n=== Test 5: Inactivity Timeout ===" << std::endl;
+    {
+        ReutersProtocolAdapter timed(port + 1);
+        timed.set_session_timeout(std::chrono::milliseconds(150));
+        check(timed.initialize(), "adapter listens");
+
+        int idle = connect_client(port + 1);
+        int active = connect_client(port + 1);
+        check(run_until_sessions(timed, 2, std::chrono::seconds(2)), "both connected");
+
+        auto start = std::chrono::steady_clock::now();
+        auto last_send = start;
+        while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(400)) {
+            if (std::chrono::steady_clock::now() - last_send > std::chrono::milliseconds(50)) {
+                auto message = make_frame();
+                send(active, message.data(), message.size(), 0);
+                last_send = std::chrono::steady_clock::now();
+            }
+            timed.run_once(5);
+        }
+        check(timed.session_count() == 1, "only the idle session timed out");
+        check(peer_closed(idle), "idle client disconnected");
+        check(!peer_closed(active), "active client still connected");
+
+        timed.shutdown();
+        close(idle);
+        close(active);
+    }
+
+    // Test 6: A 1ms keepalive cannot make the loop spin on heartbeats
+    std::cout << "=== Test 6: Minimum Keepalive ===" << std::endl;
+    {
+        ReutersProtocolAdapter fast(port + 3);
+        check(fast.initialize(), "adapter listens");
+
+        int client = connect_client(port + 3);
+        check(run_until_sessions(fast, 1, std::chrono::seconds(2)), "connected");
+        auto negotiate = make_session_frame(MessageTypes::NEGOTIATE);
+        auto establish = make_session_frame(MessageTypes::ESTABLISH, 1);
+        send(client, negotiate.data(), negotiate.size(), 0);
+        send(client, establish.data(), establish.size(), 0);
+        check(run_until_received(fast, 2), "established");
+        peer_closed(client); // Discard the responses
+
+        auto start = std::chrono::steady_clock::now();
+        int iterations = 0;
+        while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(300)) {
+            fast.run_once(1);
+            ++iterations;
+        }
+        uint8_t buffer[65536];
+        ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+        size_t heartbeats = received > 0 ? received / ReutersEncoder::encode_heartbeat().size() : 0;
+        check(iterations > 10, "run_once keeps returning");
+        check(heartbeats >= 2 && heartbeats <= 8, "heartbeats paced by the minimum interval");
+
+        fast.shutdown();
+        close(client);
+    }
+
+    // Test 7: With io_uring the output limit and policy still hold per
+    // session, so a stalled client loses updates rather than taking the
+    // ring's shared slots from everyone else
+    std::cout << "=== Test 7: io_uring Slow Consumer ===" << std::endl;
+    {
+        ReutersProtocolAdapter ring(port + 4);
+        SessionOutputQueue::Config config;
+        config.max_bytes = 16384;
+        config.policy = SlowConsumerPolicy::DROP;
+        ring.set_output_config(config);
+        check(ring.initialize(), "adapter listens");
+        if (!ring.enable_io_uring()) {
+            std::cout << "  io_uring unavailable, skipped" << std::endl;
+        } else {
+            int stalled = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+            int buffer_size = 4096;
+            setsockopt(stalled, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+            struct sockaddr_in addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(port + 4);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            connect(stalled, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+            int healthy = connect_client(port + 4);
+            check(run_until_sessions(ring, 2, std::chrono::seconds(2)), "connected");
+
+            auto negotiate = make_session_frame(MessageTypes::NEGOTIATE);
+            auto establish = make_session_frame(MessageTypes::ESTABLISH);
+            auto subscribe = make_subscribe_all();
+            for (int fd : { stalled, healthy }) {
+                send(fd, negotiate.data(), negotiate.size(), 0);
+                send(fd, establish.data(), establish.size(), 0);
+                send(fd, subscribe.data(), subscribe.size(), 0);
+            }
+            check(run_until_received(ring, 6), "established and subscribed");
+            peer_closed(stalled);
+            peer_closed(healthy);
+
+            auto quote = std::make_shared<market_core::QuoteEvent>(7);
+            quote->price = 1.2345;
+            quote->quantity = 1000000;
+            // Far more than the kernel's socket buffers hold
+            for (int i = 0; i < 200000; ++i) {
+                ring.on_market_event(quote);
+                if (i % 10 == 9) {
+                    ring.run_once(0);
+                    peer_closed(healthy);
+                }
+            }
+
+            size_t dropping = 0;
+            size_t clean = 0;
+            bool bounded = true;
+            for (const auto& queue : ring.get_session_queue_stats()) {
+                dropping += queue.drops > 0;
+                clean += queue.drops == 0;
+                bounded = bounded && queue.max_queued_bytes <= config.max_bytes;
+            }
+            check(dropping == 1 && clean == 1, "only the stalled session drops");
+            check(bounded, "ring backlog held to the session limit");
+            check(ring.get_statistics().messages_dropped > 0, "drops counted");
+
+            close(stalled);
+            close(healthy);
+        }
+        ring.shutdown();
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll Reuters session tests passed!" << std::endl;
+    return 0;
+}
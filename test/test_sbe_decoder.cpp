@@ -0,0 +1,178 @@
+#include "messages/sbe_decoder.h"
+#include "test_check.h"
+#include <iostream>
+
+using namespace cme_mock;
+
+template <typename T>
+static void append_le(std::vector<uint8_t>& buffer, T value)
+{
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        buffer.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+// Packet header: sequence number and sending time
+static std::vector<uint8_t> make_packet(uint32_t sequence, uint64_t sending_time)
+{
+    std::vector<uint8_t> packet;
+    append_le(packet, sequence);
+    append_le(packet, sending_time);
+    return packet;
+}
+
+// Size field, SBE header, then body_length bytes of body
+static void append_message(std::vector<uint8_t>& packet, uint16_t template_id, uint16_t body_length)
+{
+    append_le<uint16_t>(packet, static_cast<uint16_t>(MDPMessage::HEADER_SIZE + body_length));
+    append_le<uint16_t>(packet, body_length); // Block length
+    append_le<uint16_t>(packet, template_id);
+    append_le<uint16_t>(packet, 1); // Schema ID
+    append_le<uint16_t>(packet, 9); // Version
+    for (uint16_t i = 0; i < body_length; ++i) {
+        packet.push_back(static_cast<uint8_t>(i));
+    }
+}
+
+static std::vector<uint16_t> template_ids(const MDPPacketView& view)
+{
+    std::vector<uint16_t> ids;
+    for (const auto& message : view) {
+        ids.push_back(message.template_id);
+    }
+    return ids;
+}
+
+// Where the walk stopped
+static size_t stop_offset(const MDPPacketView& view)
+{
+    auto it = view.begin();
+    while (it != view.end()) {
+        ++it;
+    }
+    return it.offset();
+}
+
+int main()
+{
+    std::cout << "Testing SBE Decoder\n"
+              << std::endl;
+
+    // Test 1: Field reads stay inside the buffer
+    std::cout << "=== Test 1: Field Decoding ===" << std::endl;
+    {
+        std::vector<uint8_t> buffer;
+        append_le<uint16_t>(buffer, 0x1234);
+        append_le<uint32_t>(buffer, 0xDEADBEEF);
+        append_le<int64_t>(buffer, -123450000000LL);
+        buffer.insert(buffer.end(), { 'E', 'S', 'Z', '4' });
+
+        SBEDecoder decoder(buffer.data() + 1, buffer.size() - 1);
+        decoder.reset(buffer);
+        check(decoder.decode_uint16() == 0x1234 && decoder.decode_uint32() == 0xDEADBEEF, "integers");
+        check(decoder.decode_price(9) == -123.45, "price");
+        check(decoder.decode_string(5).empty() && decoder.get_offset() == 14, "string past the end not read");
+        check(decoder.decode_string(4) == "ESZ4" && decoder.remaining() == 0, "string");
+        check(decoder.decode_uint32() == 0 && decoder.get_offset() == buffer.size(), "0 past the end");
+
+        decoder.reset(buffer.data(), 3);
+        decoder.skip(2);
+        check(!decoder.can_read(2) && decoder.decode_uint16() == 0, "no read across the end");
+        decoder.skip(10);
+        check(decoder.remaining() == 0 && decoder.decode_uint8() == 0, "skip stops at the end");
+    }
+
+    // Test 2: Every message of a multi-message packet, in order
+    std::cout << "=== Test 2: Multi-Message Packet ===" << std::endl;
+    {
+        auto packet = make_packet(42, 1700000000123456789ULL);
+        append_message(packet, 46, 11);
+        append_message(packet, 4, 0);
+        append_message(packet, 52, 3);
+
+        MDPPacketView view(packet);
+        check(view.valid() && view.sequence_number() == 42 && view.sending_time() == 1700000000123456789ULL,
+            "packet header");
+        check(template_ids(view) == std::vector<uint16_t>({ 46, 4, 52 }), "three messages in order");
+        check(stop_offset(view) == packet.size(), "walk ends at the end of the packet");
+
+        auto it = view.begin();
+        check(it->size == 19 && it->block_length == 11 && it->schema_id == 1 && it->version == 9, "message header");
+        check(it->data == packet.data() + MDPPacketView::HEADER_SIZE + MDPPacketView::SIZE_FIELD, "message data");
+        auto body = it->body();
+        check(body.remaining() == 11 && body.decode_uint8() == 0 && body.decode_uint8() == 1, "body decoder");
+        ++it;
+        check(it->size == MDPMessage::HEADER_SIZE && it->body().remaining() == 0, "empty body");
+
+        auto header_only = make_packet(7, 0);
+        MDPPacketView empty(header_only);
+        check(empty.valid() && empty.begin() == empty.end(), "packet without messages");
+    }
+
+    // Test 3: A packet shorter than its header has no fields or messages
+    std::cout << "=== Test 3: Truncated Header ===" << std::endl;
+    {
+        auto packet = make_packet(42, 99);
+        append_message(packet, 46, 4);
+        MDPPacketView view(packet.data(), MDPPacketView::HEADER_SIZE - 1);
+        check(!view.valid() && view.sequence_number() == 0 && view.sending_time() == 0, "no header fields");
+        check(view.begin() == view.end(), "no messages");
+
+        MDPPacketView nothing(packet.data(), 0);
+        check(!nothing.valid() && nothing.begin() == nothing.end(), "empty buffer");
+
+        // Half a size field after the header
+        MDPPacketView split(packet.data(), MDPPacketView::HEADER_SIZE + 1);
+        check(split.valid() && split.begin() == split.end(), "partial size field");
+        check(stop_offset(split) == MDPPacketView::HEADER_SIZE, "stopped at the size field");
+    }
+
+    // Test 4: A size field too small for an SBE header ends the walk
+    std::cout << "=== Test 4: Short Size Field ===" << std::endl;
+    {
+        for (uint16_t size : { 0, 1, 7 }) {
+            auto packet = make_packet(1, 0);
+            append_message(packet, 46, 4);
+            size_t bad = packet.size();
+            append_le<uint16_t>(packet, size);
+            packet.insert(packet.end(), 16, 0);
+            append_message(packet, 52, 4); // Unreachable
+
+            MDPPacketView view(packet);
+            std::string label = "size " + std::to_string(size);
+            check(template_ids(view) == std::vector<uint16_t>({ 46 }), label + ": messages before it");
+            check(stop_offset(view) == bad, label + ": stopped at the bad size field");
+        }
+    }
+
+    // Test 5: A size field past the end of the buffer ends the walk
+    std::cout << "=== Test 5: Size Field Past the End ===" << std::endl;
+    {
+        auto packet = make_packet(1, 0);
+        append_message(packet, 46, 4);
+        size_t last = packet.size();
+        append_message(packet, 52, 20);
+
+        MDPPacketView whole(packet);
+        check(template_ids(whole) == std::vector<uint16_t>({ 46, 52 }), "complete packet");
+
+        MDPPacketView cut(packet.data(), packet.size() - 1);
+        check(template_ids(cut) == std::vector<uint16_t>({ 46 }), "message one byte short dropped");
+        check(stop_offset(cut) == last, "stopped at the overlong size field");
+
+        // Largest size field, nowhere near the buffer's length
+        packet[last] = 0xFF;
+        packet[last + 1] = 0xFF;
+        MDPPacketView huge(packet);
+        check(template_ids(huge) == std::vector<uint16_t>({ 46 }) && stop_offset(huge) == last, "0xFFFF size");
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll SBE decoder tests passed!" << std::endl;
+    return 0;
+}
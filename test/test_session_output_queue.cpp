@@ -0,0 +1,262 @@
+#include "session_output_queue.h"
+#include "test_check.h"
+#include <algorithm>
+#include <chrono>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace reuters_protocol;
+using Result = SessionOutputQueue::Result;
+
+// Stream pair whose writing end is non-blocking with a small buffer
+static void make_pair(int& writer, int& reader)
+{
+    int fds[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    writer = fds[0];
+    reader = fds[1];
+    int buffer_size = 4096;
+    setsockopt(writer, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+    fcntl(writer, F_SETFL, fcntl(writer, F_GETFL, 0) | O_NONBLOCK);
+    fcntl(reader, F_SETFL, fcntl(reader, F_GETFL, 0) | O_NONBLOCK);
+}
+
+static std::vector<uint8_t> read_all(int fd)
+{
+    std::vector<uint8_t> data;
+    uint8_t buffer[65536];
+    ssize_t received;
+    while ((received = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        data.insert(data.end(), buffer, buffer + received);
+    }
+    return data;
+}
+
+// Send frames until one is queued rather than written
+static std::vector<uint8_t> fill(SessionOutputQueue& queue, int fd)
+{
+    std::vector<uint8_t> sent;
+    std::vector<uint8_t> frame(1000, 0xAA);
+    while (queue.empty()) {
+        queue.send(fd, frame.data(), frame.size());
+        sent.insert(sent.end(), frame.begin(), frame.end());
+    }
+    return sent;
+}
+
+int main()
+{
+    std::cout << "Testing Session Output Queue\n"
+              << std::endl;
+
+    // Test 1: Frames go straight out, then queue, and arrive in order
+    std::cout << "=== Test 1: Direct and Queued Sends ===" << std::endl;
+    {
+        int writer, reader;
+        make_pair(writer, reader);
+        SessionOutputQueue queue;
+
+        std::vector<uint8_t> small(100, 0x01);
+        check(queue.send(writer, small.data(), small.size()) == Result::SENT, "idle socket takes the frame");
+        check(read_all(reader) == small, "frame received");
+
+        std::vector<uint8_t> expected = fill(queue, writer);
+        for (int i = 0; i < 50; ++i) {
+            std::vector<uint8_t> frame(300, static_cast<uint8_t>(i));
+            check(queue.send(writer, frame.data(), frame.size()) == Result::QUEUED, "backlogged frame queued");
+            expected.insert(expected.end(), frame.begin(), frame.end());
+        }
+        check(queue.depth() > 50 && queue.queued_bytes() > 0, "backlog visible");
+
+        std::vector<uint8_t> received;
+        for (int i = 0; i < 1000 && !queue.empty(); ++i) {
+            auto chunk = read_all(reader);
+            received.insert(received.end(), chunk.begin(), chunk.end());
+            check(queue.flush(writer), "flush succeeds");
+        }
+        auto rest = read_all(reader);
+        received.insert(received.end(), rest.begin(), rest.end());
+        check(queue.empty() && queue.queued_bytes() == 0, "queue drained");
+        check(received == expected, "byte stream intact and in order");
+        close(writer);
+        close(reader);
+    }
+
+    // Test 2: Past the limit a newer update replaces a queued one with the
+    // same key and takes its place at the tail, behind frames queued in
+    // between
+    std::cout << "=== Test 2: Conflation ===" << std::endl;
+    {
+        int writer, reader;
+        make_pair(writer, reader);
+        SessionOutputQueue queue;
+        size_t filled = fill(queue, writer).size();
+        size_t depth = queue.depth();
+        SessionOutputQueue::Config config;
+        config.max_bytes = queue.queued_bytes() + 160; // Snapshot, one quote and the trade
+        queue.configure(config);
+
+        std::vector<uint8_t> snapshot(70, 0x55);
+        check(queue.send(writer, snapshot.data(), snapshot.size(), 8) == Result::QUEUED, "snapshot queued");
+        for (uint8_t version = 1; version <= 3; ++version) {
+            std::vector<uint8_t> quote(50, version);
+            Result result = queue.send(writer, quote.data(), quote.size(), 7);
+            check(result == (version == 1 ? Result::QUEUED : Result::CONFLATED), "quote queued, then conflated");
+        }
+        std::vector<uint8_t> trade(40, 0xEE);
+        check(queue.send(writer, trade.data(), trade.size()) == Result::QUEUED, "trade fits");
+        std::vector<uint8_t> newer_snapshot(70, 0x66);
+        check(queue.send(writer, newer_snapshot.data(), newer_snapshot.size(), 8) == Result::CONFLATED,
+            "snapshot conflated");
+        check(queue.depth() == depth + 3 && queue.conflations() == 3, "one quote, one trade and one snapshot queued");
+
+        std::vector<uint8_t> received;
+        while (!queue.empty()) {
+            auto chunk = read_all(reader);
+            received.insert(received.end(), chunk.begin(), chunk.end());
+            queue.flush(writer);
+        }
+        auto rest = read_all(reader);
+        received.insert(received.end(), rest.begin(), rest.end());
+        std::vector<uint8_t> tail(received.end() - 160, received.end());
+        std::vector<uint8_t> expected(50, 3);
+        expected.insert(expected.end(), trade.begin(), trade.end());
+        expected.insert(expected.end(), newer_snapshot.begin(), newer_snapshot.end());
+        check(tail == expected, "latest quote, then the trade, then the latest snapshot");
+        check(received.size() == filled + tail.size(), "replaced frames not sent");
+        close(writer);
+        close(reader);
+    }
+
+    // Test 3: Dropping holds later frames back until a gap notice fits
+    std::cout << "=== Test 3: Drop With Gap ===" << std::endl;
+    {
+        int writer, reader;
+        make_pair(writer, reader);
+        SessionOutputQueue::Config config;
+        config.max_bytes = 10000;
+        config.policy = SlowConsumerPolicy::DROP;
+        SessionOutputQueue queue(config);
+        fill(queue, writer);
+
+        std::vector<uint8_t> frame(1000, 0x42);
+        size_t dropped = 0;
+        for (int i = 0; i < 20; ++i) {
+            dropped += queue.send(writer, frame.data(), frame.size()) == Result::DROPPED;
+        }
+        check(dropped > 0 && queue.queued_bytes() <= config.max_bytes, "frames past the limit dropped");
+        check(queue.gap_pending() && queue.take_gap() == 0, "no gap notice while backlogged");
+        check(queue.send(writer, frame.data(), frame.size()) == Result::DROPPED, "frames dropped until notice");
+
+        while (!queue.empty()) {
+            read_all(reader);
+            queue.flush(writer);
+        }
+        check(queue.take_gap() == dropped + 1, "gap notice counts every dropped frame");
+        check(!queue.gap_pending() && queue.drops() == dropped + 1, "gap cleared");
+        check(queue.send(writer, frame.data(), frame.size()) == Result::SENT, "sending resumes");
+        close(writer);
+        close(reader);
+    }
+
+    // Test 4: Disconnect policy and a vanished peer
+    std::cout << "=== Test 4: Disconnect ===" << std::endl;
+    {
+        int writer, reader;
+        make_pair(writer, reader);
+        SessionOutputQueue::Config config;
+        config.max_bytes = 5000;
+        config.policy = SlowConsumerPolicy::DISCONNECT;
+        SessionOutputQueue queue(config);
+        fill(queue, writer);
+
+        std::vector<uint8_t> frame(1000, 0x42);
+        Result result = Result::QUEUED;
+        for (int i = 0; i < 10 && result == Result::QUEUED; ++i) {
+            result = queue.send(writer, frame.data(), frame.size());
+        }
+        check(result == Result::DISCONNECT, "overflow asks for disconnect");
+
+        close(reader);
+        check(!queue.flush(writer), "flush to a closed peer fails without SIGPIPE");
+        close(writer);
+    }
+
+    // Test 5: Below the limit, or under DROP, no queued frame is replaced
+    std::cout << "=== Test 5: No Replacement Without Need ===" << std::endl;
+    for (SlowConsumerPolicy policy : { SlowConsumerPolicy::CONFLATE, SlowConsumerPolicy::DROP }) {
+        bool drop = policy == SlowConsumerPolicy::DROP;
+        std::string label = drop ? "DROP: " : "CONFLATE: ";
+        int writer, reader;
+        make_pair(writer, reader);
+        SessionOutputQueue queue;
+        size_t filled = fill(queue, writer).size();
+        SessionOutputQueue::Config config;
+        config.max_bytes = queue.queued_bytes() + 100; // Two quotes
+        config.policy = policy;
+        queue.configure(config);
+
+        std::vector<uint8_t> expected;
+        for (uint8_t version = 1; version <= 2; ++version) {
+            std::vector<uint8_t> quote(50, version);
+            check(queue.send(writer, quote.data(), quote.size(), 7) == Result::QUEUED,
+                label + "quote below the limit queued");
+            expected.insert(expected.end(), quote.begin(), quote.end());
+        }
+        std::vector<uint8_t> third(50, 3);
+        Result result = queue.send(writer, third.data(), third.size(), 7);
+        check(result == (drop ? Result::DROPPED : Result::CONFLATED), label + "quote past the limit");
+        check(queue.conflations() == (drop ? 0u : 1u), label + "conflations counted");
+        if (!drop) {
+            expected.erase(expected.begin() + 50, expected.end());
+            expected.insert(expected.end(), third.begin(), third.end());
+        }
+
+        std::vector<uint8_t> received;
+        while (!queue.empty()) {
+            auto chunk = read_all(reader);
+            received.insert(received.end(), chunk.begin(), chunk.end());
+            queue.flush(writer);
+        }
+        auto rest = read_all(reader);
+        received.insert(received.end(), rest.begin(), rest.end());
+        check(received.size() == filled + expected.size()
+                && std::equal(expected.begin(), expected.end(), received.end() - expected.size()),
+            label + (drop ? "both queued quotes sent" : "first quote, then the latest"));
+        close(writer);
+        close(reader);
+    }
+
+    // Benchmark: publishing to a stalled client must stay cheap
+    std::cout << "\n=== Benchmark ===" << std::endl;
+    {
+        int writer, reader;
+        make_pair(writer, reader);
+        SessionOutputQueue queue;
+        fill(queue, writer);
+
+        const int sends = 1000000;
+        std::vector<uint8_t> quote(80, 0x33);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < sends; ++i) {
+            queue.send(writer, quote.data(), quote.size(), 1 + i % 64); // 64 instruments
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "  Send to a stalled client (conflating 64 instruments): " << ns / sends << "ns, depth "
+                  << queue.depth() << ", " << queue.conflations() << " conflated" << std::endl;
+        close(writer);
+        close(reader);
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll session output queue tests passed!" << std::endl;
+    return 0;
+}
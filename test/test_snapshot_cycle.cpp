@@ -0,0 +1,176 @@
+#include "capture_transport.h"
+#include "cme_encoder.h"
+#include "cme_event_listener.h"
+#include "cme_snapshot_cycle.h"
+#include "market_data_generator.h"
+#include "test_check.h"
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <thread>
+
+using namespace market_core;
+
+struct Snapshot {
+    uint32_t packet_sequence;
+    int32_t security_id;
+    uint32_t last_msg_seq_num_processed;
+    uint32_t tot_num_reports;
+    uint32_t rpt_seq;
+};
+
+// Template 52 messages after each 12-byte packet header
+static std::vector<Snapshot> decode_snapshots(const std::vector<std::vector<uint8_t>>& packets)
+{
+    std::vector<Snapshot> snapshots;
+    for (const auto& packet : packets) {
+        uint32_t packet_sequence;
+        std::memcpy(&packet_sequence, packet.data(), 4);
+
+        size_t offset = 12;
+        while (offset + 2 <= packet.size()) {
+            uint16_t size;
+            std::memcpy(&size, packet.data() + offset, 2);
+            char* message = const_cast<char*>(reinterpret_cast<const char*>(packet.data() + offset + 2));
+
+            cme_sbe::MessageHeader header(message, size);
+            if (header.templateId() == cme_sbe::SnapshotFullRefresh52::sbeTemplateId()) {
+                cme_sbe::SnapshotFullRefresh52 decoded;
+                decoded.wrapForDecode(message, header.encodedLength(), header.blockLength(), header.version(), size);
+                snapshots.push_back({ packet_sequence, decoded.securityID(), decoded.lastMsgSeqNumProcessed(),
+                    decoded.totNumReports(), decoded.rptSeq() });
+            }
+            offset += 2 + size;
+        }
+    }
+    return snapshots;
+}
+
+struct Fixture {
+    std::shared_ptr<OrderBookManager> manager = std::make_shared<OrderBookManager>();
+    std::shared_ptr<MarketDataGenerator> generator;
+    std::shared_ptr<CaptureTransport> incremental_transport = std::make_shared<CaptureTransport>();
+    std::shared_ptr<CaptureTransport> snapshot_transport = std::make_shared<CaptureTransport>();
+    std::shared_ptr<cme_protocol::CMEProtocolAdapter> incremental = std::make_shared<cme_protocol::CMEProtocolAdapter>();
+    std::shared_ptr<cme_protocol::CMEProtocolAdapter> snapshots = std::make_shared<cme_protocol::CMEProtocolAdapter>();
+    std::shared_ptr<cme_protocol::CMEEventListener> listener;
+
+    explicit Fixture(uint32_t instruments)
+    {
+        for (uint32_t id = 1; id <= instruments; ++id) {
+            auto instrument = std::make_shared<FuturesInstrument>(id, "ES" + std::to_string(id));
+            instrument->tick_size = 0.25;
+            instrument->set_property("initial_price", 4500.0);
+            manager->add_instrument(instrument);
+            manager->create_order_book(id);
+        }
+
+        generator = std::make_shared<MarketDataGenerator>(manager);
+        incremental->set_transport(incremental_transport);
+        incremental->set_batch_size(1000);
+        snapshots->set_transport(snapshot_transport);
+        listener = std::make_shared<cme_protocol::CMEEventListener>(manager, incremental);
+        generator->add_listener(listener);
+    }
+};
+
+int main()
+{
+    std::cout << "Testing CME Snapshot Cycle\n"
+              << std::endl;
+
+    // Test 1: One cycle reports every instrument, stamped against the
+    // incremental feed
+    std::cout << "=== Test 1: Cycle Stamping ===" << std::endl;
+    {
+        Fixture fixture(6);
+        fixture.generator->generate_batch(500);
+
+        cme_protocol::CMESnapshotCycle::Config config;
+        cme_protocol::CMESnapshotCycle cycle(fixture.manager, fixture.snapshots, fixture.incremental, config);
+        check(cycle.run_cycle() == 6, "one snapshot per instrument");
+
+        auto decoded = decode_snapshots(fixture.snapshot_transport->packets);
+        check(decoded.size() == 6, "six template 52 messages");
+
+        uint32_t incremental_sequence = fixture.incremental->last_sent_sequence();
+        check(incremental_sequence == fixture.incremental_transport->packets.size(), "incremental sequence tracked");
+
+        bool stamped = true;
+        bool rpt_seq_matches = true;
+        for (const auto& snapshot : decoded) {
+            stamped &= snapshot.last_msg_seq_num_processed == incremental_sequence && snapshot.tot_num_reports == 6;
+            auto book = fixture.manager->get_order_book(static_cast<uint32_t>(snapshot.security_id));
+            rpt_seq_matches &= book && snapshot.rpt_seq == book->last_sequence() && snapshot.rpt_seq > 0;
+        }
+        check(stamped, "lastMsgSeqNumProcessed and totNumReports");
+        check(rpt_seq_matches, "rptSeq is the book's last applied sequence");
+        check(!decoded.empty() && decoded.front().packet_sequence == 1, "snapshot channel starts at 1");
+
+        // The next cycle restarts the snapshot sequence and moves with the books
+        fixture.generator->generate_batch(500);
+        fixture.snapshot_transport->packets.clear();
+        cycle.run_cycle();
+        auto next = decode_snapshots(fixture.snapshot_transport->packets);
+        check(!next.empty() && next.front().packet_sequence == 1, "sequence restarts each cycle");
+        check(!next.empty() && next.front().last_msg_seq_num_processed == fixture.incremental->last_sent_sequence(),
+            "later cycle stamped with the later incremental sequence");
+        check(cycle.get_statistics().cycles == 2 && cycle.get_statistics().snapshots == 12, "statistics");
+    }
+
+    // Test 2: Background cycling alongside incremental publishing
+    std::cout << "=== Test 2: Background Cycle ===" << std::endl;
+    {
+        Fixture fixture(20);
+        fixture.generator->generate_all_instruments();
+
+        cme_protocol::CMESnapshotCycle::Config config;
+        config.snapshots_per_second = 20000.0;
+        config.max_depth = 5;
+        cme_protocol::CMESnapshotCycle cycle(fixture.manager, fixture.snapshots, fixture.incremental, config);
+        cycle.start();
+        check(cycle.is_running(), "thread started");
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (cycle.get_statistics().cycles < 3 && std::chrono::steady_clock::now() < deadline) {
+            fixture.generator->generate_batch(50);
+        }
+        cycle.stop();
+        check(!cycle.is_running(), "thread stopped");
+
+        auto stats = cycle.get_statistics();
+        std::cout << "  " << stats.cycles << " cycles, " << stats.snapshots << " snapshots, "
+                  << fixture.incremental->last_sent_sequence() << " incremental packets" << std::endl;
+        check(stats.cycles >= 3, "cycled continuously");
+
+        // Per instrument, both stamps only move forward and lastMsgSeqNumProcessed
+        // never runs ahead of the incremental feed
+        std::map<int32_t, Snapshot> previous;
+        bool monotonic = true;
+        bool bounded = true;
+        bool reports = true;
+        for (const auto& snapshot : decode_snapshots(fixture.snapshot_transport->packets)) {
+            auto it = previous.find(snapshot.security_id);
+            if (it != previous.end()) {
+                monotonic &= snapshot.rpt_seq >= it->second.rpt_seq
+                    && snapshot.last_msg_seq_num_processed >= it->second.last_msg_seq_num_processed;
+            }
+            previous[snapshot.security_id] = snapshot;
+            bounded &= snapshot.last_msg_seq_num_processed <= fixture.incremental->last_sent_sequence();
+            reports &= snapshot.tot_num_reports == 20;
+        }
+        check(previous.size() == 20, "every instrument reported");
+        check(monotonic, "rptSeq and lastMsgSeqNumProcessed non-decreasing");
+        check(bounded, "lastMsgSeqNumProcessed within the incremental feed");
+        check(reports, "totNumReports is the instrument count");
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll snapshot cycle tests passed!" << std::endl;
+    return 0;
+}
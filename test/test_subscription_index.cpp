@@ -0,0 +1,256 @@
+#include "lseg_sbe/MarketDataRequest.h"
+#include "reuters_protocol_adapter.h"
+#include "subscription_index.h"
+#include "test_check.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace reuters_protocol;
+
+static std::vector<ClientSession*> subscribers(const SubscriptionIndex& index, uint32_t instrument_id)
+{
+    std::vector<ClientSession*> result;
+    index.for_each_subscriber(instrument_id, [&](ClientSession& session) { result.push_back(&session); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// SOFH-framed session message; the body is zero padding
+static std::vector<uint8_t> make_session_frame(uint16_t template_id)
+{
+    std::vector<uint8_t> frame(SOFHeader::size() + 256, 0);
+    SOFHeader sofh;
+    sofh.message_length = static_cast<uint32_t>(frame.size());
+    sofh.pack(frame.data());
+    SBEMessageHeader header;
+    header.template_id = template_id;
+    header.pack(frame.data() + SOFHeader::size());
+    return frame;
+}
+
+// SOFH-framed MarketDataRequest; no securities means every instrument
+static std::vector<uint8_t> make_request(lseg_sbe::SubscriptionRequestTypeEnum::Value type,
+    const std::vector<std::string>& securities)
+{
+    std::vector<uint8_t> frame(1024, 0);
+    char* buffer = reinterpret_cast<char*>(frame.data());
+    lseg_sbe::MarketDataRequest request;
+    request.wrapAndApplyHeader(buffer, SOFHeader::size(), frame.size() - SOFHeader::size());
+    request.putMDReqID(std::string("REQ1"));
+    request.subscriptionRequestType(type);
+    request.mDEntryTypeGrpCount(1).next().mDEntryType(lseg_sbe::EntryTypeEnum::Bid);
+    auto& symbols = request.relatedSymGrpCount(static_cast<uint16_t>(securities.size()));
+    for (const auto& security : securities) {
+        symbols.next().putSecurityID(security);
+    }
+
+    SOFHeader sofh;
+    sofh.message_length = static_cast<uint32_t>(
+        SOFHeader::size() + lseg_sbe::MessageHeader::encodedLength() + request.encodedLength());
+    sofh.pack(frame.data());
+    frame.resize(sofh.message_length);
+    return frame;
+}
+
+static int connect_client(uint16_t port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+    return fd;
+}
+
+// Bytes waiting on a client socket, discarded
+static size_t drain(int fd)
+{
+    uint8_t buffer[65536];
+    size_t total = 0;
+    ssize_t received;
+    while ((received = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        total += static_cast<size_t>(received);
+    }
+    return total;
+}
+
+static void run_for(ReutersProtocolAdapter& adapter, std::chrono::milliseconds duration)
+{
+    auto deadline = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < deadline) {
+        adapter.run_once(1);
+    }
+}
+
+// Connect, negotiate and establish count clients
+static std::vector<int> establish_clients(ReutersProtocolAdapter& adapter, uint16_t port, size_t count)
+{
+    std::vector<int> clients;
+    for (size_t i = 0; i < count; ++i) {
+        clients.push_back(connect_client(port));
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (adapter.session_count() < count && std::chrono::steady_clock::now() < deadline) {
+        adapter.run_once(1);
+    }
+
+    auto negotiate = make_session_frame(MessageTypes::NEGOTIATE);
+    auto establish = make_session_frame(MessageTypes::ESTABLISH);
+    for (int fd : clients) {
+        send(fd, negotiate.data(), negotiate.size(), 0);
+        send(fd, establish.data(), establish.size(), 0);
+    }
+    run_for(adapter, std::chrono::milliseconds(50));
+    for (int fd : clients) {
+        drain(fd);
+    }
+    return clients;
+}
+
+static std::shared_ptr<market_core::QuoteEvent> make_quote(uint32_t instrument_id)
+{
+    auto quote = std::make_shared<market_core::QuoteEvent>(instrument_id);
+    quote->price = 1.2345;
+    quote->quantity = 1000000;
+    return quote;
+}
+
+int main()
+{
+    std::cout << "Testing Reuters Subscription Index\n"
+              << std::endl;
+
+    // Test 1: Subscribe, unsubscribe and wildcard bookkeeping
+    std::cout << "=== Test 1: Index Maintenance ===" << std::endl;
+    {
+        SubscriptionIndex index;
+        ClientSession a, b, c;
+
+        check(index.subscribe(&a, 1) && index.subscribe(&a, 2), "a subscribes to 1 and 2");
+        check(!index.subscribe(&a, 1), "duplicate subscription ignored");
+        check(index.subscribe(&b, 2), "b subscribes to 2");
+        check(subscribers(index, 1) == std::vector<ClientSession*> { &a }, "instrument 1 has one subscriber");
+        check(index.subscriber_count(2) == 2 && index.subscriber_count(3) == 0, "counts per instrument");
+
+        index.subscribe_all(&c);
+        check(index.subscriber_count(3) == 1 && index.is_subscribed(&c, 42), "wildcard reaches every instrument");
+        check(!index.subscribe(&c, 2), "wildcard session not listed twice");
+
+        check(index.unsubscribe(&a, 2) && !index.unsubscribe(&a, 2), "unsubscribe once");
+        std::vector<ClientSession*> expected { &b, &c };
+        std::sort(expected.begin(), expected.end());
+        check(subscribers(index, 2) == expected, "remaining subscribers of 2");
+
+        index.subscribe_all(&a);
+        check(subscribers(index, 1).size() == 2, "a listed once after going wildcard");
+
+        index.remove(&a);
+        index.remove(&c);
+        check(subscribers(index, 1).empty() && index.subscriber_count(2) == 1, "removed sessions gone");
+        index.unsubscribe(&b, 2);
+        check(index.empty(), "no sessions left");
+    }
+
+    const uint16_t port = 21519;
+    ReutersProtocolAdapter adapter(port);
+    check(adapter.initialize(), "adapter listens");
+
+    // Test 2: Requests from clients drive the index and the fan-out
+    std::cout << "=== Test 2: Market Data Requests ===" << std::endl;
+    {
+        auto clients = establish_clients(adapter, port, 3);
+        using Type = lseg_sbe::SubscriptionRequestTypeEnum;
+
+        auto request = make_request(Type::Subscribe, { "1001" });
+        send(clients[0], request.data(), request.size(), 0);
+        request = make_request(Type::Subscribe, { "1001", "1002" });
+        send(clients[1], request.data(), request.size(), 0);
+        request = make_request(Type::Subscribe, {});
+        send(clients[2], request.data(), request.size(), 0);
+        run_for(adapter, std::chrono::milliseconds(20));
+        check(adapter.subscriber_count(1001) == 3, "three sessions on 1001");
+        check(adapter.subscriber_count(1002) == 2 && adapter.subscriber_count(7) == 1, "specific and wildcard");
+
+        adapter.on_market_event(make_quote(1002));
+        run_for(adapter, std::chrono::milliseconds(20));
+        check(drain(clients[0]) == 0, "unsubscribed client skipped");
+        check(drain(clients[1]) > 0 && drain(clients[2]) > 0, "subscribers receive the quote");
+
+        request = make_request(Type::Unsubscribe, { "1001" });
+        send(clients[1], request.data(), request.size(), 0);
+        request = make_request(Type::Subscribe, { "EURUSD" });
+        send(clients[0], request.data(), request.size(), 0);
+        run_for(adapter, std::chrono::milliseconds(20));
+        check(adapter.subscriber_count(1001) == 2 && adapter.subscriber_count(1002) == 2, "unsubscribed from 1001");
+        check(drain(clients[0]) > 0, "unknown security rejected");
+
+        close(clients[2]);
+        run_for(adapter, std::chrono::milliseconds(20));
+        check(adapter.subscriber_count(7) == 0 && adapter.subscriber_count(1001) == 1, "closed session unsubscribed");
+
+        close(clients[0]);
+        close(clients[1]);
+        run_for(adapter, std::chrono::milliseconds(20));
+        check(adapter.session_count() == 0 && adapter.subscriber_count(1002) == 0, "index empty");
+    }
+
+    // Benchmark: fan-out follows the subscribers, not the sessions
+    std::cout << "\n=== Benchmark ===" << std::endl;
+    {
+        const size_t session_count = 1000;
+        auto clients = establish_clients(adapter, port, session_count);
+        for (size_t i = 0; i < clients.size(); ++i) {
+            auto request = make_request(lseg_sbe::SubscriptionRequestTypeEnum::Subscribe, { std::to_string(i) });
+            send(clients[i], request.data(), request.size(), 0);
+        }
+        run_for(adapter, std::chrono::milliseconds(100));
+        check(adapter.subscriber_count(0) == 1 && adapter.subscriber_count(session_count - 1) == 1,
+            "one subscriber per instrument");
+
+        const int events = 100000;
+        std::vector<std::shared_ptr<market_core::QuoteEvent>> quotes;
+        for (size_t i = 0; i < session_count; ++i) {
+            quotes.push_back(make_quote(static_cast<uint32_t>(i)));
+        }
+        auto unwatched = make_quote(static_cast<uint32_t>(session_count));
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < events; ++i) {
+            adapter.on_market_event(quotes[i % session_count]);
+        }
+        double subscribed_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < events; ++i) {
+            adapter.on_market_event(unwatched);
+        }
+        double unwatched_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "  Quote to 1 of " << adapter.session_count() << " sessions: " << subscribed_ns / events
+                  << "ns/event" << std::endl;
+        std::cout << "  Quote with no subscribers: " << unwatched_ns / events << "ns/event" << std::endl;
+
+        for (int fd : clients) {
+            close(fd);
+        }
+    }
+
+    adapter.shutdown();
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll subscription index tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include "udp_multicast_transport.h"
+#include "loopback_receiver.h"
+#include "test_check.h"
+#include "udp_transport.h"
+#include <chrono>
+#include <iostream>
+
+// Room for every datagram a test sends before it drains
+static constexpr int RECEIVE_BUFFER = 4 * 1024 * 1024;
+
+// Runs of equal sizes with short tails, so GSO batches form and break
+static std::vector<std::vector<uint8_t>> make_packets(size_t count)
+{
+    static const size_t sizes[] = { 200, 200, 200, 120, 300, 300, 64, 64, 64, 64, 1400 };
+    std::vector<std::vector<uint8_t>> packets;
+    for (size_t i = 0; i < count; ++i) {
+        std::vector<uint8_t> packet(sizes[i % (sizeof(sizes) / sizeof(sizes[0]))]);
+        for (size_t b = 0; b < packet.size(); ++b) {
+            packet[b] = static_cast<uint8_t>(i * 31 + b);
+        }
+        packets.push_back(packet);
+    }
+    return packets;
+}
+
+// Fails every send after the first `limit`
+class FailingTransport : public market_protocols::IMessageTransport {
+public:
+    explicit FailingTransport(size_t limit)
+        : limit_(limit)
+    {
+    }
+
+    bool send_message(const std::vector<uint8_t>&) override
+    {
+        if (sent_ == limit_) {
+            return false;
+        }
+        ++sent_;
+        return true;
+    }
+    std::string get_transport_type() const override { return "FAILING"; }
+    bool is_connected() const override { return true; }
+
+private:
+    size_t limit_;
+    size_t sent_ = 0;
+};
+
+static double run_benchmark(market_protocols::UDPTransport& transport,
+    const std::vector<market_protocols::PacketRef>& refs, size_t batches, bool batched)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t b = 0; b < batches; ++b) {
+        if (batched) {
+            transport.send_packets(refs.data(), refs.size());
+        } else {
+            for (const auto& ref : refs) {
+                transport.send_packet(ref.data, ref.length);
+            }
+        }
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(batches * refs.size()) / elapsed;
+}
+
+int main()
+{
+    std::cout << "Testing UDP Batch Sender\n"
+              << std::endl;
+
+    auto packets = make_packets(150);
+
+    // Test 1: A batch arrives whole, in order, in fewer syscalls
+    std::cout << "=== Test 1: Batched Send ===" << std::endl;
+    for (bool gso : { true, false }) {
+        Receiver receiver(RECEIVE_BUFFER);
+        market_protocols::UDPTransport transport("127.0.0.1", receiver.port());
+        check(transport.initialize(), "transport initializes");
+        bool gso_on = transport.set_gso_enabled(gso);
+        std::cout << "  GSO " << (gso ? "requested" : "off") << ", in use: " << (gso_on ? "yes" : "no") << std::endl;
+
+        check(transport.send_batch(packets), "batch sent");
+        check(receiver.drain() == packets, "datagrams match, in order");
+
+        const auto& sender = transport.batch_sender();
+        check(sender.datagrams_sent() == packets.size(), "datagram count");
+        check(sender.syscalls() <= (packets.size() + 63) / 64, "at most one syscall per 64 packets");
+        std::cout << "  " << packets.size() << " packets in " << sender.syscalls() << " syscall(s)" << std::endl;
+    }
+
+    // Test 2: The multicast transport class shares the batch path
+    std::cout << "=== Test 2: Multicast Transport Batch ===" << std::endl;
+    {
+        Receiver receiver(RECEIVE_BUFFER);
+        protocol_common::UDPTransport transport;
+        check(transport.create_multicast_sender("127.0.0.1", receiver.port()), "sender created");
+
+        std::vector<market_protocols::PacketRef> refs;
+        for (const auto& packet : packets) {
+            refs.push_back({ packet.data(), packet.size() });
+        }
+        check(transport.send_packets(refs.data(), refs.size()) == packets.size(), "all packets sent");
+        check(receiver.drain() == packets, "datagrams match, in order");
+        check(transport.batch_sender().syscalls() < packets.size(), "fewer syscalls than packets");
+    }
+
+    // Test 3: The default batch path stops at the first failure
+    std::cout << "=== Test 3: Default Batch Fallback ===" << std::endl;
+    {
+        FailingTransport transport(3);
+        std::vector<market_protocols::PacketRef> refs(5, { packets[0].data(), packets[0].size() });
+        check(transport.send_packets(refs.data(), refs.size()) == 3, "sent up to the failure");
+    }
+
+    // Benchmark: loopback throughput for MDP-sized packets
+    std::cout << "\n=== Benchmark ===" << std::endl;
+    {
+        Receiver receiver(RECEIVE_BUFFER);
+        std::vector<uint8_t> packet(200, 0x5A);
+        std::vector<market_protocols::PacketRef> refs(64, { packet.data(), packet.size() });
+        const size_t batches = 2000;
+
+        struct Mode {
+            const char* name;
+            bool batched;
+            bool gso;
+        };
+        for (const Mode& mode : { Mode { "sendto per packet", false, false },
+                 Mode { "sendmmsg", true, false },
+                 Mode { "sendmmsg + GSO", true, true } }) {
+            market_protocols::UDPTransport transport("127.0.0.1", receiver.port());
+            transport.initialize();
+            bool gso_on = transport.set_gso_enabled(mode.gso);
+            if (mode.gso && !gso_on) {
+                std::cout << "  " << mode.name << ": UDP_SEGMENT unsupported, skipped" << std::endl;
+                continue;
+            }
+
+            double rate = run_benchmark(transport, refs, batches, mode.batched);
+            receiver.drain();
+
+            uint64_t packets_sent = batches * refs.size();
+            double syscalls = mode.batched ? static_cast<double>(transport.batch_sender().syscalls()) : static_cast<double>(packets_sent);
+            std::cout << "  " << mode.name << ": " << static_cast<uint64_t>(rate) << " packets/sec, "
+                      << syscalls / static_cast<double>(packets_sent) << " syscalls/packet" << std::endl;
+        }
+    }
+
+    if (failures > 0) {
+        std::cout << "\n"
+                  << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll UDP batch sender tests passed!" << std::endl;
+    return 0;
+}